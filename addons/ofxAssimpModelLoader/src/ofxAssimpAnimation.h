@@ -47,6 +47,7 @@ protected:
     
     shared_ptr<const aiScene> scene;
     aiAnimation * animation;
+    vector<aiNode*> channelNodes; // node animated by each channel, found once
     float animationCurrTime;
     float animationPrevTime;
     bool bPlay;
@@ -11,6 +11,13 @@
 
 class aiMesh;
 
+// a bone influencing a vertex, stored per vertex so skinning
+// reads each vertex's weights contiguously
+struct ofxAssimpBoneWeight {
+    unsigned int bone;
+    float weight;
+};
+
 class ofxAssimpMeshHelper {
 
 public:
@@ -37,6 +44,13 @@ public:
     vector<aiVector3D> animatedPos;
     vector<aiVector3D> animatedNorm;
 
+    // skinning data built when the model is loaded. the weights of
+    // vertex i are weights[weightsStart[i]] to weights[weightsStart[i+1]-1]
+    vector<int> boneNodes; // index of each bone's node in the loader, -1 if not found
+    vector<aiMatrix4x4> boneMatrices; // updated every frame
+    vector<unsigned int> weightsStart;
+    vector<ofxAssimpBoneWeight> weights;
+
     ofMesh cachedMesh;
     bool validCache;
     
@@ -1,5 +1,6 @@
 #include "ofxAssimpModelLoader.h"
 #include "ofxAssimpUtils.h"
+#include "ofxAssimpSceneCache.h"
 
 #include "assimp.h"
 #include "aiScene.h"
@@ -7,6 +8,8 @@
 #include "aiPostProcess.h"
 
 ofxAssimpModelLoader::ofxAssimpModelLoader(){
+	bParallelSkinning = true;
+	bUsingCache = false;
 	clear();
 }
 
@@ -33,8 +36,19 @@ bool ofxAssimpModelLoader::loadModel(string modelName, bool optimize){
     // sets various properties & flags to a default preference
     unsigned int flags = initImportProperties(optimize);
     
+    if(bUsingCache){
+        scene = ofxAssimpLoadSceneCache(getCachePath(), file.getAbsolutePath(), flags);
+        bLoadedFromCache = scene != NULL;
+    }
+
     // loads scene from file
-    scene = shared_ptr<const aiScene>(aiImportFile(file.getAbsolutePath().c_str(), flags),aiReleaseImport);
+    if(!scene){
+        scene = shared_ptr<const aiScene>(aiImportFile(file.getAbsolutePath().c_str(), flags),aiReleaseImport);
+        if(scene && bUsingCache){
+            ofFilePath::createEnclosingDirectory(getCachePath(), false);
+            ofxAssimpSaveSceneCache(*scene, getCachePath(), file.getAbsolutePath(), flags);
+        }
+    }
     
     bool bOk = processScene();
     return bOk;
@@ -81,6 +95,7 @@ bool ofxAssimpModelLoader::processScene() {
     if(scene){
         calculateDimensions();
         loadGLResources();
+        loadSkinningData();
         update();
         
         if(getAnimationCount())
@@ -119,7 +134,41 @@ void ofxAssimpModelLoader::createEmptyModel(){
 	}
 }
 
+//-------------------------------------------
+void ofxAssimpModelLoader::enableCache(){
+	bUsingCache = true;
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::disableCache(){
+	bUsingCache = false;
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::setCacheFolder(const string & folder){
+	cacheFolder = folder;
+}
+
+//-------------------------------------------
+string ofxAssimpModelLoader::getCachePath(){
+	if(cacheFolder.empty()){
+		return file.getAbsolutePath() + ".ofxassimp";
+	}
+	// models with the same name in different folders get different files
+	string path = file.getAbsolutePath();
+	unsigned int hash = 2166136261u;
+	for(size_t i=0; i<path.size(); i++){
+		hash = (hash ^ (unsigned char)path[i]) * 16777619u;
+	}
+	return ofFilePath::join(ofToDataPath(cacheFolder, true), file.getFileName() + "." + ofToHex(hash) + ".ofxassimp");
+}
+
+//-------------------------------------------
+bool ofxAssimpModelLoader::isLoadedFromCache(){
+	return bLoadedFromCache;
+}
 
+//-------------------------------------------
 void ofxAssimpModelLoader::setNormalizationFactor(float factor){
 	normalizeFactor = factor;
 }
@@ -166,6 +215,11 @@ void ofxAssimpModelLoader::createLightsFromAiModel(){
 }
 
 void ofxAssimpModelLoader::optimizeScene(){
+	// post processing only works on scenes created by the importer
+	if(bLoadedFromCache){
+		ofLogWarning("ofxAssimpModelLoader") << "optimizeScene(): can't optimize a scene loaded from the cache, load it with optimize = true instead";
+		return;
+	}
 	aiApplyPostProcessing(scene.get(),aiProcess_ImproveCacheLocality | aiProcess_OptimizeGraph |
 			aiProcess_OptimizeMeshes | aiProcess_JoinIdenticalVertices |
 			aiProcess_RemoveRedundantMaterials);
@@ -176,6 +230,13 @@ void ofxAssimpModelLoader::loadGLResources(){
 
 	ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): starting";
 
+    // without a GL renderer, eg. in an ofAppNoWindow, the model can still
+    // be animated and its meshes read with getCurrentAnimatedMesh()
+    bUsingGLResources = ofGetGLRenderer().get() != NULL;
+    if(!bUsingGLResources){
+        ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): no GL renderer, skipping textures and vbos";
+    }
+
     // create new mesh helpers for each mesh, will populate their data later.
     modelMeshes.resize(scene->mNumMeshes,ofxAssimpMeshHelper());
 
@@ -238,7 +299,7 @@ void ofxAssimpModelLoader::loadGLResources(){
         aiString texPath;
 
         // TODO: handle other aiTextureTypes
-        if(AI_SUCCESS == mtl->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)){
+        if(bUsingGLResources && AI_SUCCESS == mtl->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)){
             ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): loading image from \"" << texPath.data << "\"";
             string modelFolder = file.getEnclosingDirectory();
             string relTexPath = ofFilePath::getEnclosingDirectory(texPath.data,false);
@@ -290,6 +351,17 @@ void ofxAssimpModelLoader::loadGLResources(){
         	meshHelper.animatedNorm.resize(mesh->mNumVertices);
         }
 
+        meshHelper.indices.resize(mesh->mNumFaces * 3);
+        int j=0;
+        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
+			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
+				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
+			}
+		}
+
+        if(!bUsingGLResources){
+            continue;
+        }
 
         int usage;
         if(getAnimationCount()){
@@ -318,14 +390,6 @@ void ofxAssimpModelLoader::loadGLResources(){
         	meshHelper.vbo.setTexCoordData(meshHelper.cachedMesh.getTexCoordsPointer()[0].getPtr(),mesh->mNumVertices,GL_STATIC_DRAW,sizeof(ofVec2f));
         }
 
-        meshHelper.indices.resize(mesh->mNumFaces * 3);
-        int j=0;
-        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
-			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
-				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
-			}
-		}
-
         meshHelper.vbo.setIndexData(&meshHelper.indices[0],meshHelper.indices.size(),GL_STATIC_DRAW);
 
         //modelMeshes.push_back(meshHelper);
@@ -348,6 +412,10 @@ void ofxAssimpModelLoader::clear(){
     // clear out everything.
     modelMeshes.clear();
     animations.clear();
+    nodes.clear();
+    nodeParents.clear();
+    nodeMatrices.clear();
+    skinningRanges.clear();
     pos.set(0,0,0);
     scale.set(1,1,1);
     rotAngle.clear();
@@ -360,6 +428,8 @@ void ofxAssimpModelLoader::clear(){
     bUsingNormals = true;
     bUsingTextures = true;
     bUsingColors = true;
+    bUsingGLResources = false;
+    bLoadedFromCache = false;
 
     currentAnimation = -1;
 
@@ -408,67 +478,181 @@ void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix)
     }
 }
 
+// skins the vertices begin to end of a mesh. the bone matrices are blended
+// per vertex and applied once, the same result as adding the weighted
+// vertex transformed by each bone but with one write per vertex
+static void skinVertices(ofxAssimpMeshHelper & meshHelper, unsigned int begin, unsigned int end) {
+	const aiMesh * mesh = meshHelper.mesh;
+	const aiVector3D * srcPos = mesh->mVertices;
+	const aiVector3D * srcNorm = mesh->HasNormals() ? mesh->mNormals : NULL;
+	aiVector3D * dstPos = &meshHelper.animatedPos[0];
+	aiVector3D * dstNorm = srcNorm ? &meshHelper.animatedNorm[0] : NULL;
+	const unsigned int * weightsStart = &meshHelper.weightsStart[0];
+	const ofxAssimpBoneWeight * weights = meshHelper.weights.empty() ? NULL : &meshHelper.weights[0];
+	const aiMatrix4x4 * boneMatrices = &meshHelper.boneMatrices[0];
+
+	for(unsigned int v=begin; v<end; ++v) {
+		unsigned int w = weightsStart[v];
+		unsigned int wEnd = weightsStart[v+1];
+		if(w == wEnd) {
+			// not influenced by any bone
+			dstPos[v] = srcPos[v];
+			if(srcNorm) {
+				dstNorm[v] = srcNorm[v];
+			}
+			continue;
+		}
+
+		// only the 3 first rows are needed, the last one is always 0,0,0,1
+		float m[12] = {0,0,0,0, 0,0,0,0, 0,0,0,0};
+		for(; w<wEnd; ++w) {
+			const float * bone = boneMatrices[weights[w].bone][0];
+			float weight = weights[w].weight;
+			for(int k=0; k<12; ++k) {
+				m[k] += weight * bone[k];
+			}
+		}
+
+		const aiVector3D & p = srcPos[v];
+		dstPos[v].x = m[0] * p.x + m[1] * p.y + m[2]  * p.z + m[3];
+		dstPos[v].y = m[4] * p.x + m[5] * p.y + m[6]  * p.z + m[7];
+		dstPos[v].z = m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11];
+		if(srcNorm) {
+			// rotation and scale only, like aiMatrix3x3(boneMatrix)
+			const aiVector3D & n = srcNorm[v];
+			dstNorm[v].x = m[0] * n.x + m[1] * n.y + m[2]  * n.z;
+			dstNorm[v].y = m[4] * n.x + m[5] * n.y + m[6]  * n.z;
+			dstNorm[v].z = m[8] * n.x + m[9] * n.y + m[10] * n.z;
+		}
+	}
+}
+
 void ofxAssimpModelLoader::updateBones() {
-    // update mesh position for the animation
+	updateNodeMatrices();
+
+	// bone matrix = global transformation of its node * mesh to bone matrix
 	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
-		// current mesh we are introspecting
-		const aiMesh* mesh = modelMeshes[i].mesh;
-        
-		// calculate bone matrices
-		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
+		ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+		const aiMesh* mesh = meshHelper.mesh;
+		if(mesh->mNumBones == 0) {
+			continue;
+		}
 		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-            
-			// find the corresponding node by again looking recursively through the node hierarchy for the same name
-			aiNode* node = scene->mRootNode->FindNode(bone->mName);
-            
-			// start with the mesh-to-bone matrix
-			boneMatrices[a] = bone->mOffsetMatrix;
-			// and now append all node transformations down the parent chain until we're back at mesh coordinates again
-			const aiNode* tempNode = node;
-			while(tempNode) {
-				// check your matrix multiplication order here!!!
-				boneMatrices[a] = tempNode->mTransformation * boneMatrices[a];
-				// boneMatrices[a] = boneMatrices[a] * tempNode->mTransformation;
-				tempNode = tempNode->mParent;
+			int node = meshHelper.boneNodes[a];
+			if(node >= 0) {
+				meshHelper.boneMatrices[a] = nodeMatrices[node] * mesh->mBones[a]->mOffsetMatrix;
+			} else {
+				meshHelper.boneMatrices[a] = mesh->mBones[a]->mOffsetMatrix;
 			}
-			modelMeshes[i].hasChanged = true;
-			modelMeshes[i].validCache = false;
 		}
-        
-		modelMeshes[i].animatedPos.assign(modelMeshes[i].animatedPos.size(),0);
-		if(mesh->HasNormals()){
-			modelMeshes[i].animatedNorm.assign(modelMeshes[i].animatedNorm.size(),0);
+		meshHelper.hasChanged = true;
+		meshHelper.validCache = false;
+	}
+
+	// each range writes different vertices so they can run in parallel
+#ifdef OF_USING_THREAD_POOL
+	if(bParallelSkinning && skinningRanges.size() > 1) {
+		ofParallelFor(0, skinningRanges.size(), [&](size_t i){
+			const SkinningRange & range = skinningRanges[i];
+			skinVertices(modelMeshes[range.mesh], range.begin, range.end);
+		}, 1);
+	} else
+#endif
+	{
+		for(unsigned int i=0; i<skinningRanges.size(); ++i) {
+			const SkinningRange & range = skinningRanges[i];
+			skinVertices(modelMeshes[range.mesh], range.begin, range.end);
+		}
+	}
+}
+
+void ofxAssimpModelLoader::updateNodeMatrices() {
+	// parents are always before their children
+	for(unsigned int i=0; i<nodes.size(); ++i) {
+		if(nodeParents[i] >= 0) {
+			nodeMatrices[i] = nodeMatrices[nodeParents[i]] * nodes[i]->mTransformation;
+		} else {
+			nodeMatrices[i] = nodes[i]->mTransformation;
+		}
+	}
+}
+
+void ofxAssimpModelLoader::addNodes(aiNode * node, int parent) {
+	int index = nodes.size();
+	nodes.push_back(node);
+	nodeParents.push_back(parent);
+	for(unsigned int i=0; i<node->mNumChildren; ++i) {
+		addNodes(node->mChildren[i], index);
+	}
+}
+
+void ofxAssimpModelLoader::loadSkinningData() {
+	nodes.clear();
+	nodeParents.clear();
+	skinningRanges.clear();
+	addNodes(scene->mRootNode, -1);
+	nodeMatrices.resize(nodes.size());
+
+	// vertices skinned as a single task, smaller meshes are one range
+	const unsigned int verticesPerRange = 2048;
+
+	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
+		ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+		const aiMesh * mesh = meshHelper.mesh;
+		meshHelper.boneNodes.assign(mesh->mNumBones, -1);
+		meshHelper.boneMatrices.resize(mesh->mNumBones);
+		meshHelper.weightsStart.assign(mesh->mNumVertices + 1, 0);
+		meshHelper.weights.clear();
+		if(mesh->mNumBones == 0) {
+			continue;
 		}
-		// loop through all vertex weights of all bones
+
 		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-			const aiMatrix4x4& posTrafo = boneMatrices[a];
-            
+			const aiNode * node = scene->mRootNode->FindNode(mesh->mBones[a]->mName);
+			vector<aiNode*>::iterator it = find(nodes.begin(), nodes.end(), node);
+			if(it != nodes.end()) {
+				meshHelper.boneNodes[a] = it - nodes.begin();
+			} else {
+				ofLogWarning("ofxAssimpModelLoader") << "loadSkinningData(): couldn't find node for bone \""
+					<< mesh->mBones[a]->mName.data << "\"";
+			}
+		}
+
+		// count the weights of each vertex and scatter them grouped by vertex
+		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+			const aiBone * bone = mesh->mBones[a];
 			for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-				const aiVertexWeight& weight = bone->mWeights[b];
-                
-				size_t vertexId = weight.mVertexId;
-				const aiVector3D& srcPos = mesh->mVertices[vertexId];
-                
-				modelMeshes[i].animatedPos[vertexId] += weight.mWeight * (posTrafo * srcPos);
+				meshHelper.weightsStart[bone->mWeights[b].mVertexId + 1]++;
 			}
-			if(mesh->HasNormals()){
-				// 3x3 matrix, contains the bone matrix without the translation, only with rotation and possibly scaling
-				aiMatrix3x3 normTrafo = aiMatrix3x3( posTrafo);
-				for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-					const aiVertexWeight& weight = bone->mWeights[b];
-					size_t vertexId = weight.mVertexId;
-                    
-					const aiVector3D& srcNorm = mesh->mNormals[vertexId];
-					modelMeshes[i].animatedNorm[vertexId] += weight.mWeight * (normTrafo * srcNorm);
-				}
+		}
+		for(unsigned int v=0; v<mesh->mNumVertices; ++v) {
+			meshHelper.weightsStart[v + 1] += meshHelper.weightsStart[v];
+		}
+		meshHelper.weights.resize(meshHelper.weightsStart[mesh->mNumVertices]);
+		vector<unsigned int> next(meshHelper.weightsStart.begin(), meshHelper.weightsStart.end() - 1);
+		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+			const aiBone * bone = mesh->mBones[a];
+			for(unsigned int b=0; b<bone->mNumWeights; ++b) {
+				ofxAssimpBoneWeight & weight = meshHelper.weights[next[bone->mWeights[b].mVertexId]++];
+				weight.bone = a;
+				weight.weight = bone->mWeights[b].mWeight;
 			}
 		}
+
+		for(unsigned int begin=0; begin<mesh->mNumVertices; begin+=verticesPerRange) {
+			SkinningRange range;
+			range.mesh = i;
+			range.begin = begin;
+			range.end = MIN(begin + verticesPerRange, mesh->mNumVertices);
+			skinningRanges.push_back(range);
+		}
 	}
 }
 
 void ofxAssimpModelLoader::updateGLResources(){
+    if(!bUsingGLResources){
+        return;
+    }
     // now upload the result position and normal along with the other vertex attributes into a dynamic vertex buffer, VBO or whatever
     for (unsigned int i = 0; i < modelMeshes.size(); ++i){
     	if(modelMeshes[i].hasChanged){
@@ -545,6 +729,14 @@ void ofxAssimpModelLoader::setPositionForAllAnimations(float position) {
     }
 }
 
+void ofxAssimpModelLoader::setParallelSkinning(bool parallel) {
+    bParallelSkinning = parallel;
+}
+
+bool ofxAssimpModelLoader::getParallelSkinning() {
+    return bParallelSkinning;
+}
+
 // DEPRECATED.
 void ofxAssimpModelLoader::setAnimation(int animationIndex) {
     if(!hasAnimations()) {
@@ -705,7 +897,7 @@ void ofxAssimpModelLoader::drawVertices(){
 
 //-------------------------------------------
 void ofxAssimpModelLoader::draw(ofPolyRenderMode renderType) {
-    if(scene == NULL) {
+    if(scene == NULL || !bUsingGLResources) {
         return;
     }
     
@@ -34,6 +34,16 @@ class ofxAssimpModelLoader{
         void createLightsFromAiModel();
         void optimizeScene();
 
+        // keeps a binary copy of each imported scene so loading the same
+        // model again doesn't run the importer. the copy is imported again
+        // when the model file or the import flags change
+        void enableCache();
+        void disableCache();
+        // by default the cache is saved next to the model
+        void setCacheFolder(const string & folder);
+        string getCachePath();
+        bool isLoadedFromCache();
+
         void update();
     
         bool hasAnimations();
@@ -45,6 +55,11 @@ class ofxAssimpModelLoader{
         void setPausedForAllAnimations(bool pause);
         void setLoopStateForAllAnimations(ofLoopType state);
         void setPositionForAllAnimations(float position);
+
+        // skins big meshes, or several meshes, in the thread pool. enabled
+        // by default, only has effect when compiling with c++11
+        void setParallelSkinning(bool parallel);
+        bool getParallelSkinning();
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setAnimation(int animationIndex));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setNormalizedTime(float time));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setTime(float time));
@@ -118,7 +133,13 @@ class ofxAssimpModelLoader{
         void updateAnimations();
         void updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix);
         void updateBones();
+        void updateNodeMatrices();
         void updateModelMatrix();
+
+        // finds the bone nodes and packs the vertex weights once, so
+        // updateBones() doesn't search the node hierarchy every frame
+        void loadSkinningData();
+        void addNodes(aiNode * node, int parent);
     
         // ai scene setup
         unsigned int initImportProperties(bool optimize);
@@ -153,12 +174,32 @@ class ofxAssimpModelLoader{
         vector<ofxAssimpTexture> textures;
         vector<ofxAssimpMeshHelper> modelMeshes;
         vector<ofxAssimpAnimation> animations;
+
+        // every node in the scene with its parent before it, their
+        // global transformations are calculated once per frame
+        vector<aiNode*> nodes;
+        vector<int> nodeParents;
+        vector<aiMatrix4x4> nodeMatrices;
+
+        // vertices of a mesh skinned as one task
+        struct SkinningRange {
+            unsigned int mesh;
+            unsigned int begin;
+            unsigned int end;
+        };
+        vector<SkinningRange> skinningRanges;
+        bool bParallelSkinning;
+
         int currentAnimation; // DEPRECATED - to be removed with deprecated animation functions.
 
         bool bUsingTextures;
         bool bUsingNormals;
         bool bUsingColors;
         bool bUsingMaterials;
+        bool bUsingGLResources; // false when loaded without a GL renderer, eg. in an ofAppNoWindow
+        bool bUsingCache;
+        bool bLoadedFromCache;
+        string cacheFolder;
         float normalizeFactor;
 
         // the main Asset Import scene that does the magic.
@@ -0,0 +1,593 @@
+//
+//  ofxAssimpSceneCache.cpp
+//
+
+#include "ofxAssimpSceneCache.h"
+
+#include "aiScene.h"
+#include "aiVersion.h"
+
+#include "Poco/File.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/Exception.h"
+
+// increase when the layout of the file changes
+static const unsigned int cacheVersion = 1;
+static const char cacheMagic[8] = {'o','f','x','A','i','B','i','n'};
+
+//-------------------------------------------
+class ofxAssimpCacheWriter {
+public:
+	ofxAssimpCacheWriter(ostream & out)
+	:out(out){}
+
+	void write(const void * data, size_t bytes){
+		out.write((const char*)data, bytes);
+	}
+
+	template<typename T>
+	void write(const T & value){
+		write(&value, sizeof(T));
+	}
+
+	template<typename T>
+	void writeArray(const T * values, unsigned int count){
+		if(values != NULL && count > 0){
+			write(values, sizeof(T) * count);
+		}
+	}
+
+	void writeString(const aiString & str){
+		unsigned int length = str.length;
+		write(length);
+		write(str.data, length);
+	}
+
+	void writeString(const string & str){
+		unsigned int length = str.size();
+		write(length);
+		write(str.c_str(), length);
+	}
+
+	bool good() const{
+		return out.good();
+	}
+
+private:
+	ostream & out;
+};
+
+//-------------------------------------------
+// every read is bounds checked, after the first one that fails the
+// rest read zeros and good() returns false
+class ofxAssimpCacheReader {
+public:
+	ofxAssimpCacheReader(const char * data, size_t size)
+	:data(data)
+	,size(size)
+	,pos(0)
+	,ok(true){}
+
+	bool read(void * dst, size_t bytes){
+		if(!ok || bytes > size - pos){
+			ok = false;
+			memset(dst, 0, bytes);
+			return false;
+		}
+		memcpy(dst, data + pos, bytes);
+		pos += bytes;
+		return true;
+	}
+
+	template<typename T>
+	T read(){
+		T value;
+		read(&value, sizeof(T));
+		return value;
+	}
+
+	// allocates the array with new[] as assimp expects to delete it
+	template<typename T>
+	T * readArray(unsigned int count){
+		if(count == 0){
+			return NULL;
+		}
+		if(!ok || count > (size - pos) / sizeof(T)){
+			ok = false;
+			return NULL;
+		}
+		T * values = new T[count];
+		read(values, sizeof(T) * count);
+		return values;
+	}
+
+	// checks there are at least count bytes left before allocating
+	// count objects, so a corrupted count can't allocate huge arrays
+	bool canRead(unsigned int count){
+		if(!ok || count > size - pos){
+			ok = false;
+		}
+		return ok;
+	}
+
+	void readString(aiString & str){
+		unsigned int length = read<unsigned int>();
+		if(length >= MAXLEN){
+			ok = false;
+			length = 0;
+		}
+		read(str.data, length);
+		str.data[length] = '\0';
+		str.length = length;
+	}
+
+	string readString(){
+		unsigned int length = read<unsigned int>();
+		if(!ok || length > size - pos){
+			ok = false;
+			return "";
+		}
+		string str(data + pos, length);
+		pos += length;
+		return str;
+	}
+
+	bool good() const{
+		return ok;
+	}
+
+private:
+	const char * data;
+	size_t size;
+	size_t pos;
+	bool ok;
+};
+
+//-------------------------------------------
+// what makes a cache valid for a model: the file can only be loaded
+// by the same version of the addon and assimp, with the same layout
+// of the structures copied as they are, for the same model and flags
+struct ofxAssimpCacheKey {
+	unsigned int version;
+	unsigned int assimpVersion[3];
+	unsigned int structSizes[6];
+	unsigned int importFlags;
+	long long modified;
+	unsigned long long size;
+	string path;
+
+	ofxAssimpCacheKey(const string & modelPath, unsigned int flags){
+		version = cacheVersion;
+		assimpVersion[0] = aiGetVersionMajor();
+		assimpVersion[1] = aiGetVersionMinor();
+		assimpVersion[2] = aiGetVersionRevision();
+		structSizes[0] = sizeof(aiString);
+		structSizes[1] = sizeof(aiVectorKey);
+		structSizes[2] = sizeof(aiQuatKey);
+		structSizes[3] = sizeof(aiLight);
+		structSizes[4] = sizeof(aiCamera);
+		structSizes[5] = sizeof(aiMatrix4x4);
+		importFlags = flags;
+		Poco::File file(modelPath);
+		modified = file.getLastModified().epochMicroseconds();
+		size = file.getSize();
+		path = modelPath;
+	}
+
+	void write(ofxAssimpCacheWriter & writer) const{
+		writer.write(cacheMagic, sizeof(cacheMagic));
+		writer.write(version);
+		writer.write(assimpVersion);
+		writer.write(structSizes);
+		writer.write(importFlags);
+		writer.write(modified);
+		writer.write(size);
+		writer.writeString(path);
+	}
+
+	bool matches(ofxAssimpCacheReader & reader) const{
+		char magic[sizeof(cacheMagic)];
+		reader.read(magic, sizeof(magic));
+		if(memcmp(magic, cacheMagic, sizeof(magic)) != 0 || reader.read<unsigned int>() != version){
+			return false;
+		}
+		unsigned int fileAssimpVersion[3];
+		unsigned int fileStructSizes[6];
+		reader.read(fileAssimpVersion, sizeof(fileAssimpVersion));
+		reader.read(fileStructSizes, sizeof(fileStructSizes));
+		return reader.good()
+			&& memcmp(fileAssimpVersion, assimpVersion, sizeof(assimpVersion)) == 0
+			&& memcmp(fileStructSizes, structSizes, sizeof(structSizes)) == 0
+			&& reader.read<unsigned int>() == importFlags
+			&& reader.read<long long>() == modified
+			&& reader.read<unsigned long long>() == size
+			&& reader.readString() == path;
+	}
+};
+
+//------------------------------------------- writing
+static void writeMesh(ofxAssimpCacheWriter & writer, const aiMesh & mesh){
+	writer.writeString(mesh.mName);
+	writer.write(mesh.mPrimitiveTypes);
+	writer.write(mesh.mMaterialIndex);
+	writer.write(mesh.mNumVertices);
+
+	// which of the optional arrays follow
+	unsigned int channels = 0;
+	if(mesh.HasNormals()) channels |= 1 << 0;
+	if(mesh.HasTangentsAndBitangents()) channels |= 1 << 1;
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(mesh.HasVertexColors(i)) channels |= 1 << (2 + i);
+	}
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(mesh.HasTextureCoords(i)) channels |= 1 << (2 + AI_MAX_NUMBER_OF_COLOR_SETS + i);
+	}
+	writer.write(channels);
+
+	writer.writeArray(mesh.mVertices, mesh.mNumVertices);
+	if(mesh.HasNormals()){
+		writer.writeArray(mesh.mNormals, mesh.mNumVertices);
+	}
+	if(mesh.HasTangentsAndBitangents()){
+		writer.writeArray(mesh.mTangents, mesh.mNumVertices);
+		writer.writeArray(mesh.mBitangents, mesh.mNumVertices);
+	}
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(mesh.HasVertexColors(i)){
+			writer.writeArray(mesh.mColors[i], mesh.mNumVertices);
+		}
+	}
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(mesh.HasTextureCoords(i)){
+			writer.write(mesh.mNumUVComponents[i]);
+			writer.writeArray(mesh.mTextureCoords[i], mesh.mNumVertices);
+		}
+	}
+
+	writer.write(mesh.mNumFaces);
+	for(unsigned int i=0; i<mesh.mNumFaces; i++){
+		writer.write(mesh.mFaces[i].mNumIndices);
+		writer.writeArray(mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices);
+	}
+
+	writer.write(mesh.mNumBones);
+	for(unsigned int i=0; i<mesh.mNumBones; i++){
+		const aiBone & bone = *mesh.mBones[i];
+		writer.writeString(bone.mName);
+		writer.write(bone.mOffsetMatrix);
+		writer.write(bone.mNumWeights);
+		writer.writeArray(bone.mWeights, bone.mNumWeights);
+	}
+}
+
+static void writeMaterial(ofxAssimpCacheWriter & writer, const aiMaterial & material){
+	writer.write(material.mNumProperties);
+	for(unsigned int i=0; i<material.mNumProperties; i++){
+		const aiMaterialProperty & property = *material.mProperties[i];
+		writer.writeString(property.mKey);
+		writer.write(property.mSemantic);
+		writer.write(property.mIndex);
+		writer.write((unsigned int)property.mType);
+		writer.write(property.mDataLength);
+		writer.writeArray(property.mData, property.mDataLength);
+	}
+}
+
+static void writeNode(ofxAssimpCacheWriter & writer, const aiNode & node){
+	writer.writeString(node.mName);
+	writer.write(node.mTransformation);
+	writer.write(node.mNumMeshes);
+	writer.writeArray(node.mMeshes, node.mNumMeshes);
+	writer.write(node.mNumChildren);
+	for(unsigned int i=0; i<node.mNumChildren; i++){
+		writeNode(writer, *node.mChildren[i]);
+	}
+}
+
+static void writeAnimation(ofxAssimpCacheWriter & writer, const aiAnimation & animation){
+	writer.writeString(animation.mName);
+	writer.write(animation.mDuration);
+	writer.write(animation.mTicksPerSecond);
+	writer.write(animation.mNumChannels);
+	for(unsigned int i=0; i<animation.mNumChannels; i++){
+		const aiNodeAnim & channel = *animation.mChannels[i];
+		writer.writeString(channel.mNodeName);
+		writer.write((unsigned int)channel.mPreState);
+		writer.write((unsigned int)channel.mPostState);
+		writer.write(channel.mNumPositionKeys);
+		writer.writeArray(channel.mPositionKeys, channel.mNumPositionKeys);
+		writer.write(channel.mNumRotationKeys);
+		writer.writeArray(channel.mRotationKeys, channel.mNumRotationKeys);
+		writer.write(channel.mNumScalingKeys);
+		writer.writeArray(channel.mScalingKeys, channel.mNumScalingKeys);
+	}
+}
+
+static void writeTexture(ofxAssimpCacheWriter & writer, const aiTexture & texture){
+	writer.write(texture.mWidth);
+	writer.write(texture.mHeight);
+	writer.write(texture.achFormatHint);
+	// compressed textures have mHeight 0 and mWidth bytes of data
+	if(texture.mHeight == 0){
+		writer.writeArray((const char*)texture.pcData, texture.mWidth);
+	}else{
+		writer.writeArray(texture.pcData, texture.mWidth * texture.mHeight);
+	}
+}
+
+//------------------------------------------- reading
+// counts are only set once the arrays they describe are allocated so
+// deleting the scene after a failed read never touches invalid memory
+
+static void readMesh(ofxAssimpCacheReader & reader, aiMesh & mesh){
+	reader.readString(mesh.mName);
+	mesh.mPrimitiveTypes = reader.read<unsigned int>();
+	mesh.mMaterialIndex = reader.read<unsigned int>();
+	unsigned int numVertices = reader.read<unsigned int>();
+	unsigned int channels = reader.read<unsigned int>();
+
+	mesh.mVertices = reader.readArray<aiVector3D>(numVertices);
+	if(channels & (1 << 0)){
+		mesh.mNormals = reader.readArray<aiVector3D>(numVertices);
+	}
+	if(channels & (1 << 1)){
+		mesh.mTangents = reader.readArray<aiVector3D>(numVertices);
+		mesh.mBitangents = reader.readArray<aiVector3D>(numVertices);
+	}
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(channels & (1 << (2 + i))){
+			mesh.mColors[i] = reader.readArray<aiColor4D>(numVertices);
+		}
+	}
+	for(unsigned int i=0; i<AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(channels & (1 << (2 + AI_MAX_NUMBER_OF_COLOR_SETS + i))){
+			mesh.mNumUVComponents[i] = reader.read<unsigned int>();
+			mesh.mTextureCoords[i] = reader.readArray<aiVector3D>(numVertices);
+		}
+	}
+	mesh.mNumVertices = numVertices;
+
+	unsigned int numFaces = reader.read<unsigned int>();
+	if(numFaces > 0 && reader.canRead(numFaces)){
+		mesh.mFaces = new aiFace[numFaces];
+		mesh.mNumFaces = numFaces;
+		for(unsigned int i=0; i<numFaces && reader.good(); i++){
+			unsigned int numIndices = reader.read<unsigned int>();
+			mesh.mFaces[i].mIndices = reader.readArray<unsigned int>(numIndices);
+			mesh.mFaces[i].mNumIndices = mesh.mFaces[i].mIndices ? numIndices : 0;
+		}
+	}
+
+	unsigned int numBones = reader.read<unsigned int>();
+	if(numBones > 0 && reader.canRead(numBones)){
+		mesh.mBones = new aiBone*[numBones]();
+		mesh.mNumBones = numBones;
+		for(unsigned int i=0; i<numBones && reader.good(); i++){
+			aiBone * bone = new aiBone;
+			mesh.mBones[i] = bone;
+			reader.readString(bone->mName);
+			bone->mOffsetMatrix = reader.read<aiMatrix4x4>();
+			unsigned int numWeights = reader.read<unsigned int>();
+			bone->mWeights = reader.readArray<aiVertexWeight>(numWeights);
+			bone->mNumWeights = bone->mWeights ? numWeights : 0;
+		}
+	}
+}
+
+static void readMaterial(ofxAssimpCacheReader & reader, aiMaterial & material){
+	unsigned int numProperties = reader.read<unsigned int>();
+	if(numProperties == 0 || !reader.canRead(numProperties)){
+		return;
+	}
+	material.mProperties = new aiMaterialProperty*[numProperties]();
+	material.mNumAllocated = numProperties;
+	material.mNumProperties = numProperties;
+	for(unsigned int i=0; i<numProperties && reader.good(); i++){
+		aiMaterialProperty * property = new aiMaterialProperty;
+		material.mProperties[i] = property;
+		reader.readString(property->mKey);
+		property->mSemantic = reader.read<unsigned int>();
+		property->mIndex = reader.read<unsigned int>();
+		property->mType = (aiPropertyTypeInfo)reader.read<unsigned int>();
+		unsigned int dataLength = reader.read<unsigned int>();
+		property->mData = reader.readArray<char>(dataLength);
+		property->mDataLength = property->mData ? dataLength : 0;
+	}
+}
+
+static aiNode * readNode(ofxAssimpCacheReader & reader, aiNode * parent){
+	aiNode * node = new aiNode;
+	node->mParent = parent;
+	reader.readString(node->mName);
+	node->mTransformation = reader.read<aiMatrix4x4>();
+	unsigned int numMeshes = reader.read<unsigned int>();
+	node->mMeshes = reader.readArray<unsigned int>(numMeshes);
+	node->mNumMeshes = node->mMeshes ? numMeshes : 0;
+	unsigned int numChildren = reader.read<unsigned int>();
+	if(numChildren > 0 && reader.canRead(numChildren)){
+		node->mChildren = new aiNode*[numChildren]();
+		node->mNumChildren = numChildren;
+		for(unsigned int i=0; i<numChildren && reader.good(); i++){
+			node->mChildren[i] = readNode(reader, node);
+		}
+	}
+	return node;
+}
+
+static void readAnimation(ofxAssimpCacheReader & reader, aiAnimation & animation){
+	reader.readString(animation.mName);
+	animation.mDuration = reader.read<double>();
+	animation.mTicksPerSecond = reader.read<double>();
+	unsigned int numChannels = reader.read<unsigned int>();
+	if(numChannels == 0 || !reader.canRead(numChannels)){
+		return;
+	}
+	animation.mChannels = new aiNodeAnim*[numChannels]();
+	animation.mNumChannels = numChannels;
+	for(unsigned int i=0; i<numChannels && reader.good(); i++){
+		aiNodeAnim * channel = new aiNodeAnim;
+		animation.mChannels[i] = channel;
+		reader.readString(channel->mNodeName);
+		channel->mPreState = (aiAnimBehaviour)reader.read<unsigned int>();
+		channel->mPostState = (aiAnimBehaviour)reader.read<unsigned int>();
+		unsigned int numKeys = reader.read<unsigned int>();
+		channel->mPositionKeys = reader.readArray<aiVectorKey>(numKeys);
+		channel->mNumPositionKeys = channel->mPositionKeys ? numKeys : 0;
+		numKeys = reader.read<unsigned int>();
+		channel->mRotationKeys = reader.readArray<aiQuatKey>(numKeys);
+		channel->mNumRotationKeys = channel->mRotationKeys ? numKeys : 0;
+		numKeys = reader.read<unsigned int>();
+		channel->mScalingKeys = reader.readArray<aiVectorKey>(numKeys);
+		channel->mNumScalingKeys = channel->mScalingKeys ? numKeys : 0;
+	}
+}
+
+static void readTexture(ofxAssimpCacheReader & reader, aiTexture & texture){
+	unsigned int width = reader.read<unsigned int>();
+	unsigned int height = reader.read<unsigned int>();
+	reader.read(texture.achFormatHint, sizeof(texture.achFormatHint));
+	if(height == 0){
+		// allocated as texels since aiTexture deletes it as such
+		unsigned int numTexels = (width + sizeof(aiTexel) - 1) / sizeof(aiTexel);
+		if(numTexels > 0 && reader.canRead(width)){
+			texture.pcData = new aiTexel[numTexels];
+			reader.read(texture.pcData, width);
+		}
+	}else{
+		texture.pcData = reader.readArray<aiTexel>(width * height);
+	}
+	if(texture.pcData != NULL){
+		texture.mWidth = width;
+		texture.mHeight = height;
+	}
+}
+
+// allocates an array of pointers to T and reads each of them
+template<typename T>
+static T ** readObjects(ofxAssimpCacheReader & reader, unsigned int & count, void (*readObject)(ofxAssimpCacheReader &, T &)){
+	unsigned int numObjects = reader.read<unsigned int>();
+	if(numObjects == 0 || !reader.canRead(numObjects)){
+		return NULL;
+	}
+	T ** objects = new T*[numObjects]();
+	count = numObjects;
+	for(unsigned int i=0; i<numObjects && reader.good(); i++){
+		objects[i] = new T;
+		readObject(reader, *objects[i]);
+	}
+	return objects;
+}
+
+static void readMaterialObject(ofxAssimpCacheReader & reader, aiMaterial & material){
+	// aiMaterial doesn't initialize its members
+	material.mProperties = NULL;
+	material.mNumProperties = 0;
+	material.mNumAllocated = 0;
+	readMaterial(reader, material);
+}
+
+template<typename T>
+static void readPlain(ofxAssimpCacheReader & reader, T & object){
+	reader.read(&object, sizeof(T));
+}
+
+//-------------------------------------------
+shared_ptr<const aiScene> ofxAssimpLoadSceneCache(const string & cachePath, const string & modelPath, unsigned int importFlags){
+	try{
+		Poco::File cacheFile(cachePath);
+		if(!cacheFile.exists() || cacheFile.getSize() == 0){
+			return shared_ptr<const aiScene>();
+		}
+
+		ofxAssimpCacheKey key(modelPath, importFlags);
+		Poco::SharedMemory mapped(cacheFile, Poco::SharedMemory::AM_READ);
+		ofxAssimpCacheReader reader(mapped.begin(), mapped.end() - mapped.begin());
+		if(!key.matches(reader)){
+			ofLogVerbose("ofxAssimpSceneCache") << "ofxAssimpLoadSceneCache(): cache for \"" << modelPath << "\" is out of date";
+			return shared_ptr<const aiScene>();
+		}
+
+		shared_ptr<aiScene> scene(new aiScene);
+		scene->mFlags = reader.read<unsigned int>();
+		scene->mMeshes = readObjects(reader, scene->mNumMeshes, readMesh);
+		scene->mMaterials = readObjects(reader, scene->mNumMaterials, readMaterialObject);
+		scene->mAnimations = readObjects(reader, scene->mNumAnimations, readAnimation);
+		scene->mTextures = readObjects(reader, scene->mNumTextures, readTexture);
+		scene->mLights = readObjects(reader, scene->mNumLights, readPlain<aiLight>);
+		scene->mCameras = readObjects(reader, scene->mNumCameras, readPlain<aiCamera>);
+		if(reader.read<unsigned int>() != 0 && reader.good()){
+			scene->mRootNode = readNode(reader, NULL);
+		}
+
+		if(!reader.good() || scene->mRootNode == NULL){
+			ofLogError("ofxAssimpSceneCache") << "ofxAssimpLoadSceneCache(): cache file \"" << cachePath << "\" is corrupted";
+			return shared_ptr<const aiScene>();
+		}
+		return scene;
+	}catch(const Poco::Exception & e){
+		ofLogError("ofxAssimpSceneCache") << "ofxAssimpLoadSceneCache(): couldn't read \"" << cachePath << "\": " << e.displayText();
+		return shared_ptr<const aiScene>();
+	}
+}
+
+//-------------------------------------------
+bool ofxAssimpSaveSceneCache(const aiScene & scene, const string & cachePath, const string & modelPath, unsigned int importFlags){
+	// written to a temporary file first so a failed or interrupted
+	// write never leaves a truncated cache behind
+	string tmpPath = cachePath + ".tmp";
+	try{
+		ofxAssimpCacheKey key(modelPath, importFlags);
+		{
+			ofFile file(tmpPath, ofFile::WriteOnly, true);
+			if(!file.is_open()){
+				ofLogError("ofxAssimpSceneCache") << "ofxAssimpSaveSceneCache(): couldn't open \"" << cachePath << "\" for writing";
+				return false;
+			}
+			ofxAssimpCacheWriter writer(file);
+			key.write(writer);
+			writer.write(scene.mFlags);
+
+			writer.write(scene.mNumMeshes);
+			for(unsigned int i=0; i<scene.mNumMeshes; i++){
+				writeMesh(writer, *scene.mMeshes[i]);
+			}
+			writer.write(scene.mNumMaterials);
+			for(unsigned int i=0; i<scene.mNumMaterials; i++){
+				writeMaterial(writer, *scene.mMaterials[i]);
+			}
+			writer.write(scene.mNumAnimations);
+			for(unsigned int i=0; i<scene.mNumAnimations; i++){
+				writeAnimation(writer, *scene.mAnimations[i]);
+			}
+			writer.write(scene.mNumTextures);
+			for(unsigned int i=0; i<scene.mNumTextures; i++){
+				writeTexture(writer, *scene.mTextures[i]);
+			}
+			writer.write(scene.mNumLights);
+			for(unsigned int i=0; i<scene.mNumLights; i++){
+				writer.write(*scene.mLights[i]);
+			}
+			writer.write(scene.mNumCameras);
+			for(unsigned int i=0; i<scene.mNumCameras; i++){
+				writer.write(*scene.mCameras[i]);
+			}
+			unsigned int hasRootNode = scene.mRootNode != NULL;
+			writer.write(hasRootNode);
+			if(hasRootNode){
+				writeNode(writer, *scene.mRootNode);
+			}
+
+			if(!writer.good()){
+				ofLogError("ofxAssimpSceneCache") << "ofxAssimpSaveSceneCache(): couldn't write \"" << cachePath << "\"";
+				file.close();
+				Poco::File(tmpPath).remove();
+				return false;
+			}
+		}
+		Poco::File(tmpPath).renameTo(cachePath);
+		return true;
+	}catch(const Poco::Exception & e){
+		ofLogError("ofxAssimpSceneCache") << "ofxAssimpSaveSceneCache(): couldn't write \"" << cachePath << "\": " << e.displayText();
+		return false;
+	}
+}
@@ -0,0 +1,26 @@
+//
+//  ofxAssimpSceneCache.h
+//
+//  Binary copy of an imported aiScene: meshes, bones, materials, node
+//  hierarchy, animations, lights, cameras and embedded textures. Loading
+//  it doesn't run the importer or its post processing, the arrays are
+//  copied straight out of the memory mapped file.
+//
+//  The file stores the path, modification time and size of the model
+//  and the import flags and assimp version it was imported with, if any
+//  of them changed the cache is considered stale and not loaded. It's
+//  not meant to be portable between platforms, the size of the assimp
+//  structures is checked too.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+struct aiScene;
+
+// returns an empty pointer if the cache doesn't exist, is stale or is corrupted
+shared_ptr<const aiScene> ofxAssimpLoadSceneCache(const string & cachePath, const string & modelPath, unsigned int importFlags);
+
+// modelPath has to be the same absolute path later passed to ofxAssimpLoadSceneCache
+bool ofxAssimpSaveSceneCache(const aiScene & scene, const string & cachePath, const string & modelPath, unsigned int importFlags);
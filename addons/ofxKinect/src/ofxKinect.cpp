@@ -133,6 +133,8 @@ bool ofxKinect::init(bool infrared, bool video, bool texture) {
 	depthPixels.allocate(width, height, 1);
 	distancePixels.allocate(width, height, 1);
 
+	pointCloud.setup(width, height);
+
 	 // set
 	depthPixelsRaw.set(0);
 	depthPixelsRawBack.set(0);
@@ -204,6 +206,8 @@ bool ofxKinect::open(int deviceIndex) {
 		return false;
 	}
 
+	setupPointCloud();
+
 	if(serial == "0000000000000000") {
         bHasMotorControl = false;
         //if we do motor control via the audio device ( ie: 1473 or k4w ) and we have firmware uploaded
@@ -243,6 +247,8 @@ bool ofxKinect::open(string serial) {
 	if(!kinectContext.open(*this, serial)) {
 		return false;
 	}
+
+	setupPointCloud();
 	
 	if(serial == "0000000000000000") {
         bHasMotorControl = false;
@@ -413,6 +419,25 @@ ofVec3f ofxKinect::getWorldCoordinateAt(float cx, float cy, float wz)  const{
 	return ofVec3f(wx, wy, wz);
 }
 
+//------------------------------------
+void ofxKinect::getPointCloud(vector<ofVec3f> & points) const{
+	pointCloud.getPoints(depthPixelsRaw, points);
+}
+
+//------------------------------------
+void ofxKinect::getPointCloud(ofMesh & mesh, bool bColors) const{
+	if(bColors && !videoPixels.isAllocated()) {
+		ofLogWarning("ofxKinect") << "getPointCloud(): no video to color the points with";
+		bColors = false;
+	}
+	pointCloud.getMesh(depthPixelsRaw, mesh, bColors ? &videoPixels : NULL);
+}
+
+//------------------------------------
+ofxKinectPointCloud & ofxKinect::getPointCloudConverter(){
+	return pointCloud;
+}
+
 //------------------------------------
 float ofxKinect::getSensorEmitterDistance()  const{
 	return kinectDevice->registration.zero_plane_info.dcmos_emitter_dist;
@@ -756,14 +781,31 @@ void ofxKinect::updateDepthLookupTable() {
 	}
 }
 
+//---------------------------------------------------------------------------
+void ofxKinect::setupPointCloud() {
+	// the calibration is read from the device when it's opened,
+	// keep the defaults if it couldn't be read
+	ofRectangle roi = pointCloud.getROI();
+	if(getZeroPlanePixelSize() > 0 && getZeroPlaneDistance() > 0) {
+		pointCloud.setup(width, height, getZeroPlanePixelSize(), getZeroPlaneDistance());
+	} else {
+		pointCloud.setup(width, height);
+	}
+	pointCloud.setROI(roi);
+}
+
 //----------------------------------------------------------
 void ofxKinect::updateDepthPixels() {
+	// a single pass over the raw depth writes both images
 	int n = width * height;
+	const unsigned short * raw = depthPixelsRaw.getData();
+	float * distance = distancePixels.getData();
+	unsigned char * depth = depthPixels.getData();
+	const unsigned char * lookup = &depthLookupTable[0];
+	int maxDepth = depthLookupTable.size() - 1;
 	for(int i = 0; i < n; i++) {
-		distancePixels[i] = depthPixelsRaw[i];
-	}
-	for(int i = 0; i < n; i++) {
-		depthPixels[i] = depthLookupTable[depthPixelsRaw[i]];
+		distance[i] = raw[i];
+		depth[i] = lookup[min((int)raw[i], maxDepth)];
 	}
 }
 
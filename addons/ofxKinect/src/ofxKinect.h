@@ -44,6 +44,7 @@
 
 
 #include "ofxBase3DVideo.h"
+#include "ofxKinectPointCloud.h"
 
 class ofxKinectContext;
 
@@ -129,6 +130,23 @@ public:
 	ofVec3f getWorldCoordinateAt(int cx, int cy) const;
 	ofVec3f getWorldCoordinateAt(float cx, float cy, float wz) const;
 
+	/// converts the whole depth frame to world coordinates at once, much
+	/// faster than calling getWorldCoordinateAt() for every pixel
+	///
+	/// pixels without depth are skipped, use getPointCloudConverter() to
+	/// convert only a region, every few pixels or to keep them
+	void getPointCloud(vector<ofVec3f> & points) const;
+
+	/// converts the depth frame into the vertices of a mesh of points
+	///
+	/// if bColors is true the points get the color of the video pixels,
+	/// they only match the depth with registration enabled
+	void getPointCloud(ofMesh & mesh, bool bColors = false) const;
+
+	/// the converter used by getPointCloud(), set up with the calibration
+	/// of the device when it's opened
+	ofxKinectPointCloud & getPointCloudConverter();
+
 /// \section Intrinsic IR Sensor Parameters
 
 	/// these values are used when depth registration is enabled to align the
@@ -384,6 +402,9 @@ private:
 	void updateDepthLookupTable();
 	void updateDepthPixels();
 
+	ofxKinectPointCloud pointCloud;
+	void setupPointCloud();
+
 	bool bIsFrameNewVideo, bIsFrameNewDepth;
 	bool bNeedsUpdateVideo, bNeedsUpdateDepth;
 	bool bGrabVideo;
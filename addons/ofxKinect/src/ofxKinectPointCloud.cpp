@@ -0,0 +1,280 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+    ----------------------------------------------------------------------------
+    
+    This project uses libfreenect, copyrighted by the Open Kinect Project using
+    the Apache License v2. See the file "APACHE20" in libs/libfreenect.
+    
+    See http://www.openkinect.org & https://github.com/OpenKinect/libfreenect 
+    for documentation
+    
+==============================================================================*/
+#include "ofxKinectPointCloud.h"
+
+//------------------------------------
+ofxKinectPointCloud::ofxKinectPointCloud() {
+	width = 0;
+	height = 0;
+	step = 1;
+	bKeepInvalid = false;
+	bParallel = true;
+	x0 = y0 = x1 = y1 = 0;
+	columns = rows = 0;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::setup(int w, int h, float referencePixelSize, float referenceDistance) {
+	width = w;
+	height = h;
+
+	// same calculation as freenect_camera_to_world(): the reference pixel
+	// size is for a 1280x1024 image which is cropped to 1280x960 and scaled
+	// to the 640x480 depth image, so a depth pixel is 2 reference pixels
+	float pixelSize = 2 * referencePixelSize * 640.f / width / referenceDistance;
+	rayX.resize(width);
+	for(int x = 0; x < width; x++) {
+		rayX[x] = (x - width / 2) * pixelSize;
+	}
+	rayY.resize(height);
+	for(int y = 0; y < height; y++) {
+		rayY[y] = (y - height / 2) * pixelSize;
+	}
+	updateRegion();
+}
+
+//------------------------------------
+void ofxKinectPointCloud::setROI(const ofRectangle & _roi) {
+	roi = _roi;
+	updateRegion();
+}
+
+//------------------------------------
+ofRectangle ofxKinectPointCloud::getROI() const {
+	return roi;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::setStep(int _step) {
+	step = max(_step, 1);
+	updateRegion();
+}
+
+//------------------------------------
+int ofxKinectPointCloud::getStep() const {
+	return step;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::setKeepInvalid(bool keep) {
+	bKeepInvalid = keep;
+}
+
+//------------------------------------
+bool ofxKinectPointCloud::getKeepInvalid() const {
+	return bKeepInvalid;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::setParallel(bool parallel) {
+	bParallel = parallel;
+}
+
+//------------------------------------
+bool ofxKinectPointCloud::getParallel() const {
+	return bParallel;
+}
+
+//------------------------------------
+int ofxKinectPointCloud::getWidth() const {
+	return width;
+}
+
+//------------------------------------
+int ofxKinectPointCloud::getHeight() const {
+	return height;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::updateRegion() {
+	if(roi.isEmpty()) {
+		x0 = 0;
+		y0 = 0;
+		x1 = width;
+		y1 = height;
+	} else {
+		ofRectangle r = roi.getStandardized();
+		x0 = ofClamp(floor(r.getLeft()), 0, width);
+		y0 = ofClamp(floor(r.getTop()), 0, height);
+		x1 = ofClamp(ceil(r.getRight()), x0, width);
+		y1 = ofClamp(ceil(r.getBottom()), y0, height);
+	}
+	columns = (x1 - x0 + step - 1) / step;
+	rows = (y1 - y0 + step - 1) / step;
+}
+
+//------------------------------------
+ofVec3f ofxKinectPointCloud::getWorldCoordinateAt(int x, int y, float z) const {
+	return ofVec3f(rayX[x] * z, rayY[y] * z, z);
+}
+
+//------------------------------------
+void ofxKinectPointCloud::getPoints(const ofShortPixels & depth, vector<ofVec3f> & points) const {
+	convert(depth, points, NULL, NULL);
+}
+
+//------------------------------------
+void ofxKinectPointCloud::getMesh(const ofShortPixels & depth, ofMesh & mesh, const ofPixels * colors) const {
+	mesh.setMode(OF_PRIMITIVE_POINTS);
+	mesh.clearIndices();
+	mesh.clearNormals();
+	mesh.clearTexCoords();
+	if(colors != NULL && (colors->getWidth() != depth.getWidth() || colors->getHeight() != depth.getHeight())) {
+		ofLogError("ofxKinectPointCloud") << "getMesh(): colors are " << colors->getWidth() << "x" << colors->getHeight()
+			<< " but depth is " << depth.getWidth() << "x" << depth.getHeight() << ", ignoring colors";
+		colors = NULL;
+	}
+	if(colors == NULL) {
+		mesh.clearColors();
+	}
+	convert(depth, mesh.getVertices(), colors, colors ? &mesh.getColors() : NULL);
+}
+
+//------------------------------------
+size_t ofxKinectPointCloud::countRow(const unsigned short * depth) const {
+	size_t count = 0;
+	for(int x = x0; x < x1; x += step) {
+		count += depth[x] != 0;
+	}
+	return count;
+}
+
+//------------------------------------
+void ofxKinectPointCloud::convertRow(int y, const unsigned short * depth, ofVec3f * points, const unsigned char * colors, int channels, ofFloatColor * pointColors) const {
+	const float * rx = &rayX[0];
+	const float ry = rayY[y];
+	if(bKeepInvalid) {
+		// no branches so the compiler can vectorize it
+		for(int x = x0; x < x1; x += step, points++) {
+			float z = depth[x];
+			points->x = rx[x] * z;
+			points->y = ry * z;
+			points->z = z;
+		}
+	} else {
+		for(int x = x0; x < x1; x += step) {
+			float z = depth[x];
+			if(z != 0) {
+				points->x = rx[x] * z;
+				points->y = ry * z;
+				points->z = z;
+				points++;
+			}
+		}
+	}
+
+	if(colors != NULL) {
+		for(int x = x0; x < x1; x += step) {
+			if(bKeepInvalid || depth[x] != 0) {
+				const unsigned char * c = colors + x * channels;
+				if(channels >= 3) {
+					pointColors->set(c[0] / 255.f, c[1] / 255.f, c[2] / 255.f);
+				} else {
+					pointColors->set(c[0] / 255.f);
+				}
+				pointColors++;
+			}
+		}
+	}
+}
+
+//------------------------------------
+void ofxKinectPointCloud::convert(const ofShortPixels & depth, vector<ofVec3f> & points, const ofPixels * colors, vector<ofFloatColor> * pointColors) const {
+	if((int)depth.getWidth() != width || (int)depth.getHeight() != height || depth.getNumChannels() != 1) {
+		ofLogError("ofxKinectPointCloud") << "convert(): expected " << width << "x" << height
+			<< " depth with 1 channel, got " << depth.getWidth() << "x" << depth.getHeight()
+			<< " with " << depth.getNumChannels();
+		points.clear();
+		if(pointColors != NULL) {
+			pointColors->clear();
+		}
+		return;
+	}
+
+	const unsigned short * depthData = depth.getData();
+	const unsigned char * colorData = colors ? colors->getData() : NULL;
+	int channels = colors ? colors->getNumChannels() : 0;
+
+	// first point of each row, without invalid pixels it needs a first pass
+	// counting them so every row can be written independently
+	vector<size_t> rowStart(rows + 1, 0);
+	if(bKeepInvalid) {
+		for(int r = 0; r <= rows; r++) {
+			rowStart[r] = size_t(r) * columns;
+		}
+	} else {
+#ifdef OF_USING_THREAD_POOL
+		if(bParallel) {
+			ofParallelFor(0, rows, [&](size_t r){
+				rowStart[r + 1] = countRow(depthData + (y0 + r * step) * width);
+			}, 16);
+		} else
+#endif
+		{
+			for(int r = 0; r < rows; r++) {
+				rowStart[r + 1] = countRow(depthData + (y0 + r * step) * width);
+			}
+		}
+		for(int r = 0; r < rows; r++) {
+			rowStart[r + 1] += rowStart[r];
+		}
+	}
+
+	points.resize(rowStart[rows]);
+	if(pointColors != NULL) {
+		pointColors->resize(rowStart[rows]);
+	}
+	if(points.empty()) {
+		return;
+	}
+
+	ofVec3f * pointsData = &points[0];
+	ofFloatColor * colorsData = pointColors ? &(*pointColors)[0] : NULL;
+#ifdef OF_USING_THREAD_POOL
+	if(bParallel) {
+		ofParallelFor(0, rows, [&](size_t r){
+			int y = y0 + r * step;
+			convertRow(y, depthData + y * width, pointsData + rowStart[r],
+				colorData ? colorData + y * width * channels : NULL, channels,
+				colorsData ? colorsData + rowStart[r] : NULL);
+		}, 16);
+	} else
+#endif
+	{
+		for(int r = 0; r < rows; r++) {
+			int y = y0 + r * step;
+			convertRow(y, depthData + y * width, pointsData + rowStart[r],
+				colorData ? colorData + y * width * channels : NULL, channels,
+				colorsData ? colorsData + rowStart[r] : NULL);
+		}
+	}
+}
@@ -0,0 +1,129 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+    ----------------------------------------------------------------------------
+    
+    This project uses libfreenect, copyrighted by the Open Kinect Project using
+    the Apache License v2. See the file "APACHE20" in libs/libfreenect.
+    
+    See http://www.openkinect.org & https://github.com/OpenKinect/libfreenect 
+    for documentation
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+/// \class ofxKinectPointCloud
+///
+/// converts whole depth frames to world coordinates
+///
+/// ofxKinect::getWorldCoordinateAt() does the perspective calculation for one
+/// pixel per call, building a point cloud that way repeats it for every pixel.
+/// the converter precomputes the ray through each column and row once, so a
+/// pixel only costs 2 multiplications, and splits the frame in bands of rows
+/// converted by the thread pool when compiling with c++11
+///
+/// it only needs the raw depth in mm, so it can also convert recorded frames
+/// without a device:
+///
+///     ofShortPixels depth;
+///     ofLoadImage(depth, "depth/frame_00000.png");
+///
+///     ofxKinectPointCloud converter;
+///     converter.setup(depth.getWidth(), depth.getHeight());
+///     converter.setStep(2);
+///     converter.getMesh(depth, mesh);
+///
+/// ofxKinect sets one up with the calibration of each device, see
+/// ofxKinect::getPointCloud()
+///
+class ofxKinectPointCloud {
+
+public:
+
+	ofxKinectPointCloud();
+
+	/// set the frame size and the depth camera calibration
+	///
+	/// the reference pixel size and distance describe the zero plane of the
+	/// IR camera, the defaults are the usual values of a Kinect for Xbox 360,
+	/// ofxKinect reads the real ones from the device
+	void setup(int width, int height, float referencePixelSize = 0.1042, float referenceDistance = 120);
+
+	/// only convert the pixels inside roi, an empty rectangle converts the whole frame
+	void setROI(const ofRectangle & roi);
+	ofRectangle getROI() const;
+
+	/// only convert every step pixels in x and y, default 1
+	void setStep(int step);
+	int getStep() const;
+
+	/// keep pixels without depth as (0,0,0) so the output is a grid of
+	/// columns x rows points in the same order as the pixels, default false
+	void setKeepInvalid(bool keep);
+	bool getKeepInvalid() const;
+
+	/// split the frame between the threads of the thread pool, default true
+	///
+	/// only has an effect when compiling with c++11
+	void setParallel(bool parallel);
+	bool getParallel() const;
+
+	/// converts depth, in mm, to world coordinates, in mm
+	///
+	/// points is resized to the number of converted pixels, reusing its memory
+	/// from frame to frame
+	void getPoints(const ofShortPixels & depth, vector<ofVec3f> & points) const;
+
+	/// converts depth into the vertices of a mesh of points
+	///
+	/// if colors is not NULL the color of each pixel is added too, the colors
+	/// have to be aligned to the depth, ie. with depth registration enabled
+	void getMesh(const ofShortPixels & depth, ofMesh & mesh, const ofPixels * colors = NULL) const;
+
+	/// converts a single pixel, same as ofxKinect::getWorldCoordinateAt()
+	ofVec3f getWorldCoordinateAt(int x, int y, float z) const;
+
+	int getWidth() const;
+	int getHeight() const;
+
+private:
+
+	void convert(const ofShortPixels & depth, vector<ofVec3f> & points, const ofPixels * colors, vector<ofFloatColor> * pointColors) const;
+	size_t countRow(const unsigned short * depth) const;
+	void convertRow(int y, const unsigned short * depth, ofVec3f * points, const unsigned char * colors, int channels, ofFloatColor * pointColors) const;
+
+	int width, height;
+	vector<float> rayX; ///< x world coordinate per mm of depth for each column
+	vector<float> rayY; ///< y world coordinate per mm of depth for each row
+
+	ofRectangle roi;
+	int step;
+	bool bKeepInvalid;
+	bool bParallel;
+
+	// region being converted, in pixels
+	int x0, y0, x1, y1;
+	int columns, rows;
+	void updateRegion();
+};
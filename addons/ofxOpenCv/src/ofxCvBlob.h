@@ -27,12 +27,16 @@ class ofxCvBlob {
         vector <ofPoint>    pts;    // the contour of the blob
         int                 nPts;   // number of pts;
 
+        int                 id;     // stable id across frames set by
+                                    // ofxCvBlobTracker, -1 if not tracked
+
         //----------------------------------------
         ofxCvBlob() {
             area 		= 0.0f;
             length 		= 0.0f;
             hole 		= false;
             nPts        = 0;
+            id          = -1;
         }
 
         //----------------------------------------
@@ -0,0 +1,123 @@
+
+#include "ofxCvBlobTracker.h"
+
+
+//--------------------------------------------------------------------------------
+ofxCvBlobTracker::ofxCvBlobTracker() {
+	maximumDistance = 50;
+	persistence = 5;
+	reset();
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::reset() {
+	tracks.clear();
+	newIds.clear();
+	lostIds.clear();
+	nextId = 0;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::track( vector<ofxCvBlob>& blobs ) {
+	newIds.clear();
+	lostIds.clear();
+
+	// every pair of track and blob close enough to be the same object,
+	// tracks are compared at the position predicted from their velocity
+	matches.clear();
+	float maxDistanceSquared = maximumDistance * maximumDistance;
+	for( int i = 0; i < (int)tracks.size(); i++ ) {
+		ofPoint predicted = tracks[i].centroid + tracks[i].velocity * (tracks[i].framesLost + 1);
+		for( int j = 0; j < (int)blobs.size(); j++ ) {
+			float distance = predicted.squareDistance( blobs[j].centroid );
+			if( distance < maxDistanceSquared ) {
+				Match match;
+				match.distance = distance;
+				match.track = i;
+				match.blob = j;
+				matches.push_back( match );
+			}
+		}
+	}
+
+	// closest pairs first, each track and blob can only be matched once
+	sort( matches.begin(), matches.end(), compareMatches );
+	trackMatched.assign( tracks.size(), false );
+	blobMatched.assign( blobs.size(), false );
+	for( int i = 0; i < (int)matches.size(); i++ ) {
+		const Match& match = matches[i];
+		if( trackMatched[match.track] || blobMatched[match.blob] ) {
+			continue;
+		}
+		trackMatched[match.track] = true;
+		blobMatched[match.blob] = true;
+
+		Track& track = tracks[match.track];
+		ofxCvBlob& blob = blobs[match.blob];
+		track.velocity = (blob.centroid - track.centroid) / (track.framesLost + 1);
+		track.centroid = blob.centroid;
+		track.framesLost = 0;
+		blob.id = track.id;
+	}
+
+	// tracks without a blob are kept until they pass the persistence
+	int numTracks = tracks.size();
+	for( int i = numTracks - 1; i >= 0; i-- ) {
+		if( !trackMatched[i] ) {
+			tracks[i].framesLost++;
+			if( tracks[i].framesLost > persistence ) {
+				lostIds.push_back( tracks[i].id );
+				tracks.erase( tracks.begin() + i );
+			}
+		}
+	}
+
+	// blobs without a track are new objects
+	for( int j = 0; j < (int)blobs.size(); j++ ) {
+		if( !blobMatched[j] ) {
+			Track track;
+			track.id = nextId++;
+			track.centroid = blobs[j].centroid;
+			track.velocity.set( 0, 0 );
+			track.framesLost = 0;
+			tracks.push_back( track );
+			blobs[j].id = track.id;
+			newIds.push_back( track.id );
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::setMaximumDistance( float distance ) {
+	maximumDistance = distance;
+}
+
+//--------------------------------------------------------------------------------
+float ofxCvBlobTracker::getMaximumDistance() const {
+	return maximumDistance;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvBlobTracker::setPersistence( int frames ) {
+	persistence = frames;
+}
+
+//--------------------------------------------------------------------------------
+int ofxCvBlobTracker::getPersistence() const {
+	return persistence;
+}
+
+//--------------------------------------------------------------------------------
+const vector<int>& ofxCvBlobTracker::getNewIds() const {
+	return newIds;
+}
+
+//--------------------------------------------------------------------------------
+const vector<int>& ofxCvBlobTracker::getLostIds() const {
+	return lostIds;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvBlobTracker::compareMatches( const Match& a, const Match& b ) {
+	return a.distance < b.distance;
+}
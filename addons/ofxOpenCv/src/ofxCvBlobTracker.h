@@ -0,0 +1,72 @@
+/*
+* ofxCvBlobTracker.h
+*
+* Assigns stable ids to the blobs found by ofxCvContourFinder
+* from one frame to the next. Each blob is matched to the
+* closest blob of the previous frames, predicted using its
+* last velocity. Blobs that disappear are remembered for a
+* few frames so they keep their id if they come back nearby.
+*
+*/
+
+#pragma once
+
+#include "ofxCvConstants.h"
+#include "ofxCvBlob.h"
+
+class ofxCvBlobTracker {
+
+  public:
+
+    ofxCvBlobTracker();
+
+    // assigns an id to every blob, blobs that match
+    // one from previous frames keep the same id
+    void track( vector<ofxCvBlob>& blobs );
+
+    // forget all the blobs and start counting ids from 0
+    void reset();
+
+    // maximum distance in pixels a blob can move
+    // between frames and still keep its id
+    void setMaximumDistance( float distance );
+    float getMaximumDistance() const;
+
+    // number of frames a blob that disappeared is remembered
+    void setPersistence( int frames );
+    int getPersistence() const;
+
+    // the ids of the blobs that are new this frame / that
+    // were lost this frame after passing the persistence
+    const vector<int>& getNewIds() const;
+    const vector<int>& getLostIds() const;
+
+
+  protected:
+
+    typedef struct {
+        int      id;
+        ofPoint  centroid;
+        ofPoint  velocity;
+        int      framesLost;
+    } Track;
+
+    typedef struct {
+        float    distance;
+        int      track;
+        int      blob;
+    } Match;
+
+    static bool compareMatches( const Match& a, const Match& b );
+
+    vector<Track>  tracks;
+    vector<Match>  matches;
+    vector<bool>   trackMatched;
+    vector<bool>   blobMatched;
+    vector<int>    newIds;
+    vector<int>    lostIds;
+    int            nextId;
+    float          maximumDistance;
+    int            persistence;
+
+};
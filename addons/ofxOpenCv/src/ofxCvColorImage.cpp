@@ -70,8 +70,7 @@ void ofxCvColorImage::operator -= ( float value ) {
         ofLogError("ofxCvColorImage") << "set(): image not allocated";
 		return;		
     }
-	cvSubS( cvImage, cvScalar(value, value, value), cvImageTemp );
-	swapTemp();
+	cvSubS( cvImage, cvScalar(value, value, value), cvImage );
     flagImageChanged();
 }
 
@@ -81,8 +80,7 @@ void ofxCvColorImage::operator += ( float value ) {
         ofLogError("ofxCvColorImage") << "set(): image not allocated";
 		return;		
     }
-	cvAddS( cvImage, cvScalar(value, value, value), cvImageTemp );
-	swapTemp();
+	cvAddS( cvImage, cvScalar(value, value, value), cvImage );
     flagImageChanged();
 }
 
@@ -105,7 +103,9 @@ void ofxCvColorImage::setFromPixels( const unsigned char* _pixels, int w, int h
 		allocate(w,h);
 	}
 	
-	if( cvImage->width*cvImage->nChannels == cvImage->widthStep ){
+	if( (const char*)_pixels == cvImage->imageData ){
+		// wrapping these pixels already, nothing to copy
+	}else if( cvImage->width*cvImage->nChannels == cvImage->widthStep ){
 		memcpy( cvImage->imageData,  _pixels, w*h*iplchannels);
 	}else{		
 		for( int i=0; i < height; i++ ) {
@@ -456,8 +456,7 @@ void ofxCvColorImage::convertRgbToHsv(){
 		ofLogError("ofxCvColorImage") << "convertRgbToHsv(): image not allocated";	
 		return;	
 	}
-    cvCvtColor( cvImage, cvImageTemp, CV_RGB2HSV);
-    swapTemp();
+    cvCvtColor( cvImage, cvImage, CV_RGB2HSV);
     flagImageChanged();
 }
 
@@ -467,8 +466,7 @@ void ofxCvColorImage::convertHsvToRgb(){
 		ofLogError("ofxCvColorImage") << "convertHsvToRgb(): image not allocated";
 		return;	
 	}
-    cvCvtColor( cvImage, cvImageTemp, CV_HSV2RGB);
-    swapTemp();
+    cvCvtColor( cvImage, cvImage, CV_HSV2RGB);
     flagImageChanged();
 }
 
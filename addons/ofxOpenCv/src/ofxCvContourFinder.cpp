@@ -4,13 +4,28 @@
 
 
 //--------------------------------------------------------------------------------
-static bool sort_carea_compare( const CvSeq* a, const CvSeq* b) {
-	
-	// use opencv to calc size, then sort based on size
-	float areaa = cvContourArea(a, CV_WHOLE_SEQ);
-	float areab = cvContourArea(b, CV_WHOLE_SEQ);
-	
-	return (areaa > areab);
+static bool sort_carea_compare( const pair<float,CvSeq*>& a, const pair<float,CvSeq*>& b) {
+	// areas are calculated once when filtering, sort by their absolute value
+	return fabs(a.first) > fabs(b.first);
+}
+
+//--------------------------------------------------------------------------------
+static double contour_signed_area( CvSeq* contour ) {
+	// same as cvContourArea( contour, CV_WHOLE_SEQ, true )
+	if( contour->total < 3 ) {
+		return 0;
+	}
+	CvPoint prev = *CV_GET_SEQ_ELEM( CvPoint, contour, contour->total - 1 );
+	CvPoint pt;
+	CvSeqReader reader;
+	cvStartReadSeq( contour, &reader, 0 );
+	double a00 = 0;
+	for( int j=0; j < contour->total; j++ ) {
+		CV_READ_SEQ_ELEM( pt, reader );
+		a00 += (double)prev.x * pt.y - (double)prev.y * pt.x;
+		prev = pt;
+	}
+	return a00 * 0.5;
 }
 
 
@@ -20,22 +35,54 @@ static bool sort_carea_compare( const CvSeq* a, const CvSeq* b) {
 ofxCvContourFinder::ofxCvContourFinder() {
     _width = 0;
     _height = 0;
-	myMoments = (CvMoments*)malloc( sizeof(CvMoments) );
+    contour_storage = NULL;
+    bAnchorIsPct = false;
+    bCopyInput = true;
+    bTrackBlobs = false;
 	reset();
 }
 
 //--------------------------------------------------------------------------------
 ofxCvContourFinder::~ofxCvContourFinder() {
-	free( myMoments );
+	if( contour_storage != NULL ) { cvReleaseMemStorage(&contour_storage); }
 }
 
 //--------------------------------------------------------------------------------
 void ofxCvContourFinder::reset() {
     cvSeqBlobs.clear();
+    cvSeqAreas.clear();
     blobs.clear();
     nBlobs = 0;
 }
 
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::setCopyInput( bool bCopy ) {
+	bCopyInput = bCopy;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvContourFinder::getCopyInput() const {
+	return bCopyInput;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::setTrackBlobs( bool bTrack ) {
+	if( bTrack && !bTrackBlobs ) {
+		tracker.reset();
+	}
+	bTrackBlobs = bTrack;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvContourFinder::getTrackBlobs() const {
+	return bTrackBlobs;
+}
+
+//--------------------------------------------------------------------------------
+ofxCvBlobTracker& ofxCvContourFinder::getTracker() {
+	return tracker;
+}
+
 //--------------------------------------------------------------------------------
 int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
 									  int minArea,
@@ -49,106 +96,146 @@ int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
     _width = ipltemp->width;
     _height = ipltemp->height;
 
-	reset();
+    // the blobs are not cleared so their points
+    // can reuse the memory from the previous call
+    cvSeqBlobs.clear();
+    cvSeqAreas.clear();
+
+    IplImage* contourImage;
+    if( bCopyInput ) {
+        // opencv will clober the image it detects contours on, so we want to
+        // copy it into a copy before we detect contours.  That copy is allocated
+        // if necessary (necessary = (a) not allocated or (b) wrong size)
+        // so be careful if you pass in different sized images to "findContours"
+        // there is a performance penalty, but we think there is not a memory leak
+        // to worry about better to create mutiple contour finders for different
+        // sizes, ie, if you are finding contours in a 640x480 image but also a
+        // 320x240 image better to make two ofxCvContourFinder objects then to use
+        // one, because you will get penalized less.
+
+        inputCopy.setUseTexture(false);
+        if( inputCopy.getWidth() == 0 ) {
+            inputCopy.allocate( _width, _height );
+        } else if( inputCopy.getWidth() != _width || inputCopy.getHeight() != _height ) {
+            // reallocate to new size
+            inputCopy.clear();
+            inputCopy.allocate( _width, _height );
+        }
+
+        inputCopy.setROI( input.getROI() );
+        inputCopy = input;
+        contourImage = inputCopy.getCvImage();
+    } else {
+        contourImage = input.getCvImage();
+        input.flagImageChanged();
+    }
 
-	// opencv will clober the image it detects contours on, so we want to
-    // copy it into a copy before we detect contours.  That copy is allocated
-    // if necessary (necessary = (a) not allocated or (b) wrong size)
-	// so be careful if you pass in different sized images to "findContours"
-	// there is a performance penalty, but we think there is not a memory leak
-    // to worry about better to create mutiple contour finders for different
-    // sizes, ie, if you are finding contours in a 640x480 image but also a
-    // 320x240 image better to make two ofxCvContourFinder objects then to use
-    // one, because you will get penalized less.
-
-    inputCopy.setUseTexture(false);
-	if( inputCopy.getWidth() == 0 ) {
-		inputCopy.allocate( _width, _height );
-	} else if( inputCopy.getWidth() != _width || inputCopy.getHeight() != _height ) {
-        // reallocate to new size
-        inputCopy.clear();
-        inputCopy.allocate( _width, _height );
+	// the storage is created once and cleared on every call
+	// instead of being created and released each time
+	if( contour_storage == NULL ) {
+		contour_storage = cvCreateMemStorage( 0 );
+	} else {
+		cvClearMemStorage( contour_storage );
 	}
 
-    inputCopy.setROI( input.getROI() );
-    inputCopy = input;
-
 	CvSeq* contour_list = NULL;
-	contour_storage = cvCreateMemStorage( 1000 );
-	storage	= cvCreateMemStorage( 1000 );
-
 	CvContourRetrievalMode  retrieve_mode
         = (bFindHoles) ? CV_RETR_LIST : CV_RETR_EXTERNAL;
-	cvFindContours( inputCopy.getCvImage(), contour_storage, &contour_list,
+	cvFindContours( contourImage, contour_storage, &contour_list,
                     sizeof(CvContour), retrieve_mode, bUseApproximation ? CV_CHAIN_APPROX_SIMPLE : CV_CHAIN_APPROX_NONE );
 	CvSeq* contour_ptr = contour_list;
 
 	// put the contours from the linked list, into an array for sorting
+	// together with their area so it's only calculated once
 	while( (contour_ptr != NULL) ) {
-		float area = cvContourArea(contour_ptr, CV_WHOLE_SEQ, bFindHoles); // oriented=true for holes
-		if(bFindHoles && area < 0) { // areas can be non negative in the case of holes
-			area = fabs(area);
-		}
-		if((area > minArea) && (area < maxArea)) {
-			cvSeqBlobs.push_back(contour_ptr);
+		float area = contour_signed_area( contour_ptr ); // oriented, holes have positive areas
+		if((fabs(area) > minArea) && (fabs(area) < maxArea)) {
+			cvSeqAreas.push_back( make_pair(area, contour_ptr) );
 		}
 		contour_ptr = contour_ptr->h_next;
 	}
 
 
-	// sort the pointers based on size
-	if( cvSeqBlobs.size() > 1 ) {
-        sort( cvSeqBlobs.begin(), cvSeqBlobs.end(), sort_carea_compare );
+	// sort the contours based on size
+	if( cvSeqAreas.size() > 1 ) {
+        sort( cvSeqAreas.begin(), cvSeqAreas.end(), sort_carea_compare );
+	}
+	for( int i = 0; i < (int)cvSeqAreas.size(); i++ ) {
+		cvSeqBlobs.push_back( cvSeqAreas[i].second );
 	}
 
 
 	// now, we have cvSeqBlobs.size() contours, sorted by size in the array
-    // cvSeqBlobs let's get the data out and into our structures that we like
-	for( int i = 0; i < MIN(nConsidered, (int)cvSeqBlobs.size()); i++ ) {
-		blobs.push_back( ofxCvBlob() );
-		float area = cvContourArea( cvSeqBlobs[i], CV_WHOLE_SEQ, bFindHoles ); // oriented=true for holes
-		CvRect rect	= cvBoundingRect( cvSeqBlobs[i], 0 );
-		cvMoments( cvSeqBlobs[i], myMoments );
-
-		blobs[i].area                     = bFindHoles ? fabs(area) : area; // only return positive areas
-		blobs[i].length 			      = cvArcLength(cvSeqBlobs[i]);
-		blobs[i].boundingRect.x           = rect.x;
-		blobs[i].boundingRect.y           = rect.y;
-		blobs[i].boundingRect.width       = rect.width;
-		blobs[i].boundingRect.height      = rect.height;
-		blobs[i].centroid.x 			  = (myMoments->m10 / myMoments->m00);
-		blobs[i].centroid.y 			  = (myMoments->m01 / myMoments->m00);
+    // cvSeqBlobs let's get the data out and into our structures that we like.
+    // the length, bounding box and moments are calculated in the same pass
+    // that copies the points, the same way cvArcLength, cvBoundingRect and
+    // cvMoments do for a closed contour
+	blobs.resize( MIN(nConsidered, (int)cvSeqBlobs.size()) );
+	for( int i = 0; i < (int)blobs.size(); i++ ) {
+		CvSeq* contour = cvSeqBlobs[i];
+		float area = cvSeqAreas[i].first;
+		ofxCvBlob& blob = blobs[i];
+
+		blob.pts.resize( contour->total );
+		blob.nPts = contour->total;
+		blob.id = -1;
+
+		CvPoint prev = *CV_GET_SEQ_ELEM( CvPoint, contour, contour->total - 1 );
+		CvPoint pt;
+		CvSeqReader reader;
+		cvStartReadSeq( contour, &reader, 0 );
+
+		int minX = prev.x, maxX = prev.x, minY = prev.y, maxY = prev.y;
+		double a00 = 0, a10 = 0, a01 = 0, length = 0;
+		for( int j=0; j < contour->total; j++ ) {
+			CV_READ_SEQ_ELEM( pt, reader );
+			blob.pts[j].set( (float)pt.x, (float)pt.y );
+
+			double dxy = (double)prev.x * pt.y - (double)pt.x * prev.y;
+			a00 += dxy;
+			a10 += dxy * (prev.x + pt.x);
+			a01 += dxy * (prev.y + pt.y);
+
+			double dx = pt.x - prev.x;
+			double dy = pt.y - prev.y;
+			length += sqrt( dx * dx + dy * dy );
+
+			minX = MIN( minX, pt.x );
+			maxX = MAX( maxX, pt.x );
+			minY = MIN( minY, pt.y );
+			maxY = MAX( maxY, pt.y );
+			prev = pt;
+		}
+
+		blob.area                     = fabs(area); // only return positive areas
+		blob.length                   = length;
+		blob.boundingRect.x           = minX;
+		blob.boundingRect.y           = minY;
+		blob.boundingRect.width       = maxX - minX + 1;
+		blob.boundingRect.height      = maxY - minY + 1;
+		if( fabs(a00) > FLT_EPSILON ) {
+			blob.centroid.x           = a10 / (3 * a00);
+			blob.centroid.y           = a01 / (3 * a00);
+		} else {
+			// degenerate contours, like a line, have no area
+			blob.centroid.x           = blob.boundingRect.getCenter().x;
+			blob.centroid.y           = blob.boundingRect.getCenter().y;
+		}
 
 		if(bFindHoles) {
-			// for some reason, changing the orientation when looking for holes
-			// yields negative areas for non holes and positive areas for holes
-			//
-			// negating the value here works, even though it feels like a hack
-			blobs[i].hole                 = -area < 0 ? true : false; // negative area denotes a hole
+			// with oriented areas holes are positive and non holes negative
+			blob.hole                 = area > 0;
 		}
 		else {
-			blobs[i].hole                 = false; // no holes
-		}
-
-		// get the points for the blob:
-		CvPoint           pt;
-		CvSeqReader       reader;
-		cvStartReadSeq( cvSeqBlobs[i], &reader, 0 );
-
-    	for( int j=0; j < cvSeqBlobs[i]->total; j++ ) {
-			CV_READ_SEQ_ELEM( pt, reader );
-            blobs[i].pts.push_back( ofPoint((float)pt.x, (float)pt.y) );
+			blob.hole                 = false; // no holes
 		}
-		blobs[i].nPts = blobs[i].pts.size();
-
 	}
 
     nBlobs = blobs.size();
 
-	// Free the storage memory.
-	// Warning: do this inside this function otherwise a strange memory leak
-	if( contour_storage != NULL ) { cvReleaseMemStorage(&contour_storage); }
-	if( storage != NULL ) { cvReleaseMemStorage(&storage); }
+	if( bTrackBlobs ) {
+		tracker.track( blobs );
+	}
 
 	return nBlobs;
 
@@ -12,6 +12,7 @@
 
 #include "ofxCvConstants.h"
 #include "ofxCvBlob.h"
+#include "ofxCvBlobTracker.h"
 #include "ofxCvGrayscaleImage.h"
 #include <algorithm>
 
@@ -37,6 +38,18 @@ class ofxCvContourFinder : public ofBaseDraws {
                                // of the contour, if the contour runs
                                // along a straight line, for example...
 
+    // opencv modifies the image it finds contours in so by default
+    // the input is copied first. if the input is not needed after
+    // finding the contours, disabling the copy saves some time
+    virtual void  setCopyInput( bool bCopy );
+    virtual bool  getCopyInput() const;
+
+    // when enabled each blob gets an id that stays the same
+    // from one call to findContours to the next
+    virtual void  setTrackBlobs( bool bTrack );
+    virtual bool  getTrackBlobs() const;
+    ofxCvBlobTracker&  getTracker();
+
     virtual void  draw() const { draw(0,0, _width, _height); };
     virtual void  draw( float x, float y ) const { draw(x,y, _width, _height); };
     virtual void  draw( float x, float y, float w, float h ) const;
@@ -54,13 +67,15 @@ class ofxCvContourFinder : public ofBaseDraws {
     int  _width;
     int  _height;
     ofxCvGrayscaleImage     inputCopy;
-    CvMemStorage*           contour_storage;
-    CvMemStorage*           storage;
-    CvMoments*              myMoments;
+    CvMemStorage*           contour_storage;  //reused on every call
     vector<CvSeq*>          cvSeqBlobs;  //these will become blobs
+    vector< pair<float,CvSeq*> >  cvSeqAreas;  //signed area of each contour, for sorting
     
     ofPoint  anchor;
     bool  bAnchorIsPct;      
+    bool  bCopyInput;
+    bool  bTrackBlobs;
+    ofxCvBlobTracker  tracker;
 
     virtual void reset();
 
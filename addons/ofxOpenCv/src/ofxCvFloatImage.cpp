@@ -395,8 +395,7 @@ void ofxCvFloatImage::operator *= ( ofxCvImage& mom ) {
 		
 	if( mom.getCvImage()->nChannels == cvImage->nChannels && mom.getCvImage()->depth == cvImage->depth ){
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvMul( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cvMul( cvImage, mom.getCvImage(), cvImage );
             flagImageChanged();
         } else {
             ofLogError("ofxCvFloatImage") << "operator*=: region of interest mismatch";
@@ -421,8 +420,7 @@ void ofxCvFloatImage::operator &= ( ofxCvImage& mom ) {
 	if( mom.getCvImage()->nChannels == cvImage->nChannels && mom.getCvImage()->depth == cvImage->depth ){
         if( matchingROI(getROI(), mom.getROI()) ) {
             //this is doing it bit-wise; probably not what we want
-            cvAnd( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cvAnd( cvImage, mom.getCvImage(), cvImage );
             flagImageChanged();
         } else {
             ofLogError("ofxCvFloatImage") << "operator&=: region of interest mismatch";
@@ -69,7 +69,9 @@ void ofxCvGrayscaleImage::setFromPixels( const unsigned char* _pixels, int w, in
 	
     if( w == width && h == height ) {
 		
-		if( cvImage->width == cvImage->widthStep ){
+		if( (const char*)_pixels == cvImage->imageData ){
+			// wrapping these pixels already, nothing to copy
+		}else if( cvImage->width == cvImage->widthStep ){
 			memcpy( cvImage->imageData,  _pixels, w*h);
 		}else{
 		
@@ -236,8 +238,7 @@ void ofxCvGrayscaleImage::absDiff( ofxCvGrayscaleImage& mom ){
 	}	
 
     if( matchingROI(getROI(), mom.getROI()) ) {
-        cvAbsDiff( cvImage, mom.getCvImage(), cvImageTemp );
-        swapTemp();
+        cvAbsDiff( cvImage, mom.getCvImage(), cvImage );
         flagImageChanged();
     } else {
         ofLogError("ofxCvGrayscaleImage") << "absDiff(): region of interest mismatch";
@@ -388,8 +389,7 @@ void ofxCvGrayscaleImage::brightnessContrast(float brightness, float contrast){
 
 	//cvSetData( briConLutMatrix, briConLut, 0 );
 
-	cvLUT( cvImage, cvImageTemp, briConLutMatrix); 
-	swapTemp();
+	cvLUT( cvImage, cvImage, briConLutMatrix); 
 	flagImageChanged();
 }
 
@@ -15,6 +15,11 @@ ofxCvHaarFinder::ofxCvHaarFinder() {
 	cascade = NULL;
 	scaleHaar = 1.08;
 	neighbors = 2;
+	bParallel = false;
+	bTemporalRoi = false;
+	fullScanInterval = 10;
+	roiMargin = 0.5;
+	framesSinceFullScan = 0;
 	img.setUseTexture(false);
 }
 
@@ -22,6 +27,11 @@ ofxCvHaarFinder::ofxCvHaarFinder(const ofxCvHaarFinder& finder) {
 	cascade = NULL;
 	scaleHaar = finder.scaleHaar;
 	neighbors = finder.neighbors;
+	bParallel = finder.bParallel;
+	bTemporalRoi = finder.bTemporalRoi;
+	fullScanInterval = finder.fullScanInterval;
+	roiMargin = finder.roiMargin;
+	framesSinceFullScan = 0;
 	img.setUseTexture(false);
 	setup(finder.haarFile);
 }
@@ -29,6 +39,7 @@ ofxCvHaarFinder::ofxCvHaarFinder(const ofxCvHaarFinder& finder) {
 ofxCvHaarFinder::~ofxCvHaarFinder() {
 	if(cascade != NULL)
 		cvReleaseHaarClassifierCascade(&cascade);
+	clearCascadeCopies();
 }
 
 // low values	- more accurate - eg: 1.01
@@ -43,9 +54,29 @@ void ofxCvHaarFinder::setNeighbors(unsigned neighbors) {
 	this->neighbors = neighbors;
 }
 
+void ofxCvHaarFinder::setParallel(bool parallel) {
+	bParallel = parallel;
+}
+
+bool ofxCvHaarFinder::isParallel() const {
+	return bParallel;
+}
+
+void ofxCvHaarFinder::setUseTemporalRoi(bool useTemporalRoi, int fullScanInterval, float margin) {
+	bTemporalRoi = useTemporalRoi;
+	this->fullScanInterval = fullScanInterval;
+	roiMargin = margin;
+	framesSinceFullScan = 0;
+}
+
+bool ofxCvHaarFinder::isUsingTemporalRoi() const {
+	return bTemporalRoi;
+}
+
 void ofxCvHaarFinder::setup(string haarFile) {
 	if(cascade != NULL)
 		cvReleaseHaarClassifierCascade(&cascade);
+	clearCascadeCopies();
 
 	this->haarFile = haarFile;
 
@@ -77,47 +108,43 @@ float ofxCvHaarFinder::getHeight() {
 }
 
 int ofxCvHaarFinder::findHaarObjects(ofImage& input, int minWidth, int minHeight) {
-
-	ofxCvGrayscaleImage gray;
-	gray.setUseTexture(false);
-	gray.allocate(input.width, input.height);
-
-	if( input.type == OF_IMAGE_COLOR ){
-		ofxCvColorImage color;
-		color.setUseTexture(false);
-		color.allocate(input.width, input.height);
-		color = input.getPixels();
-		gray = color;
-	}else if( input.type == OF_IMAGE_GRAYSCALE ){
-		gray = input.getPixels();
-	}else{
-		ofLogError("ofxCvHaarFinder") << "findHaarObjects(): OF_IMAGE_RGBA image type not supported";
-		return 0;
-	}
-
-	return findHaarObjects(gray, minWidth, minHeight);
-
+	return findHaarObjects(input.getPixels(), minWidth, minHeight);
 }
 
 int ofxCvHaarFinder::findHaarObjects(ofPixels& input, int minWidth, int minHeight){
-	ofxCvGrayscaleImage gray;
-	gray.setUseTexture(false);
-	gray.allocate(input.getWidth(), input.getHeight());
+	if( !cascade ) {
+		return 0;
+	}
 
+	// wrap the pixels in an opencv header and convert or equalize
+	// them straight into img instead of going through ofxCvImages
+	int w = input.getWidth();
+	int h = input.getHeight();
+	IplImage header;
 	if( input.getImageType() == OF_IMAGE_COLOR ){
-		ofxCvColorImage color;
-		color.setUseTexture(false);
-		color.allocate(input.getWidth(), input.getHeight());
-		color.setFromPixels(input);
-		gray = color;
+		cvInitImageHeader(&header, cvSize(w, h), IPL_DEPTH_8U, 3);
+		cvSetData(&header, input.getData(), w * 3);
+		if(img.width != w || img.height != h) {
+			img.clear();
+			img.allocate(w, h);
+		}
+		img.resetROI();
+		cvCvtColor(&header, img.getCvImage(), CV_RGB2GRAY);
+		if(!prepareImage(img.getCvImage(), 0, 0, w, h)) {
+			return 0;
+		}
 	}else if( input.getImageType() == OF_IMAGE_GRAYSCALE ){
-		gray.setFromPixels(input);
+		cvInitImageHeader(&header, cvSize(w, h), IPL_DEPTH_8U, 1);
+		cvSetData(&header, input.getData(), w);
+		if(!prepareImage(&header, 0, 0, w, h)) {
+			return 0;
+		}
 	}else{
 		ofLogError("ofxCvHaarFinder") << "findHaarObjects(): OF_IMAGE_RGBA image type not supported";
 		return 0;
 	}
 
-	return findHaarObjects(gray, minWidth, minHeight);
+	return detect(getTemporalRegions(0, 0, w, h, NULL), 0, 0, w, h, minWidth, minHeight);
 }
 
 int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage&  input,
@@ -127,6 +154,16 @@ int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage&  input,
 		minWidth, minHeight);
 }
 
+int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage& input,
+	const ofxCvGrayscaleImage& motionMask,
+	int minWidth, int minHeight) {
+	if( !cascade || !prepareImage(input.getCvImage(), 0, 0, input.width, input.height) ) {
+		return 0;
+	}
+	return detect(getTemporalRegions(0, 0, input.width, input.height, &motionMask),
+		0, 0, input.width, input.height, minWidth, minHeight);
+}
+
 int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage&  input,
 	ofRectangle& roi,
 	int minWidth, int minHeight) {
@@ -158,27 +195,159 @@ void ofxCvHaarFinder::draw( float x, float y ) {
 int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage& input,
 	int x, int y, int w, int h,
 	int minWidth, int minHeight) {
+	if( !cascade || !prepareImage(input.getCvImage(), x, y, w, h) ) {
+		return 0;
+	}
+	return detect(getTemporalRegions(x, y, w, h, NULL), x, y, w, h, minWidth, minHeight);
+}
 
-	int nHaarResults = 0;
+bool ofxCvHaarFinder::prepareImage(const IplImage* input, int x, int y, int w, int h) {
+	if(img.width != input->width || img.height != input->height) {
+		img.clear();
+		img.allocate(input->width, input->height);
+	}
+	img.resetROI();
 
-	if (cascade) {
-		if (!blobs.empty())
-			blobs.clear();
+	ofRectangle roi = ofRectangle(x, y, w, h).getIntersection(ofRectangle(0, 0, input->width, input->height));
+	if(roi.width <= 0 || roi.height <= 0) {
+		blobs.clear();
+		return false;
+	}
 
-		// we make a copy of the input image here
-		// because we need to equalize it.
+	// the detector works on the equalized region of interest,
+	// equalizing from the input avoids copying it first
+	CvRect rect = cvRect(roi.x, roi.y, roi.width, roi.height);
+	CvMat src, dst;
+	cvGetSubRect(input, &src, rect);
+	cvGetSubRect(img.getCvImage(), &dst, rect);
+	cvEqualizeHist(&src, &dst);
+	img.flagImageChanged();
+	return true;
+}
+
+vector<ofRectangle> ofxCvHaarFinder::getTemporalRegions(int x, int y, int w, int h, const ofxCvGrayscaleImage* motionMask) {
+	ofRectangle full = ofRectangle(x, y, w, h).getIntersection(ofRectangle(0, 0, img.width, img.height));
+	vector<ofRectangle> regions;
+	if(!bTemporalRoi && !motionMask) {
+		regions.push_back(full);
+		return regions;
+	}
 
-		if (img.width == input.width && img.height == input.height) {
-                img.resetROI();
-				img = input;
-		} else {
-				img.clear();
-				img.allocate(input.width, input.height);
-				img = input;
+	// scan everything from time to time to find new objects, without
+	// a motion mask also when nothing was found in the last frame
+	framesSinceFullScan++;
+	if(bTemporalRoi && (framesSinceFullScan >= fullScanInterval || (blobs.empty() && !motionMask))) {
+		framesSinceFullScan = 0;
+		regions.push_back(full);
+		return regions;
+	}
+
+	for(size_t i = 0; i < blobs.size(); i++) {
+		ofRectangle region = blobs[i].boundingRect;
+		region.scaleFromCenter(1 + roiMargin * 2);
+		region = region.getIntersection(full);
+		if(region.width > 0 && region.height > 0) {
+			regions.push_back(region);
 		}
+	}
 
-		img.setROI(x, y, w, h);
-		cvEqualizeHist(img.getCvImage(), img.getCvImage());
+	if(motionMask && motionMask->bAllocated) {
+		CvRect motion = cvBoundingRect((CvArr*)motionMask->getCvImage());
+		if(motion.width > 0 && motion.height > 0) {
+			// make room for a detector window around the moving pixels
+			ofRectangle region(motion.x, motion.y, motion.width, motion.height);
+			region.x -= cascade->orig_window_size.width;
+			region.y -= cascade->orig_window_size.height;
+			region.width += cascade->orig_window_size.width * 2;
+			region.height += cascade->orig_window_size.height * 2;
+			region = region.getIntersection(full);
+			if(region.width > 0 && region.height > 0) {
+				regions.push_back(region);
+			}
+		}
+	}
+
+	// overlapping regions are merged so objects aren't found twice
+	bool merged = true;
+	while(merged) {
+		merged = false;
+		for(size_t i = 0; i < regions.size() && !merged; i++) {
+			for(size_t j = i + 1; j < regions.size() && !merged; j++) {
+				if(regions[i].intersects(regions[j])) {
+					regions[i].growToInclude(regions[j]);
+					regions.erase(regions.begin() + j);
+					merged = true;
+				}
+			}
+		}
+	}
+	return regions;
+}
+
+CvHaarClassifierCascade* ofxCvHaarFinder::getCascadeCopy() {
+	{
+		ofScopedLock lock(cascadeMutex);
+		if(!cascadeCopies.empty()) {
+			CvHaarClassifierCascade* copy = cascadeCopies.back();
+			cascadeCopies.pop_back();
+			return copy;
+		}
+	}
+	return (CvHaarClassifierCascade*) cvLoad(ofToDataPath(haarFile).c_str(), 0, 0, 0);
+}
+
+void ofxCvHaarFinder::releaseCascadeCopy(CvHaarClassifierCascade* copy) {
+	ofScopedLock lock(cascadeMutex);
+	cascadeCopies.push_back(copy);
+}
+
+void ofxCvHaarFinder::clearCascadeCopies() {
+	ofScopedLock lock(cascadeMutex);
+	for(size_t i = 0; i < cascadeCopies.size(); i++) {
+		cvReleaseHaarClassifierCascade(&cascadeCopies[i]);
+	}
+	cascadeCopies.clear();
+}
+
+void ofxCvHaarFinder::detect(const ScaleBand& band, vector<cv::Rect>& results) {
+	// opencv keeps state about the image in the cascade so
+	// bands running in parallel need their own copy
+	CvHaarClassifierCascade* bandCascade = bParallel ? getCascadeCopy() : cascade;
+	if(!bandCascade) {
+		return;
+	}
+
+	CvMat sub;
+	cvGetSubRect(img.getCvImage(), &sub, cvRect(band.region.x, band.region.y, band.region.width, band.region.height));
+	CvMemStorage* storage = cvCreateMemStorage();
+
+	// without grouping, neighbors are grouped once all
+	// the regions and scales have been searched
+	CvSeq* haarResults = cvHaarDetectObjects(
+			&sub, bandCascade, storage, scaleHaar, 0, CV_HAAR_DO_CANNY_PRUNING,
+			band.minSize, band.maxSize);
+
+	for (int i = 0; i < haarResults->total; i++ ) {
+		CvRect* r = (CvRect*) cvGetSeqElem(haarResults, i);
+		results.push_back(cv::Rect(r->x + band.region.x, r->y + band.region.y, r->width, r->height));
+	}
+	cvReleaseMemStorage(&storage);
+
+	if(bParallel) {
+		releaseCascadeCopy(bandCascade);
+	}
+}
+
+int ofxCvHaarFinder::detect(const vector<ofRectangle>& regions, int x, int y, int w, int h, int minWidth, int minHeight) {
+	blobs.clear();
+
+	vector<cv::Rect> rects;
+	ofRectangle full = ofRectangle(x, y, w, h).getIntersection(ofRectangle(0, 0, img.width, img.height));
+	if(!bParallel && regions.size() == 1 && regions[0] == full) {
+		// a single search over the whole region of interest,
+		// let opencv group the results
+		CvMat sub;
+		cvGetSubRect(img.getCvImage(), &sub, cvRect(full.x, full.y, full.width, full.height));
 		CvMemStorage* storage = cvCreateMemStorage();
 
 		/*
@@ -201,47 +370,119 @@ int ofxCvHaarFinder::findHaarObjects(const ofxCvGrayscaleImage& input,
 		*/
 
 		CvSeq* haarResults = cvHaarDetectObjects(
-				img.getCvImage(), cascade, storage, scaleHaar, neighbors, CV_HAAR_DO_CANNY_PRUNING,
+				&sub, cascade, storage, scaleHaar, neighbors, CV_HAAR_DO_CANNY_PRUNING,
 				cvSize(minWidth, minHeight));
 
-		nHaarResults = haarResults->total;
-
-		for (int i = 0; i < nHaarResults; i++ ) {
-			//ofLogNotice("ofxCvHaarFinder") << "findHaarObjects(): " << i << " objects";
-
-			ofxCvBlob blob;
-
+		for (int i = 0; i < haarResults->total; i++ ) {
 			CvRect* r = (CvRect*) cvGetSeqElem(haarResults, i);
+			rects.push_back(cv::Rect(r->x + full.x, r->y + full.y, r->width, r->height));
+		}
+		cvReleaseMemStorage(&storage);
+	} else {
+		// each region is searched in bands of scales: the detector
+		// runs at every scale between minSize and maxSize of the band.
+		// the bands are balanced by the number of windows to check
+		vector<ScaleBand> bands;
+
+		int numBands = 1;
+		if(bParallel) {
+			numBands = MAX(1, (int)ofGetThreadPool().getNumThreads());
+		}
 
-			float area = r->width * r->height;
-			float length = (r->width * 2) + (r->height * 2);
-			float centerx	= (r->x) + (r->width / 2.0);
-			float centery	= (r->y) + (r->height / 2.0);
-
-			blob.area = fabs(area);
-			blob.hole = area < 0 ? true : false;
-			blob.length	= length;
-			blob.boundingRect.x = r->x + x;
-			blob.boundingRect.y = r->y + y;
-			blob.boundingRect.width = r->width;
-			blob.boundingRect.height = r->height;
-			blob.centroid.x = centerx;
-			blob.centroid.y = centery;
-			blob.pts.push_back(ofPoint(r->x, r->y));
-			blob.pts.push_back(ofPoint(r->x + r->width, r->y));
-			blob.pts.push_back(ofPoint(r->x + r->width, r->y + r->height));
-			blob.pts.push_back(ofPoint(r->x, r->y + r->height));
-
-			blobs.push_back(blob);
+		for(size_t i = 0; i < regions.size(); i++) {
+			const ofRectangle& region = regions[i];
+			vector<CvSize> sizes;
+			vector<double> costs;
+			double totalCost = 0;
+			CvSize origSize = cascade->orig_window_size;
+			// same loop cvHaarDetectObjects uses to go through the scales
+			for(double factor = 1; factor * origSize.width < region.width - 10 && factor * origSize.height < region.height - 10; factor *= scaleHaar) {
+				CvSize winSize = cvSize(cvRound(origSize.width * factor), cvRound(origSize.height * factor));
+				if(winSize.width < minWidth || winSize.height < minHeight) {
+					continue;
+				}
+				double ystep = MAX(2., factor);
+				double cost = ((region.width - winSize.width) / ystep + 1) * ((region.height - winSize.height) / ystep + 1);
+				sizes.push_back(winSize);
+				costs.push_back(cost);
+				totalCost += cost;
+			}
+			if(sizes.empty()) {
+				continue;
+			}
+
+			ScaleBand band;
+			band.region = region;
+			band.minSize = sizes[0];
+			double bandCost = 0;
+			for(size_t j = 0; j < sizes.size(); j++) {
+				bandCost += costs[j];
+				bool last = j + 1 == sizes.size();
+				// bands can only be split between different window sizes
+				bool canSplit = !last && (sizes[j + 1].width > sizes[j].width || sizes[j + 1].height > sizes[j].height);
+				if(last || (canSplit && bandCost >= totalCost / numBands)) {
+					band.maxSize = sizes[j];
+					bands.push_back(band);
+					if(!last) {
+						band.minSize = sizes[j + 1];
+						bandCost = 0;
+					}
+				}
+			}
 		}
 
-		// sort the pointers based on size
-		if( blobs.size() > 1 ) {
-			sort( blobs.begin(), blobs.end(), sort_carea_compare );
+#ifdef OF_USING_THREAD_POOL
+		if(bParallel) {
+			vector< vector<cv::Rect> > bandRects(bands.size());
+			ofParallelFor(0, bands.size(), [&](size_t i){
+				detect(bands[i], bandRects[i]);
+			}, 1);
+			for(size_t i = 0; i < bandRects.size(); i++) {
+				rects.insert(rects.end(), bandRects[i].begin(), bandRects[i].end());
+			}
+		} else
+#endif
+		{
+			for(size_t i = 0; i < bands.size(); i++) {
+				detect(bands[i], rects);
+			}
 		}
 
-		cvReleaseMemStorage(&storage);
+		// the same grouping cvHaarDetectObjects does
+		if(neighbors != 0) {
+			cv::groupRectangles(rects, neighbors, 0.2);
+		}
+	}
+
+	for (size_t i = 0; i < rects.size(); i++ ) {
+		const cv::Rect& r = rects[i];
+		ofxCvBlob blob;
+
+		float area = r.width * r.height;
+		float length = (r.width * 2) + (r.height * 2);
+
+		blob.area = fabs(area);
+		blob.hole = area < 0 ? true : false;
+		blob.length	= length;
+		blob.boundingRect.x = r.x;
+		blob.boundingRect.y = r.y;
+		blob.boundingRect.width = r.width;
+		blob.boundingRect.height = r.height;
+		blob.centroid.x = r.x + r.width / 2.0;
+		blob.centroid.y = r.y + r.height / 2.0;
+		blob.pts.push_back(ofPoint(r.x, r.y));
+		blob.pts.push_back(ofPoint(r.x + r.width, r.y));
+		blob.pts.push_back(ofPoint(r.x + r.width, r.y + r.height));
+		blob.pts.push_back(ofPoint(r.x, r.y + r.height));
+		blob.nPts = blob.pts.size();
+
+		blobs.push_back(blob);
+	}
+
+	// sort the pointers based on size
+	if( blobs.size() > 1 ) {
+		sort( blobs.begin(), blobs.end(), sort_carea_compare );
 	}
 
-	return nHaarResults;
+	return blobs.size();
 }
@@ -40,15 +40,62 @@ public:
 
 	int findHaarObjects(ofPixels& input, int minWidth = 0, int minHeight = 0);
 
+	// Only looks for objects where the mask is not black and around the objects
+	// found in the previous frames. Useful with the difference between frames or
+	// a background subtraction mask, see setUseTemporalRoi.
+	int findHaarObjects(const ofxCvGrayscaleImage& input, const ofxCvGrayscaleImage& motionMask, int minWidth = 0, int minHeight = 0);
+
+	// Splits the scales the detector is run at in bands that run in parallel in
+	// the global thread pool, each with its own copy of the cascade. The detected
+	// objects are the same as when running in one thread. Needs c++11, otherwise
+	// the bands run one after another. Default is false.
+	void setParallel(bool parallel);
+	bool isParallel() const;
+
+	// Instead of scanning the whole frame every time, only looks around the
+	// objects found in the previous frame, enlarged by the margin as a fraction
+	// of their size. The whole frame is scanned every fullScanInterval frames or
+	// when nothing was found in the previous frame. Default is false.
+	void setUseTemporalRoi(bool useTemporalRoi, int fullScanInterval = 10, float margin = 0.5);
+	bool isUsingTemporalRoi() const;
+
 	float getWidth();
 	float getHeight();
 	
 	void draw(float x, float y);
 
 protected:
+	// equalizes the region of the input to search in img
+	bool prepareImage(const IplImage* input, int x, int y, int w, int h);
+	// runs the detector in img over the passed regions
+	int detect(const vector<ofRectangle>& regions, int x, int y, int w, int h, int minWidth, int minHeight);
+	// a region searched at the scales between minSize and maxSize
+	typedef struct {
+		ofRectangle region;
+		CvSize minSize;
+		CvSize maxSize;
+	} ScaleBand;
+	void detect(const ScaleBand& band, vector<cv::Rect>& results);
+	vector<ofRectangle> getTemporalRegions(int x, int y, int w, int h, const ofxCvGrayscaleImage* motionMask);
+
+	// copies of the cascade for the parallel bands, opencv
+	// keeps per image state in the cascade while detecting
+	CvHaarClassifierCascade* getCascadeCopy();
+	void releaseCascadeCopy(CvHaarClassifierCascade* copy);
+	void clearCascadeCopies();
+
 	CvHaarClassifierCascade* cascade;
 	string haarFile;
 	ofxCvGrayscaleImage img;
 	float scaleHaar;
 	unsigned neighbors;
+
+	bool bParallel;
+	vector<CvHaarClassifierCascade*> cascadeCopies;
+	ofMutex cascadeMutex;
+
+	bool bTemporalRoi;
+	int fullScanInterval;
+	float roiMargin;
+	int framesSinceFullScan;
 };
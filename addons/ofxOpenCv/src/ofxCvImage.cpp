@@ -18,6 +18,7 @@ ofxCvImage::ofxCvImage() {
 	bAllocated		= false;
     bPixelsDirty    = true;
     bRoiPixelsDirty = true;
+    bExternalPixels = false;
 }
 
 //--------------------------------------------------------------------------------
@@ -37,8 +38,8 @@ void ofxCvImage::allocate( int w, int h ) {
 		return;
 	}
 
-	cvImage = cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
-	cvImageTemp	= cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
+	cvImage = createImage( w, h );
+	cvImageTemp	= createImage( w, h );
 
 	width = w;
 	height = h;
@@ -55,9 +56,14 @@ void ofxCvImage::clear() {
 
 	if (bAllocated == true){
 		if (width > 0 && height > 0){
-			cvReleaseImage( &cvImage );
+			if( bExternalPixels ){
+				cvReleaseImageHeader( &cvImage );
+			}else{
+				cvReleaseImage( &cvImage );
+			}
 			cvReleaseImage( &cvImageTemp );
 		}
+        bExternalPixels = false;
         pixels.clear();
         bPixelsDirty = true;
         bRoiPixelsDirty = true;
@@ -74,6 +80,63 @@ void ofxCvImage::clear() {
 	}
 }
 
+//--------------------------------------------------------------------------------
+IplImage* ofxCvImage::createImage( int w, int h ) {
+    // opencv aligns rows to 4 bytes by default, without padding
+    // getPixels() and setFromPixels() can share or copy the whole
+    // image at once instead of going row by row
+    IplImage* img = cvCreateImageHeader( cvSize(w,h), ipldepth, iplchannels );
+    img->widthStep = w * iplchannels * (ipldepth & 255) / 8;
+    img->imageSize = img->widthStep * h;
+    cvCreateData( img );
+    return img;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvImage::setFromExternalPixels( ofPixels & pixels ) {
+	if( ipldepth != IPL_DEPTH_8U || (int)pixels.getNumChannels() != iplchannels ){
+		ofLogError("ofxCvImage") << "setFromExternalPixels(): pixels need to have "
+			<< iplchannels << " channels of 8 bits";
+		return;
+	}
+	setFromExternalPixels( pixels.getData(), pixels.getWidth(), pixels.getHeight() );
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvImage::setFromExternalPixels( void* _pixels, int w, int h, int widthStep ) {
+	if( w == 0 || h == 0 || _pixels == NULL ){
+		ofLogError("ofxCvImage") << "setFromExternalPixels(): width and height are zero or pixels are null";
+		return;
+	}
+	if( widthStep == 0 ){
+		widthStep = w * iplchannels * (ipldepth & 255) / 8;
+	}
+
+	if( bExternalPixels && w == width && h == height ){
+		// only point the header to the new data, keeps the temp image
+		cvSetData( cvImage, _pixels, widthStep );
+	}else{
+		clear();
+		cvImage = cvCreateImageHeader( cvSize(w,h), ipldepth, iplchannels );
+		cvSetData( cvImage, _pixels, widthStep );
+		// only used by the operations that can't work in place
+		cvImageTemp = createImage( w, h );
+		width = w;
+		height = h;
+		bAllocated = true;
+		bExternalPixels = true;
+		if( bUseTexture ) {
+			tex.allocate( width, height, glchannels );
+		}
+	}
+	flagImageChanged();
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvImage::isUsingExternalPixels() const {
+	return bExternalPixels;
+}
+
 //--------------------------------------------------------------------------------
 float ofxCvImage::getWidth() const{
 	return width;
@@ -244,8 +307,7 @@ void ofxCvImage::operator -= ( float value ) {
 		ofLogError("ofxCvImage") << "operator-=: image not allocated";
 		return;		
 	}
-	cvSubS( cvImage, cvScalar(value), cvImageTemp );
-	swapTemp();
+	cvSubS( cvImage, cvScalar(value), cvImage );
     flagImageChanged();
 }
 
@@ -255,8 +317,7 @@ void ofxCvImage::operator += ( float value ) {
 		ofLogError("ofxCvImage") << "operator-=: image not allocated";
 		return;		
 	}
-	cvAddS( cvImage, cvScalar(value), cvImageTemp );
-	swapTemp();
+	cvAddS( cvImage, cvScalar(value), cvImage );
     flagImageChanged();
 }
 
@@ -277,8 +338,7 @@ void ofxCvImage::operator -= ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvSub( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cvSub( cvImage, mom.getCvImage(), cvImage );
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator-=: region of interest mismatch";
@@ -304,8 +364,7 @@ void ofxCvImage::operator += ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvAdd( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cvAdd( cvImage, mom.getCvImage(), cvImage );
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator+=: region of interest mismatch";
@@ -332,8 +391,7 @@ void ofxCvImage::operator *= ( ofxCvImage& mom ) {
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
             float scalef = 1.0f / 255.0f;
-            cvMul( cvImage, mom.getCvImage(), cvImageTemp, scalef );
-            swapTemp();
+            cvMul( cvImage, mom.getCvImage(), cvImage, scalef );
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator*=: region of interest mismatch";
@@ -359,8 +417,7 @@ void ofxCvImage::operator &= ( ofxCvImage& mom ) {
         mom.getCvImage()->depth == cvImage->depth )
     {
         if( matchingROI(getROI(), mom.getROI()) ) {
-            cvAnd( cvImage, mom.getCvImage(), cvImageTemp );
-            swapTemp();
+            cvAnd( cvImage, mom.getCvImage(), cvImage );
             flagImageChanged();
         } else {
             ofLogError("ofxCvImage") << "operator&=: region of interest mismatch";
@@ -539,8 +596,7 @@ void ofxCvImage::dilate() {
 		ofLogError("ofxCvImage") << "dilate(): image not allocated";
 		return;		
 	}
-	cvDilate( cvImage, cvImageTemp, 0, 1 );
-	swapTemp();
+	cvDilate( cvImage, cvImage, 0, 1 );
     flagImageChanged();
 }
 
@@ -550,8 +606,7 @@ void ofxCvImage::erode() {
 		ofLogError("ofxCvImage") << "erode(): image not allocated";
 		return;		
 	}
-	cvErode( cvImage, cvImageTemp, 0, 1 );
-	swapTemp();
+	cvErode( cvImage, cvImage, 0, 1 );
     flagImageChanged();
 }
 
@@ -831,6 +886,9 @@ void ofxCvImage::swapTemp() {
 		getROI().height != height )
     {
 		cvCopy( cvImageTemp, cvImage );
+	} else if( bExternalPixels ) {
+		// the header has to keep pointing to the external data
+		cvCopy( cvImageTemp, cvImage );
 	} else {
 		IplImage*  temp;
 		temp = cvImage;
@@ -874,7 +932,45 @@ void  ofxCvImage::resetImageROI( IplImage* img ) {
 
 //--------------------------------------------------------------------------------
 void ofxCvImage::setFromPixels( const ofPixels & pixels ){
-	setFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight());
+	if( ipldepth != IPL_DEPTH_8U || (int)pixels.getNumChannels() == iplchannels ){
+		setFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight());
+		return;
+	}
+
+	// different number of channels, convert straight into cvImage
+	// instead of converting the pixels first and copying them
+	int code = -1;
+	int channels = pixels.getNumChannels();
+	if( channels == 1 && iplchannels == 3 ) code = CV_GRAY2RGB;
+	else if( channels == 3 && iplchannels == 1 ) code = CV_RGB2GRAY;
+	else if( channels == 4 && iplchannels == 1 ) code = CV_RGBA2GRAY;
+	else if( channels == 4 && iplchannels == 3 ) code = CV_RGBA2RGB;
+	if( code == -1 ){
+		ofLogError("ofxCvImage") << "setFromPixels(): can't convert " << channels
+			<< " channels to " << iplchannels;
+		return;
+	}
+
+	int w = pixels.getWidth();
+	int h = pixels.getHeight();
+	if( w == 0 || h == 0 ){
+		ofLogError("ofxCvImage") << "setFromPixels(): width and height are zero";
+		return;
+	}
+	if( !bAllocated || w != width || h != height ){
+		allocate(w,h);
+	}
+
+	IplImage src;
+	cvInitImageHeader( &src, cvSize(w,h), IPL_DEPTH_8U, channels );
+	cvSetData( &src, (void*)pixels.getData(), w*channels );
+
+	// like the other setFromPixels this ignores the ROI
+	ofRectangle roi = getROI();
+	resetImageROI( cvImage );
+	cvCvtColor( &src, cvImage, code );
+	setImageROI( cvImage, roi );
+	flagImageChanged();
 }
 
 //--------------------------------------------------------------------------------
@@ -892,7 +988,7 @@ ofPixels& ofxCvImage::getPixels(){
 		//Note this possible introduces a bug where pixels doesn't contain the current image.
 		//Also it means that modifying the pointer return by get pixels - affects the internal cvImage
 		//Where as with the slower way below modifying the pointer doesn't change the image.
-		if(  cv8bit->width*cv8bit->nChannels == cvImage->widthStep ){
+		if(  cv8bit->width*cv8bit->nChannels == cv8bit->widthStep ){
 			pixels.setFromExternalPixels((unsigned char*)cv8bit->imageData,width,height,cv8bit->nChannels);
 		}else{
 			pixels.setFromAlignedPixels((unsigned char*)cv8bit->imageData,width,height,cv8bit->nChannels,cv8bit->widthStep);
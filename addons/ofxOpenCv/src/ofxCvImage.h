@@ -65,6 +65,14 @@ class ofxCvImage : public ofBaseImage {
     virtual void  setFromPixels( const ofPixels & pixels );
     virtual void  setRoiFromPixels( const unsigned char* _pixels, int w, int h ) = 0;
     virtual void  setRoiFromPixels( const ofPixels & pixels );
+
+    // wraps memory owned by someone else instead of allocating, the
+    // image works directly on that data so nothing is copied in or
+    // out. the data has to outlive the image or its next allocate()
+    // and have the same number of channels and depth as the image
+    virtual void  setFromExternalPixels( ofPixels & pixels );
+    virtual void  setFromExternalPixels( void* _pixels, int w, int h, int widthStep=0 );
+    virtual bool  isUsingExternalPixels() const;
     virtual void  operator = ( const ofxCvGrayscaleImage& mom ) = 0;
     virtual void  operator = ( const ofxCvColorImage& mom ) = 0;
     virtual void  operator = ( const ofxCvFloatImage& mom ) = 0;
@@ -161,6 +169,7 @@ class ofxCvImage : public ofBaseImage {
     virtual void  rangeMap( IplImage* img, float min1, float max1, float min2, float max2 );
     virtual void  rangeMap( IplImage* mom, IplImage* kid, float min1, float max1, float min2, float max2 );
                                      
+    IplImage*  createImage( int w, int h );  // rows without padding
     virtual void swapTemp();  // swap cvImageTemp back
                               // to cvImage after an image operation
     virtual IplImage*  getCv8BitsImage() { return cvImage; }
@@ -170,6 +179,8 @@ class ofxCvImage : public ofBaseImage {
     IplImage*  cvImageTemp;   // this is typically swapped back into cvImage
                               // after an image operation with swapImage()
                               
+    bool bExternalPixels;     // cvImage is only a header over external data
+
     int ipldepth;             // IPL_DEPTH_8U, IPL_DEPTH_16U, IPL_DEPTH_32F, ...
     int iplchannels;          // 1, 3, 4, ...
 
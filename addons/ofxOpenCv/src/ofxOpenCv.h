@@ -14,6 +14,7 @@
 
 //--------------------------
 // contours and blobs
+#include "ofxCvBlobTracker.h"
 #include "ofxCvContourFinder.h"
 
 #include "ofxCvHaarFinder.h"
@@ -239,33 +239,41 @@ bool ofxOscReceiver::getNextMessage( ofxOscMessage* message )
 bool ofxOscReceiver::getParameter(ofAbstractParameter & parameter){
 	ofxOscMessage msg;
 	if ( messages.size() == 0 ) return false;
+	string rootName = parameter.getEscapedName();
+	bool isGroup = parameter.type()==typeid(ofParameterGroup).name();
+	// a burst of messages notifies each parameter once with its last value
+	if(isGroup) static_cast<ofParameterGroup&>(parameter).beginTransaction();
 	while(hasWaitingMessages()){
-		ofAbstractParameter * p = &parameter;
-        
+		ofAbstractParameter * p = NULL;
+
         getNextMessage(&msg);
-        vector<string> address = ofSplitString(msg.getAddress(),"/",true);
-                
-        for(unsigned int i=0;i<address.size();i++){
-            
-            if(p) {
-                if(address[i]==p->getEscapedName()){
-                    if(p->type()==typeid(ofParameterGroup).name()){
-                        if(address.size()>=i+1){
-                            p = &static_cast<ofParameterGroup*>(p)->get(address[i+1]);
-                        }
-                    }else if(p->type()==typeid(ofParameter<int>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
-                        p->cast<int>() = msg.getArgAsInt32(0);
-                    }else if(p->type()==typeid(ofParameter<float>).name() && msg.getArgType(0)==OFXOSC_TYPE_FLOAT){
-                        p->cast<float>() = msg.getArgAsFloat(0);
-                    }else if(p->type()==typeid(ofParameter<bool>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
-                        p->cast<bool>() = msg.getArgAsInt32(0);
-                    }else if(msg.getArgType(0)==OFXOSC_TYPE_STRING){
-                        p->fromString(msg.getArgAsString(0));
-                    }
-                }
+
+        // the address is the name of the root parameter followed by the
+        // path of the parameter inside it, found with the group path index
+        const string & address = msg.getAddress();
+        size_t begin = address.find_first_not_of('/');
+        if(begin==string::npos) continue;
+        size_t end = address.find('/', begin);
+        if(address.compare(begin, end==string::npos ? string::npos : end-begin, rootName)!=0) continue;
+        if(end==string::npos || end==address.size()-1){
+            p = &parameter;
+        }else if(isGroup){
+            p = static_cast<ofParameterGroup&>(parameter).find(address.substr(end+1));
+        }
+
+        if(p && p->type()!=typeid(ofParameterGroup).name()){
+            if(p->type()==typeid(ofParameter<int>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+                p->cast<int>() = msg.getArgAsInt32(0);
+            }else if(p->type()==typeid(ofParameter<float>).name() && msg.getArgType(0)==OFXOSC_TYPE_FLOAT){
+                p->cast<float>() = msg.getArgAsFloat(0);
+            }else if(p->type()==typeid(ofParameter<bool>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+                p->cast<bool>() = msg.getArgAsInt32(0);
+            }else if(msg.getArgType(0)==OFXOSC_TYPE_STRING){
+                p->fromString(msg.getArgAsString(0));
             }
         }
 	}
+	if(isGroup) static_cast<ofParameterGroup&>(parameter).endTransaction();
 	return true;
 }
 
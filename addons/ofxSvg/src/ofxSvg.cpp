@@ -1,16 +1,160 @@
 #include "ofxSvg.h"
 #include "ofConstants.h"
+#include "ofThread.h"
+#include "ofThreadPool.h"
+#include "ofAppRunner.h"
 
-ofxSVG::~ofxSVG(){
-	paths.clear();
+static void setupShape(struct svgtiny_shape * shape, ofPath & path){
+	float * p = shape->path;
+
+	path.setFilled(false);
+
+	if(shape->fill != svgtiny_TRANSPARENT){
+		path.setFilled(true);
+		path.setFillHexColor(shape->fill);
+		path.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
+    }
+
+	if(shape->stroke != svgtiny_TRANSPARENT){
+		path.setStrokeWidth(shape->stroke_width);
+		path.setStrokeHexColor(shape->stroke);
+	}
+
+	for(int i = 0; i < (int)shape->path_length;){
+		if(p[i] == svgtiny_PATH_MOVE){
+			path.moveTo(p[i + 1], p[i + 2]);
+			i += 3;
+		}
+		else if(p[i] == svgtiny_PATH_CLOSE){
+			path.close();
+
+			i += 1;
+		}
+		else if(p[i] == svgtiny_PATH_LINE){
+			path.lineTo(p[i + 1], p[i + 2]);
+			i += 3;
+		}
+		else if(p[i] == svgtiny_PATH_BEZIER){
+			path.bezierTo(p[i + 1], p[i + 2],
+						   p[i + 3], p[i + 4],
+						   p[i + 5], p[i + 6]);
+			i += 7;
+		}
+		else{
+			ofLogError("ofxSVG") << "setupShape(): SVG parse error";
+			i += 1;
+		}
+	}
 }
 
-void ofxSVG::load(string path){
+// svg's default stroke-miterlimit, the longest miter as a ratio
+// of the stroke width, sharper joins are beveled
+static const float ofxSVGMiterLimit = 4;
+
+// adds the stroke of a polyline to mesh as a strip of quads, one
+// per segment, with miter or bevel joins and butt caps
+static void addStroke(const ofPolyline & polyline, float halfWidth, const ofFloatColor & color, ofMesh & mesh){
+	// repeated points have no direction to join
+	const vector<ofPoint> & vertices = polyline.getVertices();
+	vector<ofPoint> points;
+	for(int i = 0; i < (int)vertices.size(); i++){
+		if(points.empty() || vertices[i] != points.back()){
+			points.push_back(vertices[i]);
+		}
+	}
+	bool closed = polyline.isClosed();
+	if(closed && points.size() > 1 && points.front() == points.back()){
+		points.pop_back();
+	}
+	if(points.size() < 2){
+		return;
+	}
+
+	// the normal of each segment, the last one goes from the last
+	// point back to the first and is only used if the polyline is closed
+	int numPoints = points.size();
+	vector<ofPoint> normals(numPoints);
+	for(int i = 0; i < numPoints; i++){
+		ofPoint direction = (points[(i + 1) % numPoints] - points[i]).getNormalized();
+		normals[i].set(-direction.y, direction.x);
+	}
+
+	// each point adds a pair of vertices, one on each side of the
+	// line, or two pairs for a bevel. consecutive pairs make a quad
+	ofIndexType first = mesh.getNumVertices();
+	for(int i = 0; i < numPoints; i++){
+		const ofPoint & in = (closed || i > 0) ? normals[(i + numPoints - 1) % numPoints] : normals[i];
+		const ofPoint & out = (closed || i < numPoints - 1) ? normals[i] : in;
+		ofPoint miter = in + out;
+		float length = miter.length();
+		float cosine = length > 0 ? miter.dot(out) / length : 0;
+		if(cosine * ofxSVGMiterLimit >= 1){
+			miter *= halfWidth / (length * cosine);
+			mesh.addVertex(points[i] + miter);
+			mesh.addVertex(points[i] - miter);
+		}else{
+			mesh.addVertex(points[i] + in * halfWidth);
+			mesh.addVertex(points[i] - in * halfWidth);
+			mesh.addVertex(points[i] + out * halfWidth);
+			mesh.addVertex(points[i] - out * halfWidth);
+		}
+	}
+	ofIndexType last = mesh.getNumVertices() - 2;
+	for(ofIndexType i = first; i < last; i += 2){
+		mesh.addTriangle(i, i + 1, i + 3);
+		mesh.addTriangle(i, i + 3, i + 2);
+	}
+	if(closed){
+		mesh.addTriangle(last, last + 1, first + 1);
+		mesh.addTriangle(last, first + 1, first);
+	}
+	mesh.getColors().resize(mesh.getNumVertices(), color);
+}
+
+// adds the fill and the stroke of a path to mesh as colored triangles
+static void flattenPath(ofPath & path, ofMesh & mesh){
+	mesh.clear();
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+
+	if(path.isFilled()){
+		const ofMesh & fill = path.getTessellation();
+		mesh.addVertices(fill.getVertices());
+		mesh.addIndices(fill.getIndices());
+		mesh.getColors().resize(mesh.getNumVertices(), path.getFillColor());
+	}
+
+	if(path.hasOutline()){
+		const vector<ofPolyline> & outlines = path.getOutline();
+		for(int i = 0; i < (int)outlines.size(); i++){
+			addStroke(outlines[i], path.getStrokeWidth() * 0.5, path.getStrokeColor(), mesh);
+		}
+	}
+}
+
+// converts each shape into a path and flattens it, used with ofParallelFor
+class ofxSVGConvertShape{
+public:
+	ofxSVGConvertShape(svgtiny_shape ** shapes, ofPath * paths, ofMesh * meshes)
+	:shapes(shapes)
+	,paths(paths)
+	,meshes(meshes){}
+
+	void operator()(size_t i) const{
+		setupShape(shapes[i], paths[i]);
+		flattenPath(paths[i], meshes[i]);
+	}
+
+	svgtiny_shape ** shapes;
+	ofPath * paths;
+	ofMesh * meshes;
+};
+
+static bool loadDiagram(string path, float & width, float & height, vector<ofPath> & paths, vector<ofVboMesh> & meshes){
 	path = ofToDataPath(path);
 
 	if(path.compare("") == 0){
 		ofLogError("ofxSVG") << "load(): path does not exist: \"" << path << "\"";
-		return;
+		return false;
 	}
 
 	ofBuffer buffer = ofBufferFromFile(path);
@@ -45,74 +189,137 @@ void ofxSVG::load(string path){
 		ofLogError("ofxSVG") << "load(): couldn't parse \"" << path << "\": " << msg;
 	}
 
-	setupDiagram(diagram);
+	width = diagram->width;
+	height = diagram->height;
 
+	vector<svgtiny_shape*> shapes;
+	for(int i = 0; i < (int)diagram->shape_count; i++){
+		if(diagram->shape[i].path){
+			shapes.push_back(&diagram->shape[i]);
+		}else if(diagram->shape[i].text){
+			ofLogWarning("ofxSVG") << "load(): text: not implemented yet";
+		}
+	}
+
+	paths.clear();
+	paths.resize(shapes.size());
+	vector<ofMesh> pathMeshes(shapes.size());
+	if(!shapes.empty()){
+		ofParallelFor(0, shapes.size(), ofxSVGConvertShape(&shapes[0], &paths[0], &pathMeshes[0]));
+	}
 	svgtiny_free(diagram);
-}
 
-void ofxSVG::draw(){
-	for(int i = 0; i < (int)paths.size(); i++){
-		paths[i].draw();
+	// the meshes of all the paths in drawing order, a mesh only
+	// holds as many vertices as its indices can address
+	size_t maxVertices = numeric_limits<ofIndexType>::max();
+	meshes.clear();
+	for(size_t i = 0; i < pathMeshes.size(); i++){
+		if(meshes.empty() || size_t(meshes.back().getNumVertices() + pathMeshes[i].getNumVertices()) > maxVertices){
+			meshes.push_back(ofVboMesh());
+			meshes.back().setMode(OF_PRIMITIVE_TRIANGLES);
+		}
+		meshes.back().append(pathMeshes[i]);
 	}
+
+	return code == svgtiny_OK;
 }
 
+//----------------------------------------
+// loads a file in its own thread for ofxSVG::loadAsync, the results
+// are moved to the ofxSVG from the main thread once it finishes
+class ofxSVGLoader: public ofThread{
+public:
+	ofxSVGLoader(string path)
+	:path(path)
+	,width(0)
+	,height(0){}
 
-void ofxSVG::setupDiagram(struct svgtiny_diagram * diagram){
+	void threadedFunction(){
+		loadDiagram(path, width, height, paths, meshes);
+	}
 
-	width = diagram->width;
-	height = diagram->height;
+	string path;
+	float width, height;
+	vector<ofPath> paths;
+	vector<ofVboMesh> meshes;
+};
 
+ofxSVG::ofxSVG()
+:width(0)
+,height(0)
+,bLoaded(false){
+}
+
+ofxSVG::~ofxSVG(){
+	if(loader){
+		ofRemoveListener(ofEvents().update, this, &ofxSVG::update);
+		loader->waitForThread(false);
+	}
 	paths.clear();
+}
 
-	for(int i = 0; i < (int)diagram->shape_count; i++){
-		if(diagram->shape[i].path){
-			paths.push_back(ofPath());
-			setupShape(&diagram->shape[i],paths.back());
-		}else if(diagram->shape[i].text){
-			ofLogWarning("ofxSVG") << "setupDiagram(): text: not implemented yet";
-		}
+void ofxSVG::load(string path){
+	if(loader){
+		// a file loading asynchronously would replace this one
+		ofRemoveListener(ofEvents().update, this, &ofxSVG::update);
+		loader->waitForThread(false);
+		loader.reset();
 	}
+	loadDiagram(path, width, height, paths, meshes);
+	bLoaded = true;
 }
 
-void ofxSVG::setupShape(struct svgtiny_shape * shape, ofPath & path){
-	float * p = shape->path;
+void ofxSVG::loadAsync(string path){
+	if(loader){
+		// the file that was still loading is discarded
+		loader->waitForThread(false);
+	}else{
+		ofAddListener(ofEvents().update, this, &ofxSVG::update);
+	}
+	loader = shared_ptr<ofxSVGLoader>(new ofxSVGLoader(path));
+	loader->startThread();
+}
 
-	path.setFilled(false);
+void ofxSVG::update(ofEventArgs & args){
+	if(!loader || loader->isThreadRunning()){
+		return;
+	}
+	width = loader->width;
+	height = loader->height;
+	swap(paths, loader->paths);
+	swap(meshes, loader->meshes);
+	loader.reset();
+	bLoaded = true;
+	ofRemoveListener(ofEvents().update, this, &ofxSVG::update);
+}
 
-	if(shape->fill != svgtiny_TRANSPARENT){
-		path.setFilled(true);
-		path.setFillHexColor(shape->fill);
-		path.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
-    }
+bool ofxSVG::isLoaded() const{
+	return bLoaded && !loader;
+}
 
-	if(shape->stroke != svgtiny_TRANSPARENT){
-		path.setStrokeWidth(shape->stroke_width);
-		path.setStrokeHexColor(shape->stroke);
-	}
+bool ofxSVG::isLoading() const{
+	return loader.get() != NULL;
+}
 
-	for(int i = 0; i < (int)shape->path_length;){
-		if(p[i] == svgtiny_PATH_MOVE){
-			path.moveTo(p[i + 1], p[i + 2]);
-			i += 3;
-		}
-		else if(p[i] == svgtiny_PATH_CLOSE){
-			path.close();
+void ofxSVG::draw(){
+	for(int i = 0; i < (int)paths.size(); i++){
+		paths[i].draw();
+	}
+}
 
-			i += 1;
-		}
-		else if(p[i] == svgtiny_PATH_LINE){
-			path.lineTo(p[i + 1], p[i + 2]);
-			i += 3;
-		}
-		else if(p[i] == svgtiny_PATH_BEZIER){
-			path.bezierTo(p[i + 1], p[i + 2],
-						   p[i + 3], p[i + 4],
-						   p[i + 5], p[i + 6]);
-			i += 7;
-		}
-		else{
-			ofLogError("ofxSVG") << "setupShape(): SVG parse error";
-			i += 1;
-		}
+void ofxSVG::drawMeshes(){
+	// other renderers, like cairo when saving a pdf, draw each triangle
+	// on its own so the paths look better and are faster there
+	string renderer = ofGetCurrentRenderer()->getType();
+	if(renderer != "GL" && renderer != "ProgrammableGL"){
+		draw();
+		return;
+	}
+	for(int i = 0; i < (int)meshes.size(); i++){
+		meshes[i].draw();
 	}
 }
+
+const vector<ofVboMesh> & ofxSVG::getMeshes() const{
+	return meshes;
+}
@@ -4,10 +4,15 @@
 #include "svgtiny.h"
 #include "ofPath.h"
 #include "ofTypes.h"
+#include "ofVboMesh.h"
+#include "ofEvents.h"
 
-class ofxSVG {
-	public: ~ofxSVG();
+class ofxSVGLoader;
 
+class ofxSVG {
+	public:
+		ofxSVG();
+		~ofxSVG();
 
 		float getWidth() const {
 			return width;
@@ -16,8 +21,40 @@ class ofxSVG {
 			return height;
 		}
 		void load(string path);
+
+		/// \brief Loads the file in a background thread.
+		///
+		/// The file is parsed in a thread and its shapes are converted,
+		/// flattened and tessellated in parallel, so drawing it later doesn't
+		/// need to tessellate anything. The result replaces the contents of
+		/// this ofxSVG in the first update after it's ready, until then
+		/// isLoaded() returns false and draw() keeps drawing what was loaded
+		/// before, if anything.
+		///
+		/// The ofxSVG shouldn't be copied while it's loading.
+		void loadAsync(string path);
+
+		/// \returns true if a file has been loaded and there's no
+		/// asynchronous load still running.
+		bool isLoaded() const;
+
+		/// \returns true while loadAsync() is still running.
+		bool isLoading() const;
+
+		/// \brief Draws every path with its own fill and stroke.
+		///
+		/// The paths are tessellated when the file is loaded so drawing
+		/// them doesn't need to tessellate anything.
 		void draw();
 
+		/// \brief Draws the whole file with one draw call per mesh in getMeshes().
+		///
+		/// Much faster than draw() for files with many paths but the strokes
+		/// are triangles, see getMeshes(). Changes to the paths returned by
+		/// getPathAt() aren't drawn. Renderers other than the GL ones, like
+		/// cairo, draw the paths as draw() does.
+		void drawMeshes();
+
 		int getNumPath(){
 			return paths.size();
 		}
@@ -25,13 +62,26 @@ class ofxSVG {
 			return paths[n];
 		}
 
+		/// \brief Get the fills and strokes of every path as colored triangles.
+		///
+		/// The paths are added in the order they are drawn, so the meshes can
+		/// be drawn with a single call each. Strokes are triangulated with
+		/// miter joins, or bevels for sharp ones, and the path's stroke width
+		/// in the units of the file so, unlike drawing the paths, they scale
+		/// with the drawing. A translucent stroke that crosses itself is
+		/// blended twice where it overlaps.
+		///
+		/// There's usually only one mesh, a new one is started only if the
+		/// vertices don't fit in ofIndexType, eg. on OpenGL ES.
+		const vector<ofVboMesh> & getMeshes() const;
+
 	private:
+		void update(ofEventArgs & args);
 
 		float width, height;
 
 		vector <ofPath> paths;
-
-		void setupDiagram(struct svgtiny_diagram * diagram);
-		void setupShape(struct svgtiny_shape * shape, ofPath & path);
-
+		vector <ofVboMesh> meshes;
+		shared_ptr<ofxSVGLoader> loader;
+		bool bLoaded;
 };
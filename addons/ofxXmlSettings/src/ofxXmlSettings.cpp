@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include "ofThreadPool.h"
 
 // this increases the accuracy of ofToString() when saving floating point values
 // but in the process of setting it also causes very small values to be ignored.
@@ -30,9 +31,78 @@ static vector<string> tokenize(const string & str, const string & delim)
 }
 //----------------------------------------
 
+//----------------------------------------
+// converts the text of each tag to a value, used with ofParallelFor
+static void readValue(const TiXmlText * text, int & value){
+	value = ofToInt(text->Value());
+}
+
+static void readValue(const TiXmlText * text, double & value){
+	value = ofToFloat(text->Value());
+}
+
+static void readValue(const TiXmlText * text, string & value){
+	value = text->ValueStr();
+}
+
+template<typename T>
+class ofxXmlSettingsReadValues{
+public:
+	ofxXmlSettingsReadValues(const vector<TiXmlElement*> & elements, vector<T> & values)
+	:elements(elements)
+	,values(values){}
+
+	void operator()(size_t i){
+		if(elements[i] && elements[i]->FirstChild() && elements[i]->FirstChild()->ToText()){
+			readValue(elements[i]->FirstChild()->ToText(), values[i]);
+		}
+	}
+
+	const vector<TiXmlElement*> & elements;
+	vector<T> & values;
+};
+
+//----------------------------------------
+// reads an attribute of each tag, used with ofParallelFor
+static void readAttribute(const TiXmlElement * element, const string & attribute, int & value){
+	element->QueryIntAttribute(attribute, &value);
+}
+
+static void readAttribute(const TiXmlElement * element, const string & attribute, double & value){
+	element->QueryDoubleAttribute(attribute, &value);
+}
+
+static void readAttribute(const TiXmlElement * element, const string & attribute, string & value){
+	const string * attributeValue = element->Attribute(attribute);
+	if(attributeValue){
+		value = *attributeValue;
+	}
+}
+
+template<typename T>
+class ofxXmlSettingsReadAttributes{
+public:
+	ofxXmlSettingsReadAttributes(const vector<TiXmlElement*> & elements, const string & attribute, vector<T> & values)
+	:elements(elements)
+	,attribute(attribute)
+	,values(values){}
+
+	void operator()(size_t i){
+		if(elements[i]){
+			readAttribute(elements[i], attribute, values[i]);
+		}
+	}
+
+	const vector<TiXmlElement*> & elements;
+	const string & attribute;
+	vector<T> & values;
+};
+//----------------------------------------
+
 //----------------------------------------
 ofxXmlSettings::ofxXmlSettings():
-    storedHandle(NULL)
+    storedHandle(NULL),
+    bIndexEnabled(true)
 {
 	level			= 0;
 	//we do this so that we have a valid handle
@@ -42,7 +112,8 @@ ofxXmlSettings::ofxXmlSettings():
 
 //----------------------------------------
 ofxXmlSettings::ofxXmlSettings(const string& xmlFile):
-    storedHandle(NULL)
+    storedHandle(NULL),
+    bIndexEnabled(true)
 {
 	level			= 0;
 	//we do this so that we have a valid handle
@@ -68,6 +139,7 @@ void ofxXmlSettings::clear(){
 	//be all the tags inside of the pushed
 	//node - including the node itself!
 
+	removeFromIndex(storedHandle.ToNode());
 	storedHandle.ToNode()->Clear();
 }
 
@@ -76,6 +148,7 @@ bool ofxXmlSettings::loadFile(const string& xmlFile){
 
 	string fullXmlFile = ofToDataPath(xmlFile);
 
+	index.nodes.clear();
 	bool loadOkay = doc.LoadFile(fullXmlFile);
 
 	//theo removed bool check as it would
@@ -138,13 +211,21 @@ void ofxXmlSettings::removeTag(const string& tag, int which){
 		//with same name at root level
 		if(x > 0) which = 0;
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle( getChildElement(tagHandle.ToNode(), tokens.at(x), which) );
 
 		if ( !isRealHandle.ToNode() ) break;
 		else{
 			if (x == (int)tokens.size()-1){
 				//if we are at the last tag and it exists
 				//we use its parent to remove it - haha
+				if(bIndexEnabled){
+					removeFromIndex(isRealHandle.ToNode());
+					map<TiXmlNode*, ofxXmlSettingsIndex::Children>::iterator node = index.nodes.find(tagHandle.ToNode());
+					if(node != index.nodes.end()){
+						ofxXmlSettingsIndex::Elements & siblings = node->second[tokens.at(x)];
+						siblings.erase(siblings.begin() + which);
+					}
+				}
 				tagHandle.ToNode()->RemoveChild( isRealHandle.ToNode() );
 			}
 			tagHandle = isRealHandle;
@@ -186,8 +267,8 @@ bool ofxXmlSettings::readTag(const string&  tag, TiXmlHandle& valHandle, int whi
 
 	TiXmlHandle tagHandle = storedHandle;
 	for(int x=0;x<(int)tokens.size();x++){
-		if(x == 0)tagHandle = tagHandle.ChildElement(tokens.at(x), which);
-		else tagHandle = tagHandle.FirstChildElement( tokens.at(x) );
+		if(x == 0)tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
+		else tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	// once we've walked, let's get that value...
@@ -205,7 +286,7 @@ bool ofxXmlSettings::pushTag(const string&  tag, int which){
     string tagToFind((pos > 0) ? tag.substr(0,pos) :tag);
 
 	//we only allow to push one tag at a time.
-	TiXmlHandle isRealHandle = storedHandle.ChildElement(tagToFind, which);
+	TiXmlHandle isRealHandle( getChildElement(storedHandle.ToNode(), tagToFind, which) );
 
 	if( isRealHandle.ToNode() ){
 		storedHandle = isRealHandle;
@@ -257,7 +338,7 @@ bool ofxXmlSettings::tagExists(const string& tag, int which){
 		//with same name at root level
 		if(x > 0) which = 0;
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle( getChildElement(tagHandle.ToNode(), tokens.at(x), which) );
 
 		//as soon as we find a tag that doesn't exist
 		//we return false;
@@ -288,6 +369,10 @@ int ofxXmlSettings::getNumTags(const string&  tag){
 	//normally this is the doc but could be a pushed node
 	//TiXmlHandle tagHandle = storedHandle;
 
+	if(bIndexEnabled){
+		return getChildElements(storedHandle.ToNode(), tagToFind).size();
+	}
+
 	int count = 0;
 
 	//ripped from tinyXML as doing this ourselves once is a LOT! faster
@@ -303,6 +388,124 @@ int ofxXmlSettings::getNumTags(const string&  tag){
 
 
 
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<int>& values, int defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadValues<int>(elements, values), 1024);
+	return values.size();
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<double>& values, double defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadValues<double>(elements, values), 1024);
+	return values.size();
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<string>& values, const string& defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadValues<string>(elements, values), 1024);
+	return values.size();
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::getElements(const string& tag, vector<TiXmlElement*>& elements){
+
+	vector<string> tokens = tokenize(tag,":");
+	elements.clear();
+	if(tokens.empty()) return;
+
+	//all the tags with that name at the current level
+	if(bIndexEnabled){
+		const ofxXmlSettingsIndex::Elements & children = getChildElements(storedHandle.ToNode(), tokens.at(0));
+		elements.assign(children.begin(), children.end());
+	}else{
+		TiXmlElement* child = ( storedHandle.FirstChildElement( tokens.at(0) ) ).ToElement();
+		for (; child; child = child->NextSiblingElement( tokens.at(0) )){
+			elements.push_back(child);
+		}
+	}
+
+	//and the first tag of the rest of the path inside each of them,
+	//those are only read once so they are not indexed
+	for(int x=1;x<(int)tokens.size();x++){
+		for(int i=0;i<(int)elements.size();i++){
+			if(elements[i]) elements[i] = elements[i]->FirstChildElement( tokens.at(x) );
+		}
+	}
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::setIndexEnabled(bool enabled){
+	bIndexEnabled = enabled;
+	index.nodes.clear();
+}
+
+//---------------------------------------------------------
+bool ofxXmlSettings::isIndexEnabled() const{
+	return bIndexEnabled;
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::clearIndex(){
+	index.nodes.clear();
+}
+
+//---------------------------------------------------------
+TiXmlElement* ofxXmlSettings::getChildElement(TiXmlNode* parent, const string& tag, int which){
+	if(!parent) return NULL;
+	if(which < 0) which = 0;
+
+	if(!bIndexEnabled){
+		return TiXmlHandle(parent).ChildElement(tag, which).ToElement();
+	}
+
+	const ofxXmlSettingsIndex::Elements & children = getChildElements(parent, tag);
+	if(which < (int)children.size()){
+		return children[which];
+	}
+	return NULL;
+}
+
+//---------------------------------------------------------
+const ofxXmlSettingsIndex::Elements& ofxXmlSettings::getChildElements(TiXmlNode* parent, const string& tag){
+	static const ofxXmlSettingsIndex::Elements empty;
+	if(!parent) return empty;
+
+	map<TiXmlNode*, ofxXmlSettingsIndex::Children>::iterator node = index.nodes.find(parent);
+	if(node == index.nodes.end()){
+		//first time we look for a child of this tag, index all of them
+		node = index.nodes.insert(make_pair(parent, ofxXmlSettingsIndex::Children())).first;
+		for(TiXmlElement* child = parent->FirstChildElement(); child; child = child->NextSiblingElement()){
+			node->second[child->ValueStr()].push_back(child);
+		}
+	}
+
+	ofxXmlSettingsIndex::Children::iterator children = node->second.find(tag);
+	if(children == node->second.end()){
+		return empty;
+	}
+	return children->second;
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::removeFromIndex(TiXmlNode* node){
+	//the node is about to be deleted or cleared, so are all the
+	//tags inside it which could have been indexed too
+	if(index.nodes.empty() || !node) return;
+	index.nodes.erase(node);
+	for(TiXmlElement* child = node->FirstChildElement(); child; child = child->NextSiblingElement()){
+		removeFromIndex(child);
+	}
+}
+
 //---------------------------------------------------------
 int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int which){
 
@@ -333,7 +536,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			addNewTag = false;
 		}
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle( getChildElement(tagHandle.ToNode(), tokens.at(x), which) );
 
 		if ( !isRealHandle.ToNode() ||  addNewTag){
 
@@ -345,7 +548,15 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 				}
 			}
 
-			tagHandle.ToNode()->InsertEndChild(elements[x]);
+			TiXmlNode* inserted = tagHandle.ToNode()->InsertEndChild(elements[x]);
+
+			//if the siblings are already indexed add it at the end
+			if(bIndexEnabled && inserted){
+				map<TiXmlNode*, ofxXmlSettingsIndex::Children>::iterator node = index.nodes.find(tagHandle.ToNode());
+				if(node != index.nodes.end()){
+					node->second[tokens.at(x)].push_back(inserted->ToElement());
+				}
+			}
 
 			break;
 
@@ -353,6 +564,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			 tagHandle = isRealHandle;
 			 if (x == (int)tokens.size()-1){
 				// what we want to change : TiXmlHandle valHandle = tagHandle.Child( 0 );
+				removeFromIndex(tagHandle.ToNode());
 				tagHandle.ToNode()->Clear();
 				tagHandle.ToNode()->InsertEndChild(Value);
 			}
@@ -361,16 +573,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 
 
 	//lets count how many tags with our name exist so we can return an index
-
-	//ripped from tinyXML as doing this ourselves once is a LOT! faster
-	//than having this called n number of times in a while loop - we go from n*n iterations to n iterations
-	int numSameTags;
-	TiXmlElement* child = ( storedHandle.FirstChildElement( tokens.at(0) ) ).ToElement();
-	for (numSameTags = 0; child; child = child->NextSiblingElement( tokens.at(0) ), ++numSameTags){
-		//nothing
-	}
-
-	return numSameTags;
+	return getNumTags(tokens.at(0));
 }
 
 //---------------------------------------------------------
@@ -509,9 +712,9 @@ void ofxXmlSettings::removeAttribute(const string& tag, const string& attribute,
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	if (tagHandle.ToElement()) {
@@ -534,9 +737,9 @@ int ofxXmlSettings::getNumAttributes(const string& tag, int which){
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	if (tagHandle.ToElement()) {
@@ -560,9 +763,9 @@ bool ofxXmlSettings::attributeExists(const string& tag, const string& attribute,
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	if (tagHandle.ToElement()) {
@@ -583,9 +786,9 @@ bool ofxXmlSettings::getAttributeNames(const string& tag, vector<string>& outNam
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	if (tagHandle.ToElement()) {
@@ -619,6 +822,33 @@ string ofxXmlSettings::getAttribute(const string& tag, const string& attribute,
 	return value;
 }
 
+//---------------------------------------------------------
+int ofxXmlSettings::getAttributes(const string& tag, const string& attribute, vector<int>& values, int defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadAttributes<int>(elements, attribute, values), 1024);
+	return values.size();
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getAttributes(const string& tag, const string& attribute, vector<double>& values, double defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadAttributes<double>(elements, attribute, values), 1024);
+	return values.size();
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getAttributes(const string& tag, const string& attribute, vector<string>& values, const string& defaultValue){
+	vector<TiXmlElement*> elements;
+	getElements(tag, elements);
+	values.assign(elements.size(), defaultValue);
+	ofParallelFor(0, elements.size(), ofxXmlSettingsReadAttributes<string>(elements, attribute, values), 1024);
+	return values.size();
+}
+
 //---------------------------------------------------------
 int ofxXmlSettings::setAttribute(const string& tag, const string& attribute, int value, int which){
 	char valueStr[255];
@@ -647,9 +877,9 @@ TiXmlElement* ofxXmlSettings::getElementForAttribute(const string& tag, int whic
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
     return tagHandle.ToElement();
 }
@@ -694,9 +924,9 @@ int ofxXmlSettings::writeAttribute(const string& tag, const string& attribute, c
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), which);
 		else
-			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
+			tagHandle = getChildElement(tagHandle.ToNode(), tokens.at(x), 0);
 	}
 
 	int ret = 0;
@@ -706,12 +936,7 @@ int ofxXmlSettings::writeAttribute(const string& tag, const string& attribute, c
 
         // Do we really need this?  We could just ignore this and remove the 'addAttribute' functions...
 		// Now, just get the ID.
-		int numSameTags;
-		TiXmlElement* child = ( storedHandle.FirstChildElement( tokens.at(0) ) ).ToElement();
-		for (numSameTags = 0; child; child = child->NextSiblingElement( tokens.at(0) ), ++numSameTags) {
-			// nothing
-		}
-		ret = numSameTags;
+		ret = getNumTags(tokens.at(0));
 	}
 	return ret;
 }
@@ -720,6 +945,7 @@ int ofxXmlSettings::writeAttribute(const string& tag, const string& attribute, c
 bool ofxXmlSettings::loadFromBuffer( string buffer )
 {
     int size = buffer.size();
+    index.nodes.clear();
     bool loadOkay = doc.ReadFromMemory( buffer.c_str(), size);//, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING);
     storedHandle = TiXmlHandle(&doc);
     level = 0;
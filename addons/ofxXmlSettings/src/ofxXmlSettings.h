@@ -2,6 +2,8 @@
 
 #include "ofMain.h"
 #include <string.h>
+#include <deque>
+#include <map>
 #if (_MSC_VER)
 #include "../libs/tinyxml.h"
 #else
@@ -44,6 +46,22 @@ using namespace std;
 
 #define MAX_TAG_VALUE_LENGTH_IN_CHARS		1024
 
+// the child elements of each node grouped by tag name. copies start empty
+// since the pointers belong to the document they were built from
+class ofxXmlSettingsIndex{
+	public:
+		ofxXmlSettingsIndex(){}
+		ofxXmlSettingsIndex(const ofxXmlSettingsIndex &){}
+		ofxXmlSettingsIndex & operator=(const ofxXmlSettingsIndex &){
+			nodes.clear();
+			return *this;
+		}
+
+		typedef deque<TiXmlElement*> Elements;
+		typedef map<string, Elements> Children;
+		map<TiXmlNode*, Children> nodes;
+};
+
 class ofxXmlSettings: public ofBaseFileSerializer{
 
 	public:
@@ -99,6 +117,25 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		//number of <PT> tags at the current root level.
 		int		getNumTags(const string& tag);
 
+		//-- getValues
+		//reads all the tags with the same name at the current root level
+		//in one go, values[which] is the same as getValue(tag, defaultValue, which)
+		//the values are converted in parallel, returns how many were read.
+		//	<pt>10</pt><pt>20</pt><pt>30</pt>  -> getValues("pt", values) == 3
+		int		getValues(const string& tag, vector<int>& values, int defaultValue = 0);
+		int		getValues(const string& tag, vector<double>& values, double defaultValue = 0);
+		int		getValues(const string& tag, vector<string>& values, const string& defaultValue = "");
+
+		//-- tag index
+		//the children of a tag are indexed by name the first time one of
+		//them is looked up so accessing a tag with a big which, or counting
+		//tags, doesn't need to walk all the tags before it. all the methods
+		//of this class keep the index up to date but if doc is modified
+		//directly call clearIndex() before using this class again.
+		void	setIndexEnabled(bool enabled);
+		bool	isIndexEnabled() const;
+		void	clearIndex();
+
 		//-- addValue/addTag
 		//adds a tag to the document even if a tag with the same name
 		//already exists - returns an index which can then be used to
@@ -139,6 +176,13 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		double	getAttribute(const string& tag, const string& attribute, double defaultValue, int which = 0);
 		string	getAttribute(const string& tag, const string& attribute, const string& defaultValue, int which = 0);
 
+		//-- getAttributes
+		//like getValues, reads the attribute of all the tags with the same
+		//name at the current root level in one go
+		int		getAttributes(const string& tag, const string& attribute, vector<int>& values, int defaultValue = 0);
+		int		getAttributes(const string& tag, const string& attribute, vector<double>& values, double defaultValue = 0);
+		int		getAttributes(const string& tag, const string& attribute, vector<string>& values, const string& defaultValue = "");
+
 		int		setAttribute(const string& tag, const string& attribute, int value, int which = 0);
 		int		setAttribute(const string& tag, const string& attribute, double value, int which = 0);
 		int		setAttribute(const string& tag, const string& attribute, const string& value, int which = 0);
@@ -157,6 +201,8 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 
 		TiXmlHandle     storedHandle;
 		int             level;
+		ofxXmlSettingsIndex index;
+		bool            bIndexEnabled;
 
 
 		int 	writeTag(const string&  tag, const string& valueString, int which = 0);
@@ -166,6 +212,10 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		int		writeAttribute(const string& tag, const string& attribute, const string& valueString, int which = 0);
 
         TiXmlElement* getElementForAttribute(const string& tag, int which);
+        TiXmlElement* getChildElement(TiXmlNode* parent, const string& tag, int which);
+        const ofxXmlSettingsIndex::Elements& getChildElements(TiXmlNode* parent, const string& tag);
+        void getElements(const string& tag, vector<TiXmlElement*>& elements);
+        void removeFromIndex(TiXmlNode* node);
         bool readIntAttribute(const string& tag, const string& attribute, int& valueString, int which);
         bool readDoubleAttribute(const string& tag, const string& attribute, double& outValue, int which);
         bool readStringAttribute(const string& tag, const string& attribute, string& outValue, int which);
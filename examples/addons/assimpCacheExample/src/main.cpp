@@ -0,0 +1,13 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+	// the benchmark only measures loading so it runs without a
+	// window, the models are loaded without textures or vbos
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window,1024,768,OF_WINDOW);
+	ofRunApp(new ofApp());
+
+}
@@ -0,0 +1,81 @@
+#include "ofApp.h"
+#include "aiScene.h"
+
+// loads from the cache averaged for each model
+static const int numLoads = 5;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	// every model in bin/data is benchmarked, copy your own
+	// models there to see how long they take to load
+	ofDirectory dir("");
+	dir.listDir();
+	dir.sort();
+	for(int i = 0; i < (int)dir.size(); i++){
+		string extension = "." + ofToLower(dir.getFile(i).getExtension());
+		if(dir.getFile(i).isFile() && aiIsExtensionSupported(extension.c_str())){
+			benchmark(dir.getPath(i));
+		}
+	}
+	ofExit();
+}
+
+//--------------------------------------------------------------
+static int countVertices(ofxAssimpModelLoader & model){
+	int numVertices = 0;
+	for(unsigned int i = 0; i < model.getMeshCount(); i++){
+		numVertices += model.getMeshHelper(i).mesh->mNumVertices;
+	}
+	return numVertices;
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(const string & path){
+	ofxAssimpModelLoader model;
+	model.setCacheFolder("cache");
+
+	// without the cache every load runs the importer
+	unsigned long long start = ofGetElapsedTimeMicros();
+	if(!model.loadModel(path)){
+		return;
+	}
+	unsigned long long importing = ofGetElapsedTimeMicros() - start;
+	int numVertices = countVertices(model);
+
+	// the first load with the cache imports the model and saves the cache
+	model.enableCache();
+	ofFile::removeFile(model.getCachePath(), false);
+	start = ofGetElapsedTimeMicros();
+	model.loadModel(path);
+	unsigned long long saving = ofGetElapsedTimeMicros() - start;
+
+	// the next ones only read the cache
+	unsigned long long loading = 0;
+	for(int i = 0; i < numLoads; i++){
+		start = ofGetElapsedTimeMicros();
+		model.loadModel(path);
+		loading += ofGetElapsedTimeMicros() - start;
+		if(!model.isLoadedFromCache() || countVertices(model) != numVertices){
+			ofLogError() << path << ": the cache wasn't loaded correctly";
+			return;
+		}
+	}
+	loading /= numLoads;
+
+	ofLogNotice() << path << ": " << model.getMeshCount() << " meshes, " << numVertices << " vertices, "
+	              << model.getAnimationCount() << " animations" << endl
+	              << "\timporter: " << importing / 1000. << "ms" << endl
+	              << "\timporter and saving the cache: " << saving / 1000. << "ms" << endl
+	              << "\tfrom the cache: " << loading / 1000. << "ms, " << double(importing) / loading << "x faster" << endl
+	              << "\tcache size: " << ofFile(model.getCachePath(), ofFile::Reference).getSize() / 1024 << "KB";
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
@@ -0,0 +1,118 @@
+#include "ofApp.h"
+#include "aiScene.h"
+
+// animated characters, each one has its own copy of the model
+static const int numModels = 30;
+
+// frames of the animation skinned by each benchmark
+static const int numFrames = 60;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	for(int i = 0; i < numModels; i++){
+		shared_ptr<ofxAssimpModelLoader> model(new ofxAssimpModelLoader);
+		if(!model->loadModel("astroBoy_walk.dae") || !model->hasAnimations()){
+			ofLogError() << "couldn't load astroBoy_walk.dae";
+			ofExit();
+			return;
+		}
+		models.push_back(model);
+	}
+
+	int numVertices = 0;
+	int numBones = 0;
+	for(unsigned int i = 0; i < models[0]->getMeshCount(); i++){
+		numVertices += models[0]->getMeshHelper(i).mesh->mNumVertices;
+		numBones += models[0]->getMeshHelper(i).mesh->mNumBones;
+	}
+	ofLogNotice() << numModels << " models of " << models[0]->getMeshCount() << " meshes, "
+	              << numVertices << " vertices and " << numBones << " bones";
+
+	ofLogNotice() << "searching the bones every frame: " << benchmarkPerFrame() << "ms per frame";
+	ofLogNotice() << "ofxAssimpModelLoader::update(): " << benchmark(false) << "ms per frame";
+#ifdef OF_USING_THREAD_POOL
+	ofLogNotice() << "ofxAssimpModelLoader::update() with parallel skinning: " << benchmark(true) << "ms per frame";
+#endif
+	ofExit();
+}
+
+//--------------------------------------------------------------
+// how the bones were skinned before the loader cached them: the
+// nodes are searched by name and the parent chain multiplied for
+// every bone, and each bone adds its weighted vertices
+void ofApp::updateBonesPerFrame(ofxAssimpModelLoader & model){
+	const aiScene * scene = model.getAssimpScene();
+	for(unsigned int i = 0; i < model.getMeshCount(); i++){
+		ofxAssimpMeshHelper & meshHelper = model.getMeshHelper(i);
+		const aiMesh * mesh = meshHelper.mesh;
+
+		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
+		for(unsigned int a = 0; a < mesh->mNumBones; a++){
+			const aiBone * bone = mesh->mBones[a];
+			const aiNode * node = scene->mRootNode->FindNode(bone->mName);
+			boneMatrices[a] = bone->mOffsetMatrix;
+			while(node){
+				boneMatrices[a] = node->mTransformation * boneMatrices[a];
+				node = node->mParent;
+			}
+		}
+
+		meshHelper.animatedPos.assign(meshHelper.animatedPos.size(), aiVector3D());
+		meshHelper.animatedNorm.assign(meshHelper.animatedNorm.size(), aiVector3D());
+		for(unsigned int a = 0; a < mesh->mNumBones; a++){
+			const aiBone * bone = mesh->mBones[a];
+			const aiMatrix4x4 & posTrafo = boneMatrices[a];
+			aiMatrix3x3 normTrafo(posTrafo);
+			for(unsigned int b = 0; b < bone->mNumWeights; b++){
+				const aiVertexWeight & weight = bone->mWeights[b];
+				meshHelper.animatedPos[weight.mVertexId] += weight.mWeight * (posTrafo * mesh->mVertices[weight.mVertexId]);
+				if(mesh->HasNormals()){
+					meshHelper.animatedNorm[weight.mVertexId] += weight.mWeight * (normTrafo * mesh->mNormals[weight.mVertexId]);
+				}
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmarkPerFrame(){
+	unsigned long long total = 0;
+	for(int frame = 0; frame < numFrames; frame++){
+		for(size_t i = 0; i < models.size(); i++){
+			models[i]->setPositionForAllAnimations(float(frame) / numFrames);
+		}
+		unsigned long long start = ofGetElapsedTimeMicros();
+		for(size_t i = 0; i < models.size(); i++){
+			updateBonesPerFrame(*models[i]);
+		}
+		total += ofGetElapsedTimeMicros() - start;
+	}
+	return total / 1000. / numFrames;
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmark(bool parallel){
+	unsigned long long total = 0;
+	for(int frame = 0; frame < numFrames; frame++){
+		for(size_t i = 0; i < models.size(); i++){
+			models[i]->setParallelSkinning(parallel);
+			models[i]->setPositionForAllAnimations(float(frame) / numFrames);
+		}
+		unsigned long long start = ofGetElapsedTimeMicros();
+		for(size_t i = 0; i < models.size(); i++){
+			models[i]->update();
+		}
+		total += ofGetElapsedTimeMicros() - start;
+	}
+	return total / 1000. / numFrames;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
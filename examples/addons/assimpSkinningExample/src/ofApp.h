@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxAssimpModelLoader.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void updateBonesPerFrame(ofxAssimpModelLoader & model);
+		double benchmarkPerFrame();
+		double benchmark(bool parallel);
+
+		vector<shared_ptr<ofxAssimpModelLoader> > models;
+};
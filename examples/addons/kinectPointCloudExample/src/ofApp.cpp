@@ -0,0 +1,231 @@
+#include "ofApp.h"
+
+// passes over the whole sequence for each benchmark
+static const int numPasses = 5;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetFrameRate(60);
+
+	kinect.init(false, false); // only depth
+	kinect.open();
+
+	// put a sequence of raw depth frames recorded with 'r' in
+	// bin/data/depth to benchmark with real data, otherwise
+	// a sequence of moving waves is generated
+	loadFrames();
+	if(frames.empty()){
+		generateFrames();
+	}
+
+	if(kinect.isConnected()){
+		// same calibration as the device
+		converter.setup(kinect.width, kinect.height, kinect.getZeroPlanePixelSize(), kinect.getZeroPlaneDistance());
+	}else{
+		converter.setup(frames[0].getWidth(), frames[0].getHeight());
+	}
+	converter.setStep(2);
+	runBenchmarks();
+
+	currentFrame = 0;
+	bRecording = false;
+	numRecorded = 0;
+}
+
+//--------------------------------------------------------------
+void ofApp::loadFrames(){
+	ofDirectory dir("depth");
+	dir.allowExt("png");
+	dir.listDir();
+	dir.sort();
+	for(int i = 0; i < (int)dir.size(); i++){
+		ofShortPixels pixels;
+		if(ofLoadImage(pixels, dir.getPath(i)) && pixels.getNumChannels() == 1){
+			if(frames.empty() || (pixels.getWidth() == frames[0].getWidth() && pixels.getHeight() == frames[0].getHeight())){
+				frames.push_back(pixels);
+			}
+		}
+	}
+	ofLogNotice() << "loaded " << frames.size() << " depth frames";
+}
+
+//--------------------------------------------------------------
+void ofApp::generateFrames(){
+	for(int frame = 0; frame < 60; frame++){
+		ofShortPixels pixels;
+		pixels.allocate(640, 480, 1);
+		float t = frame / 30.f;
+		for(int y = 0; y < 480; y++){
+			for(int x = 0; x < 640; x++){
+				// leave some pixels without depth like the shadows in real frames
+				bool shadow = (x / 40 + y / 40 + frame / 10) % 7 == 0;
+				float wave = sin(x * 0.02 + t) * cos(y * 0.03 + t * 0.5);
+				pixels[y * 640 + x] = shadow ? 0 : 1500 + 400 * wave;
+			}
+		}
+		frames.push_back(pixels);
+	}
+	ofLogNotice() << "generated " << frames.size() << " depth frames";
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmarkPerPixel(){
+	// what building a point cloud took before, one call per pixel
+	int step = converter.getStep();
+	unsigned long long total = 0;
+	for(int pass = 0; pass < numPasses; pass++){
+		for(size_t i = 0; i < frames.size(); i++){
+			const ofShortPixels & depth = frames[i];
+			int w = depth.getWidth();
+			int h = depth.getHeight();
+			unsigned long long start = ofGetElapsedTimeMicros();
+			mesh.clear();
+			for(int y = 0; y < h; y += step){
+				for(int x = 0; x < w; x += step){
+					float z = depth[y * w + x];
+					if(z > 0){
+						mesh.addVertex(converter.getWorldCoordinateAt(x, y, z));
+					}
+				}
+			}
+			total += ofGetElapsedTimeMicros() - start;
+		}
+	}
+	return double(total) / (numPasses * frames.size());
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmark(bool bParallel){
+	converter.setParallel(bParallel);
+	unsigned long long total = 0;
+	for(int pass = 0; pass < numPasses; pass++){
+		for(size_t i = 0; i < frames.size(); i++){
+			unsigned long long start = ofGetElapsedTimeMicros();
+			converter.getMesh(frames[i], mesh);
+			total += ofGetElapsedTimeMicros() - start;
+		}
+	}
+	converter.setParallel(true);
+	return double(total) / (numPasses * frames.size());
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	stringstream out;
+	out << frames.size() << " depth frames of " << frames[0].getWidth() << "x" << frames[0].getHeight()
+		<< ", step " << converter.getStep() << endl;
+	out << "getWorldCoordinateAt per pixel: " << benchmarkPerPixel() << "us per frame" << endl;
+	out << "ofxKinectPointCloud: " << benchmark(false) << "us per frame" << endl;
+	out << "ofxKinectPointCloud parallel: " << benchmark(true) << "us per frame" << endl;
+	out << "space: run again, +/-: step";
+	if(kinect.isConnected()){
+		out << ", r: record depth frames";
+	}
+	results = out.str();
+	ofLogNotice() << results;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	kinect.update();
+	if(kinect.isConnected()){
+		if(kinect.isFrameNewDepth()){
+			if(bRecording){
+				ofSaveImage(kinect.getRawDepthPixels(), "depth/frame_" + ofToString(numRecorded++, 5, '0') + ".png");
+			}
+			converter.getMesh(kinect.getRawDepthPixels(), mesh);
+		}
+	}else{
+		converter.getMesh(frames[currentFrame], mesh);
+		currentFrame = (currentFrame + 1) % frames.size();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackground(0);
+
+	easyCam.begin();
+	ofPushMatrix();
+	// the projected points are 'upside down' and 'backwards'
+	ofScale(1, -1, -1);
+	ofTranslate(0, 0, -1000); // center the points a bit
+	ofEnableDepthTest();
+	ofSetColor(255);
+	mesh.drawVertices();
+	ofDisableDepthTest();
+	ofPopMatrix();
+	easyCam.end();
+
+	string info = results + "\n" + ofToString(mesh.getNumVertices()) + " points";
+	if(bRecording){
+		info += "\nrecording frame " + ofToString(numRecorded);
+	}
+	ofDrawBitmapStringHighlight(info, 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::exit(){
+	kinect.close();
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	switch(key){
+		case ' ':
+			runBenchmarks();
+			break;
+		case '+':
+		case '=':
+			converter.setStep(converter.getStep() + 1);
+			runBenchmarks();
+			break;
+		case '-':
+			converter.setStep(converter.getStep() - 1);
+			runBenchmarks();
+			break;
+		case 'r':
+			bRecording = kinect.isConnected() && !bRecording;
+			break;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxKinect.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+		void exit();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void loadFrames();
+		void generateFrames();
+		double benchmarkPerPixel();
+		double benchmark(bool bParallel);
+		void runBenchmarks();
+
+		ofxKinect				kinect;
+		ofxKinectPointCloud		converter;
+
+		vector<ofShortPixels>	frames;
+		size_t					currentFrame;
+		bool					bRecording;
+		int						numRecorded;
+
+		ofMesh					mesh;
+		ofEasyCam				easyCam;
+		string					results;
+};
@@ -0,0 +1,172 @@
+#include "ofApp.h"
+
+// passes over the whole sequence for each benchmark
+static const int numPasses = 5;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(0);
+
+	// put a recorded sequence of black and white masks in
+	// bin/data/masks to benchmark with real data, otherwise
+	// a sequence of moving circles is generated
+	loadMasks();
+	if(masks.empty()){
+		generateMasks();
+	}
+
+	mask.allocate(masks[0].getWidth(), masks[0].getHeight());
+	runBenchmarks();
+
+	currentFrame = 0;
+	contourFinder.setCopyInput(true);
+	contourFinder.setTrackBlobs(true);
+}
+
+//--------------------------------------------------------------
+void ofApp::loadMasks(){
+	ofDirectory dir("masks");
+	dir.allowExt("png");
+	dir.allowExt("jpg");
+	dir.allowExt("bmp");
+	dir.listDir();
+	dir.sort();
+	for(int i = 0; i < (int)dir.size(); i++){
+		ofPixels pixels;
+		if(ofLoadImage(pixels, dir.getPath(i))){
+			pixels.setImageType(OF_IMAGE_GRAYSCALE);
+			if(masks.empty() || (pixels.getWidth() == masks[0].getWidth() && pixels.getHeight() == masks[0].getHeight())){
+				masks.push_back(pixels);
+			}
+		}
+	}
+	ofLogNotice() << "loaded " << masks.size() << " masks";
+}
+
+//--------------------------------------------------------------
+void ofApp::generateMasks(){
+	ofFbo fbo;
+	fbo.allocate(640, 480, GL_RGB);
+	for(int frame = 0; frame < 240; frame++){
+		fbo.begin();
+		ofClear(0);
+		ofSetColor(255);
+		for(int i = 0; i < 16; i++){
+			float t = frame / 60.f + i;
+			float x = 320 + 260 * sin(t * 0.7 + i * 1.3);
+			float y = 240 + 200 * cos(t * 0.9 + i * 0.7);
+			ofDrawCircle(x, y, 15 + (i % 4) * 8);
+		}
+		fbo.end();
+		ofPixels pixels;
+		fbo.readToPixels(pixels);
+		pixels.setImageType(OF_IMAGE_GRAYSCALE);
+		masks.push_back(pixels);
+	}
+	ofLogNotice() << "generated " << masks.size() << " masks";
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmark(bool bCopyInput, bool bTrack){
+	ofxCvContourFinder finder;
+	finder.setCopyInput(bCopyInput);
+	finder.setTrackBlobs(bTrack);
+
+	unsigned long long total = 0;
+	for(int pass = 0; pass < numPasses; pass++){
+		for(size_t i = 0; i < masks.size(); i++){
+			// setting the pixels is not measured, without copy
+			// the contour finder modifies the mask anyway
+			mask.setFromPixels(masks[i]);
+			unsigned long long start = ofGetElapsedTimeMicros();
+			finder.findContours(mask, 20, mask.getWidth() * mask.getHeight() / 3, 50, true);
+			total += ofGetElapsedTimeMicros() - start;
+		}
+	}
+	return double(total) / (numPasses * masks.size());
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	mask.setUseTexture(false);
+	stringstream out;
+	out << masks.size() << " masks of " << masks[0].getWidth() << "x" << masks[0].getHeight() << endl;
+	out << "findContours with input copy: " << benchmark(true, false) << "us per frame" << endl;
+	out << "findContours without copy: " << benchmark(false, false) << "us per frame" << endl;
+	out << "findContours with tracking: " << benchmark(true, true) << "us per frame" << endl;
+	out << "press space to run again";
+	results = out.str();
+	mask.setUseTexture(true);
+	ofLogNotice() << results;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	mask.setFromPixels(masks[currentFrame]);
+	contourFinder.findContours(mask, 20, mask.getWidth() * mask.getHeight() / 3, 50, true);
+	currentFrame = (currentFrame + 1) % masks.size();
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofSetColor(255);
+	mask.draw(0, 0);
+	contourFinder.draw(0, 0);
+
+	// each id keeps the same color while its blob is tracked
+	for(int i = 0; i < (int)contourFinder.blobs.size(); i++){
+		const ofxCvBlob & blob = contourFinder.blobs[i];
+		ofSetColor(ofColor::fromHsb((blob.id * 37) % 255, 255, 255));
+		ofDrawBitmapString(ofToString(blob.id), blob.centroid);
+	}
+
+	ofSetColor(255);
+	ofDrawBitmapStringHighlight(results, 20, mask.getHeight() + 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == ' '){
+		runBenchmarks();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ofMain.h"
+
+#include "ofxOpenCv.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void loadMasks();
+		void generateMasks();
+		double benchmark(bool bCopyInput, bool bTrack);
+		void runBenchmarks();
+
+		vector<ofPixels>		masks;
+		ofxCvGrayscaleImage		mask;
+		ofxCvContourFinder		contourFinder;
+
+		size_t					currentFrame;
+		string					results;
+};
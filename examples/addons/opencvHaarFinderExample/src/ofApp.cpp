@@ -5,6 +5,89 @@ void ofApp::setup(){
 	img.load("test.jpg");
 	finder.setup("haarcascade_frontalface_default.xml");
 	finder.findHaarObjects(img);
+
+	// every image in the data folder is used for the benchmark
+	ofDirectory dir;
+	dir.allowExt("jpg");
+	dir.allowExt("png");
+	dir.listDir("");
+	for(int i = 0; i < (int)dir.size(); i++){
+		ofPixels pixels;
+		if(ofLoadImage(pixels, dir.getPath(i))){
+			pixels.setImageType(OF_IMAGE_COLOR);
+			benchmarkImages.push_back(pixels);
+		}
+	}
+	benchmarkResults = "press space to run the benchmark";
+}
+
+//--------------------------------------------------------------
+double ofApp::benchmark(ofxCvHaarFinder & finder, vector<vector<ofRectangle> > & detections){
+	// each image is detected several times in a row, like
+	// the frames of a video where nothing moves
+	int framesPerImage = 20;
+	detections.clear();
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(size_t i = 0; i < benchmarkImages.size(); i++){
+		for(int frame = 0; frame < framesPerImage; frame++){
+			finder.findHaarObjects(benchmarkImages[i]);
+		}
+		vector<ofRectangle> rects;
+		for(size_t j = 0; j < finder.blobs.size(); j++){
+			rects.push_back(finder.blobs[j].boundingRect);
+		}
+		detections.push_back(rects);
+	}
+	unsigned long long elapsed = ofGetElapsedTimeMicros() - start;
+	return benchmarkImages.size() * framesPerImage / (elapsed / 1000000.);
+}
+
+// true if both lists contain the same rectangles in any order
+static bool sameDetections(vector<ofRectangle> a, vector<ofRectangle> b){
+	if(a.size() != b.size()){
+		return false;
+	}
+	for(size_t i = 0; i < a.size(); i++){
+		vector<ofRectangle>::iterator found = find(b.begin(), b.end(), a[i]);
+		if(found == b.end()){
+			return false;
+		}
+		b.erase(found);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark(){
+	vector<vector<ofRectangle> > reference, detections;
+	stringstream out;
+
+	ofxCvHaarFinder single;
+	single.setup("haarcascade_frontalface_default.xml");
+	out << "single thread: " << benchmark(single, reference) << "fps" << endl;
+
+	ofxCvHaarFinder parallel;
+	parallel.setup("haarcascade_frontalface_default.xml");
+	parallel.setParallel(true);
+	out << "parallel scales: " << benchmark(parallel, detections) << "fps";
+	int matching = 0;
+	for(size_t i = 0; i < reference.size(); i++){
+		matching += sameDetections(reference[i], detections[i]);
+	}
+	out << ", " << matching << "/" << reference.size() << " images with the same detections" << endl;
+
+	ofxCvHaarFinder temporal;
+	temporal.setup("haarcascade_frontalface_default.xml");
+	temporal.setParallel(true);
+	temporal.setUseTemporalRoi(true);
+	out << "parallel + temporal roi: " << benchmark(temporal, detections) << "fps";
+	matching = 0;
+	for(size_t i = 0; i < reference.size(); i++){
+		matching += sameDetections(reference[i], detections[i]);
+	}
+	out << ", " << matching << "/" << reference.size() << " images with the same detections" << endl;
+
+	benchmarkResults = out.str();
 }
 
 //--------------------------------------------------------------
@@ -20,10 +103,15 @@ void ofApp::draw(){
 		ofRectangle cur = finder.blobs[i].boundingRect;
 		ofDrawRectangle(cur.x, cur.y, cur.width, cur.height);
 	}
+
+	ofDrawBitmapStringHighlight(benchmarkResults, 20, 20);
 }
 
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
+	if(key == ' '){
+		runBenchmark();
+	}
 
 }
 
@@ -19,6 +19,12 @@ class ofApp : public ofBaseApp{
 		void dragEvent(ofDragInfo dragInfo);
 		void gotMessage(ofMessage msg);		
 
+		void runBenchmark();
+		double benchmark(ofxCvHaarFinder & finder, vector<vector<ofRectangle> > & detections);
+
 		ofImage img;
 		ofxCvHaarFinder finder;
+
+		vector<ofPixels> benchmarkImages;
+		string benchmarkResults;
 };
@@ -7,21 +7,27 @@ void ofApp::setup(){
 	ofBackground(0);
 	ofSetColor(255);
 	
-	svg.load("tiger.svg");
-	for (int i = 0; i < svg.getNumPath(); i++){
-		ofPath p = svg.getPathAt(i);
-		// svg defaults to non zero winding which doesn't look so good as contours
-		p.setPolyWindingMode(OF_POLY_WINDING_ODD);
-		vector<ofPolyline>& lines = p.getOutline();
-		for(int j=0;j<(int)lines.size();j++){
-			outlines.push_back(lines[j].getResampledBySpacing(1));
-		}
-	}
+	// the file is parsed and tessellated in a thread, the app keeps
+	// running and svg.isLoaded() becomes true once it's ready to draw
+	svg.loadAsync("tiger.svg");
+	bDrawMeshes = false;
 }
 
 
 //--------------------------------------------------------------
 void ofApp::update(){
+	if (outlines.empty() && svg.isLoaded()){
+		for (int i = 0; i < svg.getNumPath(); i++){
+			ofPath p = svg.getPathAt(i);
+			// svg defaults to non zero winding which doesn't look so good as contours
+			p.setPolyWindingMode(OF_POLY_WINDING_ODD);
+			vector<ofPolyline>& lines = p.getOutline();
+			for(int j=0;j<(int)lines.size();j++){
+				outlines.push_back(lines[j].getResampledBySpacing(1));
+			}
+		}
+	}
+
 	step += 0.001;
 	if (step > 1) {
 		step -= 1;
@@ -31,6 +37,11 @@ void ofApp::update(){
 //--------------------------------------------------------------
 void ofApp::draw(){
 	ofDrawBitmapString(ofToString(ofGetFrameRate()),20,20);
+	ofDrawBitmapString(string("press 'm' to draw ") + (bDrawMeshes ? "the paths" : "the merged meshes"),20,40);
+	if(!svg.isLoaded()){
+		ofDrawBitmapString("loading tiger.svg...",20,60);
+		return;
+	}
 	ofPushMatrix();
 	ofTranslate(ofGetWidth() / 2, ofGetHeight() / 2);
 	ofRotate(mouseX);
@@ -50,6 +61,9 @@ void ofApp::draw(){
 			}
 			ofEndShape();
 		}
+	} else if(bDrawMeshes) {
+		// all the paths in one draw call
+		svg.drawMeshes();
 	} else {
 		svg.draw();
 	}
@@ -59,7 +73,9 @@ void ofApp::draw(){
 
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
-	
+	if(key == 'm'){
+		bDrawMeshes = !bDrawMeshes;
+	}
 }
 
 //--------------------------------------------------------------
@@ -23,5 +23,6 @@ public:
     ofxSVG svg;
     float step;
     vector<ofPolyline> outlines;
+    bool bDrawMeshes;
     
 };
@@ -0,0 +1,145 @@
+#include "ofApp.h"
+
+// every shape is tessellated this many times, like a path that
+// changes every frame
+static const int passes = 20;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(40);
+
+	// text outlines: many small shapes with a few contours each
+	text = "The quick brown fox jumps\nover the lazy dog 0123456789";
+	font.load("DIN.otf", 48, true, true, true);
+	vector<ofTTFCharacter> characters = font.getStringAsPoints(text);
+	for(size_t i = 0; i < characters.size(); i++){
+		Shape shape;
+		shape.contours = characters[i].getOutline();
+		shape.windingMode = characters[i].getWindingMode();
+		if(!shape.contours.empty()){
+			textShapes.push_back(shape);
+		}
+	}
+
+	// svg: fewer shapes, some of them with long curved contours
+	svg.load("tiger.svg");
+	for(int i = 0; i < svg.getNumPath(); i++){
+		Shape shape;
+		shape.contours = svg.getPathAt(i).getOutline();
+		shape.windingMode = svg.getPathAt(i).getWindingMode();
+		if(!shape.contours.empty()){
+			svgShapes.push_back(shape);
+		}
+	}
+
+	runBenchmark();
+}
+
+//--------------------------------------------------------------
+string ofApp::runWorkload(string name, const vector<Shape> & shapes, bool arena){
+	ofTessellator tessellator;
+	tessellator.setArenaEnabled(arena);
+
+	ofMesh mesh;
+	for(int pass = 0; pass < passes; pass++){
+		for(size_t i = 0; i < shapes.size(); i++){
+			tessellator.tessellateToMesh(shapes[i].contours, shapes[i].windingMode, mesh, true);
+		}
+	}
+
+	const ofTessellatorStats & stats = tessellator.getStats();
+	stringstream result;
+	result << name << (arena ? " arena: " : " heap:  ")
+		<< stats.tessellations << " tessellations, "
+		<< stats.allocations << " allocations, "
+		<< stats.heapAllocations << " from the heap, "
+		<< ofToString(stats.timeMicros / 1000.f, 1) << "ms";
+	if(arena){
+		result << ", peak " << stats.peakBytes / 1024 << "KB"
+			<< ", arena " << stats.arenaBytes / 1024 << "KB";
+	}
+	ofLogNotice() << result.str();
+	return result.str();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark(){
+	results.clear();
+	results.push_back(runWorkload("text", textShapes, false));
+	results.push_back(runWorkload("text", textShapes, true));
+	results.push_back(runWorkload("svg ", svgShapes, false));
+	results.push_back(runWorkload("svg ", svgShapes, true));
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofSetColor(255);
+	font.drawStringAsShapes(text, 20, 60);
+
+	ofPushMatrix();
+	ofTranslate(ofGetWidth() - 420, 140);
+	ofScale(0.8, 0.8);
+	svg.draw();
+	ofPopMatrix();
+
+	stringstream info;
+	info << textShapes.size() << " characters and " << svgShapes.size() << " svg paths, "
+		<< "each tessellated " << passes << " times" << endl;
+	info << "press b to run again" << endl << endl;
+	for(size_t i = 0; i < results.size(); i++){
+		info << results[i] << endl;
+	}
+	ofDrawBitmapStringHighlight(info.str(), 20, ofGetHeight() - 120);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'b'){
+		runBenchmark();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxSvg.h"
+
+// the contours of one shape and how they have to be filled
+struct Shape{
+	vector<ofPolyline> contours;
+	ofPolyWindingMode windingMode;
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		string runWorkload(string name, const vector<Shape> & shapes, bool arena);
+		void runBenchmark();
+
+		ofxSVG svg;
+		ofTrueTypeFont font;
+		string text;
+		vector<Shape> textShapes;
+		vector<Shape> svgShapes;
+		vector<string> results;
+};
@@ -0,0 +1,154 @@
+#include "ofApp.h"
+
+// number of <sample> tags in the generated file
+static const int numTags = 100000;
+
+// without the index reading every tag one by one takes minutes, so
+// only this many are read to compare
+static const int numTagsWithoutIndex = 10000;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(40);
+	createFile();
+	runBenchmark();
+}
+
+//--------------------------------------------------------------
+void ofApp::createFile(){
+	if(ofFile::doesFileExist("samples.xml")){
+		return;
+	}
+
+	// <samples>
+	//     <sample time="0">0.5</sample>
+	//     ...
+	// </samples>
+	ofxXmlSettings xml;
+	xml.addTag("samples");
+	xml.pushTag("samples");
+	for(int i = 0; i < numTags; i++){
+		int which = xml.addValue("sample", ofRandom(1));
+		xml.setAttribute("sample", "time", i * 10, which);
+	}
+	xml.popTag();
+	xml.saveFile("samples.xml");
+}
+
+//--------------------------------------------------------------
+string ofApp::readOneByOne(bool index){
+	ofxXmlSettings xml;
+	xml.setIndexEnabled(index);
+	xml.loadFile("samples.xml");
+	xml.pushTag("samples");
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	int numSamples = xml.getNumTags("sample");
+	if(!index){
+		numSamples = min(numSamples, numTagsWithoutIndex);
+	}
+	vector<double> values(numSamples);
+	vector<int> times(numSamples);
+	for(int i = 0; i < numSamples; i++){
+		values[i] = xml.getValue("sample", 0.0, i);
+		times[i] = xml.getAttribute("sample", "time", 0, i);
+	}
+	unsigned long long time = ofGetElapsedTimeMicros() - start;
+
+	stringstream result;
+	result << "getValue() and getAttribute() " << (index ? "with index:    " : "without index: ")
+		<< numSamples << " tags in " << ofToString(time / 1000.f, 1) << "ms";
+	ofLogNotice() << result.str();
+	return result.str();
+}
+
+//--------------------------------------------------------------
+string ofApp::readAll(){
+	ofxXmlSettings xml;
+	xml.loadFile("samples.xml");
+	xml.pushTag("samples");
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	vector<double> values;
+	vector<int> times;
+	int numSamples = xml.getValues("sample", values);
+	xml.getAttributes("sample", "time", times);
+	unsigned long long time = ofGetElapsedTimeMicros() - start;
+
+	stringstream result;
+	result << "getValues() and getAttributes():           "
+		<< numSamples << " tags in " << ofToString(time / 1000.f, 1) << "ms";
+	ofLogNotice() << result.str();
+	return result.str();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark(){
+	results.clear();
+	results.push_back(readOneByOne(false));
+	results.push_back(readOneByOne(true));
+	results.push_back(readAll());
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	stringstream info;
+	info << "reading samples.xml, " << numTags << " <sample> tags with a value and an attribute" << endl;
+	info << "press b to run again" << endl << endl;
+	for(size_t i = 0; i < results.size(); i++){
+		info << results[i] << endl;
+	}
+	ofDrawBitmapStringHighlight(info.str(), 20, 40);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'b'){
+		runBenchmark();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,13 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+	// the test talks to a pseudo terminal instead of a real device
+	// and doesn't draw anything so it runs without a window
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window,1024,768,OF_WINDOW);
+	ofRunApp(new ofApp());
+
+}
@@ -0,0 +1,209 @@
+#include "ofApp.h"
+
+#if defined(OF_USING_SERIAL_READER) && !defined(TARGET_WIN32)
+#define OF_SERIAL_READER_TEST
+#include <fcntl.h>
+#include <termios.h>
+#endif
+
+// tests ofSerial's reader thread against a pseudo terminal: the
+// master side plays the device and the serial port opens the slave.
+// runs on linux and osx with c++11 support, build it with
+// -fsanitize=thread to check the reader for data races
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	errors = 0;
+#ifdef OF_SERIAL_READER_TEST
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master == -1 || grantpt(master) != 0 || unlockpt(master) != 0){
+		ofLogError() << "couldn't open a pseudo terminal";
+		errors++;
+		return;
+	}
+	string slave = ptsname(master);
+
+	// the master doesn't need to be a terminal, only pass the bytes through
+	termios options;
+	tcgetattr(master, &options);
+	cfmakeraw(&options);
+	tcsetattr(master, TCSANOW, &options);
+
+	if(!serial.setup(slave, 115200)){
+		ofLogError() << "couldn't open " << slave;
+		errors++;
+		return;
+	}
+
+	testRawReads();
+	testDelimitedPackets();
+	testFixedLengthPackets();
+	testCopies();
+	testFlushAndHangup();
+#else
+	ofLogNotice() << "the serial reader needs c++11 support, the test uses pseudo terminals which are not available on windows";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool condition, string description){
+	if(!condition){
+		ofLogError() << "failed: " << description;
+		errors++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::writeAll(const void * data, size_t length){
+#ifdef OF_SERIAL_READER_TEST
+	const unsigned char * bytes = (const unsigned char *)data;
+	while(length > 0){
+		int written = ::write(master, bytes, length);
+		if(written < 0){
+			ofSleepMillis(1);
+			continue;
+		}
+		bytes += written;
+		length -= written;
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::testRawReads(){
+#ifdef OF_SERIAL_READER_TEST
+	// without framing the existing read functions work as before
+	check(serial.startReading(1024), "startReading()");
+	writeAll("hello world", 11);
+	ofSleepMillis(20);
+	check(serial.available() == 11, "available() returns the received bytes");
+
+	unsigned char buffer[64];
+	check(serial.readBytes(buffer, 5) == 5 && memcmp(buffer, "hello", 5) == 0, "readBytes() in order");
+	check(serial.readByte() == ' ', "readByte()");
+	check(serial.readBytes(buffer, 64) == 5, "readBytes() returns what's available");
+	check(serial.readByte() == OF_SERIAL_NO_DATA, "readByte() without data");
+	ofLogNotice() << "raw reads done";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::testDelimitedPackets(){
+#ifdef OF_SERIAL_READER_TEST
+	// 100k lines streamed from another thread while this one reads them
+	const int numLines = 100000;
+	serial.setPacketDelimiter('\n');
+	check(serial.startReading(1 << 20), "startReading() with a bigger buffer");
+	std::thread writer([this, numLines]{
+		string lines;
+		for(int i = 0; i < numLines; i++){
+			lines += ofToString(i) + "\n";
+			if(lines.size() > 3000){
+				writeAll(lines.data(), lines.size());
+				lines.clear();
+			}
+		}
+		writeAll(lines.data(), lines.size());
+	});
+
+	ofSerialPacket packet;
+	int expected = 0;
+	bool inOrder = true;
+	bool timestampsInOrder = true;
+	unsigned long long lastTimestamp = 0;
+	unsigned long long start = ofGetElapsedTimeMillis();
+	while(expected < numLines && ofGetElapsedTimeMillis() - start < 20000){
+		if(serial.readPacket(packet)){
+			int value = ofToInt(string(packet.data.begin(), packet.data.end()));
+			inOrder &= value == expected;
+			timestampsInOrder &= packet.timestamp >= lastTimestamp;
+			lastTimestamp = packet.timestamp;
+			expected++;
+		}
+	}
+	writer.join();
+
+	check(expected == numLines, "every line received");
+	check(inOrder, "lines in order");
+	check(timestampsInOrder, "timestamps in order");
+	check(serial.getNumBytesDropped() == 0, "no bytes dropped");
+	ofLogNotice() << "received " << expected << " lines";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::testFixedLengthPackets(){
+#ifdef OF_SERIAL_READER_TEST
+	// a small buffer that nobody reads while the data arrives overflows,
+	// the incomplete packets are dropped and the framing stays in sync
+	check(serial.startReading(1024), "startReading() with a small buffer");
+	serial.setPacketLength(4);
+	ofSleepMillis(1);
+	vector<unsigned char> data(8000);
+	for(size_t i = 0; i < data.size(); i++){
+		data[i] = (i / 4) & 0xff;
+	}
+	writeAll(data.data(), data.size());
+	ofSleepMillis(50);
+
+	ofSerialPacket packet;
+	int packets = 0;
+	bool inSync = true;
+	while(serial.readPacket(packet)){
+		inSync &= packet.data.size() == 4 && packet.data[0] == packet.data[3];
+		packets++;
+	}
+	check(inSync, "packets keep the framing after an overflow");
+	check(packets > 0 && packets <= 256, "only the packets that fit in the buffer");
+	check(serial.getNumBytesDropped() > 0, "dropped bytes are counted");
+	ofLogNotice() << packets << " packets, " << serial.getNumBytesDropped() << " bytes dropped";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::testCopies(){
+#ifdef OF_SERIAL_READER_TEST
+	// copies don't share the reader of the original
+	serial.clearPacketFraming();
+	serial.flush(true, false);
+	ofSerial copy(serial);
+	check(!copy.isReading(), "a copy doesn't read in a thread");
+	check(serial.isReading(), "the original keeps reading after being copied");
+	writeAll("copy", 4);
+	ofSleepMillis(20);
+	check(serial.available() == 4, "the original receives the data");
+	serial.flush(true, false);
+	ofLogNotice() << "copies done";
+	// the copy would close the port when destroyed
+	copy = ofSerial();
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::testFlushAndHangup(){
+#ifdef OF_SERIAL_READER_TEST
+	writeAll("hello world", 11);
+	ofSleepMillis(20);
+	serial.flush(true, false);
+	check(serial.available() == 0, "flush() discards the received data");
+
+	// closing the master is like unplugging the device
+	::close(master);
+	ofSleepMillis(20);
+	int result = serial.readByte();
+	check(result == OF_SERIAL_NO_DATA || result == OF_SERIAL_ERROR, "reading after a hangup doesn't block");
+	serial.close();
+	check(!serial.isReading(), "close() stops the reader");
+	ofLogNotice() << "flush and hangup done";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	if(errors > 0){
+		ofLogError() << errors << " errors";
+	}else{
+		ofLogNotice() << "all tests passed";
+	}
+	ofExit(errors);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+
+		void check(bool condition, string description);
+		void writeAll(const void * data, size_t length);
+		void testRawReads();
+		void testDelimitedPackets();
+		void testFixedLengthPackets();
+		void testCopies();
+		void testFlushAndHangup();
+
+		ofSerial serial;
+		int master;
+		int errors;
+};
@@ -0,0 +1,20 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppHeadlessWindow.h"
+
+//========================================================================
+int main( ){
+	// renders without a display, eg. on a linux server without X or in a CI
+	// job, through EGL. the app exits after rendering maxFrames
+	ofHeadlessWindowSettings settings;
+	settings.setGLVersion(3,2);
+	settings.width = 1280;
+	settings.height = 720;
+	settings.numSamples = 4;
+	settings.maxFrames = 300;
+	ofCreateWindow(settings);			// <-------- setup the GL context
+
+	// this kicks off the running of my app
+	ofRunApp(new ofApp());
+
+}
@@ -0,0 +1,110 @@
+#include "ofApp.h"
+
+// saves one of every saveEvery frames, saving every frame measures the
+// png encoder more than the rendering
+static const int saveEvery = 30;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	window = dynamic_pointer_cast<ofAppHeadlessWindow>(ofGetMainLoop()->getCurrentWindow());
+	if(!window){
+		ofLogError() << "this example needs an ofAppHeadlessWindow, see main.cpp";
+		ofExit();
+		return;
+	}
+	ofAddListener(window->newFrameEvent, this, &ofApp::frameRendered);
+	ofDirectory::createDirectory("frames", true, true);
+
+	// there's no monitor to sync with, render as fast as possible
+	ofSetFrameRate(0);
+	sphere.setRadius(200);
+	sphere.setResolution(32);
+	cam.setDistance(800);
+	startTime = ofGetElapsedTimeMicros();
+	savedFrames = 0;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackgroundGradient(ofColor(40), ofColor(0));
+	ofEnableDepthTest();
+	cam.begin();
+	ofRotateY(ofGetFrameNum());
+	ofRotateX(ofGetFrameNum() * 0.5);
+	ofSetColor(ofColor::fromHsb(ofGetFrameNum() % 255, 200, 255));
+	sphere.drawWireframe();
+	cam.end();
+	ofDisableDepthTest();
+
+	ofSetColor(255);
+	ofDrawBitmapString("frame " + ofToString(ofGetFrameNum()), 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::frameRendered(ofPixels & pixels){
+	if(ofGetFrameNum() % saveEvery == 0){
+		ofSaveImage(pixels, "frames/frame_" + ofToString(ofGetFrameNum(), 4, '0') + ".png");
+		savedFrames++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::exit(){
+	if(window){
+		float seconds = (ofGetElapsedTimeMicros() - startTime) / 1000000.f;
+		ofLogNotice() << ofGetFrameNum() << " frames of " << window->getWidth() << "x" << window->getHeight()
+			<< " in " << ofToString(seconds, 2) << "s, " << ofToString(ofGetFrameNum() / seconds, 1) << " fps, "
+			<< savedFrames << " saved to " << ofToDataPath("frames");
+		ofRemoveListener(window->newFrameEvent, this, &ofApp::frameRendered);
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
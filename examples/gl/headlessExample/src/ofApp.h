@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofAppHeadlessWindow.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+		void exit();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void frameRendered(ofPixels & pixels);
+
+		shared_ptr<ofAppHeadlessWindow> window;
+		ofSpherePrimitive sphere;
+		ofEasyCam cam;
+		unsigned long long startTime;
+		int savedFrames;
+};
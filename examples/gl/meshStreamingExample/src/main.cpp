@@ -0,0 +1,19 @@
+#include "ofMain.h"
+#include "ofApp.h"
+
+//========================================================================
+int main( ){
+	// meshes are streamed through a persistently mapped buffer which
+	// needs openGL 4.4 or GL_ARB_buffer_storage
+	ofGLWindowSettings settings;
+	settings.setGLVersion(4,5);
+	settings.width = 1024;
+	settings.height = 768;
+	ofCreateWindow(settings);			// <-------- setup the GL context
+
+	// this kicks off the running of my app
+	// can be OF_WINDOW or OF_FULLSCREEN
+	// pass in width and height too:
+	ofRunApp(new ofApp());
+
+}
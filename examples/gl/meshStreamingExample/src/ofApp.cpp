@@ -0,0 +1,126 @@
+#include "ofApp.h"
+
+static const int verticesPerBlob = 32;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetVerticalSync(false);
+	ofSetFrameRate(0);
+
+	renderer = dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+	if(!renderer){
+		ofLogError() << "this example needs the programmable renderer";
+	}
+
+	createBlobs(5000);
+	drawTime = 0;
+}
+
+//--------------------------------------------------------------
+void ofApp::createBlobs(int numBlobs){
+	blobs.resize(numBlobs);
+	centers.resize(numBlobs);
+	for(int i = 0; i < numBlobs; i++){
+		centers[i].set(ofRandomWidth(), ofRandomHeight());
+		ofMesh & blob = blobs[i];
+		blob.clear();
+		blob.setMode(OF_PRIMITIVE_TRIANGLE_FAN);
+		ofFloatColor color = ofFloatColor::fromHsb(ofRandom(1), 0.8, 1, 0.5);
+		blob.addVertex(centers[i]);
+		blob.addColor(color);
+		for(int v = 0; v < verticesPerBlob; v++){
+			blob.addVertex(centers[i]);
+			blob.addColor(color);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// the outline of every blob changes every frame, so the meshes
+	// have to be uploaded again each time they are drawn
+	float t = ofGetElapsedTimef();
+	for(size_t i = 0; i < blobs.size(); i++){
+		vector<ofVec3f> & vertices = blobs[i].getVertices();
+		for(int v = 0; v < verticesPerBlob; v++){
+			float angle = TWO_PI * v / (verticesPerBlob - 1);
+			float radius = 8 + 4 * ofNoise(i * 0.1, v * 0.3, t);
+			vertices[v + 1].set(centers[i].x + cos(angle) * radius, centers[i].y + sin(angle) * radius);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackground(0);
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(size_t i = 0; i < blobs.size(); i++){
+		blobs[i].draw();
+	}
+	// wait for the gpu so the time includes the drawing and not only the submission
+	glFinish();
+	drawTime = ofLerp(drawTime, (ofGetElapsedTimeMicros() - start) / 1000.f, 0.1);
+
+	bool streaming = renderer && renderer->getMeshStreaming();
+	stringstream info;
+	info << blobs.size() << " meshes of " << verticesPerBlob + 1 << " vertices (+/- to change)" << endl;
+	info << "streaming: " << (streaming ? "on" : "off") << " (press s to toggle)" << endl;
+	info << "draw time: " << ofToString(drawTime, 2) << "ms" << endl;
+	info << "fps: " << ofToString(ofGetFrameRate(), 1);
+	ofSetColor(255);
+	ofDrawBitmapStringHighlight(info.str(), 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 's' && renderer){
+		renderer->setMeshStreaming(!renderer->getMeshStreaming());
+	}
+	if(key == '+'){
+		createBlobs(blobs.size() * 2);
+	}
+	if(key == '-' && blobs.size() > 1){
+		createBlobs(blobs.size() / 2);
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,156 @@
+#include "ofApp.h"
+
+static const int numParticles = 50000;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetVerticalSync(false);
+	ofSetFrameRate(0);
+	ofSetCircleResolution(12);
+
+	for(int i = 0; i < numParticles; i++){
+		Particle p;
+		p.pos.set(ofRandomWidth(), ofRandomHeight());
+		p.vel.set(ofRandom(-1, 1), ofRandom(-1, 1));
+		p.color = ofColor::fromHsb(ofRandom(255), 200, 255, 160);
+		p.radius = ofRandom(1, 4);
+		particles.push_back(p);
+	}
+
+	drawTime = 0;
+	countDrawCalls();
+
+	// batching stays enabled across frames, whatever is still batched
+	// at the end of draw() is drawn before the window swaps buffers
+	batching = true;
+	ofEnableBatching();
+}
+
+//--------------------------------------------------------------
+void ofApp::countDrawCalls(){
+	// a recording renderer doesn't draw anything, it only counts what reaches
+	// it, so it shows how many draw calls a frame becomes with and without
+	// batching without depending on the gpu
+	shared_ptr<ofBaseRenderer> renderer = ofGetCurrentRenderer();
+	shared_ptr<ofRecordingRenderer> recorder(new ofRecordingRenderer);
+	recorder->setStyle(renderer->getStyle());
+	ofSetCurrentRenderer(recorder);
+
+	drawParticles();
+	drawCallsUnbatched = recorder->getNumDrawCalls();
+
+	recorder->clearCalls();
+	ofEnableBatching();
+	drawParticles();
+	ofDisableBatching();
+	drawCallsBatched = recorder->getNumDrawCalls();
+
+	ofSetCurrentRenderer(renderer);
+
+	ofLogNotice() << numParticles << " particles: "
+		<< drawCallsUnbatched << " draw calls without batching, "
+		<< drawCallsBatched << " with batching";
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	for(size_t i = 0; i < particles.size(); i++){
+		Particle & p = particles[i];
+		p.pos += p.vel;
+		if(p.pos.x < 0 || p.pos.x > ofGetWidth()) p.vel.x *= -1;
+		if(p.pos.y < 0 || p.pos.y > ofGetHeight()) p.vel.y *= -1;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::drawParticles(){
+	ofFill();
+	for(size_t i = 0; i < particles.size(); i++){
+		ofSetColor(particles[i].color);
+		ofDrawCircle(particles[i].pos, particles[i].radius);
+	}
+
+	// changing the fill mode starts a new batch, the outlines
+	// end up in a second draw call
+	ofNoFill();
+	ofSetColor(255);
+	for(size_t i = 0; i < particles.size(); i += 100){
+		ofDrawRectangle(particles[i].pos.x - 6, particles[i].pos.y - 6, 12, 12);
+	}
+	ofFill();
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackground(0);
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	drawParticles();
+	// draw what's batched now so it's included in the time, otherwise
+	// it would be drawn at the end of the frame
+	ofFlushBatch();
+	// wait for the gpu so the time includes the drawing and not only the submission
+	glFinish();
+	drawTime = ofLerp(drawTime, (ofGetElapsedTimeMicros() - start) / 1000.f, 0.1);
+
+	stringstream info;
+	info << numParticles << " particles" << endl;
+	info << "batching: " << (batching ? "on" : "off") << " (press b to toggle)" << endl;
+	info << "draw calls: " << (batching ? drawCallsBatched : drawCallsUnbatched) << endl;
+	info << "draw time: " << ofToString(drawTime, 2) << "ms" << endl;
+	info << "fps: " << ofToString(ofGetFrameRate(), 1);
+	ofSetColor(255);
+	ofDrawBitmapStringHighlight(info.str(), 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'b'){
+		batching = !batching;
+		if(batching){
+			ofEnableBatching();
+		}else{
+			ofDisableBatching();
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ofMain.h"
+
+struct Particle{
+	ofVec2f pos;
+	ofVec2f vel;
+	ofColor color;
+	float radius;
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void drawParticles();
+		void countDrawCalls();
+
+		vector<Particle> particles;
+		bool batching;
+		float drawTime;
+		size_t drawCallsUnbatched;
+		size_t drawCallsBatched;
+};
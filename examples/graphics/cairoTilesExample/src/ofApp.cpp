@@ -0,0 +1,180 @@
+#include "ofApp.h"
+
+// the scene is designed at this size and scaled to the size of the image
+static const float sceneSize = 1024;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSeedRandom(0);
+	for(int i = 0; i < 2000; i++){
+		ofPath shape;
+		ofPoint center(ofRandom(sceneSize), ofRandom(sceneSize));
+		float radius = ofRandom(5, 60);
+		shape.moveTo(center + ofPoint(radius, 0));
+		for(int j = 1; j < 8; j++){
+			float angle = j * TWO_PI / 8;
+			ofPoint to = center + ofPoint(cos(angle), sin(angle)) * radius;
+			ofPoint cp = center + ofPoint(cos(angle - PI / 8), sin(angle - PI / 8)) * radius * 1.6;
+			shape.bezierTo(cp, cp, to);
+		}
+		shape.close();
+		shape.setFillColor(ofColor::fromHsb(ofRandom(255), 180, 230, 120));
+		shape.setStrokeColor(ofColor(0, 80));
+		shape.setStrokeWidth(1);
+		shapes.push_back(shape);
+	}
+
+	mesh = ofMesh::plane(sceneSize * 0.5, sceneSize * 0.5, 40, 40);
+	mesh.disableNormals();
+	mesh.disableTextures();
+
+	image.allocate(256, 256, OF_IMAGE_COLOR);
+	for(size_t y = 0; y < image.getHeight(); y++){
+		for(size_t x = 0; x < image.getWidth(); x++){
+			image.setColor(x, y, ofColor(x, y, 255 - x));
+		}
+	}
+	image.update();
+
+	benchmarkFrame = -1;
+	renderImage(1024, 0, "preview.png");
+	preview.load("preview.png");
+}
+
+//--------------------------------------------------------------
+void ofApp::drawScene(){
+	ofBackground(255);
+	ofPushMatrix();
+	ofTranslate(sceneSize * 0.5, sceneSize * 0.5);
+	ofSetColor(0, 0, 255, 60);
+	ofSetLineWidth(0.5);
+	mesh.drawWireframe();
+	ofPopMatrix();
+
+	for(size_t i = 0; i < shapes.size(); i++){
+		shapes[i].draw();
+	}
+
+	ofSetColor(255);
+	image.draw(sceneSize - 300, sceneSize - 300);
+}
+
+//--------------------------------------------------------------
+float ofApp::renderImage(int size, size_t tiles, string filename){
+	shared_ptr<ofCairoRenderer> cairo(new ofCairoRenderer);
+	cairo->setImageTiles(tiles);
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	if(filename == ""){
+		cairo->setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, size, size));
+	}else{
+		cairo->setup(filename, ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, size, size));
+	}
+
+	shared_ptr<ofBaseRenderer> glRenderer = ofGetCurrentRenderer();
+	ofSetCurrentRenderer(cairo, true);
+	cairo->startRender();
+	cairo->scale(size / sceneSize, size / sceneSize);
+	drawScene();
+	cairo->finishRender();
+	ofSetCurrentRenderer(glRenderer);
+
+	// the rasterization happens in finishRender when using tiles,
+	// reading the pixels makes both cases finish the same work
+	cairo->getImageSurfacePixels();
+	float seconds = (ofGetElapsedTimeMicros() - start) / 1000000.f;
+	cairo->close();
+	return seconds;
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark(){
+	results.clear();
+	int sizes[] = {4096, 8192, 16384};
+	for(int i = 0; i < 3; i++){
+		float single = renderImage(sizes[i], 1);
+		float tiled = renderImage(sizes[i], 0);
+		stringstream result;
+		result << sizes[i] << "x" << sizes[i] << ": "
+			<< ofToString(single, 2) << "s single threaded, "
+			<< ofToString(tiled, 2) << "s tiled, "
+			<< ofToString(single / tiled, 1) << "x";
+		ofLogNotice() << result.str();
+		results.push_back(result.str());
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// runs once the message has been drawn since it blocks the app
+	if(benchmarkFrame >= 0 && (int)ofGetFrameNum() >= benchmarkFrame){
+		runBenchmark();
+		benchmarkFrame = -1;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackground(40);
+	ofSetColor(255);
+	preview.draw(0, 0, ofGetHeight(), ofGetHeight());
+
+	stringstream info;
+	info << "press b to rasterize the scene with cairo at" << endl;
+	info << "4k, 8k and 16k, single threaded and in tiles" << endl;
+	info << "using " << ofGetThreadPool().getNumThreads() << " threads" << endl << endl;
+	if(benchmarkFrame >= 0){
+		info << "running, this can take a few minutes...";
+	}
+	for(size_t i = 0; i < results.size(); i++){
+		info << results[i] << endl;
+	}
+	ofDrawBitmapStringHighlight(info.str(), ofGetHeight() + 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'b' && benchmarkFrame < 0){
+		benchmarkFrame = ofGetFrameNum() + 2;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
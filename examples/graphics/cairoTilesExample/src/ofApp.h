@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofCairoRenderer.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void drawScene();
+		float renderImage(int size, size_t tiles, string filename = "");
+		void runBenchmark();
+
+		vector<ofPath> shapes;
+		ofMesh mesh;
+		ofImage image;
+		ofImage preview;
+		vector<string> results;
+		int benchmarkFrame;
+};
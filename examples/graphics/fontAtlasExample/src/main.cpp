@@ -0,0 +1,14 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+	// glyphs in a dynamic font are rasterized into the cpu copy of the
+	// atlas, the texture is only uploaded when drawing, so this runs
+	// without a window or a gl context
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window,1024,768,OF_WINDOW);
+	ofRunApp(new ofApp());
+
+}
@@ -0,0 +1,96 @@
+#include "ofApp.h"
+#include "Poco/UTF8Encoding.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	errors = 0;
+	if(!font.loadDynamic("verdana.ttf", 32)){
+		ofLogError() << "couldn't load verdana.ttf";
+		errors++;
+		return;
+	}
+	ofLogNotice() << "loaded, " << font.getNumCharacters() << " glyphs, atlas "
+	              << font.getFontAtlasPixels().getWidth() << "x" << font.getFontAtlasPixels().getHeight();
+
+	// every string adds its new characters to the atlas
+	string texts[] = {
+		"The quick brown fox jumps over the lazy dog",
+		"0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~",
+		"Ça fait déjà l'été, señor. Größe, Ærø, øre",
+		"Ελληνικά και Кириллица: съешь же ещё этих мягких булок",
+		"€ ‰ ™ • … “quotes” ‘single’ — ½ ¼ ¾ ± × ÷",
+	};
+	for(int i = 0; i < 5; i++){
+		if(!checkAtlas(texts[i])){
+			errors++;
+		}
+	}
+
+	// every character from latin-1 to cyrillic doesn't fit in the
+	// initial size so the atlas has to grow, the glyphs that were
+	// already in it keep their position
+	string all;
+	Poco::UTF8Encoding utf8;
+	for(int codepoint = 0xA0; codepoint < 0x500; codepoint++){
+		unsigned char bytes[4];
+		int len = utf8.convert(codepoint, bytes, 4);
+		all.append((char*)bytes, len);
+	}
+	int atlasWidth = font.getFontAtlasPixels().getWidth();
+	int atlasHeight = font.getFontAtlasPixels().getHeight();
+	if(!checkAtlas(all)){
+		errors++;
+	}
+	if(font.getFontAtlasPixels().getWidth() == atlasWidth && font.getFontAtlasPixels().getHeight() == atlasHeight){
+		ofLogError() << "the atlas didn't grow";
+		errors++;
+	}
+
+	// characters that are already in the atlas don't add glyphs and
+	// their texture coordinates were updated to the new size
+	int glyphs = font.getNumCharacters();
+	if(!checkAtlas(texts[0])){
+		errors++;
+	}
+	if(font.getNumCharacters() != glyphs){
+		ofLogError() << "glyphs were rasterized twice";
+		errors++;
+	}
+
+	ofPixels atlas = font.getFontAtlasPixels();
+	ofSaveImage(atlas, "atlas.png");
+	ofLogNotice() << "atlas saved to bin/data/atlas.png";
+}
+
+//--------------------------------------------------------------
+bool ofApp::checkAtlas(string text){
+	// measuring the string is enough to rasterize its glyphs
+	float width = font.stringWidth(text);
+
+	// the quads of the string mesh have to point to the
+	// glyphs in the atlas, which is in [0..1] coordinates
+	const ofMesh & mesh = font.getStringMesh(text, 0, 0);
+	bool ok = mesh.getNumVertices() > 0;
+	for(int i = 0; i < mesh.getNumTexCoords(); i++){
+		ofVec2f t = mesh.getTexCoord(i);
+		if(t.x < 0 || t.x > 1 || t.y < 0 || t.y > 1){
+			ok = false;
+		}
+	}
+
+	const ofPixels & atlas = font.getFontAtlasPixels();
+	ofLogNotice() << (ok ? "ok    " : "error ") << (text.size() > 80 ? text.substr(0, 80) + "..." : text) << endl
+	              << "\twidth " << width << ", " << font.getNumCharacters() << " glyphs, atlas "
+	              << atlas.getWidth() << "x" << atlas.getHeight();
+	return ok;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	if(errors > 0){
+		ofLogError() << errors << " errors";
+	}else{
+		ofLogNotice() << "all the glyphs are in the atlas";
+	}
+	ofExit(errors);
+}
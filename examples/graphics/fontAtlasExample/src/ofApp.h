@@ -0,0 +1,15 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+
+		bool checkAtlas(string text);
+
+		ofTrueTypeFont font;
+		int errors;
+};
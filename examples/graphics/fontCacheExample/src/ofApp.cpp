@@ -0,0 +1,139 @@
+#include "ofApp.h"
+
+static const int cols = 10;
+static const int rows = 30;
+
+// the cache has to hold every string drawn in a frame, with the default
+// size of 128 this example would evict every label before drawing it again
+static const size_t cacheSize = 1024;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	font.load("verdana.ttf", 8);
+	for(int i = 0; i < cols * rows; i++){
+		names.push_back("sensor " + ofToString(i) + ":");
+	}
+
+	drawTime = 0;
+	lastReport = 0;
+	setCacheEnabled(true);
+}
+
+//--------------------------------------------------------------
+void ofApp::setCacheEnabled(bool enabled){
+	cacheEnabled = enabled;
+	font.setStringMeshCacheSize(cacheEnabled ? cacheSize : 0);
+	font.resetStringMeshCacheStats();
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// log the statistics every 5 seconds so runs with and
+	// without the cache can be compared from the console
+	unsigned long long now = ofGetElapsedTimeMillis();
+	if(now - lastReport >= 5000){
+		const ofTTFStringMeshCacheStats & stats = font.getStringMeshCacheStats();
+		unsigned long long lookups = stats.hits + stats.misses;
+		ofLogNotice() << "cache " << (cacheEnabled ? "on" : "off")
+		              << ", hits: " << stats.hits
+		              << " misses: " << stats.misses
+		              << " hit rate: " << (lookups > 0 ? ofToString(stats.hits * 100. / lookups, 1) : "-") << "%"
+		              << " layout time: " << stats.layoutTimeMicros / 1000. << "ms"
+		              << " saved: " << stats.savedTimeMicros / 1000. << "ms"
+		              << " draw time: " << ofToString(drawTime, 2) << "ms";
+		lastReport = now;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::drawLabels(){
+	float w = ofGetWidth() / float(cols);
+	float h = (ofGetHeight() - 120) / float(rows);
+	float t = ofGetElapsedTimef();
+	for(int i = 0; i < cols * rows; i++){
+		float x = (i % cols) * w + 10;
+		float y = 120 + (i / cols) * h + 12;
+
+		// the names never change so they always come from the
+		// cache, the values change slowly and repeat between labels
+		int value = ofNoise(i * 0.05, t * 0.1) * 100;
+		ofSetColor(160);
+		font.drawString(names[i], x, y);
+		ofSetColor(255);
+		font.drawString(ofToString(value), x + 65, y);
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackground(0);
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	drawLabels();
+	// wait for the gpu so the time includes the drawing and not only the submission
+	glFinish();
+	drawTime = ofLerp(drawTime, (ofGetElapsedTimeMicros() - start) / 1000.f, 0.1);
+
+	const ofTTFStringMeshCacheStats & stats = font.getStringMeshCacheStats();
+	unsigned long long lookups = stats.hits + stats.misses;
+	stringstream info;
+	info << cols * rows * 2 << " strings per frame" << endl;
+	info << "cache: " << (cacheEnabled ? "on" : "off") << " (press c to toggle, r to reset the stats)" << endl;
+	info << "hits: " << stats.hits << " misses: " << stats.misses;
+	info << " hit rate: " << (lookups > 0 ? ofToString(stats.hits * 100. / lookups, 1) : "-") << "%" << endl;
+	info << "layout time: " << ofToString(stats.layoutTimeMicros / 1000., 1) << "ms";
+	info << " saved by the cache: " << ofToString(stats.savedTimeMicros / 1000., 1) << "ms" << endl;
+	info << "draw time: " << ofToString(drawTime, 2) << "ms" << endl;
+	info << "fps: " << ofToString(ofGetFrameRate(), 1);
+	ofSetColor(255);
+	ofDrawBitmapStringHighlight(info.str(), 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'c'){
+		setCacheEnabled(!cacheEnabled);
+	}else if(key == 'r'){
+		font.resetStringMeshCacheStats();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void drawLabels();
+		void setCacheEnabled(bool enabled);
+
+		ofTrueTypeFont font;
+		vector<string> names;
+		bool cacheEnabled;
+		float drawTime;
+		unsigned long long lastReport;
+};
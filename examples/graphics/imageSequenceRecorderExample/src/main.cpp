@@ -0,0 +1,13 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+	// the frames are generated on the cpu so the example runs
+	// without a window, it can be used on a headless machine
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window,1024,768,OF_WINDOW);
+	ofRunApp(new ofApp());
+
+}
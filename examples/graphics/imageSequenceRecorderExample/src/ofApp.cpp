@@ -0,0 +1,102 @@
+#include "ofApp.h"
+
+// frames saved by each benchmark
+static const int numFrames = 120;
+
+// time the main loop would have for each frame at 60fps
+static const unsigned long long frameTime = 1000000 / 60;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	pixels.allocate(1280, 720, OF_PIXELS_RGB);
+
+	benchmarkSaveImage();
+#ifdef OF_USING_IMAGE_SEQUENCE_RECORDER
+	benchmarkRecorder(true);
+	benchmarkRecorder(false);
+#else
+	ofLogNotice() << "ofImageSequenceRecorder needs c++11 support";
+#endif
+	ofExit();
+}
+
+//--------------------------------------------------------------
+void ofApp::generateFrame(ofPixels & frame, int index){
+	// some moving gradients and noise so the encoder has real work to do
+	frame.allocate(1280, 720, OF_PIXELS_RGB);
+	int w = frame.getWidth();
+	int h = frame.getHeight();
+	unsigned char * data = frame.getData();
+	for(int y = 0; y < h; y++){
+		for(int x = 0; x < w; x++){
+			int i = (y * w + x) * 3;
+			data[i] = (x + index * 4) % 256;
+			data[i+1] = (y + index * 2) % 256;
+			data[i+2] = ofRandom(256);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkSaveImage(){
+	// what ofSaveImage costs the main loop: encoding and writing every frame
+	unsigned long long saving = 0;
+	for(int i = 0; i < numFrames; i++){
+		generateFrame(pixels, i);
+		unsigned long long start = ofGetElapsedTimeMicros();
+		ofSaveImage(pixels, "saveImage/frame_" + ofToString(i, 5, '0') + ".png");
+		saving += ofGetElapsedTimeMicros() - start;
+	}
+	ofLogNotice() << "ofSaveImage: " << saving / numFrames << "us per frame in the main thread";
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkRecorder(bool dropFrames){
+#ifdef OF_USING_IMAGE_SEQUENCE_RECORDER
+	string folder = dropFrames ? "recorderDrop/" : "recorderWait/";
+	recorder.setDropFrames(dropFrames);
+	recorder.setup(folder + "frame_");
+
+	// frames are added at 60fps like a live capture would, only
+	// the time spent in add() is paid by the main thread
+	unsigned long long adding = 0;
+	unsigned long long maxAdding = 0;
+	size_t maxQueued = 0;
+	unsigned long long begin = ofGetElapsedTimeMicros();
+	for(int i = 0; i < numFrames; i++){
+		generateFrame(pixels, i);
+		unsigned long long start = ofGetElapsedTimeMicros();
+		recorder.add(std::move(pixels));
+		unsigned long long elapsed = ofGetElapsedTimeMicros() - start;
+		adding += elapsed;
+		maxAdding = max(maxAdding, elapsed);
+		maxQueued = max(maxQueued, recorder.getNumFramesQueued());
+
+		unsigned long long next = begin + (i + 1) * frameTime;
+		unsigned long long now = ofGetElapsedTimeMicros();
+		if(next > now){
+			ofSleepMillis((next - now) / 1000);
+		}
+	}
+	unsigned long long startClose = ofGetElapsedTimeMicros();
+	recorder.close();
+	unsigned long long closing = ofGetElapsedTimeMicros() - startClose;
+
+	ofLogNotice() << "ofImageSequenceRecorder, " << (dropFrames ? "dropping" : "waiting") << " when full:" << endl
+	              << "\t" << adding / numFrames << "us per frame in the main thread, max " << maxAdding << "us" << endl
+	              << "\twritten: " << recorder.getNumFramesWritten()
+	              << " dropped: " << recorder.getNumFramesDropped()
+	              << " max queued: " << maxQueued << endl
+	              << "\t" << closing / 1000 << "ms to write the remaining frames";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void generateFrame(ofPixels & frame, int index);
+		void benchmarkSaveImage();
+		void benchmarkRecorder(bool dropFrames);
+
+#ifdef OF_USING_IMAGE_SEQUENCE_RECORDER
+		ofImageSequenceRecorder recorder;
+#endif
+		ofPixels pixels;
+};
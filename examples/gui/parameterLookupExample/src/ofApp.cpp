@@ -0,0 +1,151 @@
+#include "ofApp.h"
+
+// lookups of every parameter for each benchmark
+static const int numPasses = 10;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(0);
+
+	for(int i = 0; i < 10; i++){
+		sectionNames.push_back("section " + ofToString(i));
+		groupNames.push_back("group " + ofToString(i));
+	}
+	for(int i = 0; i < 100; i++){
+		parameterNames.push_back("param" + ofToString(i));
+	}
+
+	parameters.setName("parameters");
+	sections.resize(10);
+	groups.resize(100);
+	floats.resize(10000);
+	for(int s = 0; s < 10; s++){
+		sections[s].setName(sectionNames[s]);
+		for(int g = 0; g < 10; g++){
+			ofParameterGroup & group = groups[s * 10 + g];
+			group.setName(groupNames[g]);
+			for(int p = 0; p < 100; p++){
+				int i = (s * 10 + g) * 100 + p;
+				group.add(floats[i].set(parameterNames[p], ofRandom(1)));
+				// paths are made of escaped names, the spaces in the
+				// group names become _ like in xml files or osc addresses
+				paths.push_back("section_" + ofToString(s) + "/group_" + ofToString(g) + "/" + parameterNames[p]);
+			}
+			sections[s].add(group);
+		}
+		parameters.add(sections[s]);
+	}
+
+	runBenchmarks();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	float sum = 0;
+
+	// looking up every level by name
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		for(int s = 0; s < 10; s++){
+			for(int g = 0; g < 10; g++){
+				for(int p = 0; p < 100; p++){
+					sum += parameters.getGroup(sectionNames[s]).getGroup(groupNames[g]).getFloat(parameterNames[p]);
+				}
+			}
+		}
+	}
+	unsigned long long byLevel = ofGetElapsedTimeMicros() - start;
+
+	// the first find() builds the path index
+	start = ofGetElapsedTimeMicros();
+	parameters.find(paths[0]);
+	unsigned long long buildIndex = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		for(size_t i = 0; i < paths.size(); i++){
+			sum += parameters.find(paths[i])->cast<float>();
+		}
+	}
+	unsigned long long byPath = ofGetElapsedTimeMicros() - start;
+
+	// handles found once, reading them doesn't look anything up
+	vector<ofParameter<float> > handles(paths.size());
+	for(size_t i = 0; i < paths.size(); i++){
+		parameters.find(paths[i], handles[i]);
+	}
+	start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		for(size_t i = 0; i < handles.size(); i++){
+			sum += handles[i];
+		}
+	}
+	unsigned long long byHandle = ofGetElapsedTimeMicros() - start;
+
+	double lookups = numPasses * paths.size();
+	stringstream out;
+	out << paths.size() << " parameters in 3 levels of groups (" << sum << ")" << endl;
+	out << "getGroup().getGroup().getFloat(): " << byLevel * 1000 / lookups << "ns per lookup" << endl;
+	out << "find(path): " << byPath * 1000 / lookups << "ns per lookup, index built in " << buildIndex / 1000.f << "ms" << endl;
+	out << "handle from find(path, parameter): " << byHandle * 1000 / lookups << "ns per read" << endl;
+	out << "press space to run again";
+	results = out.str();
+	ofLogNotice() << results;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofDrawBitmapStringHighlight(results, 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == ' '){
+		runBenchmarks();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
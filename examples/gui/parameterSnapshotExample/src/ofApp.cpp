@@ -0,0 +1,236 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	parameters.setName("circles");
+	parameters.add(size.set("size", 10, 0, 100));
+	parameters.add(number.set("number", 2, 1, 20));
+	parameters.add(position.set("position", ofVec2f(ofGetWidth()*.5, ofGetHeight()*.5), ofVec2f(0,0), ofVec2f(ofGetWidth(), ofGetHeight())));
+	parameters.add(color.set("color", ofColor(127), ofColor(0,0), ofColor(255)));
+	parameters.add(filled.set("filled", true));
+
+	gui.setup(parameters);
+	// the panel adds morph to parameters too, not serializable
+	// parameters are skipped by snapshots so it's not part of the presets
+	morph.set("morph A -> B", 0, 0, 1);
+	morph.setSerializable(false);
+	gui.add(morph);
+	morph.addListener(this, &ofApp::morphChanged);
+
+	presetA.capture(parameters);
+	presetB.capture(parameters);
+	current.capture(parameters);
+
+	runBenchmarks();
+}
+
+//--------------------------------------------------------------
+void ofApp::morphChanged(float & morph){
+	// recorded as an edit when the slider is released
+	presetA.getInterpolated(presetB, morph).restore(parameters);
+}
+
+//--------------------------------------------------------------
+void ofApp::recordEdit(){
+	// only the parameters that changed are stored to undo an edit
+	ofParameterSnapshot edited(parameters);
+	ofParameterSnapshot undoEdit = edited.getDiff(current);
+	if(!undoEdit.empty()){
+		undo.push_back(undoEdit);
+		redo.clear();
+		current = edited;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmark(int numParameters){
+	// nested groups of 100 parameters so names repeat like in a real
+	// application, ofXml fails with too many different names
+	ofParameterGroup group;
+	group.setName("benchmark");
+	vector<ofParameterGroup> sections(max(numParameters / 10000, 1));
+	vector<ofParameterGroup> groups(numParameters / 100);
+	vector<ofParameter<float> > floats(numParameters / 2);
+	vector<ofParameter<int> > ints(numParameters / 4);
+	vector<ofParameter<ofFloatColor> > colors(numParameters / 4);
+	for(size_t i = 0; i < groups.size(); i++){
+		groups[i].setName("group" + ofToString(i % 100));
+		for(int j = 0; j < 50; j++){
+			groups[i].add(floats[i * 50 + j].set("float" + ofToString(j), ofRandom(1)));
+		}
+		for(int j = 0; j < 25; j++){
+			groups[i].add(ints[i * 25 + j].set("int" + ofToString(j), ofRandom(100)));
+			groups[i].add(colors[i * 25 + j].set("color" + ofToString(j), ofFloatColor(ofRandom(1), ofRandom(1), ofRandom(1))));
+		}
+		sections[i / 100].add(groups[i]);
+	}
+	for(size_t i = 0; i < sections.size(); i++){
+		sections[i].setName("section" + ofToString(i));
+		group.add(sections[i]);
+	}
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	ofXml xml;
+	xml.serialize(group);
+	string xmlString = xml.toString();
+	unsigned long long xmlSave = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	ofXml xmlLoaded;
+	xmlLoaded.loadFromBuffer(xmlString);
+	xmlLoaded.deserialize(group);
+	unsigned long long xmlLoad = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	ofParameterSnapshot snapshot(group);
+	ofBuffer buffer;
+	snapshot.save(buffer);
+	unsigned long long snapshotSave = ofGetElapsedTimeMicros() - start;
+
+	// change 1% of the values to have something to restore
+	for(size_t i = 0; i < floats.size(); i += 50){
+		floats[i] = floats[i] + 1;
+	}
+	for(size_t i = 0; i < ints.size(); i += 25){
+		ints[i] = ints[i] + 1;
+	}
+	ofParameterSnapshot edited(group);
+
+	start = ofGetElapsedTimeMicros();
+	ofParameterSnapshot loaded;
+	loaded.load(buffer);
+	loaded.restore(group);
+	unsigned long long snapshotLoad = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	ofParameterSnapshot diff = snapshot.getDiff(edited);
+	unsigned long long diffTime = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	diff.restore(group);
+	unsigned long long diffRestore = ofGetElapsedTimeMicros() - start;
+
+	start = ofGetElapsedTimeMicros();
+	snapshot.getInterpolated(edited, 0.5).restore(group);
+	unsigned long long interpolate = ofGetElapsedTimeMicros() - start;
+
+	stringstream out;
+	out << numParameters << " parameters:" << endl;
+	out << "  xml save " << xmlSave / 1000.f << "ms, load " << xmlLoad / 1000.f << "ms, " << xmlString.size() / 1024 << "KB" << endl;
+	out << "  snapshot save " << snapshotSave / 1000.f << "ms, load " << snapshotLoad / 1000.f << "ms, " << buffer.size() / 1024 << "KB" << endl;
+	out << "  diff of " << diff.size() << " changes " << diffTime / 1000.f << "ms, restore " << diffRestore / 1000.f << "ms" << endl;
+	out << "  interpolate and restore " << interpolate / 1000.f << "ms" << endl;
+	results += out.str();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	results = "";
+	runBenchmark(10000);
+	runBenchmark(100000);
+	results += "a / b: store preset A / B, z / y: undo / redo\n";
+	results += "s / l: save / load preset.ofps, space: run benchmarks again";
+	ofLogNotice() << results;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofBackgroundGradient(ofColor::white, ofColor::gray);
+	ofSetColor(color);
+	if(filled){
+		ofFill();
+	}else{
+		ofNoFill();
+	}
+	for(int i = 0; i < number; i++){
+		ofDrawCircle(position->x - size * ((number - 1) * 0.5 - i), position->y, size);
+	}
+	ofFill();
+
+	ofSetColor(255);
+	gui.draw();
+	ofDrawBitmapStringHighlight(results, 20, ofGetHeight() - 150);
+	ofDrawBitmapStringHighlight("undo: " + ofToString(undo.size()) + " redo: " + ofToString(redo.size()), ofGetWidth() - 150, 20);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == 'a'){
+		presetA.capture(parameters);
+	}
+	if(key == 'b'){
+		presetB.capture(parameters);
+	}
+	if(key == 'z' && !undo.empty()){
+		undo.back().restore(parameters);
+		undo.pop_back();
+		ofParameterSnapshot previous = current;
+		current.capture(parameters);
+		redo.push_back(current.getDiff(previous));
+	}
+	if(key == 'y' && !redo.empty()){
+		redo.back().restore(parameters);
+		redo.pop_back();
+		ofParameterSnapshot previous = current;
+		current.capture(parameters);
+		undo.push_back(current.getDiff(previous));
+	}
+	if(key == 's'){
+		current.save("preset.ofps");
+	}
+	if(key == 'l'){
+		ofParameterSnapshot preset;
+		if(preset.load("preset.ofps")){
+			preset.restore(parameters);
+			recordEdit();
+		}
+	}
+	if(key == ' '){
+		runBenchmarks();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+	recordEdit();
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxGui.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		void morphChanged(float & morph);
+		void recordEdit();
+		void runBenchmark(int numParameters);
+		void runBenchmarks();
+
+		ofxPanel gui;
+		ofParameterGroup parameters;
+		ofParameter<float> size;
+		ofParameter<int> number;
+		ofParameter<ofVec2f> position;
+		ofParameter<ofColor> color;
+		ofParameter<bool> filled;
+		ofParameter<float> morph;
+
+		ofParameterSnapshot presetA, presetB;
+
+		// each edit is stored as the diffs needed to undo and redo it
+		ofParameterSnapshot current;
+		vector<ofParameterSnapshot> undo, redo;
+
+		string results;
+};
@@ -0,0 +1,190 @@
+#include "ofApp.h"
+
+// preset recalls for each benchmark
+static const int numPasses = 10;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(0);
+	numNotifications = 0;
+
+	parameters.setName("parameters");
+	sections.resize(10);
+	groups.resize(100);
+	floats.resize(10000);
+	for(int s = 0; s < 10; s++){
+		sections[s].setName("section" + ofToString(s));
+		for(int g = 0; g < 10; g++){
+			ofParameterGroup & group = groups[s * 10 + g];
+			group.setName("group" + ofToString(g));
+			for(int p = 0; p < 100; p++){
+				ofParameter<float> & parameter = floats[(s * 10 + g) * 100 + p];
+				group.add(parameter.set("param" + ofToString(p), 0, 0, 1));
+				parameter.addListener(this, &ofApp::valueChanged);
+			}
+			ofAddListener(group.parameterChangedE, this, &ofApp::parameterChanged);
+			ofAddListener(group.parametersChangedE, this, &ofApp::parametersChanged);
+			sections[s].add(group);
+		}
+		ofAddListener(sections[s].parameterChangedE, this, &ofApp::parameterChanged);
+		ofAddListener(sections[s].parametersChangedE, this, &ofApp::parametersChanged);
+		parameters.add(sections[s]);
+	}
+	ofAddListener(parameters.parameterChangedE, this, &ofApp::parameterChanged);
+	ofAddListener(parameters.parametersChangedE, this, &ofApp::parametersChanged);
+
+	for(size_t i = 0; i < floats.size(); i++){
+		presetA.push_back(ofRandom(1));
+		presetB.push_back(ofRandom(1));
+	}
+
+	runBenchmarks();
+}
+
+//--------------------------------------------------------------
+void ofApp::valueChanged(float & value){
+	numNotifications++;
+}
+
+//--------------------------------------------------------------
+void ofApp::parameterChanged(ofAbstractParameter & parameter){
+	numNotifications++;
+}
+
+//--------------------------------------------------------------
+void ofApp::parametersChanged(vector<shared_ptr<ofAbstractParameter> > & parameters){
+	numNotifications++;
+}
+
+//--------------------------------------------------------------
+void ofApp::recallPreset(const vector<float> & preset, bool bTransaction){
+	if(bTransaction){
+		ofParameterTransaction transaction(parameters);
+		for(size_t i = 0; i < floats.size(); i++){
+			floats[i] = preset[i];
+		}
+	}else{
+		for(size_t i = 0; i < floats.size(); i++){
+			floats[i] = preset[i];
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	stringstream out;
+	out << floats.size() << " parameters in 3 levels of groups, listeners on every parameter and group" << endl;
+
+	// alternating presets so every recall changes every parameter
+	numNotifications = 0;
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		recallPreset(pass % 2 ? presetA : presetB, false);
+	}
+	unsigned long long time = ofGetElapsedTimeMicros() - start;
+	out << "recall: " << time / 1000.f / numPasses << "ms, " << numNotifications / numPasses << " notifications" << endl;
+
+	numNotifications = 0;
+	start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		recallPreset(pass % 2 ? presetA : presetB, true);
+	}
+	time = ofGetElapsedTimeMicros() - start;
+	out << "recall in a transaction: " << time / 1000.f / numPasses << "ms, " << numNotifications / numPasses << " notifications" << endl;
+
+	// snapshots restore in a transaction and only set what changed
+	ofParameterSnapshot snapshotA, snapshotB;
+	recallPreset(presetA, true);
+	snapshotA.capture(parameters);
+	recallPreset(presetB, true);
+	snapshotB.capture(parameters);
+	numNotifications = 0;
+	start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		(pass % 2 ? snapshotB : snapshotA).restore(parameters);
+	}
+	time = ofGetElapsedTimeMicros() - start;
+	out << "snapshot restore: " << time / 1000.f / numPasses << "ms, " << numNotifications / numPasses << " notifications" << endl;
+
+	// every parameter set many times, like an osc burst or a preset morph
+	// that sets the values several times per frame
+	numNotifications = 0;
+	start = ofGetElapsedTimeMicros();
+	for(int pass = 0; pass < numPasses; pass++){
+		recallPreset(pass % 2 ? presetA : presetB, false);
+	}
+	time = ofGetElapsedTimeMicros() - start;
+	out << numPasses << " recalls in a row: " << time / 1000.f << "ms, " << numNotifications << " notifications" << endl;
+
+	numNotifications = 0;
+	start = ofGetElapsedTimeMicros();
+	{
+		ofParameterTransaction transaction(parameters);
+		for(int pass = 0; pass < numPasses; pass++){
+			recallPreset(pass % 2 ? presetA : presetB, false);
+		}
+	}
+	time = ofGetElapsedTimeMicros() - start;
+	out << numPasses << " recalls in one transaction: " << time / 1000.f << "ms, " << numNotifications << " notifications" << endl;
+
+	out << "press space to run again";
+	results = out.str();
+	ofLogNotice() << results;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofDrawBitmapStringHighlight(results, 20, 30);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key == ' '){
+		runBenchmarks();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
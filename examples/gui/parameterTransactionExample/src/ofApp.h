@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+		void keyReleased(int key);
+		void mouseMoved(int x, int y );
+		void mouseDragged(int x, int y, int button);
+		void mousePressed(int x, int y, int button);
+		void mouseReleased(int x, int y, int button);
+		void windowResized(int w, int h);
+		void dragEvent(ofDragInfo dragInfo);
+		void gotMessage(ofMessage msg);
+
+		// listeners like the ones a gui or an osc sync would add
+		void valueChanged(float & value);
+		void parameterChanged(ofAbstractParameter & parameter);
+		void parametersChanged(vector<shared_ptr<ofAbstractParameter> > & parameters);
+
+		void recallPreset(const vector<float> & preset, bool bTransaction);
+		void runBenchmarks();
+
+		// 10 sections of 10 groups of 100 parameters
+		ofParameterGroup parameters;
+		vector<ofParameterGroup> sections;
+		vector<ofParameterGroup> groups;
+		vector<ofParameter<float> > floats;
+		vector<float> presetA, presetB;
+
+		int numNotifications;
+		string results;
+};
@@ -0,0 +1,94 @@
+#include "ofApp.h"
+
+// period of the scheduler callback in the benchmark: 1ms
+static const unsigned long long period = 1000000;
+
+// spin time used for the precise runs: 250us
+static const unsigned long long spin = 250000;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+#ifdef OF_USING_SCHEDULER
+	benchmarkScheduler(0);
+	benchmarkScheduler(spin);
+#else
+	ofLogNotice() << "ofScheduler needs c++11 support";
+#endif
+
+	// now measure the frame timer of the main loop
+	frames = 0;
+	ofSetFrameRate(60);
+	ofEvents().getFrameTimer().resetStats();
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkScheduler(unsigned long long spinNanos){
+#ifdef OF_USING_SCHEDULER
+	// record when each callback runs for 2 seconds
+	vector<unsigned long long> times;
+	times.reserve(3000);
+	ofTimerStats stats;
+	{
+		ofScheduler scheduler;
+		scheduler.setSpinTime(spinNanos);
+		int id = scheduler.add(period, [&times]{
+			times.push_back(ofTimer::getMonotonicNanos());
+		});
+		ofSleepMillis(2000);
+		stats = scheduler.getStats(id);
+		// the scheduler thread stops when it goes out of scope
+		// so times is not used from two threads at the same time
+	}
+
+	// jitter is how much each interval differs from the period
+	vector<long long> jitter;
+	for(size_t i = 1; i < times.size(); i++){
+		long long interval = times[i] - times[i-1];
+		jitter.push_back(abs(interval - (long long)period));
+	}
+	if(jitter.empty()){
+		return;
+	}
+	sort(jitter.begin(), jitter.end());
+
+	double percentiles[] = {50, 90, 99, 99.9, 100};
+	stringstream out;
+	out << "ofScheduler 1ms period, spin " << spinNanos / 1000 << "us, " << jitter.size() << " intervals" << endl;
+	for(int i = 0; i < 5; i++){
+		size_t index = min(jitter.size() - 1, size_t(percentiles[i] / 100. * (jitter.size() - 1) + 0.5));
+		out << "\tp" << percentiles[i] << " jitter: " << jitter[index] / 1000. << "us" << endl;
+	}
+	out << "\tavg latency: " << stats.averageLatencyNanos / 1000. << "us"
+	    << " overruns: " << stats.numOverruns
+	    << " missed periods: " << stats.numMissedPeriods;
+	ofLogNotice() << out.str();
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::printFrameStats(string title){
+	const ofTimerStats & stats = ofEvents().getFrameTimer().getStats();
+	ofLogNotice() << title << endl
+	              << "\tframes: " << stats.numPeriods
+	              << " avg latency: " << stats.averageLatencyNanos / 1000. << "us"
+	              << " max latency: " << stats.maxLatencyNanos / 1000. << "us"
+	              << " overruns: " << stats.numOverruns;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	frames++;
+	if(frames == 300){
+		printFrameStats("frame timer 60fps, sleeping");
+		ofEvents().getFrameTimer().setSpinTime(spin);
+		ofEvents().getFrameTimer().resetStats();
+	}else if(frames == 600){
+		printFrameStats("frame timer 60fps, spin " + ofToString(spin / 1000) + "us");
+		ofExit();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+
+}
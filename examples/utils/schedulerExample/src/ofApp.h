@@ -0,0 +1,16 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void benchmarkScheduler(unsigned long long spinNanos);
+		void printFrameStats(string title);
+
+		int frames;
+};
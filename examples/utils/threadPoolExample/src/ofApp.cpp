@@ -0,0 +1,128 @@
+#include "ofApp.h"
+
+// some work that takes a while to compute
+static double work(size_t i){
+	double v = i;
+	for(int j=0;j<200;j++){
+		v = sin(v) * cos(v) + sqrt(fabs(v) + 1);
+	}
+	return v;
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(0);
+	runBenchmarks();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks(){
+	stringstream out;
+	out << "processors: " << ofGetThreadPool().getNumThreads() << endl << endl;
+
+#ifdef OF_USING_THREAD_POOL
+	// scheduling overhead: time to submit and wait for empty tasks
+	int numTasks = 100000;
+	unsigned long long start = ofGetElapsedTimeMicros();
+	vector<std::future<void> > futures;
+	futures.reserve(numTasks);
+	for(int i=0;i<numTasks;i++){
+		futures.push_back(ofGetThreadPool().submit([]{}));
+	}
+	for(size_t i=0;i<futures.size();i++){
+		futures[i].get();
+	}
+	unsigned long long elapsed = ofGetElapsedTimeMicros() - start;
+	out << "submit + wait empty task: " << elapsed * 1000. / numTasks << "ns per task" << endl;
+
+	// parallel for overhead: a loop that does nothing
+	start = ofGetElapsedTimeMicros();
+	for(int i=0;i<1000;i++){
+		ofParallelFor(0, 1000, [](size_t){});
+	}
+	elapsed = ofGetElapsedTimeMicros() - start;
+	out << "empty ofParallelFor: " << elapsed / 1000. << "us per call" << endl << endl;
+
+	// scaling: the same reduction with pools of different sizes
+	size_t numItems = 200000;
+	start = ofGetElapsedTimeMicros();
+	double serial = 0;
+	for(size_t i=0;i<numItems;i++){
+		serial += work(i);
+	}
+	unsigned long long serialTime = ofGetElapsedTimeMicros() - start;
+	out << "serial: " << serialTime / 1000. << "ms" << endl;
+
+	for(size_t threads=1; threads<=ofGetThreadPool().getNumThreads(); threads*=2){
+		ofThreadPool pool(threads);
+		start = ofGetElapsedTimeMicros();
+		double parallel = pool.parallelReduce(0, numItems, 0.0, work, [](double a, double b){ return a + b; });
+		unsigned long long parallelTime = ofGetElapsedTimeMicros() - start;
+		out << threads << " threads: " << parallelTime / 1000. << "ms"
+		    << " speedup " << double(serialTime) / parallelTime
+		    << (fabs(serial - parallel) < fabs(serial) * 1e-9 ? "" : " (different result!)") << endl;
+	}
+#else
+	out << "the thread pool needs c++11 support" << endl;
+#endif
+
+	out << endl << "press space to run again";
+	results = out.str();
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofDrawBitmapString(results, 20, 20);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if(key==' '){
+		runBenchmarks();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::keyReleased(int key){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseMoved(int x, int y ){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseDragged(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mousePressed(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::mouseReleased(int x, int y, int button){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::windowResized(int w, int h){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::gotMessage(ofMessage msg){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::dragEvent(ofDragInfo dragInfo){
+
+}
@@ -28,6 +28,7 @@
 #include "ofGraphics.h" // used in runAppViaInfiniteLoop()
 #include "ofAppRunner.h"
 #include "ofUtils.h"
+#include "ofProfiler.h"
 #include "ofFileUtils.h"
 #include "ofGLProgrammableRenderer.h"
 #include "ofGLRenderer.h"
@@ -859,10 +860,13 @@ void ofAppEGLWindow::draw() {
 	}
 	currentRenderer->finishRender();
 
-	EGLBoolean success = eglSwapBuffers(eglDisplay, eglSurface);
-	if(!success) {
-		GLint error = eglGetError();
-		ofLogNotice("ofAppEGLWindow") << "display(): eglSwapBuffers failed: " << eglErrorString(error);
+	{
+		OF_PROFILE_SCOPE("swapBuffers");
+		EGLBoolean success = eglSwapBuffers(eglDisplay, eglSurface);
+		if(!success) {
+			GLint error = eglGetError();
+			ofLogNotice("ofAppEGLWindow") << "display(): eglSwapBuffers failed: " << eglErrorString(error);
+		}
 	}
 
 	nFramesSinceWindowResized++;
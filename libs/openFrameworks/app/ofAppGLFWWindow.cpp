@@ -5,6 +5,7 @@
 #include "ofGLRenderer.h"
 #include "ofGLProgrammableRenderer.h"
 #include "ofAppRunner.h"
+#include "ofProfiler.h"
 #include "Poco/URI.h"
 
 #ifdef TARGET_LINUX
@@ -337,6 +338,7 @@ void ofAppGLFWWindow::draw(){
 			currentRenderer->clear();
 		} else {
 			if ( (events().getFrameNum() < 3 || nFramesSinceWindowResized < 3) && settings.doubleBuffering){
+				OF_PROFILE_SCOPE("swapBuffers");
 				glfwSwapBuffers(windowP);
 			}else{
 				glFlush();
@@ -344,6 +346,7 @@ void ofAppGLFWWindow::draw(){
 		}
 	} else {
 		if(settings.doubleBuffering){
+		    OF_PROFILE_SCOPE("swapBuffers");
 		    glfwSwapBuffers(windowP);
 		} else {
 			glFlush();
@@ -357,6 +360,7 @@ void ofAppGLFWWindow::draw(){
 			}
 		}
 		if(settings.doubleBuffering){
+		    OF_PROFILE_SCOPE("swapBuffers");
 		    glfwSwapBuffers(windowP);
 		} else{
 			glFlush();
@@ -0,0 +1,361 @@
+#include "ofAppHeadlessWindow.h"
+#include "ofGLRenderer.h"
+#include "ofGLProgrammableRenderer.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+//------------------------------------------------------------
+static bool hasEGLExtension(const char * extensions, const string & extension){
+	if(extensions==NULL){
+		return false;
+	}
+	vector<string> tokens = ofSplitString(extensions, " ", true, true);
+	return find(tokens.begin(), tokens.end(), extension) != tokens.end();
+}
+
+//------------------------------------------------------------
+// mesa exposes a surfaceless platform that works without any windowing
+// system, nvidia only exposes its devices. the default display is the last
+// resort and will usually try to connect to X
+static EGLDisplay getHeadlessDisplay(){
+	const char * clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+			(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+	if(getPlatformDisplay && hasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless")){
+		EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+		if(display!=EGL_NO_DISPLAY){
+			ofLogVerbose("ofAppHeadlessWindow") << "using mesa surfaceless platform";
+			return display;
+		}
+	}
+
+	PFNEGLQUERYDEVICESEXTPROC queryDevices =
+			(PFNEGLQUERYDEVICESEXTPROC)eglGetProcAddress("eglQueryDevicesEXT");
+	if(getPlatformDisplay && queryDevices && hasEGLExtension(clientExtensions, "EGL_EXT_platform_device")){
+		EGLDeviceEXT device;
+		EGLint numDevices = 0;
+		if(queryDevices(1, &device, &numDevices) && numDevices>0){
+			EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, NULL);
+			if(display!=EGL_NO_DISPLAY){
+				ofLogVerbose("ofAppHeadlessWindow") << "using EGL device platform";
+				return display;
+			}
+		}
+	}
+
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+//------------------------------------------------------------
+ofAppHeadlessWindow::ofAppHeadlessWindow()
+:display(NULL)
+,context(NULL)
+,surface(NULL)
+,bEnableSetupScreen(true)
+,bShouldClose(false){
+
+}
+
+//------------------------------------------------------------
+ofAppHeadlessWindow::~ofAppHeadlessWindow(){
+	close();
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::setup(const ofGLWindowSettings & _settings){
+	const ofHeadlessWindowSettings * headlessSettings = dynamic_cast<const ofHeadlessWindowSettings*>(&_settings);
+	if(headlessSettings){
+		setup(*headlessSettings);
+	}else{
+		setup(ofHeadlessWindowSettings(_settings));
+	}
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::setup(const ofHeadlessWindowSettings & _settings){
+	if(context){
+		ofLogError("ofAppHeadlessWindow") << "setup(): window already setup";
+		return;
+	}
+	settings = _settings;
+
+	display = getHeadlessDisplay();
+	if(display==EGL_NO_DISPLAY){
+		ofLogError("ofAppHeadlessWindow") << "setup(): couldn't get an EGL display";
+		return;
+	}
+
+	EGLint major, minor;
+	if(!eglInitialize(display, &major, &minor)){
+		ofLogError("ofAppHeadlessWindow") << "setup(): couldn't initialize EGL: " << ofToHex(eglGetError());
+		display = NULL;
+		return;
+	}
+	ofLogVerbose("ofAppHeadlessWindow") << "EGL " << major << "." << minor << " " << eglQueryString(display, EGL_VENDOR);
+
+	if(!eglBindAPI(EGL_OPENGL_API)){
+		ofLogError("ofAppHeadlessWindow") << "setup(): EGL doesn't support desktop GL";
+		return;
+	}
+
+	// the default framebuffer is never drawn to, the config only needs to
+	// support pbuffers for drivers without surfaceless contexts
+	EGLint configAttribs[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint numConfigs = 0;
+	if(!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs==0){
+		ofLogError("ofAppHeadlessWindow") << "setup(): couldn't find an EGL config for desktop GL";
+		return;
+	}
+
+	vector<EGLint> contextAttribs;
+	contextAttribs.push_back(EGL_CONTEXT_MAJOR_VERSION_KHR);
+	contextAttribs.push_back(settings.glVersionMajor);
+	contextAttribs.push_back(EGL_CONTEXT_MINOR_VERSION_KHR);
+	contextAttribs.push_back(settings.glVersionMinor);
+	if((settings.glVersionMajor==3 && settings.glVersionMinor>=2) || settings.glVersionMajor>=4){
+		contextAttribs.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR);
+		contextAttribs.push_back(EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR);
+	}
+	if(settings.glVersionMajor>=3){
+		contextAttribs.push_back(EGL_CONTEXT_FLAGS_KHR);
+		contextAttribs.push_back(EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR);
+		currentRenderer = shared_ptr<ofBaseRenderer>(new ofGLProgrammableRenderer(this));
+	}else{
+		currentRenderer = shared_ptr<ofBaseRenderer>(new ofGLRenderer(this));
+	}
+	contextAttribs.push_back(EGL_NONE);
+
+	context = eglCreateContext(display, config, EGL_NO_CONTEXT, &contextAttribs[0]);
+	if(context==EGL_NO_CONTEXT){
+		ofLogError("ofAppHeadlessWindow") << "setup(): couldn't create a GL " << settings.glVersionMajor << "." << settings.glVersionMinor
+				<< " context: " << ofToHex(eglGetError());
+		context = NULL;
+		return;
+	}
+
+	if(!hasEGLExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")){
+		EGLint pbufferAttribs[] = {
+			EGL_WIDTH, 1,
+			EGL_HEIGHT, 1,
+			EGL_NONE
+		};
+		surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+		if(surface==EGL_NO_SURFACE){
+			ofLogError("ofAppHeadlessWindow") << "setup(): couldn't create a pbuffer surface: " << ofToHex(eglGetError());
+			surface = NULL;
+			return;
+		}
+	}
+
+	if(!eglMakeCurrent(display, surface, surface, context)){
+		ofLogError("ofAppHeadlessWindow") << "setup(): couldn't make the context current: " << ofToHex(eglGetError());
+		return;
+	}
+
+	static bool inited = false;
+	if(!inited){
+		glewExperimental = GL_TRUE;
+		GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		// glew built for glx looks for an X display after loading the core
+		// functions, which there isn't when running headless
+		if(err==GLEW_ERROR_NO_GLX_DISPLAY){
+			err = GLEW_OK;
+		}
+#endif
+		if (GLEW_OK != err)
+		{
+			ofLogError("ofAppHeadlessWindow") << "couldn't init GLEW: " << glewGetErrorString(err);
+			return;
+		}
+		inited = true;
+	}
+
+	ofLogVerbose() << "GL Version:" << glGetString(GL_VERSION);
+
+	if(currentRenderer->getType()==ofGLProgrammableRenderer::TYPE){
+		static_cast<ofGLProgrammableRenderer*>(currentRenderer.get())->setup(settings.glVersionMajor,settings.glVersionMinor);
+	}else{
+		static_cast<ofGLRenderer*>(currentRenderer.get())->setup();
+	}
+
+	allocateFbo();
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::allocateFbo(){
+	ofFbo::Settings fboSettings;
+	fboSettings.width = settings.width;
+	fboSettings.height = settings.height;
+	fboSettings.internalformat = GL_RGBA;
+	fboSettings.numSamples = settings.numSamples;
+	fboSettings.useDepth = settings.depthBuffer;
+	fboSettings.useStencil = settings.stencilBuffer;
+	fbo.allocate(fboSettings);
+
+	// the renderer binds its default framebuffer when an fbo is unbound,
+	// which for this window is the render target instead of 0
+	if(currentRenderer->getType()==ofGLProgrammableRenderer::TYPE){
+		static_cast<ofGLProgrammableRenderer*>(currentRenderer.get())->setDefaultFramebufferId(fbo.getFbo());
+	}else{
+		static_cast<ofGLRenderer*>(currentRenderer.get())->setDefaultFramebufferId(fbo.getFbo());
+	}
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::update(){
+	events().notifyUpdate();
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::draw(){
+	if(!context){
+		return;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo.getFbo());
+	currentRenderer->startRender();
+	if( bEnableSetupScreen ) currentRenderer->setupScreen();
+
+	events().notifyDraw();
+
+	currentRenderer->finishRender();
+	fbo.flagDirty();
+
+	if(!newFrameEvent.empty()){
+		readToPixels(pixels);
+		ofNotifyEvent(newFrameEvent, pixels, this);
+	}
+
+	if(settings.maxFrames>0 && events().getFrameNum()>=settings.maxFrames && !bShouldClose){
+		setWindowShouldClose();
+	}
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::readToPixels(ofPixels & pixels){
+	fbo.readToPixels(pixels);
+	pixels.mirror(true, false);
+}
+
+//------------------------------------------------------------
+bool ofAppHeadlessWindow::getWindowShouldClose(){
+	return bShouldClose;
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::setWindowShouldClose(){
+	bShouldClose = true;
+	events().notifyExit();
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::close(){
+	if(context){
+		makeCurrent();
+		fbo.clear();
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if(surface){
+			eglDestroySurface(display, surface);
+			surface = NULL;
+		}
+		eglDestroyContext(display, context);
+		context = NULL;
+		// the display isn't terminated, it's shared with any other
+		// headless window in the application
+		events().disable();
+	}
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::makeCurrent(){
+	if(context){
+		eglMakeCurrent(display, surface, surface, context);
+	}
+}
+
+//------------------------------------------------------------
+ofPoint ofAppHeadlessWindow::getWindowPosition(){
+	return ofPoint(0,0);
+}
+
+//------------------------------------------------------------
+ofPoint ofAppHeadlessWindow::getWindowSize(){
+	return ofPoint(settings.width, settings.height);
+}
+
+//------------------------------------------------------------
+ofPoint ofAppHeadlessWindow::getScreenSize(){
+	return ofPoint(settings.width, settings.height);
+}
+
+//------------------------------------------------------------
+int ofAppHeadlessWindow::getWidth(){
+	return settings.width;
+}
+
+//------------------------------------------------------------
+int ofAppHeadlessWindow::getHeight(){
+	return settings.height;
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::setWindowShape(int w, int h){
+	if(w==settings.width && h==settings.height){
+		return;
+	}
+	settings.width = w;
+	settings.height = h;
+	if(context){
+		allocateFbo();
+		events().notifyWindowResized(w, h);
+	}
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::enableSetupScreen(){
+	bEnableSetupScreen = true;
+}
+
+//------------------------------------------------------------
+void ofAppHeadlessWindow::disableSetupScreen(){
+	bEnableSetupScreen = false;
+}
+
+//------------------------------------------------------------
+void * ofAppHeadlessWindow::getWindowContext(){
+	return context;
+}
+
+//------------------------------------------------------------
+void * ofAppHeadlessWindow::getEGLDisplay(){
+	return display;
+}
+
+//------------------------------------------------------------
+ofCoreEvents & ofAppHeadlessWindow::events(){
+	return coreEvents;
+}
+
+//------------------------------------------------------------
+shared_ptr<ofBaseRenderer> & ofAppHeadlessWindow::renderer(){
+	return currentRenderer;
+}
+
+//------------------------------------------------------------
+ofFbo & ofAppHeadlessWindow::getFbo(){
+	return fbo;
+}
+
+//------------------------------------------------------------
+const ofFbo & ofAppHeadlessWindow::getFbo() const{
+	return fbo;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofAppBaseWindow.h"
+#include "ofFbo.h"
+#include "ofPixels.h"
+
+class ofHeadlessWindowSettings: public ofGLWindowSettings{
+public:
+	ofHeadlessWindowSettings()
+	:numSamples(0)
+	,depthBuffer(true)
+	,stencilBuffer(false)
+	,maxFrames(0){}
+
+	ofHeadlessWindowSettings(const ofWindowSettings & settings)
+	:ofGLWindowSettings(settings)
+	,numSamples(0)
+	,depthBuffer(true)
+	,stencilBuffer(false)
+	,maxFrames(0){}
+
+	/// samples of the render target, 0 disables multisampling
+	int numSamples;
+	bool depthBuffer;
+	bool stencilBuffer;
+
+	/// the window closes after rendering this many frames, 0 renders
+	/// until ofExit() is called
+	int maxFrames;
+};
+
+/// \class ofAppHeadlessWindow
+/// \brief Window with a GL context but no display.
+///
+/// The context is created through EGL on the surfaceless platform (mesa,
+/// including the llvmpipe software rasterizer) or the first EGL device
+/// (nvidia), so it doesn't need an X server. Frames are rendered to an
+/// ofFbo of the size of the window which can be read back as ofPixels,
+/// eg. to render an animation to disk on a render farm:
+///
+///     ofHeadlessWindowSettings settings;
+///     settings.setGLVersion(3,2);
+///     settings.width = 1920;
+///     settings.height = 1080;
+///     settings.maxFrames = 1000;
+///     ofCreateWindow(settings);
+///     ofRunApp(new ofApp);
+///
+///     // in ofApp::setup()
+///     window = dynamic_pointer_cast<ofAppHeadlessWindow>(ofGetMainLoop()->getCurrentWindow());
+///     ofAddListener(window->newFrameEvent, this, &ofApp::frameRendered);
+///
+/// Only available on linux with desktop GL.
+class ofAppHeadlessWindow: public ofAppBaseGLWindow{
+public:
+	ofAppHeadlessWindow();
+	~ofAppHeadlessWindow();
+
+	static bool doesLoop(){ return false; }
+	static bool allowsMultiWindow(){ return true; }
+	static void loop(){};
+	static bool needsPolling(){ return false; }
+	static void pollEvents(){};
+
+	using ofAppBaseGLWindow::setup;
+	void setup(const ofGLWindowSettings & settings);
+	void setup(const ofHeadlessWindowSettings & settings);
+	void update();
+	void draw();
+	bool getWindowShouldClose();
+	void setWindowShouldClose();
+	void close();
+	void makeCurrent();
+
+	ofPoint getWindowPosition();
+	ofPoint getWindowSize();
+	ofPoint getScreenSize();
+	int getWidth();
+	int getHeight();
+
+	/// reallocates the render target with the new size
+	void setWindowShape(int w, int h);
+
+	void enableSetupScreen();
+	void disableSetupScreen();
+
+	void * getWindowContext();
+	void * getEGLDisplay();
+
+	ofCoreEvents & events();
+	shared_ptr<ofBaseRenderer> & renderer();
+
+	/// render target, the frames are stored upside down like in the
+	/// default framebuffer of a window
+	ofFbo & getFbo();
+	const ofFbo & getFbo() const;
+
+	/// reads back the last frame rendered, top row first
+	void readToPixels(ofPixels & pixels);
+
+	/// notified after each frame with its pixels, the frames are only read
+	/// back when this event has listeners
+	ofEvent<ofPixels> newFrameEvent;
+
+private:
+	void allocateFbo();
+
+	ofHeadlessWindowSettings settings;
+	ofCoreEvents coreEvents;
+	shared_ptr<ofBaseRenderer> currentRenderer;
+	ofFbo fbo;
+	ofPixels pixels;
+	void * display;
+	void * context;
+	void * surface;
+	bool bEnableSetupScreen;
+	bool bShouldClose;
+};
@@ -8,6 +8,7 @@
 #include <ofMainLoop.h>
 #include "ofWindowSettings.h"
 #include "ofConstants.h"
+#include "ofProfiler.h"
 
 //========================================================================
 // default windowing
@@ -25,6 +26,9 @@
 	#include "ofxAppEmscriptenWindow.h"
 #else
 	#include "ofAppGLFWWindow.h"
+	#if defined(TARGET_LINUX) && !defined(TARGET_OPENGLES)
+		#include "ofAppHeadlessWindow.h"
+	#endif
 #endif
 
 
@@ -57,6 +61,14 @@ shared_ptr<ofAppBaseWindow> ofMainLoop::createWindow(const ofWindowSettings & se
 	#elif defined(TARGET_OPENGLES)
 	shared_ptr<ofAppGLFWWindow> window = shared_ptr<ofAppGLFWWindow>(new ofAppGLFWWindow());
 	#else
+	#ifdef TARGET_LINUX
+	if(dynamic_cast<const ofHeadlessWindowSettings*>(&settings)){
+		shared_ptr<ofAppHeadlessWindow> window = shared_ptr<ofAppHeadlessWindow>(new ofAppHeadlessWindow());
+		addWindow(window);
+		window->setup(settings);
+		return window;
+	}
+	#endif
 	shared_ptr<ofAppGLFWWindow> window = shared_ptr<ofAppGLFWWindow>(new ofAppGLFWWindow());
 	#endif
 #endif
@@ -129,6 +141,7 @@ int ofMainLoop::loop(){
 }
 
 void ofMainLoop::loopOnce(){
+	OF_PROFILE_SCOPE("frame");
 	for(map<shared_ptr<ofAppBaseWindow>,shared_ptr<ofBaseApp> >::iterator i = windowsApps.begin(); !windowsApps.empty() && i != windowsApps.end() ;){
 		if(i->first->getWindowShouldClose()){
 			i->first->close();
@@ -136,12 +149,19 @@ void ofMainLoop::loopOnce(){
 		}else{
 			currentWindow = i->first;
 			i->first->makeCurrent();
-			i->first->update();
-			i->first->draw();
+			{
+				OF_PROFILE_SCOPE("update");
+				i->first->update();
+			}
+			{
+				OF_PROFILE_SCOPE("draw");
+				i->first->draw();
+			}
 			i++; ///< continue to next window
 		}
 	}
 	if(pollEvents){
+		OF_PROFILE_SCOPE("pollEvents");
 		pollEvents();
 	}
 }
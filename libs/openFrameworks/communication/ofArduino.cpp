@@ -42,7 +42,6 @@
 #include "ofArduino.h"
 #include "ofUtils.h"
 
-// TODO thread it?
 // TODO throw event or exception if the serial port goes down...
 //---------------------------------------------------------------------------
 ofArduino::ofArduino(){
@@ -116,6 +115,13 @@ bool ofArduino::connect(string device, int baud){
 	_initialized = false;
 	_port.enumerateDevices();
 	connected = _port.setup(device.c_str(), baud);
+#ifdef OF_USING_SERIAL_READER
+	// a thread empties the port as soon as data arrives, so fast
+	// reporting doesn't overflow the OS buffer between calls to update()
+	if(connected){
+		_port.startReading();
+	}
+#endif
 	return connected;
 }
 
@@ -160,14 +166,17 @@ void ofArduino::disconnect(){
 }
 
 void ofArduino::update(){
-	vector<unsigned char> bytesToProcess;
+	unsigned char bytesToProcess[1024];
 	int bytesToRead = _port.available();
-	if (bytesToRead>0) {
-		bytesToProcess.resize(bytesToRead);
-		_port.readBytes(&bytesToProcess[0], bytesToRead);
-		for (int i = 0; i < bytesToRead; i++) {
-			processData((char)(bytesToProcess[i]));
+	while (bytesToRead > 0) {
+		int bytesRead = _port.readBytes(bytesToProcess, min(bytesToRead, (int)sizeof(bytesToProcess)));
+		if (bytesRead <= 0) {
+			break;
+		}
+		for (int i = 0; i < bytesRead; i++) {
+			processData(bytesToProcess[i]);
 		}
+		bytesToRead -= bytesRead;
 	}
 }
 
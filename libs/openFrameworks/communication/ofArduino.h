@@ -189,7 +189,10 @@ public:
 	/// \name Update
 	/// \{
 	
-	/// \brief Polls data from the serial port, this has to be called periodically
+	/// \brief Processes the data received from the serial port, this has to be called periodically
+	///
+	/// When compiling with c++11 support connect() starts a thread that reads
+	/// the serial port, update() then only processes what that thread received.
 	void update();
 	
 	/// \}
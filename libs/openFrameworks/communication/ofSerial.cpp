@@ -96,6 +96,293 @@ void ofSerial::enumerateWin32Ports(){
 
 
 
+#ifdef OF_USING_SERIAL_READER
+
+#include <atomic>
+#include <thread>
+#ifndef TARGET_WIN32
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------
+// Reads the port from its own thread into a ring buffer. The reading
+// thread is the only writer and the thread calling ofSerial's read
+// functions the only reader, so the buffer only needs atomic positions.
+// Positions count bytes since the start and are never wrapped, the
+// index in the buffer is the position masked by its size.
+//
+// With framing, the reading thread also splits the data in packets and
+// pushes their positions in the stream to a second ring buffer.
+class ofSerialReader{
+public:
+#ifdef TARGET_WIN32
+	typedef HANDLE Port;
+#else
+	typedef int Port;
+#endif
+
+	ofSerialReader(Port port, size_t bufferSize, int delimiter, size_t length)
+	:port(port)
+	,bytesWritten(0)
+	,bytesRead(0)
+	,packetsWritten(0)
+	,packetsRead(0)
+	,delimiter(delimiter)
+	,length(length)
+	,bytesDropped(0)
+	,error(false)
+	,running(true)
+	,packetStart(0)
+	,packetSize(0)
+	,discardPacket(false)
+	,currentDelimiter(delimiter)
+	,currentLength(length){
+		size_t size = 64;
+		while(size < bufferSize){
+			size *= 2;
+		}
+		bytes.resize(size);
+		packets.resize(std::max(size / 8, size_t(64)));
+		#ifndef TARGET_WIN32
+			if(pipe(wakeFds) == -1){
+				ofLogError("ofSerial") << "startReading(): couldn't create pipe: " << errno << " " << strerror(errno);
+				wakeFds[0] = wakeFds[1] = -1;
+			}
+		#endif
+		thread = std::thread(&ofSerialReader::threadedFunction, this);
+	}
+
+	~ofSerialReader(){
+		running = false;
+		#ifndef TARGET_WIN32
+			if(wakeFds[1] != -1){
+				char wake = 0;
+				if(write(wakeFds[1], &wake, 1) == -1){}
+			}
+		#endif
+		thread.join();
+		#ifndef TARGET_WIN32
+			if(wakeFds[0] != -1){
+				::close(wakeFds[0]);
+				::close(wakeFds[1]);
+			}
+		#endif
+	}
+
+	void setFraming(int _delimiter, size_t _length){
+		delimiter = _delimiter;
+		length = _length;
+	}
+
+	size_t available() const{
+		return bytesWritten.load(std::memory_order_acquire) - bytesRead.load(std::memory_order_relaxed);
+	}
+
+	size_t read(unsigned char * buffer, size_t size){
+		unsigned long long start = bytesRead.load(std::memory_order_relaxed);
+		unsigned long long end = bytesWritten.load(std::memory_order_acquire);
+		size = std::min(size, size_t(end - start));
+		copy(start, size, buffer);
+		bytesRead.store(start + size, std::memory_order_release);
+		return size;
+	}
+
+	bool readPacket(ofSerialPacket & packet){
+		unsigned long long next = packetsRead.load(std::memory_order_relaxed);
+		unsigned long long end = packetsWritten.load(std::memory_order_acquire);
+		bool found = false;
+		while(next < end && !found){
+			const Packet & p = packets[next % packets.size()];
+			next++;
+			// skip packets already consumed by readBytes()
+			if(p.start >= bytesRead.load(std::memory_order_relaxed)){
+				packet.data.resize(p.size);
+				copy(p.start, p.size, packet.data.data());
+				packet.timestamp = p.timestamp;
+				bytesRead.store(p.end, std::memory_order_release);
+				found = true;
+			}
+		}
+		packetsRead.store(next, std::memory_order_release);
+		return found;
+	}
+
+	void flush(){
+		bytesRead.store(bytesWritten.load(std::memory_order_acquire), std::memory_order_release);
+		packetsRead.store(packetsWritten.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	bool hasError() const{
+		return error;
+	}
+
+	size_t getNumBytesDropped() const{
+		return bytesDropped;
+	}
+
+private:
+	struct Packet{
+		unsigned long long start;
+		unsigned long long end;
+		size_t size;
+		unsigned long long timestamp;
+	};
+
+	void copy(unsigned long long start, size_t size, unsigned char * dst) const{
+		size_t mask = bytes.size() - 1;
+		size_t first = std::min(size, bytes.size() - size_t(start & mask));
+		memcpy(dst, &bytes[start & mask], first);
+		memcpy(dst + first, &bytes[0], size - first);
+	}
+
+	void threadedFunction(){
+		unsigned char chunk[4096];
+	#ifdef TARGET_WIN32
+		while(running){
+			DWORD nRead = 0;
+			if(!ReadFile(port, chunk, sizeof(chunk), &nRead, 0)){
+				ofLogError("ofSerial") << "reading thread: couldn't read from port";
+				error = true;
+				break;
+			}
+			if(nRead > 0){
+				received(chunk, nRead, ofGetElapsedTimeMicros());
+			}else{
+				// reads return immediately, the timeouts are set that way
+				// in setup() and changing them would block writes while waiting
+				ofSleepMillis(1);
+			}
+		}
+	#else
+		struct pollfd fds[2];
+		fds[0].fd = port;
+		fds[0].events = POLLIN;
+		fds[1].fd = wakeFds[0];
+		fds[1].events = POLLIN;
+		while(running){
+			fds[0].revents = 0;
+			fds[1].revents = 0;
+			if(poll(fds, wakeFds[0] == -1 ? 1 : 2, wakeFds[0] == -1 ? 10 : -1) == -1){
+				if(errno == EINTR) continue;
+				ofLogError("ofSerial") << "reading thread: poll failed: " << errno << " " << strerror(errno);
+				error = true;
+				break;
+			}
+			if(fds[1].revents || !running){
+				break;
+			}
+			if(fds[0].revents){
+				int nRead = ::read(port, chunk, sizeof(chunk));
+				if(nRead > 0){
+					received(chunk, nRead, ofGetElapsedTimeMicros());
+				}else if(nRead == 0){
+					ofLogError("ofSerial") << "reading thread: device disconnected";
+					error = true;
+					break;
+				}else if(errno != EAGAIN && errno != EINTR){
+					ofLogError("ofSerial") << "reading thread: couldn't read from port: " << errno << " " << strerror(errno);
+					error = true;
+					break;
+				}
+			}
+		}
+	#endif
+	}
+
+	void received(const unsigned char * data, size_t size, unsigned long long timestamp){
+		int newDelimiter = delimiter;
+		size_t newLength = length;
+		if(newDelimiter != currentDelimiter || newLength != currentLength){
+			currentDelimiter = newDelimiter;
+			currentLength = newLength;
+			packetStart = bytesWritten.load(std::memory_order_relaxed);
+			packetSize = 0;
+			discardPacket = false;
+		}
+		bool framing = currentDelimiter >= 0 || currentLength > 0;
+
+		size_t mask = bytes.size() - 1;
+		unsigned long long written = bytesWritten.load(std::memory_order_relaxed);
+		unsigned long long read = bytesRead.load(std::memory_order_acquire);
+		unsigned long long packetsEnd = packetsWritten.load(std::memory_order_relaxed);
+		unsigned long long packetsStart = packetsRead.load(std::memory_order_acquire);
+		size_t dropped = 0;
+		for(size_t i = 0; i < size; i++){
+			if(written - read == bytes.size()){
+				read = bytesRead.load(std::memory_order_acquire);
+			}
+			if(written - read < bytes.size()){
+				bytes[written & mask] = data[i];
+				written++;
+			}else{
+				dropped++;
+				discardPacket = true;
+			}
+
+			if(!framing) continue;
+			// framing counts dropped bytes too so it doesn't go out of sync
+			packetSize++;
+			bool isDelimiter = currentDelimiter >= 0 && data[i] == (unsigned char)currentDelimiter;
+			if(isDelimiter || packetSize == currentLength){
+				if(packetsEnd - packetsStart == packets.size()){
+					packetsStart = packetsRead.load(std::memory_order_acquire);
+				}
+				if(discardPacket){
+					// its bytes were already counted as dropped
+				}else if(packetsEnd - packetsStart < packets.size()){
+					Packet & packet = packets[packetsEnd % packets.size()];
+					packet.start = packetStart;
+					packet.end = written;
+					packet.size = size_t(written - packetStart) - (isDelimiter ? 1 : 0);
+					packet.timestamp = timestamp;
+					packetsEnd++;
+				}else{
+					dropped += size_t(written - packetStart);
+				}
+				packetStart = written;
+				packetSize = 0;
+				discardPacket = false;
+			}
+		}
+		// bytes first so every published packet has its data
+		bytesWritten.store(written, std::memory_order_release);
+		packetsWritten.store(packetsEnd, std::memory_order_release);
+		if(dropped){
+			bytesDropped += dropped;
+		}
+	}
+
+	Port port;
+	#ifndef TARGET_WIN32
+		int wakeFds[2];
+	#endif
+	std::thread thread;
+
+	vector<unsigned char> bytes;
+	vector<Packet> packets;
+	std::atomic<unsigned long long> bytesWritten;
+	std::atomic<unsigned long long> bytesRead;
+	std::atomic<unsigned long long> packetsWritten;
+	std::atomic<unsigned long long> packetsRead;
+
+	std::atomic<int> delimiter;
+	std::atomic<size_t> length;
+	std::atomic<size_t> bytesDropped;
+	std::atomic<bool> error;
+	std::atomic<bool> running;
+
+	// only used from the reading thread
+	unsigned long long packetStart;
+	size_t packetSize;
+	bool discardPacket;
+	int currentDelimiter;
+	size_t currentLength;
+};
+
+#endif
+
+
 //----------------------------------------------------------------
 ofSerial::ofSerial(){
 
@@ -112,9 +399,66 @@ ofSerial::ofSerial(){
 			portNamesFriendly[i] = new char[MAX_PATH];
 		}
 	//---------------------------------------------
+	#else
+	//---------------------------------------------
+		fd = -1;
+	//---------------------------------------------
 	#endif
 	//---------------------------------------------
+	bHaveEnumeratedDevices = false;
 	bInited = false;
+	#ifdef OF_USING_SERIAL_READER
+		packetDelimiter = -1;
+		packetLength = 0;
+	#endif
+}
+
+//----------------------------------------------------------------
+ofSerial::ofSerial(const ofSerial & mom){
+	#ifdef TARGET_WIN32
+		portNamesShort = new char * [MAX_SERIAL_PORTS];
+		portNamesFriendly = new char * [MAX_SERIAL_PORTS];
+		for (int i = 0; i < MAX_SERIAL_PORTS; i++){
+			portNamesShort[i] = new char[10];
+			portNamesFriendly[i] = new char[MAX_PATH];
+		}
+	#endif
+	*this = mom;
+}
+
+//----------------------------------------------------------------
+ofSerial & ofSerial::operator=(const ofSerial & mom){
+	if(this == &mom){
+		return *this;
+	}
+
+	deviceType = mom.deviceType;
+	devices = mom.devices;
+	bHaveEnumeratedDevices = mom.bHaveEnumeratedDevices;
+	bInited = mom.bInited;
+
+	#ifdef TARGET_WIN32
+		for (int i = 0; i < MAX_SERIAL_PORTS; i++){
+			memcpy(portNamesShort[i], mom.portNamesShort[i], 10);
+			memcpy(portNamesFriendly[i], mom.portNamesFriendly[i], MAX_PATH);
+		}
+		hComm = mom.hComm;
+		nPorts = mom.nPorts;
+		bPortsEnumerated = mom.bPortsEnumerated;
+		oldTimeout = mom.oldTimeout;
+	#else
+		fd = mom.fd;
+		oldoptions = mom.oldoptions;
+	#endif
+
+	#ifdef OF_USING_SERIAL_READER
+		// the reader thread and its buffer belong to the original,
+		// sharing them would split the received bytes between both
+		reader.reset();
+		packetDelimiter = mom.packetDelimiter;
+		packetLength = mom.packetLength;
+	#endif
+	return *this;
 }
 
 //----------------------------------------------------------------
@@ -254,6 +598,11 @@ void ofSerial::enumerateDevices(){
 //----------------------------------------------------------------
 void ofSerial::close(){
 
+	#ifdef OF_USING_SERIAL_READER
+		// the thread has to stop before the port is closed
+		stopReading();
+	#endif
+
 	//---------------------------------------------
 	#ifdef TARGET_WIN32
 	//---------------------------------------------
@@ -299,6 +648,9 @@ bool ofSerial::setup(int deviceNumber, int baud){
 //----------------------------------------------------------------
 bool ofSerial::setup(string portName, int baud){
 
+	#ifdef OF_USING_SERIAL_READER
+		stopReading();
+	#endif
 	bInited = false;
 
 	//---------------------------------------------
@@ -505,6 +857,16 @@ int ofSerial::readBytes(unsigned char * buffer, int length){
 		return OF_SERIAL_ERROR;
 	}
 
+	#ifdef OF_USING_SERIAL_READER
+		if(reader){
+			int nRead = reader->read(buffer, length);
+			if(nRead == 0){
+				return reader->hasError() ? OF_SERIAL_ERROR : OF_SERIAL_NO_DATA;
+			}
+			return nRead;
+		}
+	#endif
+
 	//---------------------------------------------
 	#if defined( TARGET_OSX ) || defined( TARGET_LINUX )
 		int nRead = read(fd, buffer, length);
@@ -582,6 +944,15 @@ int ofSerial::readByte(){
 
 	unsigned char tmpByte = 0;
 
+	#ifdef OF_USING_SERIAL_READER
+		if(reader){
+			if(reader->read(&tmpByte, 1) == 0){
+				return reader->hasError() ? OF_SERIAL_ERROR : OF_SERIAL_NO_DATA;
+			}
+			return tmpByte;
+		}
+	#endif
+
 	//---------------------------------------------
 	#if defined( TARGET_OSX ) || defined( TARGET_LINUX )
 		int nRead = read(fd, &tmpByte, 1);
@@ -619,6 +990,13 @@ void ofSerial::flush(bool flushIn, bool flushOut){
 		return;
 	}
 
+	#ifdef OF_USING_SERIAL_READER
+		// data already in the buffer was received before this call too
+		if(reader && flushIn){
+			reader->flush();
+		}
+	#endif
+
 
 	//---------------------------------------------
 	#if defined( TARGET_OSX ) || defined( TARGET_LINUX )
@@ -662,6 +1040,12 @@ int ofSerial::available(){
 
 	int numBytes = 0;
 
+	#ifdef OF_USING_SERIAL_READER
+		if(reader){
+			return reader->available();
+		}
+	#endif
+
 	//---------------------------------------------
 	#if defined( TARGET_OSX ) || defined( TARGET_LINUX )
 		ioctl(fd,FIONREAD,&numBytes);
@@ -690,3 +1074,71 @@ int ofSerial::available(){
 bool ofSerial::isInitialized() const{
 	return bInited;
 }
+
+#ifdef OF_USING_SERIAL_READER
+//----------------------------------------------------------------
+bool ofSerial::startReading(size_t bufferSize){
+	if (!bInited){
+		ofLogError("ofSerial") << "startReading(): serial not inited";
+		return false;
+	}
+	stopReading();
+	#ifdef TARGET_WIN32
+		reader = std::make_shared<ofSerialReader>(hComm, bufferSize, packetDelimiter, packetLength);
+	#else
+		reader = std::make_shared<ofSerialReader>(fd, bufferSize, packetDelimiter, packetLength);
+	#endif
+	return true;
+}
+
+//----------------------------------------------------------------
+void ofSerial::stopReading(){
+	reader.reset();
+}
+
+//----------------------------------------------------------------
+bool ofSerial::isReading() const{
+	return reader != nullptr;
+}
+
+//----------------------------------------------------------------
+void ofSerial::setPacketDelimiter(unsigned char delimiter){
+	packetDelimiter = delimiter;
+	packetLength = 0;
+	if(reader){
+		reader->setFraming(packetDelimiter, packetLength);
+	}
+}
+
+//----------------------------------------------------------------
+void ofSerial::setPacketLength(size_t length){
+	packetDelimiter = -1;
+	packetLength = length;
+	if(reader){
+		reader->setFraming(packetDelimiter, packetLength);
+	}
+}
+
+//----------------------------------------------------------------
+void ofSerial::clearPacketFraming(){
+	packetDelimiter = -1;
+	packetLength = 0;
+	if(reader){
+		reader->setFraming(packetDelimiter, packetLength);
+	}
+}
+
+//----------------------------------------------------------------
+bool ofSerial::readPacket(ofSerialPacket & packet){
+	if(!reader){
+		ofLogError("ofSerial") << "readPacket(): call startReading() first";
+		return false;
+	}
+	return reader->readPacket(packet);
+}
+
+//----------------------------------------------------------------
+size_t ofSerial::getNumBytesDropped() const{
+	return reader ? reader->getNumBytesDropped() : 0;
+}
+#endif
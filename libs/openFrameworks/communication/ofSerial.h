@@ -22,6 +22,24 @@
     #endif
 #endif
 
+#if !defined(TARGET_NO_THREADS) && (__cplusplus>=201103L || defined(_MSC_VER))
+	#define OF_USING_SERIAL_READER
+#endif
+
+#ifdef OF_USING_SERIAL_READER
+class ofSerialReader;
+
+/// \brief A packet received by an ofSerial reading in the background.
+/// \sa ofSerial::setPacketDelimiter() ofSerial::setPacketLength()
+struct ofSerialPacket{
+	/// The bytes of the packet, without the delimiter.
+	vector<unsigned char> data;
+
+	/// ofGetElapsedTimeMicros() when the last byte of the packet was
+	/// received by the reader thread.
+	unsigned long long timestamp;
+};
+#endif
 
 /// \brief  ofSerial provides a cross platform system for interfacing with the
 /// serial port. You can choose the port and baud rate, and then read and send
@@ -50,6 +68,11 @@ public:
 	/// connection to any devices. You'll need to use the setup() method
 	/// before doing that.
 	ofSerial();
+
+	/// Copies use the same port as the original but not its reader
+	/// thread, startReading() has to be called again on the copy.
+	ofSerial(const ofSerial & mom);
+	ofSerial & operator=(const ofSerial & mom);
 	
 	virtual ~ofSerial();
 	
@@ -256,6 +279,77 @@ public:
 	void drain();
 	
 	/// \}
+
+#ifdef OF_USING_SERIAL_READER
+	/// \name Background Reading
+	/// \{
+
+	/// \brief Starts reading the port from a thread.
+	///
+	/// Reading from update() only empties the port once per frame, with fast
+	/// devices the OS buffer can overflow in between and bytes are lost. Once
+	/// started, a thread waits for data on the port and copies it as soon as
+	/// it arrives to a buffer of the given size. available(), readBytes(),
+	/// readByte() and flush() then work on that buffer so the rest of the code
+	/// doesn't need to change:
+	///
+	/// ~~~~{.cpp}
+	///     serial.setup("/dev/ttyACM0", 115200);
+	///     serial.setPacketDelimiter('\n');
+	///     serial.startReading();
+	///     ...
+	///     ofSerialPacket packet;
+	///     while(serial.readPacket(packet)){
+	///         string line(packet.data.begin(), packet.data.end());
+	///     }
+	/// ~~~~
+	///
+	/// The buffer has a single reader, all the read functions must be called
+	/// from the same thread. If the buffer fills up, new bytes are dropped.
+	///
+	/// Only available when compiling with c++11 support, in that case
+	/// OF_USING_SERIAL_READER is defined.
+	///
+	/// \param bufferSize Bytes that can be waiting to be read, rounded up to
+	/// a power of 2.
+	/// \returns false if the port is not open.
+	bool startReading(size_t bufferSize = 65536);
+
+	/// \brief Stops the reading thread, any data still in its buffer is lost.
+	void stopReading();
+
+	/// \returns true if a thread is reading the port.
+	bool isReading() const;
+
+	/// \brief Splits the received data in packets ending in a delimiter.
+	///
+	/// Can be changed while reading, it applies to the data received after
+	/// the call.
+	void setPacketDelimiter(unsigned char delimiter);
+
+	/// \brief Splits the received data in packets of a fixed length.
+	///
+	/// Can be changed while reading, it applies to the data received after
+	/// the call.
+	void setPacketLength(size_t length);
+
+	/// \brief Stops splitting the received data in packets, the default.
+	void clearPacketFraming();
+
+	/// \brief Reads the oldest complete packet.
+	///
+	/// The bytes of packets can be read with readBytes() too, packets
+	/// whose bytes were already read that way are skipped.
+	///
+	/// \returns false if there's no complete packet.
+	bool readPacket(ofSerialPacket & packet);
+
+	/// \returns the number of bytes dropped because the buffer was full.
+	/// Packets that lost bytes are dropped as a whole.
+	size_t getNumBytesDropped() const;
+
+	/// \}
+#endif
 	
 protected:
 	void buildDeviceList();
@@ -281,6 +375,12 @@ protected:
 	int fd;	// the handle to the serial port mac
 	struct termios oldoptions;
 #endif
+
+#ifdef OF_USING_SERIAL_READER
+	shared_ptr<ofSerialReader> reader;
+	int packetDelimiter;
+	size_t packetLength;
+#endif
 	
 };
 
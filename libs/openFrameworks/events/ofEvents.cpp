@@ -1,4 +1,5 @@
 #include "ofEvents.h"
+#include "ofProfiler.h"
 
 
 static ofEventArgs voidEventArgs;
@@ -132,6 +133,11 @@ void ofCoreEvents::setFrameRate(int _targetRate){
 	}
 }
 
+//--------------------------------------
+ofTimer & ofCoreEvents::getFrameTimer(){
+	return timer;
+}
+
 //--------------------------------------
 float ofCoreEvents::getFrameRate() const{
 	return fps.getFps();
@@ -186,20 +192,26 @@ int ofCoreEvents::getPreviousMouseY() const{
 
 //------------------------------------------
 void ofCoreEvents::notifySetup(){
+	OF_PROFILE_SCOPE("notifySetup");
 	ofNotifyEvent( setup, voidEventArgs );
 }
 
 #include "ofGraphics.h"
 //------------------------------------------
 void ofCoreEvents::notifyUpdate(){
+	OF_PROFILE_SCOPE("notifyUpdate");
 	ofNotifyEvent( update, voidEventArgs );
 }
 
 //------------------------------------------
 void ofCoreEvents::notifyDraw(){
-	ofNotifyEvent( draw, voidEventArgs );
+	{
+		OF_PROFILE_SCOPE("notifyDraw");
+		ofNotifyEvent( draw, voidEventArgs );
+	}
 
 	if (bFrameRateSet){
+		OF_PROFILE_SCOPE("frameRateWait");
 		timer.waitNext();
 	}
 	
@@ -219,6 +231,7 @@ void ofCoreEvents::notifyDraw(){
 
 //------------------------------------------
 void ofCoreEvents::notifyKeyPressed(int key, int keycode, int scancode, int codepoint){
+	OF_PROFILE_SCOPE("notifyKeyPressed");
 	// FIXME: modifiers are being reported twice, for generic and for left/right
 	// add operators to the arguments class so it can be checked for both
     if(key == OF_KEY_RIGHT_CONTROL || key == OF_KEY_LEFT_CONTROL){
@@ -249,6 +262,7 @@ void ofCoreEvents::notifyKeyPressed(int key, int keycode, int scancode, int code
 
 //------------------------------------------
 void ofCoreEvents::notifyKeyReleased(int key, int keycode, int scancode, int codepoint){
+	OF_PROFILE_SCOPE("notifyKeyReleased");
 	// FIXME: modifiers are being reported twice, for generic and for left/right
 	// add operators to the arguments class so it can be checked for both
     if(key == OF_KEY_RIGHT_CONTROL || key == OF_KEY_LEFT_CONTROL){
@@ -314,6 +328,7 @@ void ofCoreEvents::notifyMouseEvent(const ofMouseEventArgs & mouseEvent){
 
 //------------------------------------------
 void ofCoreEvents::notifyMousePressed(int x, int y, int button){
+	OF_PROFILE_SCOPE("notifyMousePressed");
     if( bPreMouseNotSet ){
 		previousMouseX	= x;
 		previousMouseY	= y;
@@ -334,6 +349,7 @@ void ofCoreEvents::notifyMousePressed(int x, int y, int button){
 
 //------------------------------------------
 void ofCoreEvents::notifyMouseReleased(int x, int y, int button){
+	OF_PROFILE_SCOPE("notifyMouseReleased");
 	if( bPreMouseNotSet ){
 		previousMouseX	= x;
 		previousMouseY	= y;
@@ -353,6 +369,7 @@ void ofCoreEvents::notifyMouseReleased(int x, int y, int button){
 
 //------------------------------------------
 void ofCoreEvents::notifyMouseDragged(int x, int y, int button){
+	OF_PROFILE_SCOPE("notifyMouseDragged");
 	if( bPreMouseNotSet ){
 		previousMouseX	= x;
 		previousMouseY	= y;
@@ -371,6 +388,7 @@ void ofCoreEvents::notifyMouseDragged(int x, int y, int button){
 
 //------------------------------------------
 void ofCoreEvents::notifyMouseMoved(int x, int y){
+	OF_PROFILE_SCOPE("notifyMouseMoved");
 	if( bPreMouseNotSet ){
 		previousMouseX	= x;
 		previousMouseY	= y;
@@ -389,6 +407,7 @@ void ofCoreEvents::notifyMouseMoved(int x, int y){
 
 //------------------------------------------
 void ofCoreEvents::notifyMouseScrolled(float x, float y){
+	OF_PROFILE_SCOPE("notifyMouseScrolled");
 	ofMouseEventArgs mouseEventArgs(ofMouseEventArgs::Scrolled,x,y);
 
 	mouseEventArgs.x = x;
@@ -399,22 +418,26 @@ void ofCoreEvents::notifyMouseScrolled(float x, float y){
 
 //------------------------------------------
 void ofCoreEvents::notifyExit(){
+	OF_PROFILE_SCOPE("notifyExit");
 	ofNotifyEvent( exit, voidEventArgs );
 }
 
 //------------------------------------------
 void ofCoreEvents::notifyWindowResized(int width, int height){
+	OF_PROFILE_SCOPE("notifyWindowResized");
 	ofResizeEventArgs resizeEventArgs(width,height);
 	ofNotifyEvent( windowResized, resizeEventArgs );
 }
 
 //------------------------------------------
 void ofCoreEvents::notifyDragEvent(ofDragInfo info){
+	OF_PROFILE_SCOPE("notifyDragEvent");
 	ofNotifyEvent(fileDragEvent, info);
 }
 
 //------------------------------------------
 void ofCoreEvents::notifyWindowEntry( int state ) {
+	OF_PROFILE_SCOPE("notifyWindowEntry");
 	ofEntryEventArgs entryArgs(state);
 	ofNotifyEvent(windowEntered, entryArgs);
 
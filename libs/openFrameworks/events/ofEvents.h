@@ -232,6 +232,12 @@ class ofCoreEvents {
 	double getLastFrameTime() const;
 	int getFrameNum() const;
 
+	/// \brief The timer used to keep the frame rate set with setFrameRate().
+	///
+	/// Allows to set a spin time for more precise frame timing and to
+	/// check the latency and overrun stats of each frame.
+	ofTimer & getFrameTimer();
+
 	bool getMousePressed(int button=-1) const;
 	bool getKeyPressed(int key=-1) const;
 	int getMouseX() const;
@@ -134,6 +134,23 @@ void ofBufferObject::updateData(GLintptr offset, GLsizeiptr bytes, const void *
 }
 
 #ifndef TARGET_OPENGLES
+void ofBufferObject::setStorage(GLsizeiptr bytes, const void * data, GLbitfield flags){
+	if(!this->data) return;
+	this->data->size = bytes;
+
+#ifdef GLEW_ARB_direct_state_access
+	if (this->data->useDSA) {
+		glNamedBufferStorage(this->data->id, bytes, data, flags);
+		return;
+	}
+#endif
+
+	/// --------| invariant: direct state access is not available
+	bind(this->data->lastTarget);
+	glBufferStorage(this->data->lastTarget, bytes, data, flags);
+	unbind(this->data->lastTarget);
+}
+
 void * ofBufferObject::map(GLenum access){
 	if(!this->data) return NULL;
 
@@ -174,7 +191,7 @@ void * ofBufferObject::mapRange(GLintptr offset, GLsizeiptr length, GLenum acces
 
 #ifdef GLEW_ARB_direct_state_access
 	if (data->useDSA) {
-		return glMapBufferRange(data->id,offset,length,access);
+		return glMapNamedBufferRange(data->id,offset,length,access);
 	}
 #endif
 
@@ -201,3 +218,143 @@ GLsizeiptr ofBufferObject::size() const{
 	if (data) return data->size;
 	else return 0;
 }
+
+#ifndef TARGET_OPENGLES
+ofStreamingBufferObject::ofStreamingBufferObject()
+:mapping(NULL)
+,currentRegion(0)
+,regionSize(0)
+,reserved(0){
+
+}
+
+ofStreamingBufferObject::~ofStreamingBufferObject(){
+	clearFences();
+}
+
+void ofStreamingBufferObject::clearFences(){
+	for(size_t i=0;i<fences.size();i++){
+		if(fences[i]){
+			glDeleteSync(fences[i]);
+		}
+	}
+	fences.clear();
+}
+
+void ofStreamingBufferObject::allocate(GLsizeiptr bytesPerRegion, int numRegions){
+	clearFences();
+	numRegions = max(numRegions,1);
+	regionSize = bytesPerRegion;
+	fences.resize(numRegions,0);
+	currentRegion = 0;
+	reserved = 0;
+	mapping = NULL;
+
+	// a new buffer, the old one is released once the gpu is done with it
+	buffer = ofBufferObject();
+	buffer.allocate();
+	buffer.bind(GL_ARRAY_BUFFER);
+	buffer.unbind(GL_ARRAY_BUFFER);
+	GLsizeiptr size = regionSize * numRegions;
+	if(ofGetGLRenderer() && (ofGetGLRenderer()->getGLVersionMajor()>4 ||
+			(ofGetGLRenderer()->getGLVersionMajor()==4 && ofGetGLRenderer()->getGLVersionMinor()>=4) ||
+			ofGLCheckExtension("GL_ARB_buffer_storage"))){
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		buffer.setStorage(size, NULL, flags);
+		mapping = static_cast<unsigned char*>(buffer.mapRange(0, size, flags));
+		buffer.unbind(GL_ARRAY_BUFFER);
+		if(!mapping){
+			ofLogWarning("ofStreamingBufferObject") << "allocate(): couldn't map the buffer, using glBufferSubData";
+			buffer = ofBufferObject();
+			buffer.allocate();
+		}
+	}
+	if(!mapping){
+		buffer.setData(size, NULL, GL_STREAM_DRAW);
+	}
+}
+
+bool ofStreamingBufferObject::isAllocated() const{
+	return buffer.isAllocated();
+}
+
+GLintptr ofStreamingBufferObject::reserve(GLsizeiptr bytes, GLsizeiptr alignment){
+	GLintptr regionOffset = getRegionOffset();
+	// aligned relative to the start of the buffer, regions don't need to be a multiple of alignment
+	GLintptr offset = regionOffset + reserved;
+	if(alignment>1){
+		offset = ((offset + alignment - 1) / alignment) * alignment;
+	}
+	if(!isAllocated() || offset + bytes > regionOffset + regionSize){
+		return -1;
+	}
+	reserved = offset + bytes - regionOffset;
+	return offset;
+}
+
+void ofStreamingBufferObject::write(GLintptr offset, GLsizeiptr bytes, const void * data){
+	if(mapping){
+		memcpy(mapping + offset, data, bytes);
+	}else{
+		buffer.updateData(offset, bytes, data);
+	}
+}
+
+void ofStreamingBufferObject::nextRegion(){
+	if(fences.empty()){
+		return;
+	}
+	if(reserved){
+		if(fences[currentRegion]){
+			glDeleteSync(fences[currentRegion]);
+		}
+		fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+	currentRegion = (currentRegion + 1) % fences.size();
+	reserved = 0;
+
+	GLsync fence = fences[currentRegion];
+	if(fence){
+		// usually already signaled, the first wait also flushes the commands
+		// so the fence is guaranteed to signal eventually
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		while(true){
+			GLenum result = glClientWaitSync(fence, waitFlags, 1000000000);
+			if(result==GL_ALREADY_SIGNALED || result==GL_CONDITION_SATISFIED || result==GL_WAIT_FAILED){
+				break;
+			}
+			waitFlags = 0;
+		}
+		glDeleteSync(fence);
+		fences[currentRegion] = 0;
+	}
+}
+
+GLintptr ofStreamingBufferObject::getRegionOffset() const{
+	return GLintptr(currentRegion) * regionSize;
+}
+
+GLsizeiptr ofStreamingBufferObject::getRegionSize() const{
+	return regionSize;
+}
+
+int ofStreamingBufferObject::getNumRegions() const{
+	return fences.size();
+}
+
+GLsizeiptr ofStreamingBufferObject::getBytesReserved() const{
+	return reserved;
+}
+
+bool ofStreamingBufferObject::isMapped() const{
+	return mapping!=NULL;
+}
+
+ofBufferObject & ofStreamingBufferObject::getBuffer(){
+	return buffer;
+}
+
+const ofBufferObject & ofStreamingBufferObject::getBuffer() const{
+	return buffer;
+}
+#endif
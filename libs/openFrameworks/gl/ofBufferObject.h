@@ -66,6 +66,14 @@ public:
 	/// for this buffer uploading data to that target and unbinding again
 	void updateData(GLintptr offset, GLsizeiptr bytes, const void * data);
 
+#ifndef TARGET_OPENGLES
+	/// glNamedBufferStorage: https://www.opengl.org/sdk/docs/man4/html/glBufferStorage.xhtml
+	/// allocates immutable storage, needed to map the buffer with GL_MAP_PERSISTENT_BIT.
+	/// requires GL 4.4 or GL_ARB_buffer_storage, before GL 4.5 emulates glNamedBufferStorage
+	/// by binding to last known target for this buffer and unbinding again
+	void setStorage(GLsizeiptr bytes, const void * data, GLbitfield flags);
+#endif
+
 	/// typed version of setData, same functionality but guesses the size from the size
 	/// of the passed vector and size of the type
 	template<typename T>
@@ -134,3 +142,79 @@ private:
 	};
 	shared_ptr<Data> data;
 };
+
+#ifndef TARGET_OPENGLES
+/// ring buffer for data that changes every frame, like the vertices of meshes
+/// that are drawn once and then modified.
+///
+/// the buffer is divided in regions, 3 by default, and each frame writes to the
+/// next one. when a region is done nextRegion() puts a fence after the commands
+/// that read from it, so it's not written again until the gpu has finished with
+/// it, usually 2 frames later without stalling. writing doesn't allocate or
+/// orphan buffers, with GL 4.4 or GL_ARB_buffer_storage the buffer is mapped
+/// once and data is copied straight into it, otherwise it uses glBufferSubData.
+///
+///     GLintptr offset = stream.reserve(vertices.size()*sizeof(ofVec3f), sizeof(ofVec3f));
+///     if(offset!=-1){
+///         stream.write(offset, vertices.size()*sizeof(ofVec3f), &vertices[0]);
+///         // draw from stream.getBuffer() starting at offset
+///     }
+///     ...
+///     // once per frame, after the last draw using the buffer
+///     stream.nextRegion();
+class ofStreamingBufferObject {
+public:
+	ofStreamingBufferObject();
+	~ofStreamingBufferObject();
+
+	/// allocates numRegions regions of bytesPerRegion bytes each, any
+	/// previous data or fences are discarded
+	void allocate(GLsizeiptr bytesPerRegion, int numRegions=3);
+
+	/// true if allocate was called before
+	bool isAllocated() const;
+
+	/// reserves bytes in the current region aligned to a multiple of alignment,
+	/// which doesn't need to be a power of 2, so offset/alignment can be used
+	/// as the index of the first element. returns the offset in the buffer or -1
+	/// if the region doesn't have enough space left
+	GLintptr reserve(GLsizeiptr bytes, GLsizeiptr alignment=4);
+
+	/// copies data to a range of the buffer in the current region, usually
+	/// reserved with reserve()
+	void write(GLintptr offset, GLsizeiptr bytes, const void * data);
+
+	/// fences the current region and moves to the next one, waiting for the
+	/// gpu to finish with it if it's still being used
+	void nextRegion();
+
+	/// offset in the buffer where the current region starts
+	GLintptr getRegionOffset() const;
+
+	GLsizeiptr getRegionSize() const;
+	int getNumRegions() const;
+
+	/// bytes reserved so far in the current region
+	GLsizeiptr getBytesReserved() const;
+
+	/// true if the buffer is persistently mapped
+	bool isMapped() const;
+
+	ofBufferObject & getBuffer();
+	const ofBufferObject & getBuffer() const;
+
+private:
+	// fences and the mapping belong to one buffer
+	ofStreamingBufferObject(const ofStreamingBufferObject &);
+	ofStreamingBufferObject & operator=(const ofStreamingBufferObject &);
+
+	void clearFences();
+
+	ofBufferObject buffer;
+	unsigned char * mapping;
+	vector<GLsync> fences;
+	int currentRegion;
+	GLsizeiptr regionSize;
+	GLsizeiptr reserved;
+};
+#endif
@@ -74,6 +74,14 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 	currentFramebufferId = 0;
 	defaultFramebufferId = 0;
 
+#ifndef TARGET_OPENGLES
+	meshStreaming = true;
+	meshStreamOverflow = false;
+	meshStreamVertexCapacity = 1 << 16;
+	meshStreamIndexCapacity = 1 << 17;
+	meshStreamVerticesUsed = 0;
+	meshStreamIndicesUsed = 0;
+#endif
 }
 
 ofGLProgrammableRenderer::~ofGLProgrammableRenderer() {
@@ -109,6 +117,31 @@ void ofGLProgrammableRenderer::finishRender() {
 	}
 	matrixStack.clearStacks();
 	framebufferIdStack.clear();
+
+#ifndef TARGET_OPENGLES
+	if(meshStreamPositions.isAllocated()){
+		meshStreamPositions.nextRegion();
+		meshStreamColors.nextRegion();
+		meshStreamNormals.nextRegion();
+		meshStreamTexCoords.nextRegion();
+		meshStreamIndices.nextRegion();
+
+		// some meshes didn't fit this frame, grow so they do in the next ones.
+		// meshes bigger than the maximum keep being uploaded to a vbo
+		if(meshStreamOverflow){
+			static const int maxVertices = 1 << 20;
+			static const int maxIndices = 1 << 22;
+			int numVertices = min(max(meshStreamVertexCapacity * 2, meshStreamVerticesUsed), maxVertices);
+			int numIndices = min(max(meshStreamIndexCapacity * 2, meshStreamIndicesUsed), maxIndices);
+			if(numVertices>meshStreamVertexCapacity || numIndices>meshStreamIndexCapacity){
+				allocateMeshStream(max(numVertices, meshStreamVertexCapacity), max(numIndices, meshStreamIndexCapacity));
+			}
+		}
+	}
+	meshStreamOverflow = false;
+	meshStreamVerticesUsed = 0;
+	meshStreamIndicesUsed = 0;
+#endif
 }
 
 //----------------------------------------------------------
@@ -180,9 +213,13 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	
 
 #ifndef TARGET_OPENGLES
-	meshVbo.setMesh(vertexData, GL_STREAM_DRAW, useColors, useTextures, useNormals);
 	glPolygonMode(GL_FRONT_AND_BACK, ofGetGLPolyMode(renderType));
 	GLenum drawMode = ofGetGLPrimitiveMode(vertexData.getMode());
+	if(meshStreaming && streamMesh(vertexData, drawMode, useColors, useTextures, useNormals)){
+		glPolygonMode(GL_FRONT_AND_BACK, currentStyle.bFill ?  GL_FILL : GL_LINE);
+		return;
+	}
+	meshVbo.setMesh(vertexData, GL_STREAM_DRAW, useColors, useTextures, useNormals);
 #else
 	meshVbo.setMesh(vertexData, GL_STATIC_DRAW, useColors, useTextures, useNormals);
 	GLenum drawMode;
@@ -222,6 +259,105 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	//if (bSmoothHinted) endSmoothing();
 }
 
+#ifndef TARGET_OPENGLES
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::streamMesh(const ofMesh & vertexData, GLenum drawMode, bool useColors, bool useTextures, bool useNormals) const{
+	// every attribute has its own ring buffer, all of them with room for the same
+	// number of vertices, so the position of the first vertex in the positions
+	// buffer is the base vertex for all of them
+	int numVertices = vertexData.getNumVertices();
+	int numIndices = vertexData.getNumIndices();
+	if(!meshStreamPositions.isAllocated()){
+		const_cast<ofGLProgrammableRenderer*>(this)->allocateMeshStream(meshStreamVertexCapacity, meshStreamIndexCapacity);
+	}
+	meshStreamVerticesUsed += numVertices;
+	meshStreamIndicesUsed += numIndices;
+
+	GLintptr positionsOffset = meshStreamPositions.reserve(numVertices * sizeof(ofVec3f), sizeof(ofVec3f));
+	GLintptr indicesOffset = 0;
+	if(positionsOffset!=-1 && numIndices){
+		indicesOffset = meshStreamIndices.reserve(numIndices * sizeof(ofIndexType), sizeof(ofIndexType));
+	}
+	if(positionsOffset==-1 || indicesOffset==-1){
+		meshStreamOverflow = true;
+		return false;
+	}
+	GLint baseVertex = positionsOffset / sizeof(ofVec3f);
+
+	meshStreamPositions.write(positionsOffset, numVertices * sizeof(ofVec3f), vertexData.getVerticesPointer());
+	if(numIndices){
+		meshStreamIndices.write(indicesOffset, numIndices * sizeof(ofIndexType), vertexData.getIndexPointer());
+	}
+
+	useColors &= vertexData.hasColors();
+	if(useColors){
+		int numColors = min<int>(vertexData.getNumColors(), numVertices);
+		meshStreamColors.write(baseVertex * sizeof(ofFloatColor), numColors * sizeof(ofFloatColor), vertexData.getColorsPointer());
+		meshStreamVbo.enableColors();
+	}else{
+		meshStreamVbo.disableColors();
+	}
+
+	useNormals &= vertexData.hasNormals();
+	if(useNormals){
+		int numNormals = min<int>(vertexData.getNumNormals(), numVertices);
+		meshStreamNormals.write(baseVertex * sizeof(ofVec3f), numNormals * sizeof(ofVec3f), vertexData.getNormalsPointer());
+		meshStreamVbo.enableNormals();
+	}else{
+		meshStreamVbo.disableNormals();
+	}
+
+	useTextures &= vertexData.hasTexCoords();
+	if(useTextures){
+		int numTexCoords = min<int>(vertexData.getNumTexCoords(), numVertices);
+		meshStreamTexCoords.write(baseVertex * sizeof(ofVec2f), numTexCoords * sizeof(ofVec2f), vertexData.getTexCoordsPointer());
+		meshStreamVbo.enableTexCoords();
+	}else{
+		meshStreamVbo.disableTexCoords();
+	}
+
+	meshStreamVbo.bind();
+	const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,useColors,useTextures,useNormals);
+	if(numIndices){
+		glDrawElementsBaseVertex(drawMode, numIndices, GL_UNSIGNED_INT, (void*)indicesOffset, baseVertex);
+	}else{
+		glDrawArrays(drawMode, baseVertex, numVertices);
+	}
+	meshStreamVbo.unbind();
+	return true;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::allocateMeshStream(int numVertices, int numIndices){
+	meshStreamVertexCapacity = numVertices;
+	meshStreamIndexCapacity = numIndices;
+	meshStreamPositions.allocate(numVertices * sizeof(ofVec3f));
+	meshStreamColors.allocate(numVertices * sizeof(ofFloatColor));
+	meshStreamNormals.allocate(numVertices * sizeof(ofVec3f));
+	meshStreamTexCoords.allocate(numVertices * sizeof(ofVec2f));
+	meshStreamIndices.allocate(numIndices * sizeof(ofIndexType));
+
+	// the attributes always point to the start of the buffers,
+	// each draw selects its vertices through the base vertex
+	meshStreamVbo = ofVbo();
+	meshStreamVbo.setVertexBuffer(meshStreamPositions.getBuffer(), 3, sizeof(ofVec3f));
+	meshStreamVbo.setColorBuffer(meshStreamColors.getBuffer(), sizeof(ofFloatColor));
+	meshStreamVbo.setNormalBuffer(meshStreamNormals.getBuffer(), sizeof(ofVec3f));
+	meshStreamVbo.setTexCoordBuffer(meshStreamTexCoords.getBuffer(), sizeof(ofVec2f));
+	meshStreamVbo.setIndexBuffer(meshStreamIndices.getBuffer());
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setMeshStreaming(bool streaming){
+	meshStreaming = streaming;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::getMeshStreaming() const{
+	return meshStreaming;
+}
+#endif
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVboMesh & mesh, ofPolyRenderMode renderType) const{
 	drawInstanced(mesh,renderType,1);
@@ -1759,8 +1895,19 @@ void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string te
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
+	// get the mesh before binding the texture so glyphs
+	// rasterized on demand are already in the atlas. the
+	// mesh is laid out at the fractional part of x,y so it
+	// can come from the font cache, it's moved by whole
+	// pixels into place using the matrix
+	float pixelX = floor(x);
+	float pixelY = floor(y);
+	const ofMesh & mesh = font.getStringMesh(text,x-pixelX,y-pixelY,isVFlipped());
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	mutThis->pushMatrix();
+	mutThis->translate(pixelX,pixelY);
+	draw(mesh,OF_MESH_FILL);
+	mutThis->popMatrix();
 	mutThis->unbind(font.getFontTexture(),0);
 
 	mutThis->setBlendMode(blendMode);
@@ -2263,6 +2410,13 @@ void ofGLProgrammableRenderer::setup(int _major, int _minor){
 
 	major = _major;
 	minor = _minor;
+
+#ifndef TARGET_OPENGLES
+	// without persistent mapping the stream is written with glBufferSubData
+	// which is not faster than uploading each mesh to its own vbo
+	meshStreaming = major>4 || (major==4 && minor>=4) || ofGLCheckExtension("GL_ARB_buffer_storage");
+#endif
+
 #ifdef TARGET_RASPBERRY_PI
 	uniqueShader = true;
 #else
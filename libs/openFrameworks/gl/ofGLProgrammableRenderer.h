@@ -196,6 +196,11 @@ public:
 
 	const GLuint& getCurrentFramebufferId() const { return currentFramebufferId; };
 
+	/// framebuffer used as default at the start of each frame, for windows
+	/// that don't render to framebuffer 0. the window has to bind it
+	void setDefaultFramebufferId(GLuint id){ defaultFramebufferId = id; };
+	const GLuint& getDefaultFramebufferId() const { return defaultFramebufferId; };
+
 	void begin(const ofFbo & fbo, bool setupPerspective);
 	void end(const ofFbo & fbo);
 
@@ -233,6 +238,15 @@ public:
 	int getGLVersionMajor();
 	int getGLVersionMinor();
 
+#ifndef TARGET_OPENGLES
+	/// meshes drawn with draw(ofMesh) are copied to a persistently mapped
+	/// streaming buffer instead of being uploaded to a vbo on every call.
+	/// enabled by default when the GL version is 4.4 or GL_ARB_buffer_storage
+	/// is supported, disabling it is mostly useful to compare both
+	void setMeshStreaming(bool streaming);
+	bool getMeshStreaming() const;
+#endif
+
 	void saveScreen(int x, int y, int w, int h, ofPixels & pixels);
 	void saveFullViewport(ofPixels & pixels);
 
@@ -249,6 +263,22 @@ private:
 	mutable ofMesh lineMesh;
 	mutable ofVbo meshVbo;
 
+#ifndef TARGET_OPENGLES
+	bool streamMesh(const ofMesh & vertexData, GLenum drawMode, bool useColors, bool useTextures, bool useNormals) const;
+	void allocateMeshStream(int numVertices, int numIndices);
+
+	bool meshStreaming;
+	mutable bool meshStreamOverflow;
+	int meshStreamVertexCapacity, meshStreamIndexCapacity;
+	mutable int meshStreamVerticesUsed, meshStreamIndicesUsed;
+	mutable ofStreamingBufferObject meshStreamPositions;
+	mutable ofStreamingBufferObject meshStreamColors;
+	mutable ofStreamingBufferObject meshStreamNormals;
+	mutable ofStreamingBufferObject meshStreamTexCoords;
+	mutable ofStreamingBufferObject meshStreamIndices;
+	mutable ofVbo meshStreamVbo;
+#endif
+
 	void uploadCurrentMatrix();
 
 
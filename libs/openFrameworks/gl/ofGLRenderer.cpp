@@ -1611,8 +1611,19 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, string text, float x,
     glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	// get the mesh before binding the texture so glyphs
+	// rasterized on demand are already in the atlas. the
+	// mesh is laid out at the fractional part of x,y so it
+	// can come from the font cache, it's moved by whole
+	// pixels into place using the matrix
+	float pixelX = floor(x);
+	float pixelY = floor(y);
+	const ofMesh & mesh = font.getStringMesh(text,x-pixelX,y-pixelY,isVFlipped());
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	mutThis->pushMatrix();
+	mutThis->translate(pixelX,pixelY);
+	draw(mesh,OF_MESH_FILL);
+	mutThis->popMatrix();
 	mutThis->unbind(font.getFontTexture(),0);
 
 	if(!blendEnabled){
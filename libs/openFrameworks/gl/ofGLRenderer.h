@@ -207,6 +207,11 @@ public:
 
 	const GLuint& getCurrentFramebufferId() const { return currentFramebufferId; };
 
+	/// framebuffer used as default at the start of each frame, for windows
+	/// that don't render to framebuffer 0. the window has to bind it
+	void setDefaultFramebufferId(GLuint id){ defaultFramebufferId = id; };
+	const GLuint& getDefaultFramebufferId() const { return defaultFramebufferId; };
+
 	int getGLVersionMajor();
 	int getGLVersionMinor();
 
@@ -230,6 +230,8 @@ ofVbo::ofVbo(const ofVbo & mom){
 	totalIndices = mom.totalIndices;
 	indexAttribute = mom.indexAttribute;
 
+	vaoID = 0;
+	vaoChanged = false;
 	if(ofIsGLProgrammableRenderer()){
 		vaoID	   = mom.vaoID;
 		retainVAO(vaoID);
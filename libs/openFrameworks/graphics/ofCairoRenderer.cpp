@@ -7,9 +7,46 @@
 #include "ofTrueTypeFont.h"
 #include "ofNode.h"
 #include "ofGraphics.h"
+#include "ofThreadPool.h"
 
 const string ofCairoRenderer::TYPE="cairo";
 
+#if (CAIRO_VERSION_MAJOR==1 && CAIRO_VERSION_MINOR>=10) || CAIRO_VERSION_MAJOR>1
+	#define OF_CAIRO_RECORDING_SURFACE
+#endif
+
+#ifdef OF_CAIRO_RECORDING_SURFACE
+// replays a recorded frame into a band of rows of the image, used with ofParallelFor
+class ofCairoImageTile{
+public:
+	ofCairoImageTile(cairo_surface_t * recording, ofPixels & pixels, int y, int height, int tileHeight)
+	:recording(recording)
+	,pixels(pixels)
+	,y(y)
+	,height(height)
+	,tileHeight(tileHeight){}
+
+	void operator()(size_t i) const{
+		int tileY = y + i * tileHeight;
+		int h = min(tileHeight, y + height - tileY);
+		int stride = pixels.getWidth() * 4;
+		cairo_surface_t * tile = cairo_image_surface_create_for_data(pixels.getData() + tileY * stride, CAIRO_FORMAT_ARGB32, pixels.getWidth(), h, stride);
+		cairo_t * tileCr = cairo_create(tile);
+		cairo_set_source_surface(tileCr, recording, 0, -tileY);
+		cairo_paint(tileCr);
+		cairo_destroy(tileCr);
+		cairo_surface_finish(tile);
+		cairo_surface_destroy(tile);
+	}
+
+	cairo_surface_t * recording;
+	ofPixels & pixels;
+	int y;
+	int height;
+	int tileHeight;
+};
+#endif
+
 _cairo_status ofCairoRenderer::stream_function(void *closure,const unsigned char *data, unsigned int length){
 	((ofCairoRenderer*)closure)->streamBuffer.append((const char*)data,length);
 	return CAIRO_STATUS_SUCCESS;
@@ -25,6 +62,7 @@ ofCairoRenderer::ofCairoRenderer()
 	multiPage = false;
 	b3D = false;
 	currentMatrixMode=OF_MATRIX_MODELVIEW;
+	imageTiles = 1;
 }
 
 ofCairoRenderer::~ofCairoRenderer(){
@@ -80,7 +118,14 @@ void ofCairoRenderer::setup(string _filename, Type _type, bool multiPage_, bool
 	case IMAGE:
 		imageBuffer.allocate(_viewport.width, _viewport.height, 4);
 		imageBuffer.set(0);
-		surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,_viewport.width, _viewport.height,_viewport.width*4);
+		if(isImageTiled()){
+#ifdef OF_CAIRO_RECORDING_SURFACE
+			cairo_rectangle_t extents = {0, 0, double(imageBuffer.getWidth()), double(imageBuffer.getHeight())};
+			surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+#endif
+		}else{
+			surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,_viewport.width, _viewport.height,_viewport.width*4);
+		}
 		break;
 	case FROM_FILE_EXTENSION:
 		ofLogFatalError("ofCairoRenderer") << "setup(): couldn't determine type from extension for filename: \"" << _filename << "\"!";
@@ -106,13 +151,131 @@ void ofCairoRenderer::setupMemoryOnly(Type _type, bool multiPage_, bool b3D_, of
 	setup("",_type,multiPage_,b3D_,_viewport);
 }
 
-void ofCairoRenderer::flush(){
+void ofCairoRenderer::setImageTiles(size_t numTiles){
 	if(surface){
+		ofLogError("ofCairoRenderer") << "setImageTiles(): has to be called before setup()";
+		return;
+	}
+#ifndef OF_CAIRO_RECORDING_SURFACE
+	if(numTiles!=1){
+		ofLogWarning("ofCairoRenderer") << "setImageTiles(): image tiles need cairo 1.10 or later";
+	}
+#endif
+	imageTiles = numTiles;
+}
+
+size_t ofCairoRenderer::getImageTiles() const{
+	return imageTiles;
+}
+
+bool ofCairoRenderer::isImageTiled() const{
+#ifdef OF_CAIRO_RECORDING_SURFACE
+	return type==IMAGE && imageTiles!=1;
+#else
+	return false;
+#endif
+}
+
+void ofCairoRenderer::rasterizeImageTiles(){
+#ifdef OF_CAIRO_RECORDING_SURFACE
+	// only the rows that were drawn to need to be replayed
+	double inkX, inkY, inkWidth, inkHeight;
+	cairo_recording_surface_ink_extents(surface, &inkX, &inkY, &inkWidth, &inkHeight);
+	int y = ofClamp(floor(inkY), 0, imageBuffer.getHeight());
+	int height = ofClamp(ceil(inkY + inkHeight), 0, imageBuffer.getHeight()) - y;
+
+	if(height>0 && inkWidth>0){
+		size_t numTiles = imageTiles;
+		if(numTiles==0){
+			numTiles = max(ofGetThreadPool().getNumThreads() * 2, (size_t)1);
+		}
+		int tileHeight = max((height + (int)numTiles - 1) / (int)numTiles, 1);
+		numTiles = (height + tileHeight - 1) / tileHeight;
+
+		// the first replay of a recording surface lazily builds an index of
+		// its commands, do it once on this thread before replaying from several
+		unsigned char primePixel[4];
+		cairo_surface_t * prime = cairo_image_surface_create_for_data(primePixel, CAIRO_FORMAT_ARGB32, 1, 1, 4);
+		cairo_t * primeCr = cairo_create(prime);
+		cairo_set_source_surface(primeCr, surface, 0, -y);
+		cairo_paint(primeCr);
+		cairo_destroy(primeCr);
+		cairo_surface_destroy(prime);
+
+		ofCairoImageTile tile(surface, imageBuffer, y, height, tileHeight);
+		ofParallelFor(0, numTiles, tile, 1);
+	}
+
+	// start recording the next frame, keeping the state of the context
+	cairo_rectangle_t extents = {0, 0, double(imageBuffer.getWidth()), double(imageBuffer.getHeight())};
+	cairo_surface_t * recording = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+	cairo_t * recordingCr = cairo_create(recording);
+	cairo_matrix_t matrix;
+	cairo_get_matrix(cr, &matrix);
+	cairo_set_matrix(recordingCr, &matrix);
+
+	// the clip rectangles are in user space so they are copied after the
+	// matrix, clips that aren't rectangles are approximated by their extents
+	cairo_rectangle_list_t * clip = cairo_copy_clip_rectangle_list(cr);
+	if(clip->status==CAIRO_STATUS_SUCCESS){
+		for(int i=0;i<clip->num_rectangles;i++){
+			const cairo_rectangle_t & r = clip->rectangles[i];
+			cairo_rectangle(recordingCr, r.x, r.y, r.width, r.height);
+		}
+	}else{
+		double x1, y1, x2, y2;
+		cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+		cairo_rectangle(recordingCr, x1, y1, x2 - x1, y2 - y1);
+	}
+	cairo_clip(recordingCr);
+	cairo_rectangle_list_destroy(clip);
+
+	cairo_set_source(recordingCr, cairo_get_source(cr));
+	cairo_set_operator(recordingCr, cairo_get_operator(cr));
+	cairo_set_tolerance(recordingCr, cairo_get_tolerance(cr));
+	cairo_set_antialias(recordingCr, cairo_get_antialias(cr));
+	cairo_set_fill_rule(recordingCr, cairo_get_fill_rule(cr));
+	cairo_set_line_width(recordingCr, cairo_get_line_width(cr));
+	cairo_set_line_cap(recordingCr, cairo_get_line_cap(cr));
+	cairo_set_line_join(recordingCr, cairo_get_line_join(cr));
+	cairo_set_miter_limit(recordingCr, cairo_get_miter_limit(cr));
+
+	int numDashes = cairo_get_dash_count(cr);
+	vector<double> dashes(numDashes);
+	double dashOffset = 0;
+	if(numDashes>0){
+		cairo_get_dash(cr, &dashes[0], &dashOffset);
+		cairo_set_dash(recordingCr, &dashes[0], numDashes, dashOffset);
+	}
+
+	cairo_matrix_t fontMatrix;
+	cairo_get_font_matrix(cr, &fontMatrix);
+	cairo_set_font_face(recordingCr, cairo_get_font_face(cr));
+	cairo_set_font_matrix(recordingCr, &fontMatrix);
+	cairo_font_options_t * fontOptions = cairo_font_options_create();
+	cairo_get_font_options(cr, fontOptions);
+	cairo_set_font_options(recordingCr, fontOptions);
+	cairo_font_options_destroy(fontOptions);
+
+	cairo_destroy(cr);
+	cairo_surface_destroy(surface);
+	cr = recordingCr;
+	surface = recording;
+#endif
+}
+
+void ofCairoRenderer::flush(){
+	if(isImageTiled() && surface){
+		rasterizeImageTiles();
+	}else if(surface){
 		cairo_surface_flush(surface);
 	}
 }
 
 void ofCairoRenderer::close(){
+	if(isImageTiled() && surface){
+		rasterizeImageTiles();
+	}
 	if(surface){
 		cairo_surface_flush(surface);
 		if(type==IMAGE && filename!=""){
@@ -147,7 +310,7 @@ void ofCairoRenderer::startRender(){
 }
 
 void ofCairoRenderer::finishRender(){
-	cairo_surface_flush(surface);
+	flush();
 }
 
 void ofCairoRenderer::setStyle(const ofStyle & style){
@@ -1382,6 +1545,8 @@ cairo_surface_t * ofCairoRenderer::getCairoSurface(){
 ofPixels & ofCairoRenderer::getImageSurfacePixels(){
 	if(type!=IMAGE){
 		ofLogError("ofCairoRenderer") << "getImageSurfacePixels(): can only get pixels from image surface";
+	}else if(isImageTiled() && surface){
+		rasterizeImageTiles();
 	}
 	return imageBuffer;
 }
@@ -28,6 +28,16 @@ public:
 	};
 	void setup(string filename, Type type=ofCairoRenderer::FROM_FILE_EXTENSION, bool multiPage=true, bool b3D=false, ofRectangle viewport = ofRectangle(0,0,0,0));
 	void setupMemoryOnly(Type _type, bool multiPage=true, bool b3D=false, ofRectangle viewport = ofRectangle(0,0,0,0));
+
+	// IMAGE surfaces only: records each frame and replays it in numTiles
+	// horizontal bands from the thread pool when it finishes, which speeds up
+	// large images. frames are composited over the previous one so only the
+	// alpha blend mode accumulates across frames exactly.
+	// has to be called before setup, 0 uses two tiles per thread, 1 (default)
+	// draws directly to the pixels
+	void setImageTiles(size_t numTiles);
+	size_t getImageTiles() const;
+
 	void close();
 	void flush();
 
@@ -156,8 +166,13 @@ public:
 	void drawString(const ofTrueTypeFont & font, string text, float x, float y) const;
 
 	// cairo specifics
+	// when using image tiles the context and the surface are replaced by new
+	// ones for each frame, every time the tiles are rasterized in flush(),
+	// close() or getImageSurfacePixels(), so they have to be asked for again
+	// after that instead of being kept. the state of the context is carried
+	// over but not the states saved with cairo_save()
 	cairo_t * getCairoContext();
-	cairo_surface_t * getCairoSurface();
+	cairo_surface_t * getCairoSurface(); // the frame's recording surface when using image tiles
 	ofPixels & getImageSurfacePixels();
 	ofBuffer & getContentBuffer();
 
@@ -172,6 +187,8 @@ private:
 	ofVec3f transform(ofVec3f vec) const;
 	static _cairo_status stream_function(void *closure,const unsigned char *data, unsigned int length);
 	void draw(const ofPixels & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	bool isImageTiled() const;
+	void rasterizeImageTiles();
 
 	mutable deque<ofPoint> curvePoints;
 	cairo_t * cr;
@@ -202,6 +219,7 @@ private:
 	string filename;
 	ofBuffer streamBuffer;
 	ofPixels imageBuffer;
+	size_t imageTiles;
 
 	ofStyle currentStyle;
 	deque <ofStyle> styleHistory;
@@ -583,6 +583,8 @@ void ofEnableBlendMode(ofBlendMode blendMode){
 void ofEnablePointSprites(){
 	if(ofGetCurrentRenderer()->getType()=="GL" || ofGetCurrentRenderer()->getType()=="ProgrammableGL"){
 		static_cast<ofBaseGLRenderer*>(ofGetCurrentRenderer().get())->enablePointSprites();
+	}else if(ofGetCurrentRenderer()->getType()==ofRendererCollection::TYPE){
+		static_cast<ofRendererCollection*>(ofGetCurrentRenderer().get())->enablePointSprites();
 	}
 }
 
@@ -590,6 +592,8 @@ void ofEnablePointSprites(){
 void ofDisablePointSprites(){
 	if(ofGetCurrentRenderer()->getType()=="GL" || ofGetCurrentRenderer()->getType()=="ProgrammableGL"){
 		static_cast<ofBaseGLRenderer*>(ofGetCurrentRenderer().get())->disablePointSprites();
+	}else if(ofGetCurrentRenderer()->getType()==ofRendererCollection::TYPE){
+		static_cast<ofRendererCollection*>(ofGetCurrentRenderer().get())->disablePointSprites();
 	}
 }
 
@@ -635,6 +639,68 @@ void ofDisableAntiAliasing(){
 	ofGetCurrentRenderer()->disableAntiAliasing();
 }
 
+static shared_ptr<ofRendererCollection> batchingRenderer;
+static shared_ptr<ofBaseRenderer> batchedRenderer;
+
+// draws what's still batched once everything else has drawn, the windows
+// swap buffers before finishing the render so waiting for the end of
+// the frame would draw it into the next one
+class ofBatchFlusher{
+public:
+	ofBatchFlusher():events(NULL){}
+
+	void draw(ofEventArgs &){
+		ofFlushBatch();
+	}
+
+	ofCoreEvents * events;
+};
+static ofBatchFlusher batchFlusher;
+
+//----------------------------------------
+void ofEnableBatching(){
+	if(batchingRenderer){
+		return;
+	}
+	batchedRenderer = ofGetCurrentRenderer();
+	batchingRenderer = shared_ptr<ofRendererCollection>(new ofRendererCollection);
+	batchingRenderer->renderers.push_back(batchedRenderer);
+	batchingRenderer->setBatching(true);
+	// the style and matrices are already set up in the renderer being wrapped
+	ofSetCurrentRenderer(batchingRenderer, false);
+	batchFlusher.events = &ofEvents();
+	ofAddListener(batchFlusher.events->draw, &batchFlusher, &ofBatchFlusher::draw, OF_EVENT_ORDER_AFTER_APP + 100);
+}
+
+//----------------------------------------
+void ofDisableBatching(){
+	if(!batchingRenderer){
+		return;
+	}
+	ofRemoveListener(batchFlusher.events->draw, &batchFlusher, &ofBatchFlusher::draw, OF_EVENT_ORDER_AFTER_APP + 100);
+	batchFlusher.events = NULL;
+	batchingRenderer->setBatching(false);
+	if(ofGetCurrentRenderer()==batchingRenderer){
+		ofSetCurrentRenderer(batchedRenderer, false);
+	}else{
+		ofLogWarning("ofGraphics") << "ofDisableBatching(): the renderer changed since ofEnableBatching(), not restoring it";
+	}
+	batchingRenderer.reset();
+	batchedRenderer.reset();
+}
+
+//----------------------------------------
+void ofFlushBatch(){
+	if(batchingRenderer){
+		batchingRenderer->flush();
+	}
+}
+
+//----------------------------------------
+bool ofIsBatching(){
+	return batchingRenderer!=NULL;
+}
+
 //----------------------------------------
 void ofSetDrawBitmapMode(ofDrawBitmapMode mode){
 	ofGetCurrentRenderer()->setBitmapTextMode(mode);
@@ -809,6 +809,48 @@ void ofEnableAntiAliasing();
 /// \brief Turns off anti-aliasing (smoothing).
 void ofDisableAntiAliasing();
 
+/// \brief Batches consecutive lines, rectangles, triangles, circles and ellipses
+/// into one draw call.
+///
+/// Each ofDrawCircle() and similar is otherwise a draw call of its own,
+/// which makes drawing thousands of them slow. While batching they are
+/// accumulated into one mesh, with the current color as vertex colors, which
+/// is drawn when something else is drawn, the matrix or a style setting
+/// other than the color changes, a texture or shader is bound or the frame
+/// ends:
+///
+/// ~~~~{.cpp}
+/// void ofApp::draw(){
+///     ofEnableBatching();
+///     for(auto & p: particles){
+///         ofSetColor(p.color);
+///         ofDrawCircle(p.pos, p.radius);  // one draw call for all of them
+///     }
+///     ofDisableBatching();
+/// }
+/// ~~~~
+///
+/// Batching can also stay enabled across frames, calling ofEnableBatching()
+/// once in setup(), what's pending is drawn at the end of every draw, after
+/// all the draw listeners and before the window swaps buffers.
+///
+/// It replaces the current renderer with an ofRendererCollection that batches,
+/// so GL calls made directly need ofDisableBatching() or ofFlushBatch() first
+/// to draw on top of the batched primitives. Lines are not batched while
+/// smoothing is enabled.
+void ofEnableBatching();
+
+/// \brief Draws the batched primitives and restores the renderer.
+/// \sa ofEnableBatching()
+void ofDisableBatching();
+
+/// \brief Draws the primitives batched so far without disabling batching.
+/// \sa ofEnableBatching()
+void ofFlushBatch();
+
+/// \returns true between ofEnableBatching() and ofDisableBatching().
+bool ofIsBatching();
+
 // drawing style - combines color, fill, blending and smoothing
 ofStyle ofGetStyle();
 
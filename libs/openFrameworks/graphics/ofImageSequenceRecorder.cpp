@@ -0,0 +1,212 @@
+#include "ofImageSequenceRecorder.h"
+
+#ifdef OF_USING_IMAGE_SEQUENCE_RECORDER
+
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+
+// defined in ofImage.cpp
+void ofInitFreeImage(bool deinit);
+
+//--------------------------------------------------
+ofImageSequenceRecorder::ofImageSequenceRecorder()
+:extension("png")
+,quality(OF_IMAGE_QUALITY_BEST)
+,numDigits(5)
+,maxQueueSize(32)
+,dropFrames(true)
+,numAdded(0)
+,numWritten(0)
+,numQueued(0)
+,numDropped(0){
+
+}
+
+//--------------------------------------------------
+ofImageSequenceRecorder::~ofImageSequenceRecorder(){
+	close();
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::setup(const string & _prefix, const string & _extension, size_t numThreads){
+	close();
+
+	prefix = _prefix;
+	extension = _extension;
+	numAdded = 0;
+	numWritten = 0;
+	numDropped = 0;
+
+	// done here once instead of from every worker at the same time
+	ofInitFreeImage(false);
+	ofFilePath::createEnclosingDirectory(prefix);
+
+	pool.reset(new ofThreadPool(numThreads));
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::setMaxQueueSize(size_t frames){
+	std::unique_lock<std::mutex> lock(mutex);
+	maxQueueSize = std::max(frames, size_t(1));
+	frameWritten.notify_all();
+}
+
+//--------------------------------------------------
+size_t ofImageSequenceRecorder::getMaxQueueSize() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return maxQueueSize;
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::setDropFrames(bool drop){
+	std::unique_lock<std::mutex> lock(mutex);
+	dropFrames = drop;
+}
+
+//--------------------------------------------------
+bool ofImageSequenceRecorder::getDropFrames() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return dropFrames;
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::setImageQuality(ofImageQualityType _quality){
+	quality = _quality;
+}
+
+//--------------------------------------------------
+ofImageQualityType ofImageSequenceRecorder::getImageQuality() const{
+	return quality;
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::setNumDigits(int digits){
+	numDigits = digits;
+}
+
+//--------------------------------------------------
+int ofImageSequenceRecorder::getNumDigits() const{
+	return numDigits;
+}
+
+//--------------------------------------------------
+bool ofImageSequenceRecorder::reserveFrame(size_t & frame, shared_ptr<ofPixels> & pixels){
+	if(!pool){
+		ofLogError("ofImageSequenceRecorder") << "add(): call setup() before adding frames";
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	if(numQueued >= maxQueueSize){
+		if(dropFrames){
+			numDropped++;
+			return false;
+		}
+		frameWritten.wait(lock, [this]{
+			return numQueued < maxQueueSize;
+		});
+	}
+	numQueued++;
+	frame = numAdded++;
+
+	if(freePixels.empty()){
+		pixels = std::make_shared<ofPixels>();
+	}else{
+		pixels = freePixels.back();
+		freePixels.pop_back();
+	}
+	return true;
+}
+
+//--------------------------------------------------
+bool ofImageSequenceRecorder::add(ofPixels && pixels){
+	size_t frame;
+	shared_ptr<ofPixels> framePixels;
+	if(!reserveFrame(frame, framePixels)){
+		return false;
+	}
+	// the caller gets back the memory of a frame already written, if any
+	framePixels->swap(pixels);
+	write(frame, framePixels);
+	return true;
+}
+
+//--------------------------------------------------
+bool ofImageSequenceRecorder::add(const ofPixels & pixels){
+	size_t frame;
+	shared_ptr<ofPixels> framePixels;
+	if(!reserveFrame(frame, framePixels)){
+		return false;
+	}
+	*framePixels = pixels;
+	write(frame, framePixels);
+	return true;
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::write(size_t frame, shared_ptr<ofPixels> pixels){
+	string fileName = getFileName(frame);
+	ofImageQualityType frameQuality = quality;
+	pool->submit([this, fileName, frameQuality, pixels]{
+		ofSaveImage(*pixels, fileName, frameQuality);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		numQueued--;
+		numWritten++;
+		if(freePixels.size() < maxQueueSize){
+			freePixels.push_back(pixels);
+		}
+		frameWritten.notify_all();
+	});
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::waitForQueue(){
+	std::unique_lock<std::mutex> lock(mutex);
+	frameWritten.wait(lock, [this]{
+		return numQueued == 0;
+	});
+}
+
+//--------------------------------------------------
+void ofImageSequenceRecorder::close(){
+	if(!pool){
+		return;
+	}
+	waitForQueue();
+	pool.reset();
+	std::unique_lock<std::mutex> lock(mutex);
+	freePixels.clear();
+}
+
+//--------------------------------------------------
+size_t ofImageSequenceRecorder::getNumFramesAdded() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numAdded;
+}
+
+//--------------------------------------------------
+size_t ofImageSequenceRecorder::getNumFramesWritten() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numWritten;
+}
+
+//--------------------------------------------------
+size_t ofImageSequenceRecorder::getNumFramesQueued() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numQueued;
+}
+
+//--------------------------------------------------
+size_t ofImageSequenceRecorder::getNumFramesDropped() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numDropped;
+}
+
+//--------------------------------------------------
+string ofImageSequenceRecorder::getFileName(size_t frame) const{
+	return prefix + ofToString(frame, numDigits, '0') + "." + extension;
+}
+
+#endif
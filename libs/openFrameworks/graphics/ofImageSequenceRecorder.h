@@ -0,0 +1,137 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofThreadPool.h"
+
+#ifdef OF_USING_THREAD_POOL
+#define OF_USING_IMAGE_SEQUENCE_RECORDER
+
+#include "ofPixels.h"
+#include "ofImage.h"
+
+/// \class ofImageSequenceRecorder
+/// \brief Saves frames as numbered image files using its own worker threads.
+///
+/// ofSaveImage() and ofSaveFrame() encode and write the image in the calling
+/// thread, which at 60fps is usually longer than a frame. The recorder queues
+/// the pixels instead and encodes them in parallel so the main loop only pays
+/// for handing the pixels over:
+///
+///     void ofApp::setup(){
+///         recorder.setup("capture/frame_");
+///     }
+///
+///     void ofApp::draw(){
+///         ...
+///         fbo.readToPixels(pixels);
+///         recorder.add(std::move(pixels));
+///     }
+///
+/// Frames are numbered in the order they are added, even if they finish
+/// encoding in a different order, so the files can be imported as a
+/// sequence. The queue is bounded: when it's full new frames are dropped,
+/// which is what a live capture needs, or add() waits for a free slot if
+/// setDropFrames(false) is used, which is what an offline render needs.
+///
+/// Only available when compiling with c++11 support, in that case
+/// OF_USING_IMAGE_SEQUENCE_RECORDER is defined.
+class ofImageSequenceRecorder{
+public:
+	ofImageSequenceRecorder();
+
+	/// \brief Waits for every queued frame to be written.
+	~ofImageSequenceRecorder();
+
+	/// \brief Starts a new sequence, numbering frames from 0.
+	///
+	/// Files are named prefix + frame number + "." + extension, the
+	/// folder in the prefix is created if it doesn't exist yet. If there
+	/// was a sequence recording already its frames are written first.
+	///
+	/// \param prefix Path relative to the data folder, eg. "frames/frame_".
+	/// \param extension Image format, any format ofSaveImage() supports.
+	/// \param numThreads Threads encoding frames, 0 uses one per processor.
+	void setup(const string & prefix, const string & extension = "png", size_t numThreads = 0);
+
+	/// \brief Sets how many frames can be waiting to be written.
+	///
+	/// Each queued frame keeps its pixels in memory. Default is 32.
+	void setMaxQueueSize(size_t frames);
+	size_t getMaxQueueSize() const;
+
+	/// \brief Sets what add() does when the queue is full.
+	///
+	/// \param drop If true, the default, the frame is dropped and add()
+	/// returns false, if false add() waits until a frame is written.
+	void setDropFrames(bool drop);
+	bool getDropFrames() const;
+
+	/// \brief Sets the quality used for formats that support it.
+	/// \sa ofSaveImage()
+	void setImageQuality(ofImageQualityType quality);
+	ofImageQualityType getImageQuality() const;
+
+	/// \brief Sets to how many digits frame numbers are padded with zeros. Default is 5.
+	void setNumDigits(int digits);
+	int getNumDigits() const;
+
+	/// \brief Queues a frame taking ownership of its pixels.
+	///
+	/// Moving the pixels avoids copying them, pixels is left
+	/// empty or with the memory of a frame already written so it
+	/// can be reused without allocating.
+	///
+	/// \returns false if the frame was dropped.
+	bool add(ofPixels && pixels);
+
+	/// \brief Queues a copy of a frame.
+	///
+	/// The copy reuses the memory of frames already written.
+	///
+	/// \returns false if the frame was dropped.
+	bool add(const ofPixels & pixels);
+
+	/// \brief Waits until every queued frame has been written.
+	void waitForQueue();
+
+	/// \brief Writes every queued frame and stops the threads.
+	void close();
+
+	/// \returns the number of frames numbered so far, written or not.
+	size_t getNumFramesAdded() const;
+
+	/// \returns the number of frames written to disk.
+	size_t getNumFramesWritten() const;
+
+	/// \returns the number of frames waiting to be or being written.
+	size_t getNumFramesQueued() const;
+
+	/// \returns the number of frames dropped because the queue was full.
+	size_t getNumFramesDropped() const;
+
+	/// \returns the path of the file for a frame number.
+	string getFileName(size_t frame) const;
+
+private:
+	bool reserveFrame(size_t & frame, shared_ptr<ofPixels> & pixels);
+	void write(size_t frame, shared_ptr<ofPixels> pixels);
+
+	unique_ptr<ofThreadPool> pool;
+	mutable std::mutex mutex;
+	std::condition_variable frameWritten;
+	vector<shared_ptr<ofPixels> > freePixels;
+
+	string prefix;
+	string extension;
+	ofImageQualityType quality;
+	int numDigits;
+	size_t maxQueueSize;
+	bool dropFrames;
+
+	size_t numAdded;
+	size_t numWritten;
+	size_t numQueued;
+	size_t numDropped;
+};
+
+#endif
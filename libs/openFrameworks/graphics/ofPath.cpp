@@ -1,6 +1,58 @@
 #include "ofPath.h"
 #include "ofAppRunner.h"
 #include "ofTessellator.h"
+#include "ofThreadPool.h"
+
+//----------------------------------------------------------
+// tessellators shared by all the paths. each thread that is tessellating
+// takes one for the duration of the call so there's only as many of them
+// as paths were ever tessellated at the same time
+class ofPathTessellators{
+public:
+	~ofPathTessellators(){
+		for(size_t i=0;i<available.size();i++){
+			delete available[i];
+		}
+	}
+
+	ofTessellator * acquire(){
+		ofScopedLock lock(mutex);
+		if(available.empty()){
+			return new ofTessellator;
+		}
+		ofTessellator * tessellator = available.back();
+		available.pop_back();
+		return tessellator;
+	}
+
+	void release(ofTessellator * tessellator){
+		ofScopedLock lock(mutex);
+		available.push_back(tessellator);
+	}
+
+private:
+	ofMutex mutex;
+	vector<ofTessellator*> available;
+};
+
+static ofPathTessellators & getTessellators(){
+	static ofPathTessellators tessellators;
+	return tessellators;
+}
+
+//----------------------------------------------------------
+// tessellates each path, used with ofParallelFor
+class ofPathTessellate{
+public:
+	ofPathTessellate(ofPath ** paths)
+	:paths(paths){}
+
+	void operator()(size_t i) const{
+		paths[i]->tessellate();
+	}
+
+	ofPath ** paths;
+};
 
 ofPath::Command::Command(Type type)
 :type(type){
@@ -46,6 +98,9 @@ ofPath::ofPath(){
 	bHasChanged = false;
 	bUseShapeColor = true;
 	bNeedsPolylinesGeneration = false;
+	cachedTessellationValid = false;
+	tessellatedContourValid = false;
+	tessellationHash = 0;
 	clear();
 }
 
@@ -56,7 +111,9 @@ void ofPath::clear(){
 	// let one polyline and clear it: avoids instantiation
 	polylines.resize(1);
 	polylines[0].clear();
-	cachedTessellation.clear();
+	// the tessellation is kept in case the same shape is built again,
+	// the hash of the new polylines decides if it's still valid
+	bNeedsTessellation = true;
 	flagShapeChanged();
 }
 
@@ -424,10 +481,7 @@ void ofPath::setPolyWindingMode(ofPolyWindingMode newMode){
 
 //----------------------------------------------------------
 void ofPath::setFilled(bool hasFill){
-	if(bFill != hasFill){
-		bFill = hasFill;
-		if(!cachedTessellationValid) bNeedsTessellation = true;
-	}
+	bFill = hasFill;
 }
 
 //----------------------------------------------------------
@@ -526,22 +580,55 @@ void ofPath::generatePolylinesFromCommands(){
 
 		bNeedsPolylinesGeneration = false;
 		bNeedsTessellation = true;
-		cachedTessellationValid=false;
 	}
 }
 
+//----------------------------------------------------------
+uint64_t ofPath::getPolylinesHash() const{
+	// FNV-1a of everything the tessellation depends on
+	uint64_t hash = 14695981039346656037ULL;
+	const uint64_t prime = 1099511628211ULL;
+	hash = (hash ^ (uint64_t)windingMode) * prime;
+	for(size_t i=0;i<polylines.size();i++){
+		hash = (hash ^ (uint64_t)polylines[i].size()) * prime;
+		hash = (hash ^ (uint64_t)polylines[i].isClosed()) * prime;
+		if(polylines[i].size()==0) continue;
+		const unsigned char * data = (const unsigned char*)&polylines[i].getVertices()[0];
+		size_t numBytes = polylines[i].size() * sizeof(ofPoint);
+		for(size_t j=0;j<numBytes;j++){
+			hash = (hash ^ data[j]) * prime;
+		}
+	}
+	return hash;
+}
+
 //----------------------------------------------------------
 void ofPath::tessellate(){
 	generatePolylinesFromCommands();
-	if(!bNeedsTessellation) return;
-	if(bFill){
-		tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
+	if(bNeedsTessellation){
+		uint64_t hash = getPolylinesHash();
+		if(hash!=tessellationHash){
+			tessellationHash = hash;
+			cachedTessellationValid = false;
+			tessellatedContourValid = false;
+		}
+		bNeedsTessellation = false;
+	}
+
+	bool needsMesh = bFill && !cachedTessellationValid;
+	bool needsContour = hasOutline() && windingMode!=OF_POLY_WINDING_ODD && !tessellatedContourValid;
+	if(!needsMesh && !needsContour) return;
+
+	ofTessellator * tessellator = getTessellators().acquire();
+	if(needsMesh){
+		tessellator->tessellateToMesh( polylines, windingMode, cachedTessellation);
 		cachedTessellationValid=true;
 	}
-	if(hasOutline() && windingMode!=OF_POLY_WINDING_ODD){
-		tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
+	if(needsContour){
+		tessellator->tessellateToPolylines( polylines, windingMode, tessellatedContour);
+		tessellatedContourValid=true;
 	}
-	bNeedsTessellation = false;
+	getTessellators().release(tessellator);
 }
 
 //----------------------------------------------------------
@@ -778,3 +865,18 @@ void ofPath::addCommand(const ofPath::Command & command){
 	}
 	commands.push_back(command);
 }
+
+//----------------------------------------------------------
+void ofTessellatePaths(vector<ofPath> & paths){
+	vector<ofPath*> pointers(paths.size());
+	for(size_t i=0;i<paths.size();i++){
+		pointers[i] = &paths[i];
+	}
+	ofTessellatePaths(pointers);
+}
+
+//----------------------------------------------------------
+void ofTessellatePaths(const vector<ofPath*> & paths){
+	if(paths.empty()) return;
+	ofParallelFor(0, paths.size(), ofPathTessellate(const_cast<ofPath**>(&paths[0])));
+}
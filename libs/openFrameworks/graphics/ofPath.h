@@ -303,6 +303,16 @@ public:
 	vector<ofPolyline> & getOutline();
 	const vector<ofPolyline> & getOutline() const;
 
+	/// \brief Converts the path into triangles for its fill and, if the winding
+	/// mode isn't OF_POLY_WINDING_ODD, into its outline contours.
+	///
+	/// Called automatically when drawing the path or getting its tessellation.
+	/// The result is cached with a hash of the path's geometry so a path that
+	/// is cleared and rebuilt with the same shape, eg. every frame, isn't
+	/// tessellated again.
+	///
+	/// Different paths can be tessellated from different threads at the same
+	/// time, see ofTessellatePaths().
 	void tessellate();
 
 	ofMesh & getTessellation();
@@ -379,6 +389,7 @@ private:
 	ofPolyline & lastPolyline();
 	void addCommand(const Command & command);
 	void generatePolylinesFromCommands();
+	uint64_t getPolylinesHash() const;
 
 	// path description
 	//vector<ofSubPath>		paths;
@@ -400,8 +411,8 @@ private:
 	ofVboMesh			cachedTessellation;
 #endif
 	bool				cachedTessellationValid;
-
-	ofTessellator tessellator;
+	bool				tessellatedContourValid;
+	uint64_t			tessellationHash;
 
 	bool				bHasChanged;
 	int					prevCurveRes;
@@ -413,4 +424,11 @@ private:
 	Mode				mode;
 };
 
-
+/// \brief Tessellates many paths in parallel using the global thread pool.
+///
+/// Has the same result as calling tessellate() on each path, eg. after
+/// loading a file with thousands of shapes so the first frame that draws them
+/// doesn't have to tessellate them all. Paths that didn't change since they
+/// were last tessellated are skipped.
+void ofTessellatePaths(vector<ofPath> & paths);
+void ofTessellatePaths(const vector<ofPath*> & paths);
@@ -0,0 +1,556 @@
+#include "ofRecordingRenderer.h"
+#include "ofMesh.h"
+#include "ofLog.h"
+
+const string ofRecordingRenderer::TYPE="Recording";
+
+//----------------------------------------------------------
+ofRecordingRenderer::ofRecordingRenderer()
+:clearOnStartRender(true)
+,backgroundAuto(true)
+,handedness(OF_LEFT_HANDED)
+,graphics3d(this){
+
+}
+
+//----------------------------------------------------------
+const vector<ofRecordingRenderer::Call> & ofRecordingRenderer::getCalls() const{
+	return calls;
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumCalls(CallType type) const{
+	size_t num = 0;
+	for(size_t i=0;i<calls.size();i++){
+		if(calls[i].type==type){
+			num++;
+		}
+	}
+	return num;
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumDrawCalls() const{
+	return calls.size() - getNumCalls(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clearCalls(){
+	calls.clear();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setClearOnStartRender(bool clear){
+	clearOnStartRender = clear;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::record(CallType type) const{
+	Call call;
+	call.type = type;
+	call.primitiveMode = OF_PRIMITIVE_TRIANGLES;
+	call.numVertices = 0;
+	call.numIndices = 0;
+	call.usedColors = false;
+	call.style = currentStyle;
+	calls.push_back(call);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::startRender(){
+	if(clearOnStartRender){
+		calls.clear();
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::finishRender(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPolyline & poly) const{
+	record(Polyline);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPath & shape) const{
+	record(Path);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
+	record(Mesh);
+	Call & call = calls.back();
+	call.primitiveMode = vertexData.getMode();
+	call.numVertices = vertexData.getNumVertices();
+	call.numIndices = vertexData.getNumIndices();
+	call.usedColors = useColors && vertexData.getNumColors();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const of3dPrimitive & model, ofPolyRenderMode renderType) const{
+	record(Primitive);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofNode & node) const{
+	record(Node);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Image);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Image);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Image);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const{
+	record(Video);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushView(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popView(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(ofRectangle viewport){
+	currentViewport = viewport;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(float x, float y, float width, float height, bool vflip){
+	currentViewport.set(x,y,width,height);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenPerspective(float width, float height, float fov, float nearDist, float farDist){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenOrtho(float width, float height, float nearDist, float farDist){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setOrientation(ofOrientation orientation, bool vFlip){
+
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getCurrentViewport() const{
+	return currentViewport;
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getNativeViewport() const{
+	return currentViewport;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportWidth() const{
+	return currentViewport.width;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportHeight() const{
+	return currentViewport.height;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::isVFlipped() const{
+	return true;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCoordHandedness(ofHandednessType _handedness){
+	handedness = _handedness;
+}
+
+//----------------------------------------------------------
+ofHandednessType ofRecordingRenderer::getCoordHandedness() const{
+	return handedness;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushMatrix(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popMatrix(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentMatrix(ofMatrixMode matrixMode_) const{
+	return ofMatrix4x4::newIdentityMatrix();
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentOrientationMatrix() const{
+	return ofMatrix4x4::newIdentityMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(float x, float y, float z){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(const ofPoint & p){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::scale(float xAmnt, float yAmnt, float zAmnt){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotate(float degrees, float vecX, float vecY, float vecZ){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateX(float degrees){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateY(float degrees){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateZ(float degrees){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotate(float degrees){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::matrixMode(ofMatrixMode mode){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadIdentityMatrix(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const ofMatrix4x4 & m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const float * m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const ofMatrix4x4 & m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const float * m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadViewMatrix(const ofMatrix4x4 & m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multViewMatrix(const ofMatrix4x4 & m){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentViewMatrix() const{
+	return ofMatrix4x4::newIdentityMatrix();
+}
+
+//----------------------------------------------------------
+ofMatrix4x4 ofRecordingRenderer::getCurrentNormalMatrix() const{
+	return ofMatrix4x4::newIdentityMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::bind(const ofCamera & camera, const ofRectangle & viewport){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::unbind(const ofCamera & camera){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupGraphicDefaults(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreen(){
+	record(Transform);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setRectMode(ofRectMode mode){
+	currentStyle.rectMode = mode;
+}
+
+//----------------------------------------------------------
+ofRectMode ofRecordingRenderer::getRectMode(){
+	return currentStyle.rectMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setFillMode(ofFillFlag fill){
+	currentStyle.bFill = (fill==OF_FILLED);
+}
+
+//----------------------------------------------------------
+ofFillFlag ofRecordingRenderer::getFillMode(){
+	return currentStyle.bFill ? OF_FILLED : OF_OUTLINE;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineWidth(float lineWidth){
+	currentStyle.lineWidth = lineWidth;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setDepthTest(bool depthTest){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBlendMode(ofBlendMode blendMode){
+	currentStyle.blendingMode = blendMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineSmoothing(bool smooth){
+	currentStyle.smoothing = smooth;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCircleResolution(int res){
+	currentStyle.circleResolution = res;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::enableAntiAliasing(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::disableAntiAliasing(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b){
+	setColor(r,g,b,255);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b, int a){
+	currentStyle.color.set(r,g,b,a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color){
+	setColor(color.r,color.g,color.b,color.a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color, int _a){
+	setColor(color.r,color.g,color.b,_a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int gray){
+	setColor(gray,gray,gray);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setHexColor(int hexColor){
+	setColor((hexColor >> 16) & 0xff, (hexColor >> 8) & 0xff, (hexColor >> 0) & 0xff);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
+	currentStyle.drawBitmapMode = mode;
+}
+
+//----------------------------------------------------------
+ofColor ofRecordingRenderer::getBackgroundColor(){
+	return currentStyle.bgColor;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundColor(const ofColor & c){
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(const ofColor & c){
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(float brightness){
+	background(ofColor(brightness));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int hexColor, float _a){
+	background(ofColor::fromHex(hexColor,_a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int r, int g, int b, int a){
+	background(ofColor(r,g,b,a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundAuto(bool bAuto){
+	backgroundAuto = bAuto;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::getBackgroundAuto(){
+	return backgroundAuto;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float r, float g, float b, float a){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float brightness, float a){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clearAlpha(){
+
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
+	record(Line);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawRectangle(float x, float y, float z, float w, float h) const{
+	record(Rectangle);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const{
+	record(Triangle);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawCircle(float x, float y, float z, float radius) const{
+	record(Circle);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawEllipse(float x, float y, float z, float width, float height) const{
+	record(Ellipse);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(string text, float x, float y, float z) const{
+	record(String);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
+	record(String);
+}
+
+//----------------------------------------------------------
+ofPath & ofRecordingRenderer::getPath(){
+	return path;
+}
+
+//----------------------------------------------------------
+ofStyle ofRecordingRenderer::getStyle() const{
+	return currentStyle;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setStyle(const ofStyle & style){
+	currentStyle = style;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushStyle(){
+	styleHistory.push_back(currentStyle);
+	if(styleHistory.size() > OF_MAX_STYLE_HISTORY){
+		styleHistory.pop_front();
+		ofLogWarning("ofRecordingRenderer") << "pushStyle(): maximum number of style pushes << " << OF_MAX_STYLE_HISTORY << " reached, did you forget to pop somewhere?";
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popStyle(){
+	if(!styleHistory.empty()){
+		setStyle(styleHistory.back());
+		styleHistory.pop_back();
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCurveResolution(int resolution){
+	currentStyle.curveResolution = resolution;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setPolyMode(ofPolyWindingMode mode){
+	currentStyle.polyMode = mode;
+}
+
+//----------------------------------------------------------
+const of3dGraphics & ofRecordingRenderer::get3dGraphics() const{
+	return graphics3d;
+}
+
+//----------------------------------------------------------
+of3dGraphics & ofRecordingRenderer::get3dGraphics(){
+	return graphics3d;
+}
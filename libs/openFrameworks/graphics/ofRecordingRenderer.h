@@ -0,0 +1,208 @@
+#pragma once
+
+#include "ofBaseTypes.h"
+#include "of3dGraphics.h"
+#include "ofPath.h"
+#include <deque>
+
+/// \class ofRecordingRenderer
+/// \brief Renderer that doesn't draw anything but records the calls it receives.
+///
+/// It keeps the style like any other renderer so it can be used instead of
+/// or together with a GL renderer in an ofRendererCollection, which makes it
+/// possible to check what reaches a renderer without a GPU or a window, eg.
+/// how many draw calls a batched frame ends up as:
+///
+///     shared_ptr<ofRecordingRenderer> recorder(new ofRecordingRenderer);
+///     ofSetCurrentRenderer(recorder);
+///     ofEnableBatching();
+///     for(int i = 0; i < 100; i++){
+///         ofDrawCircle(i * 10, 100, 5);
+///     }
+///     ofDisableBatching();
+///     // recorder->getNumCalls(ofRecordingRenderer::Mesh) == 1
+///
+/// Only draw calls and matrix changes are recorded, style changes are
+/// stored with each draw call instead.
+class ofRecordingRenderer: public ofBaseRenderer{
+public:
+	enum CallType{
+		Mesh,
+		Primitive,
+		Node,
+		Polyline,
+		Path,
+		Line,
+		Rectangle,
+		Triangle,
+		Circle,
+		Ellipse,
+		Image,
+		Video,
+		String,
+		Transform
+	};
+
+	struct Call{
+		CallType type;
+
+		/// Primitive mode, number of vertices and indices and whether the
+		/// colors were used, only for Mesh calls.
+		ofPrimitiveMode primitiveMode;
+		size_t numVertices;
+		size_t numIndices;
+		bool usedColors;
+
+		/// Style when the call was made.
+		ofStyle style;
+	};
+
+	ofRecordingRenderer();
+
+	static const string TYPE;
+	const string & getType(){ return TYPE; }
+
+	/// \returns every call recorded, in the order they were made.
+	const vector<Call> & getCalls() const;
+
+	/// \returns the number of calls recorded of a type.
+	size_t getNumCalls(CallType type) const;
+
+	/// \returns the number of draw calls recorded, every type but Transform.
+	size_t getNumDrawCalls() const;
+
+	/// \brief Forgets the calls recorded so far.
+	void clearCalls();
+
+	/// \brief If true, the default, the calls are cleared in startRender().
+	void setClearOnStartRender(bool clear);
+
+	void startRender();
+	void finishRender();
+
+	using ofBaseRenderer::draw;
+	void draw(const ofPolyline & poly) const;
+	void draw(const ofPath & shape) const;
+	void draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const;
+	void draw(const of3dPrimitive & model, ofPolyRenderMode renderType) const;
+	void draw(const ofNode & node) const;
+	void draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const;
+
+	void pushView();
+	void popView();
+	void viewport(ofRectangle viewport);
+	void viewport(float x = 0, float y = 0, float width = -1, float height = -1, bool vflip=true);
+	void setupScreenPerspective(float width = -1, float height = -1, float fov = 60, float nearDist = 0, float farDist = 0);
+	void setupScreenOrtho(float width = -1, float height = -1, float nearDist = -1, float farDist = 1);
+	void setOrientation(ofOrientation orientation, bool vFlip);
+	ofRectangle getCurrentViewport() const;
+	ofRectangle getNativeViewport() const;
+	int getViewportWidth() const;
+	int getViewportHeight() const;
+	bool isVFlipped() const;
+
+	void setCoordHandedness(ofHandednessType handedness);
+	ofHandednessType getCoordHandedness() const;
+
+	void pushMatrix();
+	void popMatrix();
+	ofMatrix4x4 getCurrentMatrix(ofMatrixMode matrixMode_) const;
+	ofMatrix4x4 getCurrentOrientationMatrix() const;
+	void translate(float x, float y, float z = 0);
+	void translate(const ofPoint & p);
+	void scale(float xAmnt, float yAmnt, float zAmnt = 1);
+	void rotate(float degrees, float vecX, float vecY, float vecZ);
+	void rotateX(float degrees);
+	void rotateY(float degrees);
+	void rotateZ(float degrees);
+	void rotate(float degrees);
+	void matrixMode(ofMatrixMode mode);
+	void loadIdentityMatrix (void);
+	void loadMatrix (const ofMatrix4x4 & m);
+	void loadMatrix (const float *m);
+	void multMatrix (const ofMatrix4x4 & m);
+	void multMatrix (const float *m);
+	void loadViewMatrix(const ofMatrix4x4 & m);
+	void multViewMatrix(const ofMatrix4x4 & m);
+	ofMatrix4x4 getCurrentViewMatrix() const;
+	ofMatrix4x4 getCurrentNormalMatrix() const;
+
+	void bind(const ofCamera & camera, const ofRectangle & viewport);
+	void unbind(const ofCamera & camera);
+
+	void setupGraphicDefaults();
+	void setupScreen();
+
+	void setRectMode(ofRectMode mode);
+	ofRectMode getRectMode();
+	void setFillMode(ofFillFlag fill);
+	ofFillFlag getFillMode();
+	void setLineWidth(float lineWidth);
+	void setDepthTest(bool depthTest);
+	void setBlendMode(ofBlendMode blendMode);
+	void setLineSmoothing(bool smooth);
+	void setCircleResolution(int res);
+	void enableAntiAliasing();
+	void disableAntiAliasing();
+
+	void setColor(int r, int g, int b);
+	void setColor(int r, int g, int b, int a);
+	void setColor(const ofColor & color);
+	void setColor(const ofColor & color, int _a);
+	void setColor(int gray);
+	void setHexColor( int hexColor );
+
+	void setBitmapTextMode(ofDrawBitmapMode mode);
+
+	ofColor getBackgroundColor();
+	void setBackgroundColor(const ofColor & c);
+	void background(const ofColor & c);
+	void background(float brightness);
+	void background(int hexColor, float _a=255.0f);
+	void background(int r, int g, int b, int a=255);
+
+	void setBackgroundAuto(bool bManual);
+	bool getBackgroundAuto();
+
+	void clear();
+	void clear(float r, float g, float b, float a=0);
+	void clear(float brightness, float a=0);
+	void clearAlpha();
+
+	void drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const;
+	void drawRectangle(float x, float y, float z, float w, float h) const;
+	void drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const;
+	void drawCircle(float x, float y, float z, float radius) const;
+	void drawEllipse(float x, float y, float z, float width, float height) const;
+	void drawString(string text, float x, float y, float z) const;
+	void drawString(const ofTrueTypeFont & font, string text, float x, float y) const;
+
+	ofPath & getPath();
+
+	ofStyle getStyle() const;
+	void setStyle(const ofStyle & style);
+	void pushStyle();
+	void popStyle();
+
+	void setCurveResolution(int resolution);
+	void setPolyMode(ofPolyWindingMode mode);
+
+	const of3dGraphics & get3dGraphics() const;
+	of3dGraphics & get3dGraphics();
+
+private:
+	void record(CallType type) const;
+
+	mutable vector<Call> calls;
+	bool clearOnStartRender;
+	ofStyle currentStyle;
+	deque<ofStyle> styleHistory;
+	bool backgroundAuto;
+	ofHandednessType handedness;
+	ofRectangle currentViewport;
+	of3dGraphics graphics3d;
+	ofPath path;
+};
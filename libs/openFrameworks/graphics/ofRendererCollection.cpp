@@ -6,5 +6,165 @@
  */
 
 #include "ofRendererCollection.h"
+#include <limits>
+
 const string ofRendererCollection::TYPE="collection";
 
+// the indices of the batch have to fit in ofIndexType, which is 16bit in some platforms
+static const size_t maxBatchVertices = std::numeric_limits<ofIndexType>::max();
+
+//----------------------------------------------------------
+void ofRendererCollection::setBatching(bool _batching){
+	if(!_batching){
+		flush();
+	}
+	batching = _batching;
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::isBatching() const{
+	return batching;
+}
+
+//----------------------------------------------------------
+void ofRendererCollection::flush() const{
+	if(batch.getNumVertices()==0){
+		return;
+	}
+	for(int i=0;i<(int)renderers.size();i++){
+		renderers[i]->draw(batch,OF_MESH_FILL,true,false,false);
+		// the fixed pipeline leaves the current color undefined after drawing with a color array
+		renderers[i]->setColor(renderers[i]->getStyle().color);
+	}
+	batch.clear();
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::beginBatch(const ofStyle & style, ofPrimitiveMode mode, size_t numVertices) const{
+	// the renderers enable smoothing around each line they draw
+	if((mode==OF_PRIMITIVE_LINES && style.smoothing) || numVertices>maxBatchVertices){
+		return false;
+	}
+	if(batch.getNumVertices() && (batch.getMode()!=mode || batch.getNumVertices()+numVertices>maxBatchVertices)){
+		flush();
+	}
+	batch.setMode(mode);
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::batchLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
+	ofStyle style = getStyle();
+	if(!beginBatch(style,OF_PRIMITIVE_LINES,2)){
+		return false;
+	}
+	ofIndexType first = batch.getNumVertices();
+	ofFloatColor color = style.color;
+	batch.addVertex(ofVec3f(x1,y1,z1));
+	batch.addVertex(ofVec3f(x2,y2,z2));
+	batch.addColor(color);
+	batch.addColor(color);
+	batch.addIndex(first);
+	batch.addIndex(first+1);
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::batchRectangle(float x, float y, float z, float w, float h) const{
+	ofStyle style = getStyle();
+	if(!beginBatch(style,style.bFill ? OF_PRIMITIVE_TRIANGLES : OF_PRIMITIVE_LINES,4)){
+		return false;
+	}
+	if(style.rectMode == OF_RECTMODE_CENTER){
+		x -= w/2.0f;
+		y -= h/2.0f;
+	}
+	ofIndexType first = batch.getNumVertices();
+	ofFloatColor color = style.color;
+	batch.addVertex(ofVec3f(x,y,z));
+	batch.addVertex(ofVec3f(x+w,y,z));
+	batch.addVertex(ofVec3f(x+w,y+h,z));
+	batch.addVertex(ofVec3f(x,y+h,z));
+	for(int i=0;i<4;i++){
+		batch.addColor(color);
+	}
+	if(style.bFill){
+		batch.addTriangle(first,first+1,first+2);
+		batch.addTriangle(first,first+2,first+3);
+	}else{
+		for(int i=0;i<4;i++){
+			batch.addIndex(first+i);
+			batch.addIndex(first+(i+1)%4);
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::batchTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const{
+	ofStyle style = getStyle();
+	if(!beginBatch(style,style.bFill ? OF_PRIMITIVE_TRIANGLES : OF_PRIMITIVE_LINES,3)){
+		return false;
+	}
+	ofIndexType first = batch.getNumVertices();
+	ofFloatColor color = style.color;
+	batch.addVertex(ofVec3f(x1,y1,z1));
+	batch.addVertex(ofVec3f(x2,y2,z2));
+	batch.addVertex(ofVec3f(x3,y3,z3));
+	for(int i=0;i<3;i++){
+		batch.addColor(color);
+	}
+	if(style.bFill){
+		batch.addTriangle(first,first+1,first+2);
+	}else{
+		for(int i=0;i<3;i++){
+			batch.addIndex(first+i);
+			batch.addIndex(first+(i+1)%3);
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofRendererCollection::batchEllipse(float x, float y, float z, float radiusX, float radiusY) const{
+	ofStyle style = getStyle();
+	// same points as the circles the GL renderers draw
+	if((int)batchCircle.size()!=style.circleResolution+1){
+		batchCircle.clear();
+		batchCircle.arc(0,0,0,1,1,0,360,style.circleResolution);
+	}
+	const vector<ofPoint> & circle = batchCircle.getVertices();
+	if(circle.size()<3 || !beginBatch(style,style.bFill ? OF_PRIMITIVE_TRIANGLES : OF_PRIMITIVE_LINES,circle.size())){
+		return false;
+	}
+	// written directly instead of with addVertex()... since there can be thousands per frame
+	vector<ofVec3f> & vertices = batch.getVertices();
+	vector<ofIndexType> & indices = batch.getIndices();
+	size_t first = vertices.size();
+	size_t numPoints = circle.size();
+	vertices.resize(first+numPoints);
+	batch.getColors().resize(first+numPoints,style.color);
+	for(size_t i=0;i<numPoints;i++){
+		vertices[first+i].set(radiusX*circle[i].x+x,radiusY*circle[i].y+y,z);
+	}
+	if(style.bFill){
+		// a triangle fan around the first point
+		size_t firstIndex = indices.size();
+		indices.resize(firstIndex+(numPoints-2)*3);
+		ofIndexType * index = &indices[firstIndex];
+		for(size_t i=1;i<numPoints-1;i++){
+			*index++ = first;
+			*index++ = first+i;
+			*index++ = first+i+1;
+		}
+	}else{
+		size_t firstIndex = indices.size();
+		indices.resize(firstIndex+(numPoints-1)*2);
+		ofIndexType * index = &indices[firstIndex];
+		for(size_t i=0;i<numPoints-1;i++){
+			*index++ = first+i;
+			*index++ = first+i+1;
+		}
+	}
+	return true;
+}
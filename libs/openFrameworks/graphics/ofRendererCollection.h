@@ -6,15 +6,31 @@
 #include "of3dGraphics.h"
 #include "ofPath.h"
 
+/// \class ofRendererCollection
+/// \brief Forwards every call to a list of renderers.
+///
+/// Used to draw to several renderers at the same time, eg. to the screen and
+/// to a pdf in ofBeginSaveScreenAsPDF().
+///
+/// It can also batch ofDrawLine(), ofDrawRectangle(), ofDrawTriangle(),
+/// ofDrawCircle() and ofDrawEllipse(): with setBatching(true) consecutive
+/// primitives drawn with the same fill mode are added to one mesh, with the
+/// color of each primitive as vertex colors, and the renderers receive that
+/// mesh as a single draw call. Any other call to the collection, a change of
+/// matrix, line width, blend mode, a texture or shader bind... draws the
+/// pending primitives first, so the result is the same as without batching.
+/// ofEnableBatching() sets up a batching collection around the current
+/// renderer.
 class ofRendererCollection: public ofBaseRenderer{
 public:
-	ofRendererCollection():graphics3d(this){}
+	ofRendererCollection():graphics3d(this),batching(false){}
 	 ~ofRendererCollection(){}
 
 	 static const string TYPE;
 	 const string & getType(){ return TYPE; }
 
 	 shared_ptr<ofBaseGLRenderer> getGLRenderer(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 if(renderers[i]->getType()=="GL" || renderers[i]->getType()=="ProgrammableGL"){
 				 return (shared_ptr<ofBaseGLRenderer>&)renderers[i];
@@ -29,6 +45,18 @@ public:
 
 	 bool rendersPathPrimitives(){return true;}
 
+	/// \brief Enables or disables batching of primitives, disabled by default.
+	///
+	/// Disabling it draws the primitives batched so far.
+	void setBatching(bool batching);
+	bool isBatching() const;
+
+	/// \brief Draws the primitives batched so far, if any.
+	///
+	/// Needed before drawing directly with GL calls while batching,
+	/// everything drawn through the renderers already flushes.
+	void flush() const;
+
 	 void startRender(){
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->startRender();
@@ -36,6 +64,7 @@ public:
 	 }
 
 	 void finishRender(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->finishRender();
 		 }
@@ -45,53 +74,62 @@ public:
 	 using ofBaseRenderer::draw;
 
 	 void draw(const ofPolyline & poly) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->draw(poly);
 		 }
 	 }
 	 void draw(const ofPath & shape) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->draw(shape);
 		 }
 	 }
 
 	 void draw(const ofMesh & vertexData, ofPolyRenderMode mode, bool useColors, bool useTextures, bool useNormals) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->draw(vertexData,mode,useColors,useTextures,useNormals);
 		 }
 	 }
 
     void draw(const  of3dPrimitive& model, ofPolyRenderMode renderType ) const {
+        flush();
         for(int i=0;i<(int)renderers.size();i++) {
             renderers[i]->draw( model, renderType );
         }
     }
 
     void draw(const  ofNode& node) const {
+        flush();
         for(int i=0;i<(int)renderers.size();i++) {
             renderers[i]->draw( node );
         }
     }
 
 	void draw(const ofImage & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->draw(img,x,y,z,w,h,sx,sy,sw,sh);
 		 }
 	}
 
 	void draw(const ofFloatImage & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->draw(img,x,y,z,w,h,sx,sy,sw,sh);
 		}
 	}
 
 	void draw(const ofShortImage & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->draw(img,x,y,z,w,h,sx,sy,sw,sh);
 		}
 	}
 
 	void draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const{
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->draw(video,x,y,w,h);
 		}
@@ -145,11 +183,13 @@ public:
 	//--------------------------------------------
 	// transformations
 	 void pushView(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->pushView();
 		 }
 	 }
 	 void popView(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->popView();
 		 }
@@ -159,21 +199,25 @@ public:
 	// if width or height are 0, assume windows dimensions (ofGetWidth(), ofGetHeight())
 	// if nearDist or farDist are 0 assume defaults (calculated based on width / height)
 	void viewport(ofRectangle viewport){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->viewport(viewport);
 		 }
 	}
 	 void viewport(float x = 0, float y = 0, float width = -1, float height = -1, bool vflip=true){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->viewport(x,y,width,height);
 		 }
 	 }
 	 void setupScreenPerspective(float width = -1, float height = -1, float fov = 60, float nearDist = 0, float farDist = 0){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setupScreenPerspective(width,height,fov,nearDist,farDist);
 		 }
 	 }
 	 void setupScreenOrtho(float width = -1, float height = -1, float nearDist = -1, float farDist = 1){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setupScreenOrtho(width,height,nearDist,farDist);
 		 }
@@ -210,6 +254,7 @@ public:
 	 }
 
 	 void setCoordHandedness(ofHandednessType handedness){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setCoordHandedness(handedness);
 		 }
@@ -224,87 +269,103 @@ public:
 
 	//our openGL wrappers
 	 void pushMatrix(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->pushMatrix();
 		 }
 	 }
 	 void popMatrix(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->popMatrix();
 		 }
 	 }
 	 void translate(float x, float y, float z = 0){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->translate(x,y,z);
 		 }
 	 }
 	 void translate(const ofPoint & p){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->translate(p);
 		 }
 	 }
 	 void scale(float xAmnt, float yAmnt, float zAmnt = 1){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->scale(xAmnt,yAmnt,zAmnt);
 		 }
 	 }
 	 void rotate(float degrees, float vecX, float vecY, float vecZ){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->rotate(degrees,vecX,vecY,vecZ);
 		 }
 	 }
 	 void rotateX(float degrees){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->rotateX(degrees);
 		 }
 	 }
 	 void rotateY(float degrees){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->rotateY(degrees);
 		 }
 	 }
 	 void rotateZ(float degrees){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->rotateZ(degrees);
 		 }
 	 }
 	 void rotate(float degrees){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->rotate(degrees);
 		 }
 	 }
 
 	void loadIdentityMatrix (void){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->loadIdentityMatrix();
 		}
 	}
 
 	void loadMatrix (const ofMatrix4x4 & m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->loadMatrix( m );
 		}
 	}
 
 	void loadMatrix (const float * m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->loadMatrix( m );
 		}
 	}
 
 	void multMatrix (const ofMatrix4x4 & m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->multMatrix( m );
 		}
 	}
 
 	void multMatrix (const float * m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->multMatrix( m );
 		}
 	}
 
 	void setOrientation(ofOrientation orientation, bool vflip){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->setOrientation( orientation, vflip );
 		}
@@ -320,18 +381,21 @@ public:
 	}
 
 	void matrixMode(ofMatrixMode mode){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->matrixMode( mode );
 		}
 	}
 
 	void loadViewMatrix(const ofMatrix4x4& m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->loadViewMatrix( m );
 		}
 	}
 
 	void multViewMatrix(const ofMatrix4x4& m){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->multViewMatrix( m );
 		}
@@ -349,6 +413,7 @@ public:
 
 	// screen coordinate things / default gl values
 	 void setupGraphicDefaults(){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->setupGraphicDefaults();
 		}
@@ -356,6 +421,7 @@ public:
 		path.setUseShapeColor(false);
 	 }
 	 void setupScreen(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setupScreen();
 		 }
@@ -408,6 +474,7 @@ public:
 	}
 
 	void setBackgroundColor(const ofColor & color){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setBackgroundColor(color);
 		 }
@@ -422,54 +489,63 @@ public:
 	}
 
 	void background(const ofColor & c){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->background(c);
 		 }
 	}
 
 	void background(float brightness){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->background(brightness);
 		 }
 	}
 
 	void background(int hexColor, float _a=255.0f){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->background(hexColor,_a);
 		 }
 	}
 
 	void background(int r, int g, int b, int a=255){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->background(r,g,b,a);
 		 }
 	}
 
 	void setBackgroundAuto(bool bManual){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setBackgroundAuto(bManual);
 		 }
 	}
 
 	void clear(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->clear();
 		 }
 	}
 
 	void clear(float r, float g, float b, float a=0){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->clear(r,g,b,a);
 		 }
 	}
 
 	void clear(float brightness, float a=0){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->clear(brightness,a);
 		 }
 	}
 
 	void clearAlpha(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->clearAlpha();
 		 }
@@ -512,6 +588,7 @@ public:
 	}
 
 	void setLineWidth(float lineWidth){
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->setLineWidth(lineWidth);
 		}
@@ -521,17 +598,20 @@ public:
 	}
 
 	void setDepthTest(bool depthTest) {
+		flush();
 		for(int i=0;i<(int)renderers.size();i++){
 			renderers[i]->setDepthTest(depthTest);
 		}
 	}
 
 	void setBlendMode(ofBlendMode blendMode){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setBlendMode(blendMode);
 		 }
 	}
 	void setLineSmoothing(bool smooth){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setLineSmoothing(smooth);
 		 }
@@ -542,6 +622,7 @@ public:
 		 }
 	}
 	void enablePointSprites(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 if(renderers[i]->getType()=="GL" || renderers[i]->getType()=="ProgrammableGL"){
 				 ((shared_ptr<ofBaseGLRenderer>&)renderers[i])->enablePointSprites();
@@ -549,6 +630,7 @@ public:
 		 }
 	}
 	void disablePointSprites(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 if(renderers[i]->getType()=="GL" || renderers[i]->getType()=="ProgrammableGL"){
 				 ((shared_ptr<ofBaseGLRenderer>&)renderers[i])->disablePointSprites();
@@ -557,12 +639,14 @@ public:
 	}
 
 	void enableAntiAliasing(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->enableAntiAliasing();
 		 }
 	}
 
 	void disableAntiAliasing(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->disableAntiAliasing();
 		 }
@@ -589,12 +673,14 @@ public:
 	}
 
 	void popStyle(){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->popStyle();
 		 }
 	}
 
 	void setStyle(const ofStyle & style){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->setStyle(style);
 		 }
@@ -616,53 +702,77 @@ public:
 
 	// drawing
 	void drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
+		if(batching && batchLine(x1,y1,z1,x2,y2,z2)){
+			return;
+		}
+		flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawLine(x1,y1,z1,x2,y2,z2);
 		 }
 	}
 
 	void drawRectangle(float x, float y, float z, float w, float h) const{
+		if(batching && batchRectangle(x,y,z,w,h)){
+			return;
+		}
+		flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawRectangle(x,y,z,w,h);
 		 }
 	}
 
 	void drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const{
+		if(batching && batchTriangle(x1,y1,z1,x2,y2,z2,x3,y3,z3)){
+			return;
+		}
+		flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawTriangle(x1,y1,z1,x2,y2,z2,x3,y3,z3);
 		 }
 	}
 
 	void drawCircle(float x, float y, float z, float radius) const{
+		if(batching && batchEllipse(x,y,z,radius,radius)){
+			return;
+		}
+		flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawCircle(x,y,z,radius);
 		 }
 	}
 
 	void drawEllipse(float x, float y, float z, float width, float height) const{
+		if(batching && batchEllipse(x,y,z,width*0.5f,height*0.5f)){
+			return;
+		}
+		flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawEllipse(x,y,z,width,height);
 		 }
 	}
 
 	void drawString(string text, float x, float y, float z) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawString(text, x,y,z);
 		 }
 	}
 
 	void drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->drawString(font, text, x,y);
 		 }
 	}
 
 	virtual void bind(const ofCamera & camera, const ofRectangle & viewport){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->bind(camera, viewport);
 		 }
 	}
 	virtual void unbind(const ofCamera & camera){
+		 flush();
 		 for(int i=0;i<(int)renderers.size();i++){
 			 renderers[i]->unbind(camera);
 		 }
@@ -683,4 +793,15 @@ public:
 	vector<shared_ptr<ofBaseRenderer> > renderers;
 	of3dGraphics graphics3d;
 	ofPath path;
+
+private:
+	bool beginBatch(const ofStyle & style, ofPrimitiveMode mode, size_t numVertices) const;
+	bool batchLine(float x1, float y1, float z1, float x2, float y2, float z2) const;
+	bool batchRectangle(float x, float y, float z, float w, float h) const;
+	bool batchTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const;
+	bool batchEllipse(float x, float y, float z, float radiusX, float radiusY) const;
+
+	bool batching;
+	mutable ofMesh batch;
+	mutable ofPolyline batchCircle;
 };
@@ -1,4 +1,5 @@
 #include "ofTessellator.h"
+#include "ofUtils.h"
 
 
 
@@ -38,16 +39,180 @@
 // ------------------------------------
 
 
-void * memAllocator( void *userData, unsigned int size ){
-	return malloc(size);
+//----------------------------------------------------------
+// bump allocator for libtess2: every allocation done during a tessellation
+// goes into a block that is reused by the next one instead of being freed.
+// when a tessellation doesn't fit the arena grows to a single block sized
+// from what it used so the next one does, and if the arena stays mostly
+// unused for a while it shrinks to the biggest recent tessellation.
+//
+// libtess2 keeps some of its pools in the tessellator object between calls
+// so the tessellator itself is allocated from the arena too and created
+// again after every reset
+class ofTessellatorArena{
+public:
+	ofTessellatorArena()
+	:current(0)
+	,offset(0)
+	,used(0)
+	,recentPeak(0)
+	,recentCalls(0)
+	,enabled(true){}
+
+	~ofTessellatorArena(){
+		releaseBlocks();
+	}
+
+	void * alloc(size_t size){
+		stats.allocations++;
+		if(!enabled){
+			stats.heapAllocations++;
+			return ::malloc(size);
+		}
+		size_t total = headerSize + align(size);
+		used += total;
+		while(current<blocks.size() && offset+total>blocks[current].size){
+			current++;
+			offset = 0;
+		}
+		if(current==blocks.size() && !addBlock(max(total, (size_t)blockSize))){
+			return NULL;
+		}
+		char * ptr = blocks[current].data + offset;
+		offset += total;
+		*(size_t*)ptr = size;
+		return ptr + headerSize;
+	}
+
+	void * realloc(void * ptr, size_t size){
+		if(ptr==NULL){
+			return alloc(size);
+		}
+		if(!enabled){
+			stats.allocations++;
+			stats.heapAllocations++;
+			return ::realloc(ptr,size);
+		}
+		size_t prevSize = *(size_t*)((char*)ptr - headerSize);
+		if(size<=prevSize){
+			return ptr;
+		}
+		void * newPtr = alloc(size);
+		if(newPtr){
+			memcpy(newPtr,ptr,prevSize);
+		}
+		return newPtr;
+	}
+
+	void free(void * ptr){
+		// the memory in the arena is only reused after a reset
+		if(!enabled){
+			::free(ptr);
+		}
+	}
+
+	// called before each tessellation, nothing allocated before is used
+	// anymore so the memory can be reused or resized
+	void reset(){
+		stats.peakBytes = max(stats.peakBytes, used);
+		recentPeak = max(recentPeak, used);
+		recentCalls++;
+		if(blocks.size()>1){
+			resize(recentPeak);
+		}else if(recentCalls>=shrinkPeriod){
+			if(stats.arenaBytes>blockSize && stats.arenaBytes>capacityFor(recentPeak)*4){
+				resize(recentPeak);
+			}
+			recentPeak = 0;
+			recentCalls = 0;
+		}
+		current = 0;
+		offset = 0;
+		used = 0;
+	}
+
+	// pointers allocated with one mode can't be freed with the other,
+	// nothing allocated before can be in use when calling this
+	void setEnabled(bool enabled){
+		this->enabled = enabled;
+		releaseBlocks();
+		recentPeak = 0;
+		recentCalls = 0;
+		current = 0;
+		offset = 0;
+		used = 0;
+	}
+
+	bool isEnabled() const{
+		return enabled;
+	}
+
+	ofTessellatorStats stats;
+
+private:
+	static const size_t headerSize = 16;
+	static const size_t blockSize = 64*1024;
+	static const int shrinkPeriod = 64;
+
+	static size_t align(size_t size){
+		return (size + 15) & ~(size_t)15;
+	}
+
+	// leaves some room for the next tessellation to be a bit bigger
+	static size_t capacityFor(size_t bytes){
+		bytes += bytes/4;
+		return max((size_t)blockSize, (bytes + blockSize - 1) / blockSize * blockSize);
+	}
+
+	bool addBlock(size_t size){
+		Block block;
+		block.size = size;
+		block.data = (char*)::malloc(block.size);
+		if(!block.data){
+			return false;
+		}
+		blocks.push_back(block);
+		stats.heapAllocations++;
+		stats.arenaBytes += block.size;
+		return true;
+	}
+
+	void resize(size_t bytes){
+		releaseBlocks();
+		addBlock(capacityFor(bytes));
+	}
+
+	void releaseBlocks(){
+		for(size_t i=0;i<blocks.size();i++){
+			::free(blocks[i].data);
+		}
+		blocks.clear();
+		stats.arenaBytes = 0;
+	}
+
+	struct Block{
+		char * data;
+		size_t size;
+	};
+	vector<Block> blocks;
+	size_t current;
+	size_t offset;
+	size_t used;
+	size_t recentPeak;
+	int recentCalls;
+	bool enabled;
+};
+
+static void * memAllocator( void *userData, unsigned int size ){
+	return ((ofTessellatorArena*)userData)->alloc(size);
 }
 
-void * memReallocator( void *userData, void* ptr, unsigned int size ){
-	return realloc(ptr,size);
+static void * memReallocator( void *userData, void* ptr, unsigned int size ){
+	return ((ofTessellatorArena*)userData)->realloc(ptr,size);
 }
 
-void memFree( void *userData, void *ptr ){
-	free (ptr);
+static void memFree( void *userData, void *ptr ){
+	((ofTessellatorArena*)userData)->free(ptr);
 }
 
 //----------------------------------------------------------
@@ -57,36 +222,99 @@ ofTessellator::ofTessellator(){
 
 //----------------------------------------------------------
 ofTessellator::~ofTessellator(){
-	tessDeleteTess(cacheTess);
+	deleteTess();
+	delete arena;
 }
 
 //----------------------------------------------------------
 ofTessellator::ofTessellator(const ofTessellator & mom){
-	if(&mom != this) init();
+	init();
+	setArenaEnabled(mom.isArenaEnabled());
 }
 
 //----------------------------------------------------------
 ofTessellator & ofTessellator::operator=(const ofTessellator & mom){
-	if(&mom != this) init();
+	// the tessellator doesn't keep any state between calls, only the settings
+	setArenaEnabled(mom.isArenaEnabled());
 	return *this;
 }
 
 //----------------------------------------------------------
 void ofTessellator::init(){
+	arena = new ofTessellatorArena;
 	tessAllocator.memalloc = memAllocator;
 	tessAllocator.memrealloc = memReallocator;
 	tessAllocator.memfree = memFree;
+	tessAllocator.userData = arena;
 	tessAllocator.meshEdgeBucketSize=0;
 	tessAllocator.meshVertexBucketSize=0;
 	tessAllocator.meshFaceBucketSize=0;
 	tessAllocator.dictNodeBucketSize=0;
 	tessAllocator.regionBucketSize=0;
 	tessAllocator.extraVertices=0;
+	// with the arena enabled the tessellator is created for every call
+	cacheTess = NULL;
+}
+
+//----------------------------------------------------------
+void ofTessellator::createTess(){
 	cacheTess = tessNewTess( &tessAllocator );
 }
 
+//----------------------------------------------------------
+void ofTessellator::deleteTess(){
+	// the memory of a tessellator in the arena is released with the arena
+	if(cacheTess && !arena->isEnabled()){
+		tessDeleteTess(cacheTess);
+	}
+	cacheTess = NULL;
+}
+
+//----------------------------------------------------------
+void ofTessellator::beginTessellation(){
+	if(arena->isEnabled()){
+		// the results of the previous call have been copied out by now
+		arena->reset();
+		createTess();
+	}else if(!cacheTess){
+		createTess();
+	}
+	startTime = ofGetElapsedTimeMicros();
+}
+
+//----------------------------------------------------------
+void ofTessellator::endTessellation(){
+	arena->stats.tessellations++;
+	arena->stats.timeMicros += ofGetElapsedTimeMicros() - startTime;
+}
+
+//----------------------------------------------------------
+void ofTessellator::setArenaEnabled(bool enabled){
+	if(enabled==arena->isEnabled()) return;
+	deleteTess();
+	arena->setEnabled(enabled);
+}
+
+//----------------------------------------------------------
+bool ofTessellator::isArenaEnabled() const{
+	return arena->isEnabled();
+}
+
+//----------------------------------------------------------
+const ofTessellatorStats & ofTessellator::getStats() const{
+	return arena->stats;
+}
+
+//----------------------------------------------------------
+void ofTessellator::resetStats(){
+	size_t arenaBytes = arena->stats.arenaBytes;
+	arena->stats = ofTessellatorStats();
+	arena->stats.arenaBytes = arenaBytes;
+}
+
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D){
+	beginTessellation();
 
 	ofPolyline& polyline = const_cast<ofPolyline&>(src);
 	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
@@ -97,7 +325,7 @@ void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode
 	
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, ofMesh & dstmesh, bool bIs2D ) {
-
+	beginTessellation();
 
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
@@ -111,6 +339,7 @@ void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindi
 
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D){
+	beginTessellation();
 
 	ofPolyline& polyline = const_cast<ofPolyline&>(src);
 	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
@@ -121,7 +350,7 @@ void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWinding
 
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
-
+	beginTessellation();
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
 		ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
@@ -138,6 +367,10 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 
 	if (!tessTesselate(cacheTess, polyWindingMode, TESS_POLYGONS, 3, 3, 0)){
 		ofLogError("ofTessellator") << "performTessellation(): mesh polygon tessellation failed, winding mode " << polyWindingMode;
+		// a failed tessellation keeps its contours in memory that will be
+		// reused by the next one, start again with a new tessellator
+		deleteTess();
+		endTessellation();
 		return;
 	}
 
@@ -153,7 +386,7 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 			dstmesh.addIndex(tessElements[i]);
 	}*/
 	dstmesh.setMode(OF_PRIMITIVE_TRIANGLES);
-
+	endTessellation();
 }
 
 
@@ -161,6 +394,8 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
 	if (!tessTesselate(cacheTess, polyWindingMode, TESS_BOUNDARY_CONTOURS, 0, 3, 0)){
 		ofLogError("ofTessellator") << "performTesselation(): polyline boundary contours tessellation failed, winding mode " << polyWindingMode;
+		deleteTess();
+		endTessellation();
 		return;
 	}
 
@@ -176,4 +411,5 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vecto
 			dstpoly[i].addVertices(&verts[b],n);
 			dstpoly[i].setClosed(true);
 	}
+	endTessellation();
 }
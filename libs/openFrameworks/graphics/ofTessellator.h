@@ -6,6 +6,26 @@
 #include "ofPolyline.h"
 #include "tesselator.h"
 
+class ofTessellatorArena;
+
+/// \brief Memory and time used by an ofTessellator, see ofTessellator::getStats().
+struct ofTessellatorStats{
+	ofTessellatorStats()
+	:tessellations(0)
+	,allocations(0)
+	,heapAllocations(0)
+	,timeMicros(0)
+	,peakBytes(0)
+	,arenaBytes(0){}
+
+	unsigned long long tessellations; ///< calls to any of the tessellateTo* methods
+	unsigned long long allocations; ///< memory requests done by libtess2
+	unsigned long long heapAllocations; ///< requests that needed new memory from the heap
+	unsigned long long timeMicros; ///< time spent tessellating
+	size_t peakBytes; ///< most memory used by a single tessellation
+	size_t arenaBytes; ///< memory currently kept by the arena between tessellations
+};
+
 /// \brief
 /// ofTessellator exists for one purpose: to turn ofPolylines into ofMeshes so
 /// that they can be more efficiently displayed using OpenGL. The ofPath class
@@ -21,6 +41,13 @@
 /// shown on the right.
 /// 
 /// ![tessellation](graphics/tessellation.jpg)
+///
+/// The memory libtess2 needs while tessellating comes from an arena owned by
+/// the tessellator that is reused by every call, instead of thousands of small
+/// heap allocations. The arena grows to fit the biggest tessellation and
+/// shrinks again if it stays mostly unused for a while. An ofTessellator
+/// can't be used from several threads at the same time, ofPath keeps a
+/// tessellator for each thread that is tessellating.
 class ofTessellator
 {
 public:	
@@ -48,14 +75,36 @@ public:
 	/// \brief Tessellate multiple polylines into a single polyline.
 	void tessellateToPolylines( const ofPolyline & src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D=false );
 
+	/// \brief Enables or disables the arena, enabled by default.
+	///
+	/// When disabled every allocation done while tessellating goes to the heap
+	/// as with the default libtess2 allocator, eg. to compare both.
+	void setArenaEnabled(bool enabled);
+
+	/// \returns true if the tessellations are allocated from the arena.
+	bool isArenaEnabled() const;
+
+	/// \brief Get the number of allocations, memory and time used by this
+	/// tessellator since it was created or since the last call to resetStats().
+	const ofTessellatorStats & getStats() const;
+
+	/// \brief Sets all the statistics back to 0 except for the arena size.
+	void resetStats();
+
 private:
 	
 	void performTessellation( ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D );
 	void performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D );
 	void init();
+	void createTess();
+	void deleteTess();
+	void beginTessellation();
+	void endTessellation();
 
 	TESStesselator * cacheTess;
 	TESSalloc tessAllocator;
+	ofTessellatorArena * arena;
+	unsigned long long startTime;
 };
 
 
@@ -18,6 +18,7 @@
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
 #include "Poco/TextConverter.h"
+#include "Poco/TextIterator.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
 #include "Poco/Latin9Encoding.h"
@@ -26,6 +27,7 @@ static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
 static FT_Library library;
+static const int dynamicAtlasMaxSize = 4096;
 
 //--------------------------------------------------------
 void ofTrueTypeFont::setGlobalDpi(int newDpi){
@@ -33,8 +35,8 @@ void ofTrueTypeFont::setGlobalDpi(int newDpi){
 }
 
 //--------------------------------------------------------
-static ofTTFCharacter makeContoursForCharacter(FT_Face &face);
-static ofTTFCharacter makeContoursForCharacter(FT_Face &face){
+static ofTTFCharacter makeContoursForCharacter(FT_Face face);
+static ofTTFCharacter makeContoursForCharacter(FT_Face face){
 
 		//int num			= face->glyph->outline.n_points;
 		int nContours	= face->glyph->outline.n_contours;
@@ -351,6 +353,10 @@ ofTrueTypeFont::ofTrueTypeFont(){
 	ascenderHeight = 0;
 	bAntiAliased = 0;
 	bFullCharacterSet = 0;
+	bDynamic = false;
+	bAtlasDirty = false;
+	stringMeshCacheSize = 128;
+	resetStringMeshCacheStats();
 	descenderHeight = 0;
 	dpi = 96;
 	encoding = OF_ENCODING_UTF8;
@@ -360,6 +366,78 @@ ofTrueTypeFont::ofTrueTypeFont(){
 	simplifyAmt = 0;
 }
 
+//------------------------------------------------------------------
+ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont & mom){
+	face = NULL;
+	*this = mom;
+}
+
+//------------------------------------------------------------------
+ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont & mom){
+	if(this == &mom){
+		return *this;
+	}
+
+	#if defined(TARGET_ANDROID)
+	if(mom.bLoadedOk){
+		ofAddListener(ofxAndroidEvents().unloadGL,this,&ofTrueTypeFont::unloadTextures);
+		ofAddListener(ofxAndroidEvents().reloadGL,this,&ofTrueTypeFont::reloadTextures);
+	}
+	#endif
+
+	bLoadedOk = mom.bLoadedOk;
+	bAntiAliased = mom.bAntiAliased;
+	bFullCharacterSet = mom.bFullCharacterSet;
+	bDynamic = mom.bDynamic;
+	nCharacters = mom.nCharacters;
+
+	charOutlines = mom.charOutlines;
+	charOutlinesNonVFlipped = mom.charOutlinesNonVFlipped;
+	charOutlinesContour = mom.charOutlinesContour;
+	charOutlinesNonVFlippedContour = mom.charOutlinesNonVFlippedContour;
+
+	lineHeight = mom.lineHeight;
+	ascenderHeight = mom.ascenderHeight;
+	descenderHeight = mom.descenderHeight;
+	glyphBBox = mom.glyphBBox;
+	letterSpacing = mom.letterSpacing;
+	spaceSize = mom.spaceSize;
+
+	cps = mom.cps;
+
+	fontSize = mom.fontSize;
+	bMakeContours = mom.bMakeContours;
+	simplifyAmt = mom.simplifyAmt;
+	dpi = mom.dpi;
+
+	glyphIndices = mom.glyphIndices;
+	atlasShelves = mom.atlasShelves;
+	atlasPixels = mom.atlasPixels;
+	bAtlasDirty = mom.bAtlasDirty;
+
+	filename = mom.filename;
+	texAtlas = mom.texAtlas;
+	stringQuads = mom.stringQuads;
+	encoding = mom.encoding;
+
+	// both fonts use the same face, FT_Done_Face in the
+	// destructor only releases it once nobody references it
+	if(face){
+		FT_Done_Face(face);
+	}
+	face = mom.face;
+	if(face){
+		FT_Reference_Face(face);
+	}
+
+	// the cache index points into mom's list so the
+	// cached strings are laid out again when needed
+	stringMeshCacheSize = mom.stringMeshCacheSize;
+	clearStringMeshCache();
+	resetStringMeshCacheStats();
+	return *this;
+}
+
 //------------------------------------------------------------------
 ofTrueTypeFont::~ofTrueTypeFont(){
 
@@ -376,7 +454,13 @@ void ofTrueTypeFont::unloadTextures(){
 }
 
 void ofTrueTypeFont::reloadTextures(){
-	if(bLoadedOk) load(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	if(!bLoadedOk) return;
+	if(bDynamic){
+		// the atlas is still in memory, it'll be uploaded on next use
+		bAtlasDirty = true;
+	}else{
+		load(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	}
 }
 
 static bool loadFontFace(string fontname, int _fontSize, FT_Face & face, string & filename){
@@ -436,7 +520,6 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	ofAddListener(ofxAndroidEvents().reloadGL,this,&ofTrueTypeFont::reloadTextures);
 	#endif
 	int border = 1;
-	initLibraries();
 
 	// if we've already been loaded, try to clean up :
 	unloadTextures();
@@ -450,34 +533,23 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	bLoadedOk 			= false;
 	bAntiAliased 		= _bAntiAliased;
 	bFullCharacterSet 	= _bFullCharacterSet;
+	bDynamic			= false;
 	fontSize			= _fontSize;
 	bMakeContours 		= _makeContours;
 	simplifyAmt			= _simplifyAmt;
 	dpi 				= _dpi;
 
-	//--------------- load the library and typeface
+	glyphIndices.clear();
+	atlasShelves.clear();
+	atlasPixels.clear();
+	bAtlasDirty = false;
+	clearStringMeshCache();
 
-
-	if(!loadFontFace(_filename,_fontSize,face,filename)){
-        return false;
+	//--------------- load the library and typeface
+	if(!initFace(_filename)){
+		return false;
 	}
 
-
-	FT_Set_Char_Size( face, fontSize << 6, fontSize << 6, dpi, dpi);
-	float fontUnitScale = ((float)fontSize * dpi) / (72 * face->units_per_EM);
-	lineHeight = face->height * fontUnitScale;
-	ascenderHeight = face->ascender * fontUnitScale;
-	descenderHeight = face->descender * fontUnitScale;
-	glyphBBox.set(face->bbox.xMin * fontUnitScale,
-				  face->bbox.yMin * fontUnitScale,
-				  (face->bbox.xMax - face->bbox.xMin) * fontUnitScale,
-				  (face->bbox.yMax - face->bbox.yMin) * fontUnitScale);
-
-	//------------------------------------------------------
-	//kerning would be great to support:
-	//ofLogNotice("ofTrueTypeFont") << "FT_HAS_KERNING ? " <<  FT_HAS_KERNING(face);
-	//------------------------------------------------------
-
 	nCharacters = (bFullCharacterSet ? 256 : 128) - NUM_CHARACTER_TO_START;
 
 	//--------------- initialize character info and textures
@@ -495,116 +567,14 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	vector<ofPixels> expanded_data(nCharacters);
 
 	long areaSum=0;
-	FT_Error err;
 
 
 	//--------------------- load each char -----------------------
 	for (int i = 0 ; i < nCharacters; i++){
-
-		//------------------------------------------ anti aliased or not:
 		int glyph = (unsigned char)(i+NUM_CHARACTER_TO_START);
 		if (glyph == 0xA4) glyph = 0x20AC; // hack to load the euro sign, all codes in 8859-15 match with utf-32 except for this one
-		err = FT_Load_Glyph( face, FT_Get_Char_Index( face, glyph ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
-        if(err){
-			ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for char " << i << ": FT_Error " << err;
-
-		}
-
-		if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-		else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
-
-		//------------------------------------------
-
-
-		if(bMakeContours){
-			if(printVectorInfo){
-				ofLogNotice("ofTrueTypeFont") <<  "character " << char(i+NUM_CHARACTER_TO_START);
-			}
-
-			//int character = i + NUM_CHARACTER_TO_START;
-			charOutlines[i] = makeContoursForCharacter( face );
-			charOutlinesContour[i] = charOutlines[i];
-			charOutlinesContour[i].setFilled(false);
-			charOutlinesContour[i].setStrokeWidth(1);
-
-			charOutlinesNonVFlipped[i] = charOutlines[i];
-			charOutlinesNonVFlipped[i].translate(ofVec3f(0,cps[i].height));
-			charOutlinesNonVFlipped[i].scale(1,-1);
-			charOutlinesNonVFlippedContour[i] = charOutlines[i];
-			charOutlinesNonVFlippedContour[i].setFilled(false);
-			charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
-
-
-			if(simplifyAmt>0){
-				charOutlines[i].simplify(simplifyAmt);
-				charOutlinesNonVFlipped[i].simplify(simplifyAmt);
-				charOutlinesContour[i].simplify(simplifyAmt);
-				charOutlinesNonVFlippedContour[i].simplify(simplifyAmt);
-			}
-		}
-
-
-		// -------------------------
-		// info about the character:
-		FT_Bitmap& bitmap= face->glyph->bitmap;
-		int width  = bitmap.width;
-		int height = bitmap.rows;
-
-		cps[i].characterIndex	= i;
-		cps[i].glyph			= glyph;
-		cps[i].height 			= face->glyph->metrics.height>>6;
-		cps[i].width 			= face->glyph->metrics.width>>6;
-		cps[i].bearingX			= face->glyph->metrics.horiBearingX>>6;
-		cps[i].bearingY			= face->glyph->metrics.horiBearingY>>6;
-		cps[i].xmin				= face->glyph->bitmap_left;
-		cps[i].xmax				= cps[i].xmin + cps[i].width;
-		cps[i].ymin				= -face->glyph->bitmap_top;
-		cps[i].ymax				= cps[i].ymin + cps[i].height;
-		cps[i].advance			= face->glyph->metrics.horiAdvance>>6;
-
-
-		cps[i].tW				= cps[i].width;
-		cps[i].tH				= cps[i].height;
-
-
+		loadGlyph(glyph, i, expanded_data[i]);
 		areaSum += (cps[i].tW+border*2)*(cps[i].tH+border*2);
-
-		if(width==0 || height==0) continue;
-
-		// Allocate Memory For The Texture Data.
-		expanded_data[i].allocate(width, height, OF_PIXELS_GRAY_ALPHA);
-		//-------------------------------- clear data:
-		expanded_data[i].set(0,255); // every luminance pixel = 255
-		expanded_data[i].set(1,0);
-
-
-		if (bAntiAliased == true){
-			ofPixels bitmapPixels;
-			bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,OF_PIXELS_GRAY);
-			expanded_data[i].setChannel(1,bitmapPixels);
-		} else {
-			//-----------------------------------
-			// true type packs monochrome info in a
-			// 1-bit format, hella funky
-			// here we unpack it:
-			unsigned char *src =  bitmap.buffer;
-			for(int j=0; j <bitmap.rows;j++) {
-				unsigned char b=0;
-				unsigned char *bptr =  src;
-				for(int k=0; k < bitmap.width ; k++){
-					expanded_data[i][2*(k+j*width)] = 255;
-
-					if (k%8==0){
-						b = (*bptr++);
-					}
-
-					expanded_data[i][2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
-					b <<= 1;
-				}
-				src += bitmap.pitch;
-			}
-			//-----------------------------------
-		}
 	}
 
 	vector<charProps> sortedCopy = cps;
@@ -684,12 +654,311 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	return true;
 }
 
+//-----------------------------------------------------------
+bool ofTrueTypeFont::initFace(string _filename){
+	initLibraries();
+
+	if(!loadFontFace(_filename,fontSize,face,filename)){
+        return false;
+	}
+
+
+	FT_Set_Char_Size( face, fontSize << 6, fontSize << 6, dpi, dpi);
+	float fontUnitScale = ((float)fontSize * dpi) / (72 * face->units_per_EM);
+	lineHeight = face->height * fontUnitScale;
+	ascenderHeight = face->ascender * fontUnitScale;
+	descenderHeight = face->descender * fontUnitScale;
+	glyphBBox.set(face->bbox.xMin * fontUnitScale,
+				  face->bbox.yMin * fontUnitScale,
+				  (face->bbox.xMax - face->bbox.xMin) * fontUnitScale,
+				  (face->bbox.yMax - face->bbox.yMin) * fontUnitScale);
+
+	//------------------------------------------------------
+	//kerning would be great to support:
+	//ofLogNotice("ofTrueTypeFont") << "FT_HAS_KERNING ? " <<  FT_HAS_KERNING(face);
+	//------------------------------------------------------
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::loadGlyph(uint32_t glyph, int i, ofPixels & pixels) const{
+	//------------------------------------------ anti aliased or not:
+	FT_Error err = FT_Load_Glyph( face, FT_Get_Char_Index( face, glyph ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+	if(err){
+		ofLogError("ofTrueTypeFont") << "loadGlyph(): FT_Load_Glyph failed for char " << glyph << ": FT_Error " << err;
+
+	}
+
+	if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+	else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+
+	//------------------------------------------
+
+
+	if(bMakeContours){
+		if(printVectorInfo){
+			ofLogNotice("ofTrueTypeFont") <<  "character " << glyph;
+		}
+
+		charOutlines[i] = makeContoursForCharacter( face );
+		charOutlinesContour[i] = charOutlines[i];
+		charOutlinesContour[i].setFilled(false);
+		charOutlinesContour[i].setStrokeWidth(1);
+
+		charOutlinesNonVFlipped[i] = charOutlines[i];
+		charOutlinesNonVFlipped[i].translate(ofVec3f(0,cps[i].height));
+		charOutlinesNonVFlipped[i].scale(1,-1);
+		charOutlinesNonVFlippedContour[i] = charOutlines[i];
+		charOutlinesNonVFlippedContour[i].setFilled(false);
+		charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
+
+
+		if(simplifyAmt>0){
+			charOutlines[i].simplify(simplifyAmt);
+			charOutlinesNonVFlipped[i].simplify(simplifyAmt);
+			charOutlinesContour[i].simplify(simplifyAmt);
+			charOutlinesNonVFlippedContour[i].simplify(simplifyAmt);
+		}
+	}
+
+
+	// -------------------------
+	// info about the character:
+	FT_Bitmap& bitmap= face->glyph->bitmap;
+	int width  = bitmap.width;
+	int height = bitmap.rows;
+
+	cps[i].characterIndex	= i;
+	cps[i].glyph			= glyph;
+	cps[i].height 			= face->glyph->metrics.height>>6;
+	cps[i].width 			= face->glyph->metrics.width>>6;
+	cps[i].bearingX			= face->glyph->metrics.horiBearingX>>6;
+	cps[i].bearingY			= face->glyph->metrics.horiBearingY>>6;
+	cps[i].xmin				= face->glyph->bitmap_left;
+	cps[i].xmax				= cps[i].xmin + cps[i].width;
+	cps[i].ymin				= -face->glyph->bitmap_top;
+	cps[i].ymax				= cps[i].ymin + cps[i].height;
+	cps[i].advance			= face->glyph->metrics.horiAdvance>>6;
+
+
+	cps[i].tW				= cps[i].width;
+	cps[i].tH				= cps[i].height;
+
+	if(width==0 || height==0) return;
+
+	// Allocate Memory For The Texture Data.
+	pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+	//-------------------------------- clear data:
+	pixels.set(0,255); // every luminance pixel = 255
+	pixels.set(1,0);
+
+
+	if (bAntiAliased == true){
+		ofPixels bitmapPixels;
+		bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,OF_PIXELS_GRAY);
+		pixels.setChannel(1,bitmapPixels);
+	} else {
+		//-----------------------------------
+		// true type packs monochrome info in a
+		// 1-bit format, hella funky
+		// here we unpack it:
+		unsigned char *src =  bitmap.buffer;
+		for(int j=0; j <bitmap.rows;j++) {
+			unsigned char b=0;
+			unsigned char *bptr =  src;
+			for(int k=0; k < bitmap.width ; k++){
+				pixels[2*(k+j*width)] = 255;
+
+				if (k%8==0){
+					b = (*bptr++);
+				}
+
+				pixels[2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
+				b <<= 1;
+			}
+			src += bitmap.pitch;
+		}
+		//-----------------------------------
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadDynamic(string _filename, int _fontSize, bool _bAntiAliased, bool _makeContours, float _simplifyAmt, int _dpi) {
+	#if defined(TARGET_ANDROID)
+	ofAddListener(ofxAndroidEvents().unloadGL,this,&ofTrueTypeFont::unloadTextures);
+	ofAddListener(ofxAndroidEvents().reloadGL,this,&ofTrueTypeFont::reloadTextures);
+	#endif
+
+	// if we've already been loaded, try to clean up :
+	unloadTextures();
+
+	if( _dpi == 0 ){
+		_dpi = ttfGlobalDpi;
+	}
+
+	bLoadedOk 			= false;
+	bAntiAliased 		= _bAntiAliased;
+	bFullCharacterSet 	= true;
+	bDynamic			= true;
+	fontSize			= _fontSize;
+	bMakeContours 		= _makeContours;
+	simplifyAmt			= _simplifyAmt;
+	dpi 				= _dpi;
+
+	//--------------- load the library and typeface
+	if(!initFace(_filename)){
+		return false;
+	}
+
+	//--------------- glyphs are loaded on demand
+	clearStringMeshCache();
+	nCharacters = 0;
+	cps.clear();
+	glyphIndices.clear();
+	charOutlines.clear();
+	charOutlinesNonVFlipped.clear();
+	charOutlinesContour.clear();
+	charOutlinesNonVFlippedContour.clear();
+
+	// start with an atlas big enough for the ascii set and let it grow from there
+	int atlasSize = 64;
+	while(atlasSize < (lineHeight + 2) * 10 && atlasSize < dynamicAtlasMaxSize){
+		atlasSize *= 2;
+	}
+	atlasShelves.clear();
+	atlasPixels.allocate(atlasSize,atlasSize,OF_PIXELS_GRAY_ALPHA);
+	atlasPixels.set(0,255);
+	atlasPixels.set(1,0);
+	bAtlasDirty = true;
+
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::loadDynamicGlyph(uint32_t codepoint) const{
+	int border = 1;
+	int index = cps.size();
+	cps.push_back(charProps());
+	if(bMakeContours){
+		charOutlines.push_back(ofTTFCharacter());
+		charOutlinesNonVFlipped.push_back(ofTTFCharacter());
+		charOutlinesContour.push_back(ofTTFCharacter());
+		charOutlinesNonVFlippedContour.push_back(ofTTFCharacter());
+	}
+
+	ofPixels glyphPixels;
+	loadGlyph(codepoint, index, glyphPixels);
+	glyphIndices[codepoint] = index;
+	nCharacters = cps.size();
+
+	if(!glyphPixels.isAllocated()){
+		return index;
+	}
+
+	charProps & props = cps[index];
+	int w = max<int>(props.tW, glyphPixels.getWidth()) + border*2;
+	int h = max<int>(props.tH, glyphPixels.getHeight()) + border*2;
+	int x, y;
+	if(!packDynamicGlyph(w, h, x, y)){
+		ofLogError("ofTrueTypeFont") << "loadDynamicGlyph(): atlas full, couldn't allocate char " << codepoint;
+		return index;
+	}
+
+	glyphPixels.pasteInto(atlasPixels, x + border, y + border);
+	float atlasW = atlasPixels.getWidth();
+	float atlasH = atlasPixels.getHeight();
+	props.t1 = float(x + border)/atlasW;
+	props.v1 = float(y + border)/atlasH;
+	props.t2 = float(props.tW + x + border)/atlasW;
+	props.v2 = float(props.tH + y + border)/atlasH;
+	bAtlasDirty = true;
+	return index;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::packDynamicGlyph(int w, int h, int & x, int & y) const{
+	while(true){
+		// best fit: the lowest shelf that can hold the glyph
+		int best = -1;
+		for(int i=0;i<(int)atlasShelves.size();i++){
+			if(h <= atlasShelves[i].height && atlasShelves[i].x + w <= (int)atlasPixels.getWidth()){
+				if(best == -1 || atlasShelves[i].height < atlasShelves[best].height){
+					best = i;
+				}
+			}
+		}
+
+		if(best == -1){
+			int nextY = atlasShelves.empty() ? 0 : atlasShelves.back().y + atlasShelves.back().height;
+			if(nextY + h <= (int)atlasPixels.getHeight() && w <= (int)atlasPixels.getWidth()){
+				atlasShelf shelf;
+				shelf.x = 0;
+				shelf.y = nextY;
+				shelf.height = h;
+				atlasShelves.push_back(shelf);
+				best = atlasShelves.size() - 1;
+			}else if(!growAtlas()){
+				return false;
+			}
+		}
+
+		if(best != -1){
+			x = atlasShelves[best].x;
+			y = atlasShelves[best].y;
+			atlasShelves[best].x += w;
+			return true;
+		}
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::growAtlas() const{
+	int w = atlasPixels.getWidth();
+	int h = atlasPixels.getHeight();
+	int newW = w;
+	int newH = h;
+	if(h < w){
+		newH *= 2;
+	}else{
+		newW *= 2;
+	}
+	if(newW > dynamicAtlasMaxSize || newH > dynamicAtlasMaxSize){
+		return false;
+	}
+
+	ofPixels grown;
+	grown.allocate(newW,newH,OF_PIXELS_GRAY_ALPHA);
+	grown.set(0,255);
+	grown.set(1,0);
+	atlasPixels.pasteInto(grown,0,0);
+	atlasPixels.swap(grown);
+
+	// existing glyphs keep their position in pixels so only
+	// the normalized texture coordinates need to be rescaled
+	float scaleX = float(w)/float(newW);
+	float scaleY = float(h)/float(newH);
+	for(int i=0;i<(int)cps.size();i++){
+		cps[i].t1 *= scaleX;
+		cps[i].t2 *= scaleX;
+		cps[i].v1 *= scaleY;
+		cps[i].v2 *= scaleY;
+	}
+	// the cached meshes have the old texture coordinates
+	stringMeshCache.clear();
+	stringMeshCacheIndex.clear();
+	bAtlasDirty = true;
+	return true;
+}
+
+//-----------------------------------------------------------
 ofTextEncoding ofTrueTypeFont::getEncoding() const {
 	return encoding;
 }
 
 void ofTrueTypeFont::setEncoding(ofTextEncoding _encoding) {
 	encoding = _encoding;
+	clearStringMeshCache();
 }
 
 //-----------------------------------------------------------
@@ -702,6 +971,11 @@ bool ofTrueTypeFont::isAntiAliased() const{
 	return bAntiAliased;
 }
 
+//-----------------------------------------------------------
+bool ofTrueTypeFont::isDynamic() const{
+	return bDynamic;
+}
+
 //-----------------------------------------------------------
 bool ofTrueTypeFont::hasFullCharacterSet() const{
 	return bFullCharacterSet;
@@ -715,6 +989,7 @@ int ofTrueTypeFont::getSize() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	clearStringMeshCache();
 }
 
 //-----------------------------------------------------------
@@ -740,6 +1015,7 @@ const ofRectangle & ofTrueTypeFont::getGlyphBBox() const {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	clearStringMeshCache();
 }
 
 //-----------------------------------------------------------
@@ -763,23 +1039,24 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(int character, bool vflip, b
 		ofLogError("ofxTrueTypeFont") << "getCharacterAsPoints(): contours not created, call loadFont() with makeContours set to true";
 		return ofTTFCharacter();
 	}
-    if (character - NUM_CHARACTER_TO_START >= nCharacters || character < NUM_CHARACTER_TO_START){
-        //ofLogError("ofxTrueTypeFont") << "getCharacterAsPoint(): char " << character + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
+    int index = getGlyphIndex(character);
+    if (index == -1){
+        //ofLogError("ofxTrueTypeFont") << "getCharacterAsPoint(): char " << character << " not allocated: line " << __LINE__ << " in " << __FILE__;
 
         return ofTTFCharacter();
     }
     
     if(vflip){
     	if(filled){
-    		return charOutlines[character - NUM_CHARACTER_TO_START];
+    		return charOutlines[index];
     	}else{
-    		return charOutlinesContour[character - NUM_CHARACTER_TO_START];
+    		return charOutlinesContour[index];
     	}
     }else{
     	if(filled){
-    		return charOutlinesNonVFlipped[character - NUM_CHARACTER_TO_START];
+    		return charOutlinesNonVFlipped[index];
     	}else{
-    		return charOutlinesNonVFlippedContour[character - NUM_CHARACTER_TO_START];
+    		return charOutlinesNonVFlippedContour[index];
     	}
     }
 }
@@ -800,9 +1077,12 @@ void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
 	t1		= cps[c].t1;
 	v1		= cps[c].v1;
 
-	xmin		= cps[c].xmin+x;
+	// rounded down instead of truncated, so a string laid out at the
+	// fractional part of its position and moved by whole pixels, like
+	// the cached ones, lands on the same pixels even if it crosses 0
+	xmin		= floor(cps[c].xmin+x);
 	ymin		= cps[c].ymin;
-	xmax		= cps[c].xmax+x;
+	xmax		= floor(cps[c].xmax+x);
 	ymax		= cps[c].ymax;
 
 	if(!vFlipped){
@@ -810,8 +1090,8 @@ void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
        ymax *= -1;
 	}
 
-    ymin += y;
-    ymax += y;
+    ymin = floor(ymin+y);
+    ymax = floor(ymax+y);
 
 	int firstIndex = stringQuads.getVertices().size();
 
@@ -834,7 +1114,7 @@ void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
 }
 
 int ofTrueTypeFont::getKerning(int c, int prevC) const{
-    if(FT_HAS_KERNING( face ) && prevC>0 && prevC<nCharacters && c>0 && c<nCharacters){
+    if(FT_HAS_KERNING( face ) && prevC>=0 && prevC<nCharacters && c>=0 && c<nCharacters){
         FT_Vector kerning;
         FT_Get_Kerning(face, FT_Get_Char_Index(face, cps[prevC].glyph), FT_Get_Char_Index(face, cps[c].glyph), FT_KERNING_UNFITTED, &kerning);
         return kerning.x>>6;
@@ -844,13 +1124,54 @@ int ofTrueTypeFont::getKerning(int c, int prevC) const{
 }
 
 //-----------------------------------------------------------
-vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip, bool filled) const{
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+int ofTrueTypeFont::getGlyphIndex(uint32_t codepoint) const{
+	if(bDynamic){
+		map<uint32_t,int>::const_iterator it = glyphIndices.find(codepoint);
+		if(it != glyphIndices.end()){
+			return it->second;
+		}
+		if(codepoint < NUM_CHARACTER_TO_START){
+			return -1;
+		}
+		return loadDynamicGlyph(codepoint);
+	}else{
+		int index = int(codepoint) - NUM_CHARACTER_TO_START;
+		if(index < 0 || index >= nCharacters){ // full char set or not?
+			return -1;
+		}
+		return index;
+	}
+}
+
+//-----------------------------------------------------------
+vector<uint32_t> ofTrueTypeFont::getCodepoints(const string & str) const{
+	vector<uint32_t> codepoints;
+	if(bDynamic && encoding==OF_ENCODING_UTF8){
+		Poco::UTF8Encoding utf8;
+		Poco::TextIterator it(str,utf8);
+		Poco::TextIterator end(str);
+		for(;it!=end;++it){
+			int codepoint = *it;
+			if(codepoint >= 0){ // -1 on malformed sequences
+				codepoints.push_back(codepoint);
+			}
+		}
+	}else if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
 		string o;
 		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(str,o);
-		str=o;
+		codepoints.assign((unsigned char*)o.data(), (unsigned char*)o.data()+o.size());
+	}else{
+		codepoints.assign((unsigned char*)str.data(), (unsigned char*)str.data()+str.size());
+		if(bDynamic){
+			// same hack used to load the euro sign for the full character set
+			replace(codepoints.begin(),codepoints.end(),uint32_t(0xA4),uint32_t(0x20AC));
+		}
 	}
+	return codepoints;
+}
 
+//-----------------------------------------------------------
+vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip, bool filled) const{
 	vector<ofTTFCharacter> shapes;
 
 	if (!bLoadedOk){
@@ -858,7 +1179,6 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip,
 		return shapes;
 	};
 
-	GLint		index	= 0;
 	GLfloat		X		= 0;
 	GLfloat		Y		= 0;
 	int newLineDirection		= 1;
@@ -871,25 +1191,25 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip,
 	}
 
 
-	int len = (int)str.length();
+	vector<uint32_t> codepoints = getCodepoints(str);
     int prevCy = -1;
-	while(index < len){
-		int cy = (unsigned char)str[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-			if (str[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = 0 ; //reset X Pos back to zero
-			} else if(cy > -1){
-				shapes.push_back(getCharacterAsPoints((unsigned char)str[index],vflip,filled));
-
-                X += getKerning(cy,prevCy);
-                
-				shapes.back().translate(ofPoint(X,Y));
-
-				X += cps[cy].advance * letterSpacing;
-			}
+	for(int index = 0; index < (int)codepoints.size(); index++){
+		if (codepoints[index] == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = 0 ; //reset X Pos back to zero
+			prevCy = -1;
+			continue;
+		}
+		int cy = getGlyphIndex(codepoints[index]);
+		if(cy > -1){
+			shapes.push_back(getCharacterAsPoints(codepoints[index],vflip,filled));
+
+            X += getKerning(cy,prevCy);
+            
+			shapes.back().translate(ofPoint(X,Y));
+
+			X += cps[cy].advance * letterSpacing;
 		}
-		index++;
 		prevCy = cy;
 	}
 	return shapes;
@@ -898,22 +1218,23 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip,
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawCharAsShape(int c, float x, float y, bool vFlipped, bool filled) const{
-	if (c - NUM_CHARACTER_TO_START >= nCharacters || c < NUM_CHARACTER_TO_START){
-		//ofLogError("ofTrueTypeFont") << "drawCharAsShape(): char " << << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
+	int index = getGlyphIndex(c);
+	if (index == -1){
+		//ofLogError("ofTrueTypeFont") << "drawCharAsShape(): char " << << c << " not allocated: line " << __LINE__ << " in " << __FILE__;
 		return;
 	}
 	//-----------------------
     if(vFlipped){
     	if(filled){
-    		charOutlines[c - NUM_CHARACTER_TO_START].draw(x,y);
+    		charOutlines[index].draw(x,y);
     	}else{
-    		charOutlinesContour[c - NUM_CHARACTER_TO_START].draw(x,y);
+    		charOutlinesContour[index].draw(x,y);
     	}
     }else{
     	if(filled){
-    		charOutlinesNonVFlipped[c - NUM_CHARACTER_TO_START].draw(x,y);
+    		charOutlinesNonVFlipped[index].draw(x,y);
     	}else{
-    		charOutlinesNonVFlippedContour[c - NUM_CHARACTER_TO_START].draw(x,y);
+    		charOutlinesNonVFlippedContour[index].draw(x,y);
     	}
     }
 }
@@ -934,16 +1255,16 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y) con
     	return myRect;
     }
 
-	int		index	= 0;
 	int		xoffset	= 0;
 	int		yoffset	= 0;
-    int     len     = (int)c.length();
+    vector<uint32_t> codepoints = getCodepoints(c);
+    int     len     = (int)codepoints.size();
     int     xmin    = -1;
     int     ymin    = -1;
     int     xmax    = -1;
     int     ymax    = -1;
 
-    if ( len < 1 || cps.empty() ){
+    if ( len < 1 ){
         myRect.x        = x;
         myRect.y        = y;
         myRect.width    = 0;
@@ -953,41 +1274,37 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y) con
 
     bool bFirstCharacter = true;
     int prevCy=-1;
-	while(index < len){
-		int cy = ((unsigned char)c[index]) - NUM_CHARACTER_TO_START;
- 	    if (cy < nCharacters){ 			// full char set or not?
-	       if (c[index] == '\n') {
-               yoffset += lineHeight;
-               xoffset = 0 ; //reset X Pos back to zero
-               prevCy = -1;
-               index++;
-               continue;
-	       }
-
-	       if(cy > -1){
-				if (bFirstCharacter){
-					xmin = cps[cy].xmin+x;
-					ymin = cps[cy].ymin+y;
-					xmax = cps[cy].xmax+x;
-					ymax = cps[cy].ymax+y;
-					bFirstCharacter = false;
-				} else {
-				   	xoffset += getKerning(cy,prevCy);
-				   	
-					int charxmin = cps[cy].xmin+xoffset+x;
-					int charymin = cps[cy].ymin+yoffset+y;
-					int charxmax = cps[cy].xmax+xoffset+x;
-					int charymax = cps[cy].ymax+yoffset+y;
-
-					if (charxmin < xmin) xmin = charxmin;
-					if (charymin < ymin) ymin = charymin;
-					if (charxmax > xmax) xmax = charxmax;
-					if (charymax > ymax) ymax = charymax;
-				}
-				xoffset += cps[cy].advance * letterSpacing;
+	for(int index = 0; index < len; index++){
+       if (codepoints[index] == '\n') {
+           yoffset += lineHeight;
+           xoffset = 0 ; //reset X Pos back to zero
+           prevCy = -1;
+           continue;
+       }
+
+		int cy = getGlyphIndex(codepoints[index]);
+       if(cy > -1){
+			if (bFirstCharacter){
+				xmin = cps[cy].xmin+x;
+				ymin = cps[cy].ymin+y;
+				xmax = cps[cy].xmax+x;
+				ymax = cps[cy].ymax+y;
+				bFirstCharacter = false;
+			} else {
+			   	xoffset += getKerning(cy,prevCy);
+			   	
+				int charxmin = cps[cy].xmin+xoffset+x;
+				int charymin = cps[cy].ymin+yoffset+y;
+				int charxmax = cps[cy].xmax+xoffset+x;
+				int charymax = cps[cy].ymax+yoffset+y;
+
+				if (charxmin < xmin) xmin = charxmin;
+				if (charymin < ymin) ymin = charymin;
+				if (charxmax > xmax) xmax = charxmax;
+				if (charymax > ymax) ymax = charymax;
 			}
-	  	}
-    	index++;
+			xoffset += cps[cy].advance * letterSpacing;
+		}
     	prevCy = cy;
     }
 
@@ -1005,14 +1322,15 @@ float ofTrueTypeFont::stringHeight(string c) const{
 }
 
 void ofTrueTypeFont::createStringMesh(string c, float x, float y, bool vFlipped) const{
-	
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
-	}
-	
-	GLint		index	= 0;
+	// laid out from the fractional part of x,y and moved by whole pixels
+	// at the end, the same as the cached strings, so both always land on
+	// the same pixels
+	float pixelX = floor(x);
+	float pixelY = floor(y);
+	x -= pixelX;
+	y -= pixelY;
+	size_t firstVertex = stringQuads.getNumVertices();
+
 	GLfloat		X		= x;
 	GLfloat		Y		= y;
 	int newLineDirection		= 1;
@@ -1024,37 +1342,193 @@ void ofTrueTypeFont::createStringMesh(string c, float x, float y, bool vFlipped)
 		newLineDirection = -1;
 	}
 
-	int len = (int)c.length();
+	vector<uint32_t> codepoints = getCodepoints(c);
+	if(bDynamic){
+		// load any new glyph before adding quads to the mesh, if the
+		// atlas grows the texture coordinates of every glyph change
+		for(int index = 0; index < (int)codepoints.size(); index++){
+			getGlyphIndex(codepoints[index]);
+		}
+	}
 
 	int prevCy = -1;
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-			if (c[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
-				prevCy = -1;
-			} else if(cy > -1){
-	            X += getKerning(cy,prevCy);
-				drawChar(cy, X, Y, vFlipped);
-				X += cps[cy].advance * letterSpacing;
-			}
+	for(int index = 0; index < (int)codepoints.size(); index++){
+		if (codepoints[index] == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = x ; //reset X Pos back to zero
+			prevCy = -1;
+			continue;
+		}
+		int cy = getGlyphIndex(codepoints[index]);
+		if(cy > -1){
+            X += getKerning(cy,prevCy);
+			drawChar(cy, X, Y, vFlipped);
+			X += cps[cy].advance * letterSpacing;
 		}
-		index++;
 		prevCy = cy;
 	}
+
+	if(pixelX!=0 || pixelY!=0){
+		ofVec3f offset(pixelX,pixelY);
+		vector<ofVec3f> & vertices = stringQuads.getVertices();
+		for(size_t i=firstVertex;i<vertices.size();i++){
+			vertices[i] += offset;
+		}
+	}
 }
 
-const ofMesh & ofTrueTypeFont::getStringMesh(string c, float x, float y, bool vFlipped) const{
+//-----------------------------------------------------------
+const ofMesh & ofTrueTypeFont::getStringLayout(const string & c, float x, float y, bool vFlipped) const{
+	if(stringMeshCacheSize == 0){
+		stringQuads.clear();
+		createStringMesh(c,x,y,vFlipped);
+		return stringQuads;
+	}
+
+	// x and y are the fractional part of the position, strings at
+	// whole pixels share the same layout
+	string key = c;
+	key += vFlipped ? '\1' : '\0';
+	key.append((const char*)&x, sizeof(x));
+	key.append((const char*)&y, sizeof(y));
+	unordered_map<string, list<stringMeshCacheEntry>::iterator>::iterator it = stringMeshCacheIndex.find(key);
+	if(it != stringMeshCacheIndex.end()){
+		// move to the front, it's now the most recently used
+		stringMeshCache.splice(stringMeshCache.begin(), stringMeshCache, it->second);
+		stringMeshCacheStats.hits++;
+		stringMeshCacheStats.savedTimeMicros += it->second->layoutTimeMicros;
+		return it->second->mesh;
+	}
+
+	unsigned long long start = ofGetElapsedTimeMicros();
 	stringQuads.clear();
 	createStringMesh(c,x,y,vFlipped);
+
+	stringMeshCache.push_front(stringMeshCacheEntry());
+	stringMeshCacheEntry & entry = stringMeshCache.front();
+	entry.key = key;
+	entry.mesh = stringQuads;
+	entry.layoutTimeMicros = ofGetElapsedTimeMicros() - start;
+	stringMeshCacheIndex[key] = stringMeshCache.begin();
+	stringMeshCacheStats.misses++;
+	stringMeshCacheStats.layoutTimeMicros += entry.layoutTimeMicros;
+
+	while(stringMeshCache.size() > stringMeshCacheSize){
+		stringMeshCacheIndex.erase(stringMeshCache.back().key);
+		stringMeshCache.pop_back();
+	}
+
+	return entry.mesh;
+}
+
+//-----------------------------------------------------------
+const ofMesh & ofTrueTypeFont::getStringMesh(string c, float x, float y, bool vFlipped) const{
+	if(stringMeshCacheSize == 0){
+		stringQuads.clear();
+		createStringMesh(c,x,y,vFlipped);
+		return stringQuads;
+	}
+
+	// glyphs are placed on whole pixels rounding down, so the layout
+	// at the fractional part of x,y moved by whole pixels is the same
+	// as laying out the string at x,y
+	float pixelX = floor(x);
+	float pixelY = floor(y);
+	const ofMesh & layout = getStringLayout(c,x-pixelX,y-pixelY,vFlipped);
+	if(pixelX==0 && pixelY==0){
+		return layout;
+	}
+
+	ofVec3f offset(pixelX,pixelY);
+	stringQuads = layout;
+	vector<ofVec3f> & vertices = stringQuads.getVertices();
+	for(size_t i=0;i<vertices.size();i++){
+		vertices[i] += offset;
+	}
 	return stringQuads;
 }
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendStringMesh(ofMesh & mesh, string c, float x, float y, bool vFlipped) const{
+	if (!bLoadedOk){
+		ofLogError("ofTrueTypeFont") << "appendStringMesh(): font not allocated";
+		return;
+	}
+
+	float pixelX = floor(x);
+	float pixelY = floor(y);
+	const ofMesh & layout = getStringLayout(c,x-pixelX,y-pixelY,vFlipped);
+	ofIndexType firstIndex = mesh.getNumVertices();
+	ofVec3f offset(pixelX,pixelY);
+
+	const vector<ofVec3f> & vertices = layout.getVertices();
+	for(size_t i=0;i<vertices.size();i++){
+		mesh.addVertex(vertices[i] + offset);
+	}
+	mesh.addTexCoords(layout.getTexCoords());
+
+	const vector<ofIndexType> & indices = layout.getIndices();
+	for(size_t i=0;i<indices.size();i++){
+		mesh.addIndex(indices[i] + firstIndex);
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setStringMeshCacheSize(size_t maxStrings){
+	stringMeshCacheSize = maxStrings;
+	while(stringMeshCache.size() > stringMeshCacheSize){
+		stringMeshCacheIndex.erase(stringMeshCache.back().key);
+		stringMeshCache.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getStringMeshCacheSize() const{
+	return stringMeshCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearStringMeshCache(){
+	stringMeshCache.clear();
+	stringMeshCacheIndex.clear();
+}
+
+//-----------------------------------------------------------
+const ofTTFStringMeshCacheStats & ofTrueTypeFont::getStringMeshCacheStats() const{
+	return stringMeshCacheStats;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::resetStringMeshCacheStats(){
+	stringMeshCacheStats.hits = 0;
+	stringMeshCacheStats.misses = 0;
+	stringMeshCacheStats.layoutTimeMicros = 0;
+	stringMeshCacheStats.savedTimeMicros = 0;
+}
+
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
+	if(bDynamic && bAtlasDirty){
+		// new glyphs were rasterized since the last upload
+		if(!texAtlas.isAllocated() || texAtlas.getWidth()!=atlasPixels.getWidth() || texAtlas.getHeight()!=atlasPixels.getHeight()){
+			texAtlas.allocate(atlasPixels,false);
+			texAtlas.setRGToRGBASwizzles(true);
+			if(bAntiAliased && fontSize>20){
+				texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+			}else{
+				texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+			}
+		}
+		texAtlas.loadData(atlasPixels);
+		bAtlasDirty = false;
+	}
 	return texAtlas;
 }
 
+//-----------------------------------------------------------
+const ofPixels & ofTrueTypeFont::getFontAtlasPixels() const{
+	return atlasPixels;
+}
+
 //=====================================================================
 void ofTrueTypeFont::drawString(string c, float x, float y) const{
 	if (!bLoadedOk){
@@ -1080,13 +1554,6 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) const{
 		return;
 	}
 
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
-	}
-
-	GLint		index	= 0;
 	GLfloat		X		= x;
 	GLfloat		Y		= y;
 	int newLineDirection		= 1;
@@ -1098,22 +1565,21 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) const{
 		newLineDirection = -1;
 	}
 
-	int len = (int)c.length();
+	vector<uint32_t> codepoints = getCodepoints(c);
     int prevCy = -1;
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-		  if (c[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
-				prevCy = -1;
-		  } else if(cy > -1){
-	            X += getKerning(cy,prevCy);
-				drawCharAsShape((unsigned char)c[index], X, Y, ofIsVFlipped(), ofGetStyle().bFill);
-				X += cps[cy].advance * letterSpacing;
-		  }
+	for(int index = 0; index < (int)codepoints.size(); index++){
+		if (codepoints[index] == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = x ; //reset X Pos back to zero
+			prevCy = -1;
+			continue;
+		}
+		int cy = getGlyphIndex(codepoints[index]);
+		if(cy > -1){
+            X += getKerning(cy,prevCy);
+			drawCharAsShape(codepoints[index], X, Y, ofIsVFlipped(), ofGetStyle().bFill);
+			X += cps[cy].advance * letterSpacing;
 		}
-		index++;
 		prevCy = cy;
 	}
 
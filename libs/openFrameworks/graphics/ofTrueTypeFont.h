@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <map>
+#include <list>
 #include "ofPoint.h"
 #include "ofRectangle.h"
 #include "ofConstants.h"
@@ -20,6 +22,11 @@
 /// at small sizes, so non-anti-aliased type doesn't always render
 /// beautifully. But we find it quite adequate, and at larger sizes it seems
 /// to works well.
+///
+/// Fonts loaded with ofTrueTypeFont::loadDynamic() don't rasterize any glyph
+/// up front. Instead every glyph is rendered the first time it's used and
+/// packed into an atlas that grows as needed, which makes loading much faster
+/// and allows to draw any character in the font, not only Latin-1.
 
 
 /// \cond INTERNAL
@@ -40,6 +47,32 @@ typedef struct {
 
 typedef ofPath ofTTFCharacter;
 
+//--------------------------------------------------
+typedef struct {
+	int x;
+	int y;
+	int height;
+} atlasShelf;
+
+//--------------------------------------------------
+typedef struct {
+	string key; // text, vflip and fractional position
+	ofMesh mesh;
+	unsigned long long layoutTimeMicros;
+} stringMeshCacheEntry;
+
+/// \endcond
+
+/// \brief Usage statistics of the string mesh cache of an ofTrueTypeFont.
+typedef struct {
+	unsigned long long hits; ///< strings found already laid out in the cache
+	unsigned long long misses; ///< strings that had to be laid out
+	unsigned long long layoutTimeMicros; ///< time spent laying out strings on misses
+	unsigned long long savedTimeMicros; ///< layout time avoided by cache hits
+} ofTTFStringMeshCacheStats;
+
+/// \cond INTERNAL
+
 //--------------------------------------------------
 #define NUM_CHARACTER_TO_START		32		// 0 - 32 are control characters, no graphics needed.
 
@@ -65,6 +98,17 @@ public:
 	/// \todo
 	ofTrueTypeFont();
 
+	/// \brief Copies the font and its settings.
+	///
+	/// The copy shares the typeface with the original but starts with
+	/// an empty string mesh cache and statistics.
+	ofTrueTypeFont(const ofTrueTypeFont & mom);
+
+	/// \brief Copies the font and its settings.
+	///
+	/// Discards the string mesh cache and resets its statistics.
+	ofTrueTypeFont & operator=(const ofTrueTypeFont & mom);
+
 	/// \todo
 	virtual ~ofTrueTypeFont();
 
@@ -102,6 +146,32 @@ public:
                   float simplifyAmt=0.3,
                   int dpi=0));
 	
+	/// \brief Loads a font which glyphs are rasterized on demand.
+	///
+	/// Instead of rendering a fixed character set when loading, glyphs are
+	/// rendered with freetype the first time they are drawn or measured and
+	/// packed into an atlas that grows as new characters are needed. Strings
+	/// are decoded as UTF-8 (unless the encoding is set to
+	/// `OF_ENCODING_ISO_8859_15`) so any character in the font can be used.
+	///
+	/// The atlas is kept in memory as ofPixels and only uploaded to the
+	/// texture when ofTrueTypeFont::getFontTexture() is called, so layout
+	/// and rasterization work without a GL context.
+	///
+	/// \param filename The name of the font file to load.
+	/// \param fontsize The size in pixels to load the font.
+	/// \param _bAntiAliased true if the font should be anti-aliased.
+	/// \param makeContours true if the vector contours should be cached.
+	/// \param simplifyAmt the amount to simplify the vector contours.
+	/// \param dpi the dots per inch used to specify rendering size.
+	/// \returns true if the font was loaded correctly.
+	bool loadDynamic(string filename,
+                  int fontsize,
+                  bool _bAntiAliased=true,
+                  bool makeContours=false,
+                  float simplifyAmt=0.3,
+                  int dpi=0);
+
 	/// \brief Has the font been loaded successfully?
 	/// \returns true if the font was loaded.
 	bool isLoaded() const;
@@ -118,18 +188,14 @@ public:
 	/// \returns true if the font was set to be anti-aliased.
 	bool isAntiAliased() const;
 
+	/// \brief Is the font rasterizing glyphs on demand?
+	/// \returns true if the font was loaded with ofTrueTypeFont::loadDynamic().
+	bool isDynamic() const;
+
 	/// \brief Does the font have a full character set?
 	/// \returns true if the font was allocated with a full character set.
 	bool hasFullCharacterSet() const;
 	
-	/// \brief Get the number characters in the loaded character set.
-	/// 
-	/// If you allocate the font using different parameters, you can load in partial 
-	/// and full character sets, this helps you know how many characters it can represent.
-	///
-	/// \returns Number of characters in loaded character set.
-	int	getNumCharacters();	
-
 	/// \brief Get the current font encoding.
 	/// 
 	/// This is set by ofTrueTypeFont::setEncoding() to either `OF_ENCODING_UTF8` or 
@@ -280,12 +346,85 @@ public:
 	ofTTFCharacter getCharacterAsPoints(int character, bool vflip=true, bool filled=true) const;
 	vector<ofTTFCharacter> getStringAsPoints(string str, bool vflip=true, bool filled=true) const;
 	const ofMesh & getStringMesh(string s, float x, float y, bool vflip=true) const;
+
+	/// \brief Appends the mesh of a string to an existing mesh.
+	///
+	/// Allows to build a single mesh for many strings so they can be drawn
+	/// in one call with the font texture bound:
+	///
+	///     ofMesh labels;
+	///     labels.setMode(OF_PRIMITIVE_TRIANGLES);
+	///     for(size_t i=0;i<names.size();i++){
+	///         font.appendStringMesh(labels, names[i], 10, 20+i*20);
+	///     }
+	///     font.getFontTexture().bind();
+	///     labels.draw();
+	///     font.getFontTexture().unbind();
+	///
+	/// The layout of each string comes from the string mesh cache when possible.
+	/// For fonts loaded with ofTrueTypeFont::loadDynamic() the texture coordinates
+	/// change when the atlas grows, so meshes that are kept around should be rebuilt
+	/// after drawing strings with new characters.
+	///
+	/// \param mesh The mesh to append to, it should use `OF_PRIMITIVE_TRIANGLES`.
+	/// \param s The string to append.
+	/// \param x X position of the string.
+	/// \param y Y position of the string.
+	/// \param vflip true if the string should be laid out for a vertically flipped
+	/// coordinate system, usually the value of ofIsVFlipped().
+	void appendStringMesh(ofMesh & mesh, string s, float x, float y, bool vflip=true) const;
+
 	const ofTexture & getFontTexture() const;
 
+	/// \brief Get the pixels of the glyph atlas.
+	///
+	/// For fonts loaded with ofTrueTypeFont::loadDynamic() this is the CPU
+	/// copy of the atlas, including every glyph rasterized so far. It's
+	/// empty for fonts loaded with ofTrueTypeFont::load().
+	///
+	/// \returns the atlas pixels in `OF_PIXELS_GRAY_ALPHA` format.
+	const ofPixels & getFontAtlasPixels() const;
+
 	void bind();
 	void unbind();
 
-	/// \}
+	/// \}
+	/// \name String Mesh Cache
+	/// \{
+
+	/// \brief Sets how many laid out strings are kept in the cache.
+	///
+	/// Laying out a string walks every character, so strings that are drawn
+	/// again and again (labels, titles...) are kept as meshes and moved by
+	/// whole pixels when drawn. A string drawn at whole pixel positions is
+	/// laid out once, one drawn at fractional positions once for each
+	/// fractional part. When the cache is full the least recently used
+	/// string is discarded. The default is 128 strings, 0 disables the cache.
+	///
+	/// \param maxStrings Maximum number of strings to keep laid out.
+	void setStringMeshCacheSize(size_t maxStrings);
+
+	/// \returns the maximum number of strings kept in the cache.
+	size_t getStringMeshCacheSize() const;
+
+	/// \brief Discards every laid out string in the cache.
+	///
+	/// This is done automatically when any setting that affects the layout changes.
+	void clearStringMeshCache();
+
+	/// \brief Get the hits, misses and layout time saved by the cache.
+	///
+	/// The hit rate is `hits / (hits + misses)` and `savedTimeMicros` is
+	/// the time the cached strings took to be laid out, added on every hit.
+	///
+	/// \returns the statistics since the font was created or since the
+	/// last call to ofTrueTypeFont::resetStringMeshCacheStats()
+	const ofTTFStringMeshCacheStats & getStringMeshCacheStats() const;
+
+	/// \brief Sets all the cache statistics back to 0.
+	void resetStringMeshCacheStats();
+
+	/// \}
 	
 protected:
 	/// \cond INTERNAL
@@ -293,12 +432,15 @@ protected:
 	bool bLoadedOk;
 	bool bAntiAliased;
 	bool bFullCharacterSet;
-	int nCharacters;
+	bool bDynamic;
+	// dynamic fonts add glyphs from the const drawing and measuring
+	// methods so the glyph data and the atlas are mutable
+	mutable int nCharacters;
 	
-	vector <ofTTFCharacter> charOutlines;
-	vector <ofTTFCharacter> charOutlinesNonVFlipped;
-	vector <ofTTFCharacter> charOutlinesContour;
-	vector <ofTTFCharacter> charOutlinesNonVFlippedContour;
+	mutable vector <ofTTFCharacter> charOutlines;
+	mutable vector <ofTTFCharacter> charOutlinesNonVFlipped;
+	mutable vector <ofTTFCharacter> charOutlinesContour;
+	mutable vector <ofTTFCharacter> charOutlinesNonVFlippedContour;
 
 	float lineHeight;
 	float ascenderHeight;
@@ -307,7 +449,7 @@ protected:
 	float letterSpacing;
 	float spaceSize;
 
-	vector<charProps> cps; // properties for each character
+	mutable vector<charProps> cps; // properties for each character
 
 	int fontSize;
 	bool bMakeContours;
@@ -315,16 +457,34 @@ protected:
 	int dpi;
 
 
+	mutable map<uint32_t,int> glyphIndices; // codepoint -> index in cps, only for dynamic fonts
+	mutable vector<atlasShelf> atlasShelves;
+	mutable ofPixels atlasPixels;
+	mutable bool bAtlasDirty;
+
     int getKerning(int c, int prevC) const;
+	int getGlyphIndex(uint32_t codepoint) const;
+	vector<uint32_t> getCodepoints(const string & s) const;
+	void loadGlyph(uint32_t codepoint, int index, ofPixels & pixels) const;
+	int loadDynamicGlyph(uint32_t codepoint) const;
+	bool packDynamicGlyph(int w, int h, int & x, int & y) const;
+	bool growAtlas() const;
+	bool initFace(string _filename);
 	void drawChar(int c, float x, float y, bool vFlipped) const;
 	void drawCharAsShape(int c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(string s, float x, float y, bool vFlipped) const;
+	const ofMesh & getStringLayout(const string & s, float x, float y, bool vFlipped) const;
 	
 	string filename;
 
-	ofTexture texAtlas;
+	mutable ofTexture texAtlas;
 	mutable ofMesh stringQuads;
 
+	size_t stringMeshCacheSize;
+	mutable list<stringMeshCacheEntry> stringMeshCache; // most recently used first
+	mutable unordered_map<string, list<stringMeshCacheEntry>::iterator> stringMeshCacheIndex;
+	mutable ofTTFStringMeshCacheStats stringMeshCacheStats;
+
 	/// \endcond
 
 private:
@@ -7,6 +7,9 @@
 #include "ofLog.h"
 #include "ofSystemUtils.h"
 #include "ofThread.h"
+#include "ofThreadPool.h"
+#include "ofProfiler.h"
+#include "ofScheduler.h"
 #include "ofThreadChannel.h"
 #include "ofURLFileLoader.h"
 #include "ofUtils.h"
@@ -23,6 +26,7 @@
 #include "ofXml.h"
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
+#include "ofParameterSnapshot.h"
 
 //--------------------------
 // math
@@ -59,9 +63,11 @@
 #endif
 #include "ofGraphics.h"
 #include "ofImage.h"
+#include "ofImageSequenceRecorder.h"
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
+#include "ofRecordingRenderer.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
@@ -84,6 +84,39 @@ bool ofAbstractParameter::isSerializable() const{
 	return true;
 }
 
+unsigned char ofAbstractParameter::getBinaryType() const{
+	return OF_PARAMETER_BINARY_NONE;
+}
+
+void ofAbstractParameter::writeBinary(vector<char> & data) const{
+
+}
+
+bool ofAbstractParameter::readBinary(const char * data, size_t size){
+	return false;
+}
+
+bool ofAbstractParameter::deferNotification(){
+	if(ofParameterGroup::numTransactions==0 || getParent()==NULL){
+		return false;
+	}
+	// the root of the hierarchy collects the changes of every
+	// transaction in it until the last one ends
+	ofParameterGroup * transactionGroup = getParent();
+	while(transactionGroup->getParent()){
+		transactionGroup = transactionGroup->getParent();
+	}
+	if(!transactionGroup->isInTransaction()){
+		return false;
+	}
+	transactionGroup->addChangedParameter(*this);
+	return true;
+}
+
+void ofAbstractParameter::notifyDeferred(){
+
+}
+
 shared_ptr<ofAbstractParameter> ofAbstractParameter::newReference() const{
 	return shared_ptr<ofAbstractParameter>(new ofAbstractParameter(*this));
 }
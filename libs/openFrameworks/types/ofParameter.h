@@ -11,6 +11,111 @@ template<typename ParameterType, typename Friend>
 class ofReadOnlyParameter;
 
 class ofParameterGroup;
+class ofParameterSnapshot;
+
+/// \cond INTERNAL
+/// Type tags of the binary representation of parameter values used by
+/// ofParameterSnapshot. The low 4 bits are the type of each component,
+/// the high 4 bits the number of components minus one. Values are stored
+/// as their components in native byte order, strings as their characters
+/// and any other type as the text returned by ofToString().
+enum ofParameterBinaryType{
+	OF_PARAMETER_BINARY_NONE = 0,
+	OF_PARAMETER_BINARY_BOOL,
+	OF_PARAMETER_BINARY_INT8,
+	OF_PARAMETER_BINARY_UINT8,
+	OF_PARAMETER_BINARY_INT16,
+	OF_PARAMETER_BINARY_UINT16,
+	OF_PARAMETER_BINARY_INT32,
+	OF_PARAMETER_BINARY_UINT32,
+	OF_PARAMETER_BINARY_INT64,
+	OF_PARAMETER_BINARY_UINT64,
+	OF_PARAMETER_BINARY_FLOAT,
+	OF_PARAMETER_BINARY_DOUBLE,
+	OF_PARAMETER_BINARY_STRING
+};
+
+/// Types without a binary representation are stored as text.
+template<typename ParameterType>
+struct ofParameterBinary{
+	static const unsigned char type = OF_PARAMETER_BINARY_STRING;
+	static void write(const ParameterType & value, vector<char> & data){
+		string str = ofToString(value);
+		data.insert(data.end(), str.begin(), str.end());
+	}
+	static bool read(const char * data, size_t size, ParameterType & value){
+		stringstream sstr;
+		sstr << string(data, size);
+		sstr >> value;
+		// eof is set when the value ends with the data so good()
+		// would be false for valid values, only check for errors
+		return !sstr.fail();
+	}
+};
+
+/// Types that are stored as their bytes, components is the number of
+/// values of the component type the type is made of.
+template<typename ParameterType, unsigned char ComponentType, int Components>
+struct ofParameterBinaryComponents{
+	static const unsigned char type = ComponentType | ((Components - 1) << 4);
+	static void write(const ParameterType & value, vector<char> & data){
+		const char * bytes = reinterpret_cast<const char*>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(ParameterType));
+	}
+	static bool read(const char * data, size_t size, ParameterType & value){
+		if(size != sizeof(ParameterType)) return false;
+		memcpy(&value, data, size);
+		return true;
+	}
+};
+
+#define OF_PARAMETER_BINARY_COMPONENTS(ParameterType, ComponentType, Components) \
+	template<> \
+	struct ofParameterBinary<ParameterType>: public ofParameterBinaryComponents<ParameterType, ComponentType, Components>{}
+
+#define OF_PARAMETER_BINARY_INTEGER(ParameterType, Signed) \
+	OF_PARAMETER_BINARY_COMPONENTS(ParameterType, \
+		sizeof(ParameterType) == 1 ? (Signed ? OF_PARAMETER_BINARY_INT8 : OF_PARAMETER_BINARY_UINT8) : \
+		sizeof(ParameterType) == 2 ? (Signed ? OF_PARAMETER_BINARY_INT16 : OF_PARAMETER_BINARY_UINT16) : \
+		sizeof(ParameterType) == 4 ? (Signed ? OF_PARAMETER_BINARY_INT32 : OF_PARAMETER_BINARY_UINT32) : \
+		(Signed ? OF_PARAMETER_BINARY_INT64 : OF_PARAMETER_BINARY_UINT64), 1)
+
+OF_PARAMETER_BINARY_COMPONENTS(bool, OF_PARAMETER_BINARY_BOOL, 1);
+OF_PARAMETER_BINARY_INTEGER(char, (char(-1) < 0));
+OF_PARAMETER_BINARY_INTEGER(signed char, true);
+OF_PARAMETER_BINARY_INTEGER(unsigned char, false);
+OF_PARAMETER_BINARY_INTEGER(short, true);
+OF_PARAMETER_BINARY_INTEGER(unsigned short, false);
+OF_PARAMETER_BINARY_INTEGER(int, true);
+OF_PARAMETER_BINARY_INTEGER(unsigned int, false);
+OF_PARAMETER_BINARY_INTEGER(long, true);
+OF_PARAMETER_BINARY_INTEGER(unsigned long, false);
+OF_PARAMETER_BINARY_INTEGER(long long, true);
+OF_PARAMETER_BINARY_INTEGER(unsigned long long, false);
+OF_PARAMETER_BINARY_COMPONENTS(float, OF_PARAMETER_BINARY_FLOAT, 1);
+OF_PARAMETER_BINARY_COMPONENTS(double, OF_PARAMETER_BINARY_DOUBLE, 1);
+OF_PARAMETER_BINARY_COMPONENTS(ofVec2f, OF_PARAMETER_BINARY_FLOAT, 2);
+OF_PARAMETER_BINARY_COMPONENTS(ofVec3f, OF_PARAMETER_BINARY_FLOAT, 3);
+OF_PARAMETER_BINARY_COMPONENTS(ofVec4f, OF_PARAMETER_BINARY_FLOAT, 4);
+OF_PARAMETER_BINARY_COMPONENTS(ofColor, OF_PARAMETER_BINARY_UINT8, 4);
+OF_PARAMETER_BINARY_COMPONENTS(ofShortColor, OF_PARAMETER_BINARY_UINT16, 4);
+OF_PARAMETER_BINARY_COMPONENTS(ofFloatColor, OF_PARAMETER_BINARY_FLOAT, 4);
+
+#undef OF_PARAMETER_BINARY_INTEGER
+#undef OF_PARAMETER_BINARY_COMPONENTS
+
+template<>
+struct ofParameterBinary<string>{
+	static const unsigned char type = OF_PARAMETER_BINARY_STRING;
+	static void write(const string & value, vector<char> & data){
+		data.insert(data.end(), value.begin(), value.end());
+	}
+	static bool read(const char * data, size_t size, string & value){
+		value.assign(data, size);
+		return true;
+	}
+};
+/// \endcond
 
 class ofAbstractParameter{
 public:
@@ -49,6 +154,26 @@ protected:
 	virtual void setSerializable(bool serializable);
 	void notifyParent();
 	virtual string escape(string str) const;
+
+	friend class ofParameterSnapshot;
+	/// \brief Returns the ofParameterBinaryType of the value, OF_PARAMETER_BINARY_NONE by default.
+	virtual unsigned char getBinaryType() const;
+	/// \brief Appends the binary representation of the value to data.
+	virtual void writeBinary(vector<char> & data) const;
+	/// \brief Sets the value from its binary representation.
+	/// \returns false if the data is not valid for this type.
+	virtual bool readBinary(const char * data, size_t size);
+
+	friend class ofParameterGroup;
+	/// \brief Called after setting the value, if the hierarchy containing
+	/// this parameter is in a transaction adds it to the parameters that
+	/// changed.
+	/// \returns true if the change notification has to wait for the end of
+	/// the transaction.
+	bool deferNotification();
+	/// \brief Notifies the listeners of this parameter and the
+	/// parameterChangedE of its parent groups, used when a transaction ends.
+	virtual void notifyDeferred();
 };
 
 
@@ -135,17 +260,26 @@ public:
 	void setParent(ofParameterGroup * _parent);
 	const ofParameterGroup * getParent() const;
 	ofParameterGroup * getParent();
+
+protected:
+	unsigned char getBinaryType() const;
+	void writeBinary(vector<char> & data) const;
+	bool readBinary(const char * data, size_t size);
+	void notifyDeferred();
+
 private:
 	class Value{
 	public:
 		Value()
 		:bInNotify(false)
+		,bDeferred(false)
 		,serializable(true)
 		,parent(NULL){};
 
 		Value(ParameterType v)
 		:value(v)
 		,bInNotify(false)
+		,bDeferred(false)
 		,serializable(true)
 		,parent(NULL){};
 
@@ -153,6 +287,7 @@ private:
 		:name(name)
 		,value(v)
 		,bInNotify(false)
+		,bDeferred(false)
 		,serializable(true)
 		,parent(NULL){};
 
@@ -162,6 +297,7 @@ private:
 		,min(min)
 		,max(max)
 		,bInNotify(false)
+		,bDeferred(false)
 		,serializable(true)
 		,parent(NULL){};
 
@@ -170,6 +306,7 @@ private:
 		ParameterType min, max;
 		ofEvent<ParameterType> changedE;
 		bool bInNotify;
+		bool bDeferred;
 		bool serializable;
 		ofParameterGroup * parent;
 	};
@@ -253,8 +390,16 @@ inline void ofParameter<ParameterType>::eventsSetValue(ParameterType v){
 		noEventsSetValue(v);
 		return;
 	}
-	obj->bInNotify = true;
 	obj->value = v;
+	// in a transaction only the first change is recorded
+	if(obj->bDeferred){
+		return;
+	}
+	if(obj->parent && deferNotification()){
+		obj->bDeferred = true;
+		return;
+	}
+	obj->bInNotify = true;
 	ofNotifyEvent(obj->changedE,obj->value,this);
 	notifyParent();
 	obj->bInNotify = false;
@@ -474,6 +619,38 @@ ofParameterGroup * ofParameter<ParameterType>::getParent(){
 
 
 
+template<typename ParameterType>
+unsigned char ofParameter<ParameterType>::getBinaryType() const{
+	return ofParameterBinary<ParameterType>::type;
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::writeBinary(vector<char> & data) const{
+	ofParameterBinary<ParameterType>::write(obj->value, data);
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::notifyDeferred(){
+	obj->bDeferred = false;
+	if(obj->bInNotify){
+		return;
+	}
+	obj->bInNotify = true;
+	ofNotifyEvent(obj->changedE,obj->value,this);
+	notifyParent();
+	obj->bInNotify = false;
+}
+
+template<typename ParameterType>
+bool ofParameter<ParameterType>::readBinary(const char * data, size_t size){
+	ParameterType v;
+	if(!ofParameterBinary<ParameterType>::read(data, size, v)){
+		return false;
+	}
+	set(v);
+	return true;
+}
+
 template <typename T>
 struct FriendMaker {typedef T Type;};
 
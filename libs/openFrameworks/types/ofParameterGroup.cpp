@@ -2,6 +2,8 @@
 #include "ofUtils.h"
 #include "ofParameter.h"
 
+int ofParameterGroup::numTransactions = 0;
+
 ofParameterGroup::ofParameterGroup()
 :obj(new Value)
 {
@@ -13,11 +15,13 @@ void ofParameterGroup::add(ofAbstractParameter & param){
 	obj->parameters.push_back(group);
 	obj->parametersIndex[group->getEscapedName()] = obj->parameters.size()-1;
 	group->setParent(this);
+	invalidatePathIndex();
 }
 
 void ofParameterGroup::clear(){
 	obj->parameters.clear();
 	obj->parametersIndex.clear();
+	invalidatePathIndex();
 }
 
 ofParameter<bool> ofParameterGroup::getBool(string name) const	{
@@ -154,8 +158,10 @@ string ofParameterGroup::getType(int position) const{
 
 
 int ofParameterGroup::getPosition(string name) const{
-	if(obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end())
-		return obj->parametersIndex.find(escape(name))->second;
+	unordered_map<string,int>::const_iterator it = obj->parametersIndex.find(name);
+	if(it==obj->parametersIndex.end()) it = obj->parametersIndex.find(escape(name));
+	if(it!=obj->parametersIndex.end())
+		return it->second;
 	return -1;
 }
 
@@ -183,7 +189,9 @@ string ofParameterGroup::toString() const{
 
 
 ofAbstractParameter & ofParameterGroup::get(string name) const{
-	map<string,int>::const_iterator it = obj->parametersIndex.find(escape(name));
+	// most names don't need escaping, try them as they are first
+	unordered_map<string,int>::const_iterator it = obj->parametersIndex.find(name);
+	if(it==obj->parametersIndex.end()) it = obj->parametersIndex.find(escape(name));
 	int index = it->second;
 	return get(index);
 }
@@ -217,7 +225,80 @@ ostream& operator<<(ostream& os, const ofParameterGroup& group) {
 }
 
 bool ofParameterGroup::contains(string name){
-	return obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end();
+	return obj->parametersIndex.find(name)!=obj->parametersIndex.end() ||
+		obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end();
+}
+
+ofAbstractParameter * ofParameterGroup::find(const string & path) const{
+	if(!obj->pathIndexValid){
+		obj->pathIndex.clear();
+		buildPathIndex("", obj->pathIndex);
+		obj->pathIndexValid = true;
+	}
+	unordered_map<string, shared_ptr<ofAbstractParameter> >::const_iterator it = obj->pathIndex.find(path);
+	if(it!=obj->pathIndex.end()){
+		return it->second.get();
+	}
+
+	// the path might have names that need escaping or a child group might
+	// have changed through a copy of it that doesn't notify this group
+	string escapedPath;
+	ofAbstractParameter * parameter = findByLevel(path, escapedPath);
+	if(parameter && obj->pathIndex.find(escapedPath)==obj->pathIndex.end()){
+		obj->pathIndexValid = false;
+	}
+	return parameter;
+}
+
+bool ofParameterGroup::find(const string & path, ofParameterGroup & group) const{
+	ofAbstractParameter * found = find(path);
+	if(found==NULL || found->type()!=typeid(ofParameterGroup).name()){
+		return false;
+	}
+	group = static_cast<ofParameterGroup&>(*found);
+	return true;
+}
+
+ofAbstractParameter * ofParameterGroup::findByLevel(const string & path, string & escapedPath) const{
+	const ofParameterGroup * group = this;
+	size_t begin = 0;
+	while(true){
+		size_t end = path.find('/', begin);
+		string name = escape(path.substr(begin, end==string::npos ? string::npos : end-begin));
+		unordered_map<string,int>::const_iterator it = group->obj->parametersIndex.find(name);
+		if(it==group->obj->parametersIndex.end()){
+			return NULL;
+		}
+		ofAbstractParameter * parameter = group->obj->parameters[it->second].get();
+		escapedPath += name;
+		if(end==string::npos){
+			return parameter;
+		}
+		if(parameter->type()!=typeid(ofParameterGroup).name()){
+			return NULL;
+		}
+		escapedPath += "/";
+		group = static_cast<const ofParameterGroup*>(parameter);
+		begin = end + 1;
+	}
+}
+
+void ofParameterGroup::buildPathIndex(const string & prefix, unordered_map<string, shared_ptr<ofAbstractParameter> > & index) const{
+	// parametersIndex has the escaped names and, for repeated names,
+	// the same parameter get(name) returns
+	for(unordered_map<string,int>::const_iterator it = obj->parametersIndex.begin(); it!=obj->parametersIndex.end(); ++it){
+		const shared_ptr<ofAbstractParameter> & parameter = obj->parameters[it->second];
+		string path = prefix + it->first;
+		if(parameter->type()==typeid(ofParameterGroup).name()){
+			static_cast<const ofParameterGroup&>(*parameter).buildPathIndex(path + "/", index);
+		}
+		index[path] = parameter;
+	}
+}
+
+void ofParameterGroup::invalidatePathIndex(){
+	obj->pathIndexValid = false;
+	if(getParent()) getParent()->invalidatePathIndex();
 }
 
 void ofParameterGroup::notifyParameterChanged(ofAbstractParameter & param){
@@ -225,6 +306,99 @@ void ofParameterGroup::notifyParameterChanged(ofAbstractParameter & param){
 	if(getParent()) getParent()->notifyParameterChanged(param);
 }
 
+ofParameterGroup & ofParameterGroup::getRoot(){
+	ofParameterGroup * root = this;
+	while(root->getParent()){
+		root = root->getParent();
+	}
+	return *root;
+}
+
+void ofParameterGroup::beginTransaction(){
+	// transactions are counted in the root so nested ones in any group
+	// of the same hierarchy are notified together when the last one ends
+	getRoot().obj->transactions++;
+	numTransactions++;
+}
+
+void ofParameterGroup::endTransaction(){
+	ofParameterGroup & root = getRoot();
+	if(root.obj->transactions==0){
+		ofLogWarning("ofParameterGroup") << "endTransaction(): called without a matching beginTransaction()";
+		return;
+	}
+	root.obj->transactions--;
+	numTransactions--;
+	if(root.obj->transactions==0 && !root.obj->changed.empty()){
+		root.notifyTransaction();
+	}
+}
+
+bool ofParameterGroup::isInTransaction() const{
+	const ofParameterGroup * root = this;
+	while(root->getParent()){
+		root = root->getParent();
+	}
+	return root->obj->transactions>0;
+}
+
+void ofParameterGroup::addChangedParameter(ofAbstractParameter & param){
+	// the parameter doesn't call this again until it's notified, a
+	// reference is kept in case param is a temporary copy
+	obj->changed.push_back(param.newReference());
+}
+
+void ofParameterGroup::notifyTransaction(){
+	// listeners can set parameters or start a new transaction
+	// so the list is moved out before notifying anything
+	vector<shared_ptr<ofAbstractParameter> > changed;
+	changed.swap(obj->changed);
+
+	for(size_t i=0;i<changed.size();i++){
+		changed[i]->notifyDeferred();
+	}
+
+	// every group containing a changed parameter, from the closest one to
+	// the root, gets the list of the parameters it contains. groups without
+	// listeners are skipped
+	vector<ofParameterGroup*> groups;
+	vector<vector<shared_ptr<ofAbstractParameter> > > groupChanges;
+	unordered_map<ofParameterGroup*,size_t> groupIndex;
+	const size_t noListeners = -1;
+	// parameters in the same group usually change together, the
+	// groups of the last parent are reused without looking them up
+	ofParameterGroup * lastParent = NULL;
+	vector<size_t> lastGroups;
+	for(size_t i=0;i<changed.size();i++){
+		ofParameterGroup * parent = changed[i]->getParent();
+		if(parent!=lastParent){
+			lastParent = parent;
+			lastGroups.clear();
+			for(ofParameterGroup * group = parent; group; group = group->getParent()){
+				unordered_map<ofParameterGroup*,size_t>::iterator it = groupIndex.find(group);
+				if(it==groupIndex.end()){
+					size_t index = noListeners;
+					if(!group->parametersChangedE.empty()){
+						index = groups.size();
+						groups.push_back(group);
+						groupChanges.push_back(vector<shared_ptr<ofAbstractParameter> >());
+					}
+					it = groupIndex.insert(make_pair(group, index)).first;
+				}
+				if(it->second!=noListeners){
+					lastGroups.push_back(it->second);
+				}
+			}
+		}
+		for(size_t j=0;j<lastGroups.size();j++){
+			groupChanges[lastGroups[j]].push_back(changed[i]);
+		}
+	}
+	for(size_t i=0;i<groups.size();i++){
+		ofNotifyEvent(groups[i]->parametersChangedE,groupChanges[i],groups[i]);
+	}
+}
+
 ofAbstractParameter & ofParameterGroup::back(){
 	return *obj->parameters.back();
 }
@@ -297,3 +471,11 @@ vector<shared_ptr<ofAbstractParameter> >::const_reverse_iterator ofParameterGrou
 	return obj->parameters.rend();
 }
 
+ofParameterTransaction::ofParameterTransaction(ofParameterGroup & group)
+:group(group){
+	group.beginTransaction();
+}
+
+ofParameterTransaction::~ofParameterTransaction(){
+	group.endTransaction();
+}
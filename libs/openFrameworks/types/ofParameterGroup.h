@@ -66,6 +66,41 @@ public:
 	template<typename ParameterType>
 	ofParameter<ParameterType> get(int pos) const;
 
+	/// \brief Finds a parameter anywhere inside the group by its path.
+	///
+	/// The path is made of the names of the groups that contain the
+	/// parameter, not including this one, and its own name separated
+	/// by '/', eg. "renderer1/color". The first time a path is looked
+	/// up the group builds an index of the full path of every parameter
+	/// it contains at any depth so any later lookup is a single hash
+	/// lookup instead of one search per level. Paths with escaped names,
+	/// the ones used in xml files and osc addresses, use the index
+	/// directly, paths with names that need escaping are found too but
+	/// searching level by level.
+	///
+	/// \returns the parameter or NULL if there's none with that path.
+	ofAbstractParameter * find(const string & path) const;
+
+	/// \brief Makes parameter a reference to the one with that path.
+	///
+	/// The parameter can be kept as a handle to read and set the value
+	/// without looking it up again:
+	///
+	/// ~~~~{.cpp}
+	///     ofParameter<float> radius;
+	///     if(settings.find("renderer1/size", radius)){
+	///         radius = 20;
+	///     }
+	/// ~~~~
+	///
+	/// \returns false and leaves parameter untouched if there's no
+	/// parameter with that path or its type is not ParameterType.
+	template<typename ParameterType>
+	bool find(const string & path, ofParameter<ParameterType> & parameter) const;
+
+	/// \brief Makes group a reference to the group with that path.
+	bool find(const string & path, ofParameterGroup & group) const;
+
 	int size() const;
 	string getName(int position) const;
 	string getType(int position) const;
@@ -84,6 +119,37 @@ public:
 
 	ofEvent<ofAbstractParameter> parameterChangedE;
 
+	/// \brief Starts deferring the change notifications of the parameters
+	/// in the group, at any depth, until endTransaction().
+	///
+	/// Setting many parameters at once, like when loading a preset,
+	/// notifies the listeners of each parameter and of every group up to
+	/// the root once for every value that is set. In a transaction the
+	/// parameters are only marked as changed, when it ends each parameter
+	/// that changed notifies its own listeners and parameterChangedE in
+	/// every group up to the root once with its last value, then each group
+	/// containing any of them notifies parametersChangedE once with the list
+	/// of those parameters. ofParameterTransaction does the same for a scope.
+	///
+	/// Transactions are counted for the whole hierarchy, they can be nested
+	/// in this or in any other group in it and the notifications are sent
+	/// when the last one ends, no matter which began first. Every call needs
+	/// a matching endTransaction() and the hierarchy shouldn't change until
+	/// then.
+	void beginTransaction();
+
+	/// \brief Ends a transaction started with beginTransaction() and sends
+	/// the notifications for the parameters that changed during it.
+	void endTransaction();
+
+	/// \returns true if there's a transaction in progress in the hierarchy
+	/// containing this group.
+	bool isInTransaction() const;
+
+	/// Notified at the end of a transaction with the parameters inside
+	/// this group that changed during it, in the order they changed.
+	ofEvent<vector<shared_ptr<ofAbstractParameter> > > parametersChangedE;
+
 	ofAbstractParameter & back();
 	ofAbstractParameter & front();
 	const ofAbstractParameter & back() const;
@@ -107,22 +173,70 @@ public:
 	vector<shared_ptr<ofAbstractParameter> >::const_reverse_iterator rend() const;
 
 private:
+	friend class ofAbstractParameter;
+	void addChangedParameter(ofAbstractParameter & param);
+	void notifyTransaction();
+	ofParameterGroup & getRoot();
+	// transactions in progress in any group, so setting a
+	// parameter only looks for one when there's any
+	static int numTransactions;
+
+	void invalidatePathIndex();
+	void buildPathIndex(const string & prefix, unordered_map<string, shared_ptr<ofAbstractParameter> > & index) const;
+	ofAbstractParameter * findByLevel(const string & path, string & escapedPath) const;
+
 	class Value{
 	public:
 		Value()
 		:serializable(true)
-		,parent(NULL){}
+		,parent(NULL)
+		,pathIndexValid(false)
+		,transactions(0){}
 
-		map<string,int> parametersIndex;
+		unordered_map<string,int> parametersIndex;
 		vector<shared_ptr<ofAbstractParameter> > parameters;
 		string name;
 		bool serializable;
 		ofParameterGroup * parent;
+
+		// full path of every parameter at any depth, built on the first call
+		// to find() and invalidated when this group or a child changes
+		unordered_map<string, shared_ptr<ofAbstractParameter> > pathIndex;
+		bool pathIndexValid;
+
+		// transactions in progress in the hierarchy, only used in the
+		// root, and the parameters changed during them, once each
+		int transactions;
+		vector<shared_ptr<ofAbstractParameter> > changed;
 	};
 	shared_ptr<Value> obj;
 };
 
 
+/// \brief Defers the change notifications of the parameters in a group
+/// while it's in scope:
+///
+/// ~~~~{.cpp}
+///     {
+///         ofParameterTransaction transaction(parameters);
+///         for(int i = 0; i < preset.size(); i++){
+///             ...
+///         }
+///     } // listeners are notified here
+/// ~~~~
+///
+/// \sa ofParameterGroup::beginTransaction()
+class ofParameterTransaction{
+public:
+	ofParameterTransaction(ofParameterGroup & group);
+	~ofParameterTransaction();
+private:
+	ofParameterTransaction(const ofParameterTransaction &);
+	ofParameterTransaction & operator=(const ofParameterTransaction &);
+	ofParameterGroup & group;
+};
+
+
 template<typename ParameterType>
 ofParameter<ParameterType> ofParameterGroup::get(string name) const{
 	return static_cast<ofParameter<ParameterType>& >(get(name));
@@ -132,4 +246,14 @@ template<typename ParameterType>
 ofParameter<ParameterType> ofParameterGroup::get(int pos) const{
 	return static_cast<ofParameter<ParameterType>& >(get(pos));
 }
+
+template<typename ParameterType>
+bool ofParameterGroup::find(const string & path, ofParameter<ParameterType> & parameter) const{
+	ofAbstractParameter * found = find(path);
+	if(found == NULL || found->type() != typeid(ofParameter<ParameterType>).name()){
+		return false;
+	}
+	parameter.makeReferenceTo(static_cast<ofParameter<ParameterType>&>(*found));
+	return true;
+}
 #endif /* OFXPARAMETERGROUP_H_ */
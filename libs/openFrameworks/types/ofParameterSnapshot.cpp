@@ -0,0 +1,336 @@
+#include "ofParameterSnapshot.h"
+#include "ofParameterGroup.h"
+#include "ofLog.h"
+
+// 64 bit FNV-1a, paths are hashed incrementally while walking the groups
+static const unsigned long long fnvOffsetBasis = 14695981039346656037ULL;
+static const unsigned long long fnvPrime = 1099511628211ULL;
+
+static unsigned long long hashAppend(unsigned long long hash, const string & str){
+	for(size_t i = 0; i < str.size(); i++){
+		hash ^= (unsigned char)str[i];
+		hash *= fnvPrime;
+	}
+	return hash;
+}
+
+// same as hashing ofAbstractParameter::getEscapedName() but without
+// building the escaped string for every parameter
+static unsigned long long hashAppendEscaped(unsigned long long hash, const string & name){
+	for(size_t i = 0; i < name.size(); i++){
+		unsigned char c = name[i];
+		switch(c){
+		case ' ': case '<': case '>': case '{': case '}': case '[': case ']':
+		case ',': case '(': case ')': case '/': case '\\':
+			c = '_';
+			break;
+		}
+		hash ^= c;
+		hash *= fnvPrime;
+	}
+	return hash;
+}
+
+static bool isGroup(const ofAbstractParameter & parameter){
+	return parameter.type() == typeid(ofParameterGroup).name();
+}
+
+// file format: magic, version and number of entries, then for each
+// entry its hash, type, size and value. all numbers are in the byte
+// order of the machine that saved the file, no swapping is done
+static const char snapshotMagic[4] = {'o','f','p','s'};
+static const unsigned int snapshotVersion = 1;
+
+template<typename T>
+static void writeNumber(vector<char> & out, T value){
+	const char * bytes = reinterpret_cast<const char*>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool readNumber(const char *& in, const char * end, T & value){
+	if(end - in < (ptrdiff_t)sizeof(T)) return false;
+	memcpy(&value, in, sizeof(T));
+	in += sizeof(T);
+	return true;
+}
+
+//----------------------------------------------------------------
+ofParameterSnapshot::ofParameterSnapshot(){
+
+}
+
+//----------------------------------------------------------------
+ofParameterSnapshot::ofParameterSnapshot(const ofParameterGroup & group){
+	capture(group);
+}
+
+//----------------------------------------------------------------
+unsigned long long ofParameterSnapshot::hashPath(const string & path){
+	return hashAppend(fnvOffsetBasis, path);
+}
+
+//----------------------------------------------------------------
+void ofParameterSnapshot::capture(const ofParameterGroup & group){
+	clear();
+	capture(group, fnvOffsetBasis);
+}
+
+//----------------------------------------------------------------
+void ofParameterSnapshot::capture(const ofParameterGroup & group, unsigned long long prefix){
+	for(int i = 0; i < group.size(); i++){
+		const ofAbstractParameter & parameter = group.get(i);
+		if(!parameter.isSerializable()){
+			continue;
+		}
+		unsigned long long hash = hashAppendEscaped(prefix, parameter.getName());
+		if(isGroup(parameter)){
+			capture(static_cast<const ofParameterGroup&>(parameter), hashAppend(hash, "/"));
+		}else if(parameter.getBinaryType() != OF_PARAMETER_BINARY_NONE){
+			Entry entry;
+			entry.hash = hash;
+			entry.type = parameter.getBinaryType();
+			entry.offset = data.size();
+			parameter.writeBinary(data);
+			entry.size = data.size() - entry.offset;
+			entries.push_back(entry);
+		}
+	}
+}
+
+//----------------------------------------------------------------
+const ofParameterSnapshot::Entry * ofParameterSnapshot::find(unsigned long long hash, size_t & next) const{
+	// parameters are usually in the same order they were captured
+	if(next < entries.size() && entries[next].hash == hash){
+		return &entries[next++];
+	}
+	if(index.size() != entries.size()){
+		index.resize(entries.size());
+		for(size_t i = 0; i < entries.size(); i++){
+			index[i] = make_pair(entries[i].hash, i);
+		}
+		sort(index.begin(), index.end());
+	}
+	vector<pair<unsigned long long, size_t> >::const_iterator it =
+		lower_bound(index.begin(), index.end(), make_pair(hash, size_t(0)));
+	if(it == index.end() || it->first != hash){
+		return NULL;
+	}
+	next = it->second + 1;
+	return &entries[it->second];
+}
+
+//----------------------------------------------------------------
+bool ofParameterSnapshot::equals(const Entry & entry, const char * value, size_t size) const{
+	return entry.size == size && (size == 0 || memcmp(&data[entry.offset], value, size) == 0);
+}
+
+//----------------------------------------------------------------
+size_t ofParameterSnapshot::restore(ofParameterGroup & group) const{
+	size_t next = 0;
+	vector<char> current;
+	ofParameterTransaction transaction(group);
+	return restore(group, fnvOffsetBasis, next, current);
+}
+
+//----------------------------------------------------------------
+size_t ofParameterSnapshot::restore(ofParameterGroup & group, unsigned long long prefix, size_t & next, vector<char> & current) const{
+	size_t changed = 0;
+	for(int i = 0; i < group.size(); i++){
+		ofAbstractParameter & parameter = group.get(i);
+		if(!parameter.isSerializable()){
+			continue;
+		}
+		unsigned long long hash = hashAppendEscaped(prefix, parameter.getName());
+		if(isGroup(parameter)){
+			changed += restore(static_cast<ofParameterGroup&>(parameter), hashAppend(hash, "/"), next, current);
+			continue;
+		}
+		const Entry * entry = find(hash, next);
+		if(entry == NULL || entry->type != parameter.getBinaryType()){
+			continue;
+		}
+		current.clear();
+		parameter.writeBinary(current);
+		if(current.empty() ? entry->size == 0 : equals(*entry, &current[0], current.size())){
+			continue;
+		}
+		const char * value = entry->size ? &data[entry->offset] : "";
+		if(parameter.readBinary(value, entry->size)){
+			changed++;
+		}else{
+			ofLogError("ofParameterSnapshot") << "restore(): couldn't set " << parameter.getName() << " from the snapshot";
+		}
+	}
+	return changed;
+}
+
+//----------------------------------------------------------------
+void ofParameterSnapshot::add(const Entry & entry, const char * value){
+	Entry copy = entry;
+	copy.offset = data.size();
+	data.insert(data.end(), value, value + entry.size);
+	entries.push_back(copy);
+}
+
+//----------------------------------------------------------------
+ofParameterSnapshot ofParameterSnapshot::getDiff(const ofParameterSnapshot & other) const{
+	ofParameterSnapshot diff;
+	size_t next = 0;
+	for(size_t i = 0; i < other.entries.size(); i++){
+		const Entry & entry = other.entries[i];
+		const char * value = entry.size ? &other.data[entry.offset] : "";
+		const Entry * mine = find(entry.hash, next);
+		if(mine == NULL || mine->type != entry.type || !equals(*mine, value, entry.size)){
+			diff.add(entry, value);
+		}
+	}
+	return diff;
+}
+
+// interpolates count components of type T
+template<typename T>
+static void interpolateComponents(const char * from, const char * to, char * result, size_t count, float pct){
+	for(size_t i = 0; i < count; i++){
+		T a, b;
+		memcpy(&a, from + i * sizeof(T), sizeof(T));
+		memcpy(&b, to + i * sizeof(T), sizeof(T));
+		double value = a + (double(b) - double(a)) * pct;
+		T r = numeric_limits<T>::is_integer ? T(floor(value + 0.5)) : T(value);
+		memcpy(result + i * sizeof(T), &r, sizeof(T));
+	}
+}
+
+//----------------------------------------------------------------
+ofParameterSnapshot ofParameterSnapshot::getInterpolated(const ofParameterSnapshot & other, float pct) const{
+	ofParameterSnapshot result;
+	result.entries = entries;
+	result.data = data;
+	size_t next = 0;
+	for(size_t i = 0; i < result.entries.size(); i++){
+		const Entry & entry = result.entries[i];
+		const Entry * target = other.find(entry.hash, next);
+		if(target == NULL || target->type != entry.type){
+			continue;
+		}
+		const char * to = target->size ? &other.data[target->offset] : "";
+		if(entry.size != target->size || (entry.type & 0x0f) == OF_PARAMETER_BINARY_BOOL || (entry.type & 0x0f) == OF_PARAMETER_BINARY_STRING){
+			// values that can't be interpolated switch halfway
+			if(pct >= 0.5){
+				result.entries[i].offset = result.data.size();
+				result.entries[i].size = target->size;
+				result.data.insert(result.data.end(), to, to + target->size);
+			}
+			continue;
+		}
+		const char * from = &data[entry.offset];
+		char * value = &result.data[entry.offset];
+		size_t components = (entry.type >> 4) + 1;
+		switch(entry.type & 0x0f){
+		case OF_PARAMETER_BINARY_INT8: interpolateComponents<signed char>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_UINT8: interpolateComponents<unsigned char>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_INT16: interpolateComponents<short>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_UINT16: interpolateComponents<unsigned short>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_INT32: interpolateComponents<int>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_UINT32: interpolateComponents<unsigned int>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_INT64: interpolateComponents<long long>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_UINT64: interpolateComponents<unsigned long long>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_FLOAT: interpolateComponents<float>(from, to, value, components, pct); break;
+		case OF_PARAMETER_BINARY_DOUBLE: interpolateComponents<double>(from, to, value, components, pct); break;
+		}
+	}
+	return result;
+}
+
+//----------------------------------------------------------------
+void ofParameterSnapshot::save(ofBuffer & buffer) const{
+	vector<char> out;
+	out.reserve(12 + entries.size() * 13 + data.size());
+	out.insert(out.end(), snapshotMagic, snapshotMagic + 4);
+	writeNumber(out, snapshotVersion);
+	writeNumber(out, (unsigned int)entries.size());
+	for(size_t i = 0; i < entries.size(); i++){
+		const Entry & entry = entries[i];
+		writeNumber(out, entry.hash);
+		writeNumber(out, entry.type);
+		writeNumber(out, (unsigned int)entry.size);
+		if(entry.size){
+			out.insert(out.end(), &data[entry.offset], &data[entry.offset] + entry.size);
+		}
+	}
+	buffer.set(out.empty() ? "" : &out[0], out.size());
+}
+
+//----------------------------------------------------------------
+bool ofParameterSnapshot::save(const string & path) const{
+	ofBuffer buffer;
+	save(buffer);
+	return ofBufferToFile(path, buffer, true);
+}
+
+//----------------------------------------------------------------
+bool ofParameterSnapshot::load(const ofBuffer & buffer){
+	clear();
+	const char * in = buffer.getData();
+	const char * end = in + buffer.size();
+	unsigned int version, count;
+	if(end - in < 4 || memcmp(in, snapshotMagic, 4) != 0){
+		ofLogError("ofParameterSnapshot") << "load(): not a parameter snapshot";
+		return false;
+	}
+	in += 4;
+	if(!readNumber(in, end, version) || version != snapshotVersion){
+		ofLogError("ofParameterSnapshot") << "load(): unsupported snapshot version";
+		return false;
+	}
+	// each entry needs at least its hash, type and size, checked before
+	// reserving so a corrupt count can't ask for a huge allocation
+	const size_t entryHeaderSize = sizeof(unsigned long long) + sizeof(unsigned char) + sizeof(unsigned int);
+	if(!readNumber(in, end, count) || count > (size_t)(end - in) / entryHeaderSize){
+		ofLogError("ofParameterSnapshot") << "load(): truncated snapshot";
+		return false;
+	}
+	entries.reserve(count);
+	data.reserve(end - in);
+	for(unsigned int i = 0; i < count; i++){
+		Entry entry;
+		unsigned int size;
+		if(!readNumber(in, end, entry.hash) || !readNumber(in, end, entry.type) ||
+		   !readNumber(in, end, size) || (size_t)(end - in) < size){
+			ofLogError("ofParameterSnapshot") << "load(): truncated snapshot";
+			clear();
+			return false;
+		}
+		entry.size = size;
+		add(entry, in);
+		in += size;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------
+bool ofParameterSnapshot::load(const string & path){
+	ofFile file(path);
+	if(!file.exists()){
+		ofLogError("ofParameterSnapshot") << "load(): " << path << " doesn't exist";
+		return false;
+	}
+	return load(ofBufferFromFile(path, true));
+}
+
+//----------------------------------------------------------------
+size_t ofParameterSnapshot::size() const{
+	return entries.size();
+}
+
+//----------------------------------------------------------------
+bool ofParameterSnapshot::empty() const{
+	return entries.empty();
+}
+
+//----------------------------------------------------------------
+void ofParameterSnapshot::clear(){
+	entries.clear();
+	data.clear();
+	index.clear();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofParameter.h"
+#include "ofFileUtils.h"
+
+class ofParameterGroup;
+
+/// \brief A copy of the values of every parameter in a group, in binary.
+///
+/// Saving a group with ofxPanel or ofXml converts every value to text and
+/// builds an xml tree, which for groups with thousands of parameters takes
+/// long enough to drop frames. A snapshot copies the values as bytes instead,
+/// tagged with their type and the hash of their path in the group, so they
+/// can be restored, saved to a file or compared quickly:
+///
+/// ~~~~{.cpp}
+///     ofParameterSnapshot preset(parameters);
+///     preset.save("preset.bin");
+///     ...
+///     preset.load("preset.bin");
+///     preset.restore(parameters);
+/// ~~~~
+///
+/// getDiff() returns a snapshot with only the parameters that changed, which
+/// restores in a fraction of the time of a full one and keeps undo history
+/// small:
+///
+/// ~~~~{.cpp}
+///     ofParameterSnapshot before(parameters);
+///     // ... user edits ...
+///     ofParameterSnapshot after(parameters);
+///     undo.push_back(after.getDiff(before));
+///     redo.push_back(before.getDiff(after));
+///     ...
+///     undo.back().restore(parameters);
+/// ~~~~
+///
+/// and getInterpolated() blends two snapshots to crossfade between presets.
+///
+/// Parameters are matched by path relative to the group, not by position,
+/// so a snapshot can be restored after parameters are added or removed.
+/// Parameters that are not serializable are skipped. Values are stored in the
+/// byte order of the machine, files are portable between little endian
+/// platforms, which are all the ones openFrameworks runs on.
+class ofParameterSnapshot{
+public:
+	/// \brief Creates an empty snapshot.
+	ofParameterSnapshot();
+
+	/// \brief Creates a snapshot of the current values of group.
+	ofParameterSnapshot(const ofParameterGroup & group);
+
+	/// \brief Replaces the contents with the current values of group.
+	void capture(const ofParameterGroup & group);
+
+	/// \brief Sets the parameters of group to the values in the snapshot.
+	///
+	/// Only parameters whose value is different are set, so listeners are
+	/// only notified for those, in a transaction so groups notify
+	/// parametersChangedE once, see ofParameterGroup::beginTransaction().
+	/// Parameters in the group that are not in the snapshot, or whose type
+	/// changed, are left untouched.
+	///
+	/// \returns the number of parameters that changed.
+	size_t restore(ofParameterGroup & group) const;
+
+	/// \brief Returns the values in other that are different from this.
+	///
+	/// Restoring the result on a group with the values of this snapshot
+	/// sets it to the values of other.
+	ofParameterSnapshot getDiff(const ofParameterSnapshot & other) const;
+
+	/// \brief Blends the values of this snapshot with those of other.
+	///
+	/// Numeric values and the components of vectors and colors are
+	/// interpolated linearly, integers are rounded. Booleans and strings
+	/// switch to the value of other when pct reaches 0.5. Values that are
+	/// not in other keep the value of this snapshot.
+	///
+	/// \param pct 0 returns this snapshot, 1 the values of other.
+	ofParameterSnapshot getInterpolated(const ofParameterSnapshot & other, float pct) const;
+
+	/// \brief Writes the snapshot in binary to buffer.
+	void save(ofBuffer & buffer) const;
+
+	/// \brief Writes the snapshot to a file.
+	bool save(const string & path) const;
+
+	/// \brief Reads a snapshot written by save().
+	/// \returns false if the data is not a valid snapshot.
+	bool load(const ofBuffer & buffer);
+
+	/// \brief Reads a snapshot file written by save().
+	bool load(const string & path);
+
+	/// \returns the number of parameters in the snapshot.
+	size_t size() const;
+	bool empty() const;
+	void clear();
+
+	/// \returns the hash used to identify a parameter by its path in a group,
+	/// the escaped names of its parents inside the group and its own joined
+	/// by '/', eg. "particles/color".
+	static unsigned long long hashPath(const string & path);
+
+private:
+	struct Entry{
+		unsigned long long hash;
+		unsigned char type;
+		size_t offset;
+		size_t size;
+	};
+
+	void capture(const ofParameterGroup & group, unsigned long long hash);
+	size_t restore(ofParameterGroup & group, unsigned long long hash, size_t & next, vector<char> & current) const;
+	const Entry * find(unsigned long long hash, size_t & next) const;
+	bool equals(const Entry & entry, const char * data, size_t size) const;
+	void add(const Entry & entry, const char * data);
+
+	vector<Entry> entries;
+	vector<char> data;
+
+	// entries sorted by hash, to find parameters that are not where expected
+	mutable vector<pair<unsigned long long, size_t> > index;
+};
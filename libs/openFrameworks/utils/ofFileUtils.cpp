@@ -1,9 +1,17 @@
 #include "ofFileUtils.h"
 #ifndef TARGET_WIN32
  #include <pwd.h>
+ #include <sys/stat.h>
+#endif
+
+#ifdef TARGET_LINUX
+ #include <sys/inotify.h>
+ #include <unistd.h>
+ #include <set>
 #endif
 
 #include "ofUtils.h"
+#include "ofThreadPool.h"
 
 
 #ifdef TARGET_OSX
@@ -956,47 +964,411 @@ Poco::File & ofFile::getPocoFile(){
 //------------------------------------------------------------------------------------------------------------
 
 
-//----------------------------------------
-// Simple example of a boolean function that can be used
-// with ofRemove to remove items from vectors.
-bool hiddenFile(ofFile file){
-	return file.isHidden();
+//------------------------------------------------------------------------------------------------------------
+// reads everything ofDirectoryEntry caches with as few system calls
+// as possible, folderPath ends with a separator and name can be a
+// relative path inside it
+static bool readEntryInfo(const string & folderPath, const string & name, ofDirectoryEntry & entry){
+	entry.name = name;
+	size_t slash = name.find_last_of("/\\");
+	size_t dot = name.find_last_of('.');
+	if(dot != string::npos && (slash == string::npos || dot > slash)){
+		entry.extension = toLower(name.substr(dot + 1));
+	}else{
+		entry.extension.clear();
+	}
+
+	string fullPath = folderPath + name;
+#ifndef TARGET_WIN32
+	struct stat info;
+	if(lstat(fullPath.c_str(), &info) != 0){
+		return false;
+	}
+	entry.isLink = S_ISLNK(info.st_mode);
+	if(entry.isLink && stat(fullPath.c_str(), &info) != 0){
+		// broken link, use the information of the link itself
+		lstat(fullPath.c_str(), &info);
+	}
+	entry.isDirectory = S_ISDIR(info.st_mode);
+	entry.size = entry.isDirectory ? 0 : info.st_size;
+	entry.modified = info.st_mtime;
+	size_t nameStart = slash == string::npos ? 0 : slash + 1;
+	entry.isHidden = nameStart < name.size() && name[nameStart] == '.';
+#else
+	try{
+		File file(fullPath);
+		entry.isLink = file.isLink();
+		entry.isDirectory = file.isDirectory();
+		entry.size = entry.isDirectory ? 0 : file.getSize();
+		entry.modified = file.getLastModified().epochTime();
+		entry.isHidden = file.isHidden();
+	}catch(Poco::Exception &){
+		return false;
+	}
+#endif
+	return true;
 }
 
-//----------------------------------------
-// Advanced example of a class that has a boolean function
-// that can be used with ofRemove to remove items from vectors.
-class ExtensionComparator : public unary_function<ofFile, bool> {
-	public:
-		vector<string> * extensions;
-		inline bool operator()(const ofFile & file){
-			Path curPath(file.path());
-			string curExtension = toLower(curPath.getExtension());
-			return !ofContains(*extensions, curExtension);
+//------------------------------------------------------------------------------------------------------------
+// compares numbers inside the names by their value so
+// "img2.png" goes before "img10.png"
+static bool naturalLess(const string & a, const string & b){
+	size_t i = 0, j = 0;
+	while(i < a.size() && j < b.size()){
+		if(isdigit((unsigned char)a[i]) && isdigit((unsigned char)b[j])){
+			size_t startA = i, startB = j;
+			while(startA < a.size() && a[startA] == '0') startA++;
+			while(startB < b.size() && b[startB] == '0') startB++;
+			i = startA;
+			j = startB;
+			while(i < a.size() && isdigit((unsigned char)a[i])) i++;
+			while(j < b.size() && isdigit((unsigned char)b[j])) j++;
+			// without leading zeros the longer number is the bigger one
+			if(i - startA != j - startB){
+				return i - startA < j - startB;
+			}
+			int cmp = a.compare(startA, i - startA, b, startB, j - startB);
+			if(cmp != 0){
+				return cmp < 0;
+			}
+		}else{
+			if(a[i] != b[j]){
+				return a[i] < b[j];
+			}
+			i++;
+			j++;
+		}
+	}
+	if(a.size() - i != b.size() - j){
+		return a.size() - i < b.size() - j;
+	}
+	return a < b;
+}
+
+//------------------------------------------------------------------------------------------------------------
+static bool naturalEntryLess(const ofDirectoryEntry & a, const ofDirectoryEntry & b){
+	return naturalLess(a.name, b.name);
+}
+
+//------------------------------------------------------------------------------------------------------------
+// lists the names in each folder, used with ofParallelFor
+class ListNames{
+public:
+	ListNames(const string & base, const vector<string> & folders, vector<vector<string> > & names)
+	:base(base)
+	,folders(folders)
+	,names(names){}
+
+	void operator()(size_t i){
+		try{
+			DirectoryIterator end;
+			for(DirectoryIterator it(base + folders[i]); it != end; ++it){
+				names[i].push_back(it.name());
+			}
+		}catch(Poco::Exception & e){
+			ofLogWarning("ofDirectory") << "listDir(): couldn't list \"" << base + folders[i] << "\": " << e.displayText();
 		}
+	}
+
+	const string & base;
+	const vector<string> & folders;
+	vector<vector<string> > & names;
+};
+
+//------------------------------------------------------------------------------------------------------------
+// reads the metadata of each entry, used with ofParallelFor
+class ReadEntries{
+public:
+	ReadEntries(const string & base, vector<ofDirectoryEntry> & entries, vector<char> & found)
+	:base(base)
+	,entries(entries)
+	,found(found){}
+
+	void operator()(size_t i){
+		found[i] = readEntryInfo(base, entries[i].name, entries[i]);
+	}
+
+	const string & base;
+	vector<ofDirectoryEntry> & entries;
+	vector<char> & found;
+};
+
+//------------------------------------------------------------------------------------------------------------
+static string getFolderPath(const Poco::File & dir){
+	string path = dir.path();
+	if(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\'){
+		path += "/";
+	}
+	return path;
+}
+
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofDirectoryEntry
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+ofDirectoryEntry::ofDirectoryEntry()
+:size(0)
+,modified(0)
+,isDirectory(false)
+,isHidden(false)
+,isLink(false){
+}
+
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofDirectoryIterator
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+ofDirectoryIterator::ofDirectoryIterator()
+:recursive(false)
+,showHidden(false){
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofDirectoryIterator::ofDirectoryIterator(string path, bool recursive, bool bRelativeToData)
+:recursive(false)
+,showHidden(false){
+	open(path, recursive, bRelativeToData);
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryIterator::open(string path, bool _recursive, bool bRelativeToData){
+	close();
+	if(bRelativeToData){
+		path = ofToDataPath(path);
+	}
+	root = getFolderPath(File(path));
+	recursive = _recursive;
+	try{
+		iterators.push_back(DirectoryIterator(root));
+		prefixes.push_back("");
+	}catch(Poco::Exception & e){
+		ofLogError("ofDirectoryIterator") << "open(): couldn't open \"" << path << "\": " << e.displayText();
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectoryIterator::close(){
+	iterators.clear();
+	prefixes.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectoryIterator::setShowHidden(bool _showHidden){
+	showHidden = _showHidden;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryIterator::next(ofDirectoryEntry & entry){
+	DirectoryIterator end;
+	while(!iterators.empty()){
+		DirectoryIterator & it = iterators.back();
+		if(it == end){
+			iterators.pop_back();
+			prefixes.pop_back();
+			continue;
+		}
+		string name = prefixes.back() + it.name();
+		++it;
+
+		if(!readEntryInfo(root, name, entry) || (entry.isHidden && !showHidden)){
+			continue;
+		}
+		// links to folders are not followed to avoid loops
+		if(recursive && entry.isDirectory && !entry.isLink){
+			try{
+				iterators.push_back(DirectoryIterator(root + name));
+				prefixes.push_back(name + "/");
+			}catch(Poco::Exception & e){
+				ofLogWarning("ofDirectoryIterator") << "next(): couldn't open \"" << root + name << "\": " << e.displayText();
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofDirectoryWatcher
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+// inotify watches for a directory and its subfolders,
+// only does something on linux
+class ofDirectoryWatcher{
+public:
+	typedef struct{
+		string name;
+		unsigned int mask;
+	} Event;
+
+	ofDirectoryWatcher()
+	:fd(-1)
+	,listed(false){
+#ifdef TARGET_LINUX
+		fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+	}
+
+	~ofDirectoryWatcher(){
+#ifdef TARGET_LINUX
+		if(fd != -1){
+			::close(fd);
+		}
+#endif
+	}
+
+	bool isValid() const{
+		return fd != -1;
+	}
+
+	void addWatch(const string & path, const string & prefix){
+#ifdef TARGET_LINUX
+		int wd = inotify_add_watch(fd, path.c_str(),
+			IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY |
+			IN_ATTRIB | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+		if(wd == -1){
+			ofLogWarning("ofDirectory") << "startWatching(): couldn't watch \"" << path << "\"";
+		}else{
+			prefixes[wd] = prefix;
+		}
+#endif
+	}
+
+	// removes the watches of a folder and everything inside it
+	void removeWatches(const string & prefix){
+#ifdef TARGET_LINUX
+		map<int,string>::iterator it = prefixes.begin();
+		while(it != prefixes.end()){
+			if(it->second.compare(0, prefix.size(), prefix) == 0){
+				inotify_rm_watch(fd, it->first);
+				prefixes.erase(it++);
+			}else{
+				++it;
+			}
+		}
+#endif
+	}
+
+	void clear(){
+		removeWatches("");
+		listed = false;
+	}
+
+	// returns false if some events were lost or the
+	// watched folder itself was removed or moved
+	bool readEvents(vector<Event> & events){
+		bool complete = true;
+#ifdef TARGET_LINUX
+		// aligned for inotify_event
+		unsigned long long buffer[512];
+		while(true){
+			ssize_t len = read(fd, buffer, sizeof(buffer));
+			if(len <= 0){
+				break;
+			}
+			char * ptr = (char*)buffer;
+			while(ptr < (char*)buffer + len){
+				const inotify_event * event = (const inotify_event*)ptr;
+				ptr += sizeof(inotify_event) + event->len;
+
+				if(event->mask & IN_Q_OVERFLOW){
+					complete = false;
+					continue;
+				}
+				map<int,string>::iterator prefix = prefixes.find(event->wd);
+				if(prefix == prefixes.end()){
+					continue;
+				}
+				if(event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)){
+					if(prefix->second.empty()){
+						complete = false;
+					}
+					if(event->mask & IN_IGNORED){
+						prefixes.erase(prefix);
+					}
+					continue;
+				}
+				if(event->len > 0){
+					Event e;
+					e.name = prefix->second + event->name;
+					e.mask = event->mask;
+					events.push_back(e);
+				}
+			}
+		}
+#endif
+		return complete;
+	}
+
+	int fd;
+	bool listed;
+	map<int,string> prefixes;
 };
 
 //------------------------------------------------------------------------------------------------------------
 ofDirectory::ofDirectory(){
 	showHidden = false;
+	recursive = false;
+	sorted = false;
+	filesDirty = false;
 }
 
 //------------------------------------------------------------------------------------------------------------
 ofDirectory::ofDirectory(string path){
 	showHidden = false;
+	recursive = false;
+	sorted = false;
+	filesDirty = false;
 	open(path);
 }
 
+//------------------------------------------------------------------------------------------------------------
+ofDirectory::ofDirectory(const ofDirectory & mom){
+	*this = mom;
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofDirectory & ofDirectory::operator=(const ofDirectory & mom){
+	if(this == &mom){
+		return *this;
+	}
+	myDir = mom.myDir;
+	originalDirectory = mom.originalDirectory;
+	extensions = mom.extensions;
+	entries = mom.entries;
+	files = mom.files;
+	filesDirty = mom.filesDirty;
+	showHidden = mom.showHidden;
+	recursive = mom.recursive;
+	sorted = mom.sorted;
+	// sharing the watcher would apply the same changes to both
+	// entry lists and only the first listDir() would get them
+	watcher.reset();
+	return *this;
+}
+
 //------------------------------------------------------------------------------------------------------------
 void ofDirectory::open(string path){
 	path = ofFilePath::getPathForDirectory(path);
 	originalDirectory = path;
+	entries.clear();
 	files.clear();
+	filesDirty = false;
+	sorted = false;
+	watcher.reset();
 	myDir = File(ofToDataPath(path));
 }
 
 //------------------------------------------------------------------------------------------------------------
 void ofDirectory::close(){
+	watcher.reset();
 	myDir = File();
 }
 
@@ -1089,6 +1461,9 @@ void ofDirectory::setExecutable(bool flag){
 
 //------------------------------------------------------------------------------------------------------------
 void ofDirectory::setShowHidden(bool showHidden){
+	if(watcher && showHidden != this->showHidden){
+		watcher->clear();
+	}
 	this->showHidden = showHidden;
 }
 
@@ -1229,6 +1604,10 @@ void ofDirectory::allowExt(string extension){
 		ofLogWarning("ofDirectory") << "allowExt(): wildcard extension * is deprecated";
 	}
 	extensions.push_back(toLower(extension));
+	if(watcher){
+		// the current entries were filtered with the old extensions
+		watcher->clear();
+	}
 }
 
 //------------------------------------------------------------------------------------------------------------
@@ -1237,10 +1616,120 @@ int ofDirectory::listDir(string directory){
 	return listDir();
 }
 
+//------------------------------------------------------------------------------------------------------------
+void ofDirectory::setRecursive(bool _recursive){
+	if(watcher && _recursive != recursive){
+		// the subfolders need to be listed and watched or not
+		watcher->clear();
+	}
+	recursive = _recursive;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectory::getRecursive() const{
+	return recursive;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectory::startWatching(){
+#ifdef TARGET_LINUX
+	if(!watcher){
+		watcher = shared_ptr<ofDirectoryWatcher>(new ofDirectoryWatcher);
+		if(!watcher->isValid()){
+			ofLogError("ofDirectory") << "startWatching(): couldn't initialize inotify";
+			watcher.reset();
+			return false;
+		}
+	}
+	return true;
+#else
+	ofLogWarning("ofDirectory") << "startWatching(): only supported on linux, listDir() will list everything every time";
+	return false;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectory::stopWatching(){
+	watcher.reset();
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectory::isWatching() const{
+	return watcher != NULL;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectory::isAllowed(const ofDirectoryEntry & entry) const{
+	if(entry.isHidden && !showHidden){
+		return false;
+	}
+	return extensions.empty() || ofContains(extensions, (string)"*") || ofContains(extensions, entry.extension);
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectory::listEntries(const vector<string> & folders, vector<ofDirectoryEntry> & listed, bool bRecursive) const{
+	string base = getFolderPath(myDir);
+	vector<string> level = folders;
+	while(!level.empty()){
+		// first the names in every folder of this level...
+		vector<vector<string> > names(level.size());
+		ListNames listNames(base, level, names);
+		if(level.size() > 1){
+			ofParallelFor(0, level.size(), listNames, 1);
+		}else{
+			listNames(0);
+		}
+
+		size_t first = listed.size();
+		for(size_t i = 0; i < level.size(); i++){
+			for(size_t j = 0; j < names[i].size(); j++){
+				listed.push_back(ofDirectoryEntry());
+				listed.back().name = level[i] + names[i][j];
+			}
+		}
+
+		// ...then their metadata, in parallel only when there's
+		// enough files to be worth waking up the thread pool
+		vector<char> found(listed.size(), 1);
+		ReadEntries readEntries(base, listed, found);
+		if(listed.size() - first > 256){
+			ofParallelFor(first, listed.size(), readEntries, 64);
+		}else{
+			for(size_t i = first; i < listed.size(); i++){
+				readEntries(i);
+			}
+		}
+
+		// hidden folders are not listed, neither their contents
+		vector<string> nextLevel;
+		size_t out = first;
+		for(size_t i = first; i < listed.size(); i++){
+			if(!found[i] || (listed[i].isHidden && !showHidden)){
+				continue;
+			}
+			if(bRecursive && listed[i].isDirectory && !listed[i].isLink){
+				nextLevel.push_back(listed[i].name + "/");
+			}
+			if(out != i){
+				std::swap(listed[out], listed[i]);
+			}
+			out++;
+		}
+		listed.resize(out);
+		level.swap(nextLevel);
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------
 int ofDirectory::listDir(){
+	if(watcher && watcher->listed){
+		return applyChanges();
+	}
+
+	entries.clear();
 	files.clear();
-	Path base(path());
+	filesDirty = false;
+	sorted = false;
 	if(path().empty()){
 		ofLogError("ofDirectory") << "listDir(): directory path is empty";
 		return 0;
@@ -1249,35 +1738,29 @@ int ofDirectory::listDir(){
 		ofLogError("ofDirectory") << "listDir:() source directory does not exist: \"" << myDir.path() << "\"";
 		return 0;
 	}
-	
-	// File::list(vector<File>) is broken on windows as of march 23, 2011...
-	// so we need to use File::list(vector<string>) and build a vector<File>
-	// in the future the following can be replaced width: cur.list(files);
-	vector<string>fileStrings;
-	myDir.list(fileStrings);
-	for(int i = 0; i < (int)fileStrings.size(); i++){
-		Path curPath(originalDirectory);
-		curPath.setFileName(fileStrings[i]);
-		try{
-#if __cplusplus>=201103
-			files.emplace_back(curPath.toString(), ofFile::Reference);
-#else
-			files.push_back(ofFile(curPath.toString(), ofFile::Reference));
-#endif
-		}catch(Poco::Exception & e){
-			ofLogWarning() << "couldn't add file " << e.what();
-		}
-	}
 
-	if(!showHidden){
-		ofRemove(files, hiddenFile);
+	vector<ofDirectoryEntry> listed;
+	listEntries(vector<string>(1, ""), listed, recursive);
+
+	if(watcher){
+		watcher->clear();
+		string base = getFolderPath(myDir);
+		watcher->addWatch(base, "");
+		for(size_t i = 0; i < listed.size(); i++){
+			if(recursive && listed[i].isDirectory && !listed[i].isLink){
+				watcher->addWatch(base + listed[i].name, listed[i].name + "/");
+			}
+		}
+		watcher->listed = true;
 	}
 
-	if(!extensions.empty() && !ofContains(extensions, (string)"*")){
-		ExtensionComparator extensionFilter;
-		extensionFilter.extensions = &extensions;
-		ofRemove(files, extensionFilter);
+	entries.reserve(listed.size());
+	for(size_t i = 0; i < listed.size(); i++){
+		if(isAllowed(listed[i])){
+			entries.push_back(listed[i]);
+		}
 	}
+	filesDirty = true;
 
 	if(ofGetLogLevel() == OF_LOG_VERBOSE){
 		for(int i = 0; i < (int)size(); i++){
@@ -1289,6 +1772,108 @@ int ofDirectory::listDir(){
 	return size();
 }
 
+//------------------------------------------------------------------------------------------------------------
+int ofDirectory::applyChanges(){
+#ifdef TARGET_LINUX
+	vector<ofDirectoryWatcher::Event> events;
+	if(!watcher->readEvents(events)){
+		// some changes were lost, start again
+		watcher->clear();
+		return listDir();
+	}
+	if(events.empty()){
+		return size();
+	}
+
+	// every name that changed is read again from disk at the end,
+	// so many events for the same file only cost one stat
+	std::set<string> changed;
+	vector<string> removedFolders;
+	vector<string> addedFolders;
+	for(size_t i = 0; i < events.size(); i++){
+		changed.insert(events[i].name);
+		if(recursive && (events[i].mask & IN_ISDIR)){
+			if(events[i].mask & (IN_DELETE | IN_MOVED_FROM)){
+				removedFolders.push_back(events[i].name + "/");
+			}
+			if(events[i].mask & (IN_CREATE | IN_MOVED_TO)){
+				addedFolders.push_back(events[i].name);
+			}
+		}
+	}
+
+	unordered_map<string,size_t> index;
+	for(size_t i = 0; i < entries.size(); i++){
+		index[entries[i].name] = i;
+	}
+	vector<char> removed(entries.size(), 0);
+
+	// the contents of removed folders are gone without an event for each file
+	for(size_t i = 0; i < removedFolders.size(); i++){
+		watcher->removeWatches(removedFolders[i]);
+		for(size_t j = 0; j < entries.size(); j++){
+			if(entries[j].name.compare(0, removedFolders[i].size(), removedFolders[i]) == 0){
+				removed[j] = 1;
+			}
+		}
+	}
+
+	// and folders created or moved in can already have files
+	string base = getFolderPath(myDir);
+	vector<ofDirectoryEntry> listed;
+	for(size_t i = 0; i < addedFolders.size(); i++){
+		ofDirectoryEntry folder;
+		if(!readEntryInfo(base, addedFolders[i], folder) || !folder.isDirectory || folder.isLink || (folder.isHidden && !showHidden)){
+			continue;
+		}
+		// watch before listing so nothing created in between is missed
+		watcher->addWatch(base + addedFolders[i], addedFolders[i] + "/");
+		size_t first = listed.size();
+		listEntries(vector<string>(1, addedFolders[i] + "/"), listed, true);
+		for(size_t j = first; j < listed.size(); j++){
+			if(listed[j].isDirectory && !listed[j].isLink){
+				watcher->addWatch(base + listed[j].name, listed[j].name + "/");
+			}
+			changed.insert(listed[j].name);
+		}
+	}
+
+	for(std::set<string>::iterator it = changed.begin(); it != changed.end(); ++it){
+		ofDirectoryEntry entry;
+		bool exists = readEntryInfo(base, *it, entry) && isAllowed(entry);
+		unordered_map<string,size_t>::iterator found = index.find(*it);
+		if(found != index.end()){
+			if(exists){
+				entries[found->second] = entry;
+				removed[found->second] = 0;
+			}else{
+				removed[found->second] = 1;
+			}
+		}else if(exists){
+			index[entry.name] = entries.size();
+			entries.push_back(entry);
+			removed.push_back(0);
+		}
+	}
+
+	size_t out = 0;
+	for(size_t i = 0; i < entries.size(); i++){
+		if(!removed[i]){
+			if(out != i){
+				std::swap(entries[out], entries[i]);
+			}
+			out++;
+		}
+	}
+	entries.resize(out);
+	filesDirty = true;
+	if(sorted){
+		sort();
+	}
+#endif
+	return size();
+}
+
 //------------------------------------------------------------------------------------------------------------
 string ofDirectory::getOriginalDirectory(){
 	return originalDirectory;
@@ -1296,8 +1881,7 @@ string ofDirectory::getOriginalDirectory(){
 
 //------------------------------------------------------------------------------------------------------------
 string ofDirectory::getName(unsigned int position){
-	Path cur(files.at(position).path());
-	return cur.getFileName();
+	return entries.at(position).name;
 }
 
 //------------------------------------------------------------------------------------------------------------
@@ -1307,9 +1891,7 @@ string ofDirectory::getPath(unsigned int position){
 
 //------------------------------------------------------------------------------------------------------------
 ofFile ofDirectory::getFile(unsigned int position, ofFile::Mode mode, bool binary){
-	ofFile file = files[position];
-	file.changeMode(mode, binary);
-	return file;
+	return ofFile(getPath(position), mode, binary);
 }
 
 ofFile ofDirectory::operator[](unsigned int position){
@@ -1318,38 +1900,56 @@ ofFile ofDirectory::operator[](unsigned int position){
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>ofDirectory::getFiles(){
+	updateFiles();
 	return files;
 }
 
 //------------------------------------------------------------------------------------------------------------
-bool ofDirectory::getShowHidden(){
-	return showHidden;
+const ofDirectoryEntry & ofDirectory::getEntry(unsigned int position) const{
+	return entries.at(position);
 }
 
 //------------------------------------------------------------------------------------------------------------
-void ofDirectory::reset(){
-	close();
+const vector<ofDirectoryEntry> & ofDirectory::getEntries() const{
+	return entries;
 }
 
 //------------------------------------------------------------------------------------------------------------
-bool natural(const ofFile& a, const ofFile& b) {
-	string aname = a.getBaseName(), bname = b.getBaseName();
-	int aint = ofToInt(aname), bint = ofToInt(bname);
-	if(ofToString(aint) == aname && ofToString(bint) == bname) {
-		return aint < bint;
-	} else {
-		return a < b;
+void ofDirectory::updateFiles() const{
+	if(filesDirty){
+		files.clear();
+		files.reserve(entries.size());
+		for(size_t i = 0; i < entries.size(); i++){
+#if __cplusplus>=201103
+			files.emplace_back(originalDirectory + entries[i].name, ofFile::Reference);
+#else
+			files.push_back(ofFile(originalDirectory + entries[i].name, ofFile::Reference));
+#endif
+		}
+		filesDirty = false;
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectory::getShowHidden(){
+	return showHidden;
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectory::reset(){
+	close();
+}
+
 //------------------------------------------------------------------------------------------------------------
 void ofDirectory::sort(){
-	ofSort(files, natural);
+	ofSort(entries, naturalEntryLess);
+	filesDirty = true;
+	sorted = true;
 }
 
 //------------------------------------------------------------------------------------------------------------
 unsigned int ofDirectory::size(){
-	return files.size();
+	return entries.size();
 }
 
 //------------------------------------------------------------------------------------------------------------
@@ -1469,41 +2069,49 @@ bool ofDirectory::operator>=(const ofDirectory & dir){
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::iterator ofDirectory::begin(){
+	updateFiles();
 	return files.begin();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::iterator ofDirectory::end(){
+	updateFiles();
 	return files.end();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::const_iterator ofDirectory::begin() const{
+	updateFiles();
 	return files.begin();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::const_iterator ofDirectory::end() const{
+	updateFiles();
 	return files.end();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::reverse_iterator ofDirectory::rbegin(){
+	updateFiles();
 	return files.rbegin();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::reverse_iterator ofDirectory::rend(){
+	updateFiles();
 	return files.rend();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::const_reverse_iterator ofDirectory::rbegin() const{
+	updateFiles();
 	return files.rbegin();
 }
 
 //------------------------------------------------------------------------------------------------------------
 vector<ofFile>::const_reverse_iterator ofDirectory::rend() const{
+	updateFiles();
 	return files.rend();
 }
 
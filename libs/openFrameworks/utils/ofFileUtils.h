@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofTypes.h"
 #include "Poco/File.h"
+#include "Poco/DirectoryIterator.h"
 
 //----------------------------------------------------------
 // ofBuffer
@@ -239,12 +241,74 @@ private:
 	bool binary;
 };
 
+//----------------------------------------------------------
+// ofDirectoryEntry
+//----------------------------------------------------------
+
+// metadata of a file read once while listing a directory,
+// so it can be used later without accessing the disk again
+class ofDirectoryEntry{
+public:
+	ofDirectoryEntry();
+
+	string name;        // path relative to the listed directory, e.g. "image.png" or "sub/image.png"
+	string extension;   // lower case, without the dot
+	unsigned long long size;
+	time_t modified;
+	bool isDirectory;
+	bool isHidden;
+	bool isLink;
+};
+
+//----------------------------------------------------------
+// ofDirectoryIterator
+//----------------------------------------------------------
+
+// reads the contents of a directory one entry at a time instead
+// of building the whole list first, useful for huge folders:
+//
+//	ofDirectoryIterator it("images", true);
+//	ofDirectoryEntry entry;
+//	while(it.next(entry)){
+//		...
+//	}
+class ofDirectoryIterator{
+public:
+	ofDirectoryIterator();
+	ofDirectoryIterator(string path, bool recursive = false, bool bRelativeToData = true);
+
+	bool open(string path, bool recursive = false, bool bRelativeToData = true);
+	void close();
+	void setShowHidden(bool showHidden);
+
+	// fills entry with the next file or folder, folders come before their
+	// contents when recursive. returns false once there's nothing left
+	bool next(ofDirectoryEntry & entry);
+
+private:
+	string root;
+	bool recursive;
+	bool showHidden;
+	vector<Poco::DirectoryIterator> iterators;
+	vector<string> prefixes;
+};
+
+//----------------------------------------------------------
+// ofDirectory
+//----------------------------------------------------------
+
+class ofDirectoryWatcher;
+
 class ofDirectory{
 
 public:
 	ofDirectory();
 	ofDirectory(string path);
 
+	// copies don't watch the directory even if the original does
+	ofDirectory(const ofDirectory & mom);
+	ofDirectory & operator=(const ofDirectory & mom);
+
 	void open(string path);
 	void close();
 	bool create(bool recursive = false);
@@ -276,6 +340,23 @@ public:
 	// dirList operations
 	//-------------------
 	void allowExt(string extension);
+
+	// lists the contents of subfolders too, names are then relative
+	// paths like "sub/image.png". folders are listed in parallel
+	// using the thread pool when it's available
+	void setRecursive(bool recursive);
+	bool getRecursive() const;
+
+	// linux only: keeps listening to changes in the directory,
+	// after the first listDir() following calls only apply the
+	// files that were created, deleted or modified since the last
+	// one instead of listing everything again. changing the
+	// allowed extensions, hidden files or recursion lists
+	// everything again on the next call
+	bool startWatching();
+	void stopWatching();
+	bool isWatching() const;
+
 	int listDir(string path);
 	int listDir();
 
@@ -285,12 +366,16 @@ public:
 	ofFile getFile(unsigned int position, ofFile::Mode mode=ofFile::Reference, bool binary=false);
 	vector<ofFile> getFiles();
 
+	// size, modification time... as read while listing
+	const ofDirectoryEntry & getEntry(unsigned int position) const;
+	const vector<ofDirectoryEntry> & getEntries() const;
+
 	ofFile operator[](unsigned int position);
 
 	bool getShowHidden();
 
 	void reset(); //equivalent to close, just here for bw compatibility with ofxDirList
-	void sort();
+	void sort(); // natural order, "img2.png" goes before "img10.png"
 
 	unsigned int size();
 	int numFiles(); // numFiles is deprecated, use size()
@@ -328,11 +413,21 @@ public:
 	vector<ofFile>::const_reverse_iterator rend() const;
 
 private:
+	bool isAllowed(const ofDirectoryEntry & entry) const;
+	void listEntries(const vector<string> & folders, vector<ofDirectoryEntry> & listed, bool bRecursive) const;
+	int applyChanges();
+	void updateFiles() const;
+
 	Poco::File myDir;
 	string originalDirectory;
 	vector <string> extensions;
-	vector <ofFile> files;
+	vector <ofDirectoryEntry> entries;
+	mutable vector <ofFile> files; // built from entries only when they are used
+	mutable bool filesDirty;
 	bool showHidden;
+	bool recursive;
+	bool sorted;
+	shared_ptr<ofDirectoryWatcher> watcher;
 
 };
 
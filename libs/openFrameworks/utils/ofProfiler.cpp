@@ -0,0 +1,392 @@
+#include "ofProfiler.h"
+#include "ofTypes.h"
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include <set>
+#include <iomanip>
+#include <limits>
+
+#ifndef TARGET_NO_THREADS
+	#include "Poco/Thread.h"
+	#ifndef TARGET_WIN32
+		#include <pthread.h>
+	#endif
+#endif
+
+void ofGetMonotonicTime(unsigned long long & seconds, unsigned long long & nanoseconds);
+
+namespace{
+	typedef struct{
+		const char * name;
+		unsigned long long start;
+		unsigned long long end;
+	} ofProfilerEvent;
+
+	// ring buffer of the events recorded by one thread. only the owner
+	// thread writes to it, other threads can export the events while it
+	// keeps recording: every slot is written before the count of written
+	// events is published and the events that could have been overwritten
+	// while copying them are discarded. resizing reallocates the slots so
+	// other threads only request it and the owner applies it, under the
+	// mutex that also protects copying the events
+	class ofProfilerThreadBuffer{
+	public:
+		ofProfilerThreadBuffer(size_t size, int id, const string & name)
+		:id(id)
+		,name(name)
+		,finished(false)
+		,slots(new Slot[size])
+		,size(size)
+		,written(0)
+		,cleared(0)
+		,requestedSize(size){}
+
+		~ofProfilerThreadBuffer(){
+			delete[] slots;
+		}
+
+		// only called from the thread that owns the buffer
+		void add(const char * eventName, unsigned long long start, unsigned long long end){
+#ifdef OF_USING_THREAD_POOL
+			if(requestedSize.load(std::memory_order_relaxed) != size){
+				resize();
+			}
+			if(size == 0) return;
+			size_t index = written.load(std::memory_order_relaxed);
+			Slot & slot = slots[index % size];
+			slot.name.store(eventName, std::memory_order_relaxed);
+			slot.start.store(start, std::memory_order_relaxed);
+			slot.end.store(end, std::memory_order_relaxed);
+			written.store(index + 1, std::memory_order_release);
+#else
+			ofScopedLock lock(mutex);
+			if(requestedSize != size){
+				resizeLocked();
+			}
+			if(size == 0) return;
+			Slot & slot = slots[written % size];
+			slot.name = eventName;
+			slot.start = start;
+			slot.end = end;
+			written++;
+#endif
+		}
+
+		// discards the events recorded until now
+		void clear(){
+			ofScopedLock lock(mutex);
+			cleared = (size_t)written;
+		}
+
+		// the new size is applied by the owner thread the next time it
+		// records an event or straight away if the thread finished
+		void requestSize(size_t newSize){
+			ofScopedLock lock(mutex);
+			requestedSize = newSize;
+			cleared = (size_t)written;
+			if(finished){
+				resizeLocked();
+			}
+		}
+
+		// copies the events from the oldest to the newest
+		void copyEvents(vector<ofProfilerEvent> & dst){
+			ofScopedLock lock(mutex);
+			dst.clear();
+			if(size == 0) return;
+#ifdef OF_USING_THREAD_POOL
+			size_t end = written.load(std::memory_order_acquire);
+			size_t begin = std::min(end, std::max((size_t)cleared, end > size ? end - size : 0));
+			dst.resize(end - begin);
+			for(size_t i = begin; i < end; i++){
+				const Slot & slot = slots[i % size];
+				ofProfilerEvent & event = dst[i - begin];
+				event.name = slot.name.load(std::memory_order_relaxed);
+				event.start = slot.start.load(std::memory_order_relaxed);
+				event.end = slot.end.load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// the slots of events older than these, and the one being
+			// written now, could have been overwritten while copying
+			size_t after = written.load(std::memory_order_relaxed);
+			size_t valid = after + 1 > size ? after + 1 - size : 0;
+			if(valid > begin){
+				dst.erase(dst.begin(), dst.begin() + std::min(valid - begin, dst.size()));
+			}
+#else
+			size_t begin = std::max(cleared, written > size ? written - size : 0);
+			dst.resize(written - begin);
+			for(size_t i = begin; i < written; i++){
+				const Slot & slot = slots[i % size];
+				ofProfilerEvent & event = dst[i - begin];
+				event.name = slot.name;
+				event.start = slot.start;
+				event.end = slot.end;
+			}
+#endif
+		}
+
+		int id;
+		string name;
+		bool finished;
+
+	private:
+		void resize(){
+			ofScopedLock lock(mutex);
+			resizeLocked();
+		}
+
+		void resizeLocked(){
+			delete[] slots;
+			size = requestedSize;
+			slots = new Slot[size];
+			written = 0;
+			cleared = 0;
+		}
+
+#ifdef OF_USING_THREAD_POOL
+		struct Slot{
+			std::atomic<const char *> name;
+			std::atomic<unsigned long long> start;
+			std::atomic<unsigned long long> end;
+		};
+		Slot * slots;
+		size_t size;
+		std::atomic<size_t> written;
+		std::atomic<size_t> cleared;
+		std::atomic<size_t> requestedSize;
+#else
+		typedef ofProfilerEvent Slot;
+		Slot * slots;
+		size_t size;
+		size_t written;
+		size_t cleared;
+		size_t requestedSize;
+#endif
+		ofMutex mutex;
+	};
+
+	ofMutex & getProfilerMutex(){
+		static ofMutex * mutex = new ofMutex;
+		return *mutex;
+	}
+
+	// buffers are never deleted while the application runs so
+	// threads can keep a raw pointer to their own one. buffers
+	// of threads that already finished are deleted on clear()
+	vector<ofProfilerThreadBuffer*> & getThreadBuffers(){
+		static vector<ofProfilerThreadBuffer*> * buffers = new vector<ofProfilerThreadBuffer*>;
+		return *buffers;
+	}
+
+	size_t & getBufferSizeRef(){
+		static size_t bufferSize = 65536;
+		return bufferSize;
+	}
+
+#if defined(TARGET_NO_THREADS)
+	ofProfilerThreadBuffer * currentBuffer = NULL;
+
+	ofProfilerThreadBuffer * getCurrentBuffer(){
+		return currentBuffer;
+	}
+
+	void setCurrentBuffer(ofProfilerThreadBuffer * buffer){
+		currentBuffer = buffer;
+	}
+#elif defined(TARGET_WIN32)
+	DWORD getTlsIndex(){
+		static DWORD index = TlsAlloc();
+		return index;
+	}
+
+	ofProfilerThreadBuffer * getCurrentBuffer(){
+		return (ofProfilerThreadBuffer*)TlsGetValue(getTlsIndex());
+	}
+
+	void setCurrentBuffer(ofProfilerThreadBuffer * buffer){
+		TlsSetValue(getTlsIndex(), buffer);
+	}
+#else
+	void markFinished(void * buffer){
+		ofScopedLock lock(getProfilerMutex());
+		((ofProfilerThreadBuffer*)buffer)->finished = true;
+	}
+
+	pthread_key_t & getTlsKey(){
+		static pthread_key_t key;
+		static bool created = pthread_key_create(&key, markFinished) == 0;
+		(void)created;
+		return key;
+	}
+
+	ofProfilerThreadBuffer * getCurrentBuffer(){
+		return (ofProfilerThreadBuffer*)pthread_getspecific(getTlsKey());
+	}
+
+	void setCurrentBuffer(ofProfilerThreadBuffer * buffer){
+		pthread_setspecific(getTlsKey(), buffer);
+	}
+#endif
+
+	ofProfilerThreadBuffer * createCurrentBuffer(){
+		string name;
+#ifndef TARGET_NO_THREADS
+		Poco::Thread * thread = Poco::Thread::current();
+		if(thread){
+			name = thread->getName();
+		}else
+#endif
+		{
+			name = "main";
+		}
+
+		ofScopedLock lock(getProfilerMutex());
+		vector<ofProfilerThreadBuffer*> & buffers = getThreadBuffers();
+		int id = buffers.empty() ? 1 : buffers.back()->id + 1;
+		ofProfilerThreadBuffer * buffer = new ofProfilerThreadBuffer(getBufferSizeRef(), id, name);
+		buffers.push_back(buffer);
+		setCurrentBuffer(buffer);
+		return buffer;
+	}
+
+	ofProfilerThreadBuffer & getOrCreateCurrentBuffer(){
+		ofProfilerThreadBuffer * buffer = getCurrentBuffer();
+		if(!buffer){
+			buffer = createCurrentBuffer();
+		}
+		return *buffer;
+	}
+
+	string escapeJson(const string & str){
+		string escaped;
+		escaped.reserve(str.size());
+		for(size_t i = 0; i < str.size(); i++){
+			char c = str[i];
+			if(c == '"' || c == '\\'){
+				escaped += '\\';
+				escaped += c;
+			}else if((unsigned char)c < 0x20){
+				escaped += ' ';
+			}else{
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+}
+
+#ifdef OF_USING_THREAD_POOL
+std::atomic<bool> ofProfiler::enabled(false);
+#else
+bool ofProfiler::enabled = false;
+#endif
+
+//--------------------------------------------------
+void ofProfiler::setEnabled(bool enabled){
+	ofProfiler::enabled = enabled;
+}
+
+//--------------------------------------------------
+void ofProfiler::setBufferSize(size_t eventsPerThread){
+	ofScopedLock lock(getProfilerMutex());
+	getBufferSizeRef() = eventsPerThread;
+	vector<ofProfilerThreadBuffer*> & buffers = getThreadBuffers();
+	for(size_t i = 0; i < buffers.size(); i++){
+		buffers[i]->requestSize(eventsPerThread);
+	}
+}
+
+//--------------------------------------------------
+size_t ofProfiler::getBufferSize(){
+	ofScopedLock lock(getProfilerMutex());
+	return getBufferSizeRef();
+}
+
+//--------------------------------------------------
+void ofProfiler::clear(){
+	ofScopedLock lock(getProfilerMutex());
+	vector<ofProfilerThreadBuffer*> & buffers = getThreadBuffers();
+	for(size_t i = 0; i < buffers.size();){
+		if(buffers[i]->finished){
+			delete buffers[i];
+			buffers.erase(buffers.begin() + i);
+		}else{
+			buffers[i]->clear();
+			i++;
+		}
+	}
+}
+
+//--------------------------------------------------
+void ofProfiler::addEvent(const char * name, unsigned long long startNanos, unsigned long long endNanos){
+	getOrCreateCurrentBuffer().add(name, startNanos, endNanos);
+}
+
+//--------------------------------------------------
+unsigned long long ofProfiler::getTimestamp(){
+	unsigned long long seconds, nanos;
+	ofGetMonotonicTime(seconds, nanos);
+	return seconds * 1000000000ULL + nanos;
+}
+
+//--------------------------------------------------
+void ofProfiler::setThreadName(const string & name){
+	ofProfilerThreadBuffer & buffer = getOrCreateCurrentBuffer();
+	ofScopedLock lock(getProfilerMutex());
+	buffer.name = name;
+}
+
+//--------------------------------------------------
+string ofProfiler::getChromeTrace(){
+	ofScopedLock lock(getProfilerMutex());
+	vector<ofProfilerThreadBuffer*> & buffers = getThreadBuffers();
+
+	vector<vector<ofProfilerEvent> > events(buffers.size());
+	unsigned long long origin = std::numeric_limits<unsigned long long>::max();
+	for(size_t i = 0; i < buffers.size(); i++){
+		buffers[i]->copyEvents(events[i]);
+		for(size_t j = 0; j < events[i].size(); j++){
+			origin = std::min(origin, events[i][j].start);
+		}
+	}
+
+	// timestamps in the trace format are in microseconds
+	ostringstream trace;
+	trace << std::fixed << std::setprecision(3);
+	trace << "{\"traceEvents\":[";
+	bool first = true;
+	for(size_t i = 0; i < buffers.size(); i++){
+		if(!first) trace << ",";
+		first = false;
+		trace << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffers[i]->id
+		      << ",\"args\":{\"name\":\"" << escapeJson(buffers[i]->name) << "\"}}";
+		for(size_t j = 0; j < events[i].size(); j++){
+			const ofProfilerEvent & event = events[i][j];
+			trace << ",\n{\"name\":\"" << escapeJson(event.name ? event.name : "") << "\""
+			      << ",\"cat\":\"of\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffers[i]->id
+			      << ",\"ts\":" << (event.start - origin) / 1000.
+			      << ",\"dur\":" << (event.end - event.start) / 1000. << "}";
+		}
+	}
+	trace << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return trace.str();
+}
+
+//--------------------------------------------------
+bool ofProfiler::saveChromeTrace(const string & path){
+	ofBuffer buffer(getChromeTrace());
+	if(!ofBufferToFile(path, buffer)){
+		ofLogError("ofProfiler") << "saveChromeTrace(): couldn't save trace to \"" << path << "\"";
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------
+const char * ofProfiler::intern(const string & name){
+	static set<string> * names = new set<string>;
+	ofScopedLock lock(getProfilerMutex());
+	return names->insert(name).first->c_str();
+}
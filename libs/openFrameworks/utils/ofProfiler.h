@@ -0,0 +1,135 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofThreadPool.h"
+
+#ifdef OF_USING_THREAD_POOL
+#include <atomic>
+#endif
+
+/// \class ofProfiler
+/// \brief Records how long each part of a frame takes.
+///
+/// When enabled, the main loop and ofCoreEvents timestamp every phase of
+/// the frame: update, draw, the wait to keep the frame rate, swapping
+/// buffers, polling events and every event notification. Any other block
+/// of code can be measured with a scoped marker:
+///
+///     void ofApp::update(){
+///         OF_PROFILE_SCOPE("particles");
+///         particles.update();
+///     }
+///
+/// Each thread records to its own ring buffer which keeps the latest
+/// events, by default the last 65536 per thread. Recording an event
+/// doesn't lock, when compiling with c++11, and exporting doesn't stop
+/// other threads from recording. The recorded events can
+/// be saved in the Chrome trace format and inspected by opening
+/// chrome://tracing or https://ui.perfetto.dev:
+///
+///     ofProfiler::setEnabled(true);
+///     ...
+///     ofProfiler::saveChromeTrace("trace.json");
+///
+/// While disabled, which is the default, markers only check a flag.
+class ofProfiler{
+public:
+	/// \brief Starts or stops recording events.
+	static void setEnabled(bool enabled);
+
+	/// \returns true if events are being recorded.
+	static bool isEnabled(){
+		return enabled;
+	}
+
+	/// \brief Sets how many events each thread keeps before overwriting the oldest.
+	///
+	/// Clears all the events recorded until now.
+	static void setBufferSize(size_t eventsPerThread);
+
+	/// \returns the number of events each thread keeps.
+	static size_t getBufferSize();
+
+	/// \brief Discards all the recorded events.
+	static void clear();
+
+	/// \brief Records an event that started and ended at the passed times.
+	///
+	/// Usually called through ofProfilerScope or OF_PROFILE_SCOPE.
+	///
+	/// \param name Name of the event, the pointer is stored, it has to
+	/// outlive the profiler, usually a string literal.
+	/// \param startNanos Start time as returned by getTimestamp().
+	/// \param endNanos End time as returned by getTimestamp().
+	static void addEvent(const char * name, unsigned long long startNanos, unsigned long long endNanos);
+
+	/// \returns the time used to timestamp events, in nanoseconds.
+	static unsigned long long getTimestamp();
+
+	/// \brief Names the calling thread in the exported traces.
+	///
+	/// ofThreads use their Poco thread name and the main thread is called
+	/// main by default.
+	static void setThreadName(const string & name);
+
+	/// \returns all the recorded events in the Chrome trace event format.
+	static string getChromeTrace();
+
+	/// \brief Saves the recorded events in the Chrome trace event format.
+	/// \param path Path of the json file to save to.
+	/// \returns true if the file was saved.
+	static bool saveChromeTrace(const string & path);
+
+	/// \brief Returns a pointer to a copy of name that lives as long as the application.
+	///
+	/// Allows to use names created at runtime with addEvent().
+	static const char * intern(const string & name);
+
+private:
+#ifdef OF_USING_THREAD_POOL
+	static std::atomic<bool> enabled;
+#else
+	static bool enabled;
+#endif
+};
+
+/// \class ofProfilerScope
+/// \brief Records an event from its construction until it goes out of scope.
+///
+/// Does nothing if the profiler was disabled when it was created.
+class ofProfilerScope{
+public:
+	ofProfilerScope(const char * name)
+	:name(name)
+	,start(ofProfiler::isEnabled() ? ofProfiler::getTimestamp() : 0){}
+
+	ofProfilerScope(const string & name)
+	:name(NULL)
+	,start(0){
+		if(ofProfiler::isEnabled()){
+			this->name = ofProfiler::intern(name);
+			start = ofProfiler::getTimestamp();
+		}
+	}
+
+	~ofProfilerScope(){
+		if(start){
+			ofProfiler::addEvent(name, start, ofProfiler::getTimestamp());
+		}
+	}
+
+private:
+	ofProfilerScope(const ofProfilerScope &);
+	ofProfilerScope & operator=(const ofProfilerScope &);
+
+	const char * name;
+	unsigned long long start;
+};
+
+/// \cond INTERNAL
+#define OF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OF_PROFILE_CONCAT(a, b) OF_PROFILE_CONCAT_IMPL(a, b)
+/// \endcond
+
+/// \brief Records an event with the passed name until the end of the current scope.
+#define OF_PROFILE_SCOPE(name) ofProfilerScope OF_PROFILE_CONCAT(ofProfilerScope_, __LINE__)(name)
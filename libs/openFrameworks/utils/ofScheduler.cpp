@@ -0,0 +1,201 @@
+#include "ofScheduler.h"
+#include "ofLog.h"
+
+#ifdef OF_USING_SCHEDULER
+
+// maximum time the thread sleeps before checking if any
+// callback with an earlier deadline has been added
+#define OF_SCHEDULER_MAX_SLEEP 10000000ull
+
+//-------------------------------------------------
+ofScheduler::ofScheduler()
+:nextId(0)
+,spinNanos(0)
+,runningId(-1){
+	thread.setName("ofScheduler");
+}
+
+//-------------------------------------------------
+ofScheduler::~ofScheduler(){
+	waitForThread(true);
+}
+
+//-------------------------------------------------
+int ofScheduler::add(unsigned long long periodNanos, std::function<void()> callback){
+	if(periodNanos == 0){
+		ofLogError("ofScheduler") << "add(): period can't be 0";
+		return -1;
+	}
+
+	Task task;
+	task.period = periodNanos;
+	task.nextWakeTime = ofTimer::getMonotonicNanos() + periodNanos;
+	task.callback = callback;
+	task.stats.numPeriods = 0;
+	task.stats.numOverruns = 0;
+	task.stats.numMissedPeriods = 0;
+	task.stats.lastLatencyNanos = 0;
+	task.stats.maxLatencyNanos = 0;
+	task.stats.averageLatencyNanos = 0;
+
+	int id;
+	{
+		ofScopedLock lock(mutex);
+		id = task.id = nextId++;
+		tasks.push_back(task);
+	}
+	if(!isThreadRunning()){
+		startThread();
+	}
+	return id;
+}
+
+//-------------------------------------------------
+void ofScheduler::remove(int id){
+	ofScopedLock lock(mutex);
+	for(size_t i = 0; i < tasks.size(); i++){
+		if(tasks[i].id == id){
+			tasks.erase(tasks.begin() + i);
+			break;
+		}
+	}
+
+	// a callback removing itself would wait for ever
+	if(!isCurrentThread()){
+		while(runningId == id){
+			callbackFinished.wait(mutex);
+		}
+	}
+}
+
+//-------------------------------------------------
+bool ofScheduler::hasTask(int id) const{
+	for(size_t i = 0; i < tasks.size(); i++){
+		if(tasks[i].id == id){
+			return true;
+		}
+	}
+	return false;
+}
+
+//-------------------------------------------------
+void ofScheduler::setSpinTime(unsigned long long nanoseconds){
+	ofScopedLock lock(mutex);
+	spinNanos = nanoseconds;
+}
+
+//-------------------------------------------------
+unsigned long long ofScheduler::getSpinTime() const{
+	ofScopedLock lock(mutex);
+	return spinNanos;
+}
+
+//-------------------------------------------------
+ofTimerStats ofScheduler::getStats(int id) const{
+	ofScopedLock lock(mutex);
+	for(size_t i = 0; i < tasks.size(); i++){
+		if(tasks[i].id == id){
+			return tasks[i].stats;
+		}
+	}
+	ofLogError("ofScheduler") << "getStats(): no callback with id " << id;
+	return ofTimerStats();
+}
+
+//-------------------------------------------------
+void ofScheduler::resetStats(int id){
+	ofScopedLock lock(mutex);
+	for(size_t i = 0; i < tasks.size(); i++){
+		if(tasks[i].id == id){
+			ofTimerStats & stats = tasks[i].stats;
+			stats.numPeriods = 0;
+			stats.numOverruns = 0;
+			stats.numMissedPeriods = 0;
+			stats.lastLatencyNanos = 0;
+			stats.maxLatencyNanos = 0;
+			stats.averageLatencyNanos = 0;
+		}
+	}
+}
+
+//-------------------------------------------------
+void ofScheduler::threadedFunction(){
+	vector<pair<int, std::function<void()> > > due;
+	while(isThreadRunning()){
+		unsigned long long deadline = 0;
+		unsigned long long spin;
+		{
+			ofScopedLock lock(mutex);
+			for(size_t i = 0; i < tasks.size(); i++){
+				if(deadline == 0 || tasks[i].nextWakeTime < deadline){
+					deadline = tasks[i].nextWakeTime;
+				}
+			}
+			spin = spinNanos;
+		}
+
+		unsigned long long now = ofTimer::getMonotonicNanos();
+		if(deadline == 0 || deadline > now + spin + OF_SCHEDULER_MAX_SLEEP){
+			timer.sleepUntil(now + OF_SCHEDULER_MAX_SLEEP);
+			continue;
+		}
+		// same as ofTimer::waitUntil() but reusing the timer
+		if(deadline > now + spin){
+			timer.sleepUntil(deadline - spin);
+		}
+		while(ofTimer::getMonotonicNanos() < deadline){
+			// busy wait for the rest
+		}
+
+		{
+			ofScopedLock lock(mutex);
+			now = ofTimer::getMonotonicNanos();
+			for(size_t i = 0; i < tasks.size(); i++){
+				Task & task = tasks[i];
+				if(task.nextWakeTime > now){
+					continue;
+				}
+
+				// a deadline that passed more than a period ago
+				// means the previous callbacks took too long
+				long long latency = now - task.nextWakeTime;
+				ofTimerStats & stats = task.stats;
+				stats.numPeriods++;
+				stats.lastLatencyNanos = latency;
+				stats.maxLatencyNanos = std::max(stats.maxLatencyNanos, latency);
+				stats.averageLatencyNanos += (latency - stats.averageLatencyNanos) / stats.numPeriods;
+
+				task.nextWakeTime += task.period;
+				if(task.nextWakeTime <= now){
+					unsigned long long missed = (now - task.nextWakeTime) / task.period + 1;
+					stats.numOverruns++;
+					stats.numMissedPeriods += missed;
+					task.nextWakeTime += missed * task.period;
+				}
+				due.push_back(make_pair(task.id, task.callback));
+			}
+		}
+
+		// the callbacks run without the lock so they can add or remove
+		// tasks, the ones removed since they were due are skipped and
+		// remove() waits for the one that is running
+		for(size_t i = 0; i < due.size(); i++){
+			{
+				ofScopedLock lock(mutex);
+				if(!hasTask(due[i].first)){
+					continue;
+				}
+				runningId = due[i].first;
+			}
+			due[i].second();
+			{
+				ofScopedLock lock(mutex);
+				runningId = -1;
+			}
+			callbackFinished.notify_all();
+		}
+		due.clear();
+	}
+}
+
+#endif
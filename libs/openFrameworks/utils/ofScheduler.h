@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ofConstants.h"
+
+#if !defined(TARGET_NO_THREADS) && (__cplusplus>=201103L || defined(_MSC_VER))
+#define OF_USING_SCHEDULER
+
+#include "ofThread.h"
+#include "ofTimer.h"
+#include <functional>
+#include <condition_variable>
+
+/// \class ofScheduler
+/// \brief Calls functions periodically from its own thread with precise timing.
+///
+/// Each callback has its own period. Deadlines are absolute, so they don't
+/// drift even if a callback takes a while to run, and the thread waits for
+/// them the same way ofTimer does, including busy waiting for the last part
+/// of the wait if a spin time is set:
+///
+///     ofScheduler scheduler;
+///     scheduler.setSpinTime(200000);
+///     int id = scheduler.add(1000000, [this]{ // every millisecond
+///         sendDmxFrame();
+///     });
+///
+/// All the callbacks run one after another in the scheduler thread, so they
+/// should be short and protect any data shared with other threads. A
+/// callback that takes longer than its period counts as an overrun in its
+/// stats and the periods it missed are skipped instead of run in a burst.
+///
+/// Only available when compiling with c++11 support, in that case
+/// OF_USING_SCHEDULER is defined.
+class ofScheduler: public ofThread{
+public:
+	ofScheduler();
+
+	/// \brief Stops the thread, no callbacks are called after it returns.
+	~ofScheduler();
+
+	/// \brief Calls callback every periodNanos nanoseconds starting one period from now.
+	///
+	/// Starts the scheduler thread if it wasn't running yet.
+	///
+	/// \returns an id that can be used to remove the callback or get its stats.
+	int add(unsigned long long periodNanos, std::function<void()> callback);
+
+	/// \brief Stops calling the callback with the passed id.
+	///
+	/// If the callback is running in the scheduler thread at the same time
+	/// this waits for it to finish, so it's not called anymore once remove()
+	/// returns. Callbacks can remove themselves, in that case it returns
+	/// straight away.
+	void remove(int id);
+
+	/// \brief Sets for how long to busy wait before each deadline.
+	/// \sa ofTimer::setSpinTime()
+	void setSpinTime(unsigned long long nanoseconds);
+
+	/// \returns the time busy waiting before each deadline in nanoseconds.
+	unsigned long long getSpinTime() const;
+
+	/// \returns the latency and overrun statistics of the callback with the passed id.
+	ofTimerStats getStats(int id) const;
+
+	/// \brief Sets all the statistics of the callback with the passed id to 0.
+	void resetStats(int id);
+
+protected:
+	void threadedFunction();
+
+private:
+	typedef struct{
+		int id;
+		unsigned long long period;
+		unsigned long long nextWakeTime;
+		std::function<void()> callback;
+		ofTimerStats stats;
+	} Task;
+
+	bool hasTask(int id) const;
+
+	vector<Task> tasks;
+	int nextId;
+	unsigned long long spinNanos;
+	int runningId; // id of the callback being called, -1 if none
+	std::condition_variable_any callbackFinished;
+	ofTimer timer;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+#include "Poco/Environment.h"
+
+#ifdef OF_USING_THREAD_POOL
+
+//-------------------------------------------------
+ofThreadPoolWorker::ofThreadPoolWorker(ofThreadPool & pool, size_t index)
+:pool(pool)
+,index(index){
+	thread.setName("ofThreadPool " + ofToString(index));
+}
+
+//-------------------------------------------------
+void ofThreadPoolWorker::push(const std::function<void()> & task){
+	ofScopedLock lock(mutex);
+	tasks.push_back(task);
+}
+
+//-------------------------------------------------
+bool ofThreadPoolWorker::pop(std::function<void()> & task){
+	ofScopedLock lock(mutex);
+	if(tasks.empty()){
+		return false;
+	}
+	// the owner takes the most recent task, it's more likely
+	// to still have its data in cache
+	swap(task, tasks.back());
+	tasks.pop_back();
+	return true;
+}
+
+//-------------------------------------------------
+bool ofThreadPoolWorker::steal(std::function<void()> & task){
+	ofScopedLock lock(mutex);
+	if(tasks.empty()){
+		return false;
+	}
+	// thieves take the oldest, usually the biggest piece of work
+	swap(task, tasks.front());
+	tasks.pop_front();
+	return true;
+}
+
+//-------------------------------------------------
+void ofThreadPoolWorker::threadedFunction(){
+	std::function<void()> task;
+	while(isThreadRunning()){
+		if(pool.popTask(index, task)){
+			task();
+			task = nullptr;
+		}else{
+			std::unique_lock<std::mutex> lock(pool.sleepMutex);
+			pool.wakeUp.wait(lock, [this]{
+				return pool.pendingTasks > 0 || !isThreadRunning();
+			});
+		}
+	}
+}
+
+//-------------------------------------------------
+ofThreadPool::ofThreadPool(size_t numThreads)
+:pendingTasks(0)
+,nextWorker(0){
+	if(numThreads == 0){
+		numThreads = std::max(1u, Poco::Environment::processorCount());
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers.push_back(shared_ptr<ofThreadPoolWorker>(new ofThreadPoolWorker(*this, i)));
+	}
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->startThread();
+	}
+}
+
+//-------------------------------------------------
+ofThreadPool::~ofThreadPool(){
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->stopThread();
+	}
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeUp.notify_all();
+	}
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->waitForThread(false);
+	}
+}
+
+//-------------------------------------------------
+size_t ofThreadPool::getNumThreads() const{
+	return workers.size();
+}
+
+//-------------------------------------------------
+size_t ofThreadPool::getNumPendingTasks() const{
+	return pendingTasks;
+}
+
+//-------------------------------------------------
+void ofThreadPool::push(const std::function<void()> & task){
+	// counted before it's queued so a worker that pops it
+	// straight away never takes the counter below 0
+	pendingTasks++;
+
+	// tasks created from inside the pool stay in the same
+	// worker, the rest are distributed round robin
+	int current = getCurrentWorkerIndex();
+	if(current != -1){
+		workers[current]->push(task);
+	}else{
+		workers[nextWorker++ % workers.size()]->push(task);
+	}
+
+	// taking the lock avoids waking up before a
+	// worker that just found no tasks starts waiting
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+	}
+	wakeUp.notify_one();
+}
+
+//-------------------------------------------------
+bool ofThreadPool::popTask(int workerIndex, std::function<void()> & task){
+	if(workerIndex != -1 && workers[workerIndex]->pop(task)){
+		pendingTasks--;
+		return true;
+	}
+	size_t first = workerIndex == -1 ? 0 : workerIndex + 1;
+	for(size_t i = 0; i < workers.size(); i++){
+		size_t victim = (first + i) % workers.size();
+		if(int(victim) != workerIndex && workers[victim]->steal(task)){
+			pendingTasks--;
+			return true;
+		}
+	}
+	return false;
+}
+
+//-------------------------------------------------
+bool ofThreadPool::runPendingTask(){
+	std::function<void()> task;
+	if(popTask(getCurrentWorkerIndex(), task)){
+		task();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//-------------------------------------------------
+int ofThreadPool::getCurrentWorkerIndex() const{
+	Poco::Thread * current = ofThread::getCurrentPocoThread();
+	if(current == NULL){
+		return -1;
+	}
+	for(size_t i = 0; i < workers.size(); i++){
+		if(&workers[i]->getPocoThread() == current){
+			return i;
+		}
+	}
+	return -1;
+}
+
+//-------------------------------------------------
+size_t ofThreadPool::getGrainSize(size_t range, size_t grainSize) const{
+	if(grainSize == 0){
+		grainSize = range / ((workers.size() + 1) * 4);
+	}
+	return std::max<size_t>(1, grainSize);
+}
+
+#endif
+
+//-------------------------------------------------
+ofThreadPool & ofGetThreadPool(){
+	static ofThreadPool pool;
+	return pool;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "ofConstants.h"
+
+#if !defined(TARGET_NO_THREADS) && (__cplusplus>=201103L || defined(_MSC_VER))
+#define OF_USING_THREAD_POOL
+
+#include "ofThread.h"
+#include <deque>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+
+class ofThreadPool;
+
+/// \cond INTERNAL
+/// A worker of an ofThreadPool. Keeps its own deque of tasks,
+/// new tasks are pushed and popped from the back while other
+/// workers steal from the front when they run out of work.
+class ofThreadPoolWorker: public ofThread{
+public:
+	ofThreadPoolWorker(ofThreadPool & pool, size_t index);
+
+	void push(const std::function<void()> & task);
+	bool pop(std::function<void()> & task);
+	bool steal(std::function<void()> & task);
+
+protected:
+	void threadedFunction();
+
+private:
+	ofThreadPool & pool;
+	size_t index;
+	std::deque<std::function<void()> > tasks;
+};
+/// \endcond
+
+
+/// \class ofThreadPool
+/// \brief A fixed set of threads that run tasks in parallel.
+///
+/// Instead of each class creating its own threads, tasks can be submitted
+/// to a pool that keeps as many threads as cores are available. Each worker
+/// has its own queue of tasks and steals work from the others when it runs
+/// out, so tasks created from other tasks stay on the same thread while the
+/// load is still balanced.
+///
+/// Most of the time the global pool returned by ofGetThreadPool() should be
+/// used so the whole application shares the same threads:
+///
+///     std::future<ofPixels> pixels = ofGetThreadPool().submit([this]{
+///         return blur(frame);
+///     });
+///     ...
+///     ofPixels blurred = pixels.get();
+///
+/// Loops where each iteration is independent can be split between all the
+/// threads using ofParallelFor:
+///
+///     ofParallelFor(0, particles.size(), [&](size_t i){
+///         particles[i].update();
+///     });
+///
+/// Tasks shouldn't block waiting for other tasks with std::future::get(),
+/// if every worker is waiting the pool deadlocks. Use ofThreadPool::wait()
+/// instead which runs pending tasks while the future is not ready.
+///
+/// Only available when compiling with c++11 support, otherwise
+/// OF_USING_THREAD_POOL is not defined and ofParallelFor and
+/// ofParallelReduce run the loop in the calling thread.
+class ofThreadPool{
+public:
+	/// \brief Creates a pool and starts its threads.
+	/// \param numThreads Number of threads to create,
+	/// 0 creates one per available processor.
+	ofThreadPool(size_t numThreads = 0);
+
+	/// \brief Stops and waits for all the threads.
+	///
+	/// Tasks still in the queues are discarded.
+	~ofThreadPool();
+
+	/// \returns the number of threads in the pool.
+	size_t getNumThreads() const;
+
+	/// \returns the number of tasks waiting to be run.
+	size_t getNumPendingTasks() const;
+
+	/// \brief Runs a task in the pool.
+	///
+	/// \param task Any function or lambda without arguments.
+	/// \returns a future that will contain the value returned by the
+	/// task, or the exception it threw, once it has run.
+	template<typename F>
+	std::future<typename std::result_of<F()>::type> submit(F task);
+
+	/// \brief Waits for a future, running pending tasks in the meantime.
+	///
+	/// Safe to call from inside a task, unlike std::future::get().
+	///
+	/// \returns the value of the future.
+	template<typename T>
+	T wait(std::future<T> & future);
+
+	/// \brief Calls function(i) for every i in [begin, end) using all the threads.
+	///
+	/// The range is split in chunks of grainSize iterations that run as tasks
+	/// in the pool, the calling thread runs one of the chunks and then helps
+	/// with the rest until all of them are done. If any iteration throws, the
+	/// first exception is rethrown once all the chunks have finished.
+	///
+	/// \param begin First index.
+	/// \param end One past the last index.
+	/// \param function Called with each index, possibly from several threads at
+	/// the same time.
+	/// \param grainSize Iterations per task, 0 chooses a size that creates
+	/// around 4 tasks per thread.
+	template<typename F>
+	void parallelFor(size_t begin, size_t end, F function, size_t grainSize = 0);
+
+	/// \brief Maps every index in [begin, end) to a value and reduces them in parallel.
+	///
+	/// Each chunk reduces its values starting from identity and then the
+	/// results of every chunk are reduced in order on the calling thread,
+	/// so the result is deterministic for a given grainSize.
+	///
+	///     float total = ofGetThreadPool().parallelReduce(0, values.size(), 0.f,
+	///         [&](size_t i){ return values[i]; },
+	///         [](float a, float b){ return a + b; });
+	///
+	/// \param begin First index.
+	/// \param end One past the last index.
+	/// \param identity Initial value of each partial reduction.
+	/// \param function Called with each index, returns the value to reduce.
+	/// \param reduce Combines two values.
+	/// \param grainSize Iterations per task, 0 chooses a size automatically.
+	/// \returns the reduced value.
+	template<typename T, typename F, typename R>
+	T parallelReduce(size_t begin, size_t end, T identity, F function, R reduce, size_t grainSize = 0);
+
+	/// \brief Runs one pending task in the calling thread if there's any.
+	///
+	/// Useful to help the pool while waiting for some result.
+	///
+	/// \returns true if a task was run.
+	bool runPendingTask();
+
+private:
+	friend class ofThreadPoolWorker;
+	void push(const std::function<void()> & task);
+	bool popTask(int workerIndex, std::function<void()> & task);
+	int getCurrentWorkerIndex() const;
+	size_t getGrainSize(size_t range, size_t grainSize) const;
+
+	vector<shared_ptr<ofThreadPoolWorker> > workers;
+	std::atomic<size_t> pendingTasks;
+	std::atomic<size_t> nextWorker;
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+};
+
+//--------------------------------------------------
+template<typename F>
+std::future<typename std::result_of<F()>::type> ofThreadPool::submit(F task){
+	typedef typename std::result_of<F()>::type result_type;
+	shared_ptr<std::packaged_task<result_type()> > packaged(new std::packaged_task<result_type()>(task));
+	std::future<result_type> future = packaged->get_future();
+	push([packaged]{
+		(*packaged)();
+	});
+	return future;
+}
+
+//--------------------------------------------------
+template<typename T>
+T ofThreadPool::wait(std::future<T> & future){
+	while(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+		if(!runPendingTask()){
+			std::this_thread::yield();
+		}
+	}
+	return future.get();
+}
+
+//--------------------------------------------------
+template<typename F>
+void ofThreadPool::parallelFor(size_t begin, size_t end, F function, size_t grainSize){
+	if(end <= begin){
+		return;
+	}
+	grainSize = getGrainSize(end - begin, grainSize);
+	size_t numChunks = (end - begin + grainSize - 1) / grainSize;
+	if(numChunks == 1 || workers.empty()){
+		for(size_t i = begin; i < end; i++){
+			function(i);
+		}
+		return;
+	}
+
+	// the calling thread doesn't return until every chunk has run
+	// so the tasks can safely reference these local variables
+	std::atomic<size_t> remaining(numChunks);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	auto runChunk = [&](size_t chunkBegin, size_t chunkEnd){
+		try{
+			for(size_t i = chunkBegin; i < chunkEnd; i++){
+				function(i);
+			}
+		}catch(...){
+			std::unique_lock<std::mutex> lock(errorMutex);
+			if(!error){
+				error = std::current_exception();
+			}
+		}
+		remaining--;
+	};
+
+	for(size_t chunk = 1; chunk < numChunks; chunk++){
+		size_t chunkBegin = begin + chunk * grainSize;
+		size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+		push([&runChunk, chunkBegin, chunkEnd]{
+			runChunk(chunkBegin, chunkEnd);
+		});
+	}
+	runChunk(begin, std::min(end, begin + grainSize));
+
+	while(remaining > 0){
+		if(!runPendingTask()){
+			std::this_thread::yield();
+		}
+	}
+
+	if(error){
+		std::rethrow_exception(error);
+	}
+}
+
+//--------------------------------------------------
+template<typename T, typename F, typename R>
+T ofThreadPool::parallelReduce(size_t begin, size_t end, T identity, F function, R reduce, size_t grainSize){
+	if(end <= begin){
+		return identity;
+	}
+	grainSize = getGrainSize(end - begin, grainSize);
+	size_t numChunks = (end - begin + grainSize - 1) / grainSize;
+
+	// deque instead of vector so each chunk writes to
+	// a different object even for vector<bool>
+	std::deque<T> partials(numChunks, identity);
+	parallelFor(0, numChunks, [&](size_t chunk){
+		size_t chunkBegin = begin + chunk * grainSize;
+		size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+		T partial = identity;
+		for(size_t i = chunkBegin; i < chunkEnd; i++){
+			partial = reduce(partial, function(i));
+		}
+		partials[chunk] = partial;
+	}, 1);
+
+	T result = identity;
+	for(size_t i = 0; i < partials.size(); i++){
+		result = reduce(result, partials[i]);
+	}
+	return result;
+}
+
+#else
+
+/// Without threads or c++11 support the pool has no threads
+/// and parallel loops run in the calling thread.
+class ofThreadPool{
+public:
+	ofThreadPool(size_t numThreads = 0){}
+	size_t getNumThreads() const{ return 0; }
+	size_t getNumPendingTasks() const{ return 0; }
+	bool runPendingTask(){ return false; }
+
+	template<typename F>
+	void parallelFor(size_t begin, size_t end, F function, size_t grainSize = 0){
+		for(size_t i = begin; i < end; i++){
+			function(i);
+		}
+	}
+
+	template<typename T, typename F, typename R>
+	T parallelReduce(size_t begin, size_t end, T identity, F function, R reduce, size_t grainSize = 0){
+		T result = identity;
+		for(size_t i = begin; i < end; i++){
+			result = reduce(result, function(i));
+		}
+		return result;
+	}
+};
+
+#endif
+
+/// \brief The thread pool shared by the whole application.
+///
+/// Created the first time it's used with one thread per processor.
+///
+/// \returns a reference to the global pool.
+ofThreadPool & ofGetThreadPool();
+
+/// \brief Calls function(i) for every i in [begin, end) using the global thread pool.
+/// \sa ofThreadPool::parallelFor()
+template<typename F>
+void ofParallelFor(size_t begin, size_t end, F function, size_t grainSize = 0){
+	ofGetThreadPool().parallelFor(begin, end, function, grainSize);
+}
+
+/// \brief Maps and reduces every index in [begin, end) using the global thread pool.
+/// \sa ofThreadPool::parallelReduce()
+template<typename T, typename F, typename R>
+T ofParallelReduce(size_t begin, size_t end, T identity, F function, R reduce, size_t grainSize = 0){
+	return ofGetThreadPool().parallelReduce(begin, end, identity, function, reduce, grainSize);
+}
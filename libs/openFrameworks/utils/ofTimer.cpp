@@ -1,27 +1,35 @@
 #include "ofTimer.h"
+#include <errno.h>
 
 #define NANOS_PER_SEC 1000000000ll
 
 void ofGetMonotonicTime(unsigned long long & seconds, unsigned long long & nanoseconds);
 
+#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
+// ofGetMonotonicTime uses CLOCK_MONOTONIC so deadlines
+// can be passed directly to clock_nanosleep
+#define OF_TIMER_ABSOLUTE_SLEEP
+#endif
+
 ofTimer::ofTimer()
-:nanosPerPeriod(0)
+:nextWakeTime(0)
+,nanosPerPeriod(0)
+,spinNanos(0)
 #ifdef TARGET_WIN32
 ,hTimer(CreateWaitableTimer(NULL, TRUE, NULL))
 #endif
 {
+	resetStats();
+}
 
+ofTimer::~ofTimer(){
+#ifdef TARGET_WIN32
+	CloseHandle(hTimer);
+#endif
 }
 
 void ofTimer::reset(){
-#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
-	clock_gettime(CLOCK_MONOTONIC,&nextWakeTime);
-#elif defined(TARGET_WIN32)
-	GetSystemTimeAsFileTime((LPFILETIME)&nextWakeTime);
-#else
-	ofGetMonotonicTime(nextWakeTimeSecs,nextWakeTimeNanos);
-#endif
-	calculateNextPeriod();
+	nextWakeTime = getMonotonicNanos() + nanosPerPeriod;
 }
 
 void ofTimer::setPeriodicEvent(unsigned long long nanoseconds){
@@ -29,44 +37,110 @@ void ofTimer::setPeriodicEvent(unsigned long long nanoseconds){
 	reset();
 }
 
+unsigned long long ofTimer::getPeriod() const{
+	return nanosPerPeriod;
+}
+
 void ofTimer::waitNext(){
-#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
-	timespec remainder = {0,0};
-	clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&nextWakeTime,&remainder);
-#elif defined(TARGET_WIN32)
-	WaitForSingleObject(hTimer, INFINITE);
-#else
-	unsigned long long secsNow, nanosNow;
-	ofGetMonotonicTime(secsNow, nanosNow);
-	long long waitNanos = ((long long)(nextWakeTimeSecs - secsNow))*1000000000 + ((long long)(nextWakeTimeNanos - nanosNow));
+	unsigned long long now = getMonotonicNanos();
+	if(now < nextWakeTime){
+		if(nextWakeTime - now > spinNanos){
+			sleepUntil(nextWakeTime - spinNanos);
+		}
+		while((now = getMonotonicNanos()) < nextWakeTime);
+	}else{
+		stats.numOverruns++;
+	}
+
+	long long latency = now - nextWakeTime;
+	stats.numPeriods++;
+	stats.lastLatencyNanos = latency;
+	stats.maxLatencyNanos = std::max(stats.maxLatencyNanos, latency);
+	stats.averageLatencyNanos += (latency - stats.averageLatencyNanos) / stats.numPeriods;
+
+	// the next deadline is always a whole number of periods after the
+	// previous one so the timer doesn't drift. if the caller was late
+	// for more than a period the missed ones are skipped
+	nextWakeTime += nanosPerPeriod;
+	if(nanosPerPeriod > 0 && nextWakeTime <= now){
+		unsigned long long missed = (now - nextWakeTime) / nanosPerPeriod + 1;
+		stats.numMissedPeriods += missed;
+		nextWakeTime += missed * nanosPerPeriod;
+	}
+}
+
+void ofTimer::setSpinTime(unsigned long long nanoseconds){
+	spinNanos = nanoseconds;
+}
+
+unsigned long long ofTimer::getSpinTime() const{
+	return spinNanos;
+}
+
+const ofTimerStats & ofTimer::getStats() const{
+	return stats;
+}
+
+void ofTimer::resetStats(){
+	stats.numPeriods = 0;
+	stats.numOverruns = 0;
+	stats.numMissedPeriods = 0;
+	stats.lastLatencyNanos = 0;
+	stats.maxLatencyNanos = 0;
+	stats.averageLatencyNanos = 0;
+}
+
+unsigned long long ofTimer::getMonotonicNanos(){
+	unsigned long long seconds, nanos;
+	ofGetMonotonicTime(seconds, nanos);
+	return seconds * NANOS_PER_SEC + nanos;
+}
+
+void ofTimer::sleepUntil(unsigned long long deadline){
+#ifdef TARGET_WIN32
+	long long waitNanos = deadline - getMonotonicNanos();
 	if(waitNanos > 0){
-		timespec waittime;
-		timespec remainder;
-		waittime.tv_sec = waitNanos / NANOS_PER_SEC;
-		waittime.tv_nsec = waitNanos % NANOS_PER_SEC;
-		nanosleep(&waittime,&remainder);
+		// waitable timers only accept absolute times in the system clock
+		// which isn't monotonic, a relative wait to a monotonic deadline
+		// doesn't accumulate error anyway
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -waitNanos / 100;
+		SetWaitableTimer(hTimer, &dueTime, 0, NULL, NULL, 0);
+		WaitForSingleObject(hTimer, INFINITE);
 	}
+#else
+	waitUntil(deadline);
 #endif
-	calculateNextPeriod();
 }
 
-void ofTimer::calculateNextPeriod(){
-#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
-	nextWakeTime.tv_nsec += nanosPerPeriod;
-	if(nextWakeTime.tv_nsec>NANOS_PER_SEC){
-		uint64_t secs = nextWakeTime.tv_nsec / NANOS_PER_SEC;
-		nextWakeTime.tv_nsec-=NANOS_PER_SEC*secs;
-		nextWakeTime.tv_sec+=secs;
-	}
+void ofTimer::waitUntil(unsigned long long deadline, unsigned long long spinNanos){
+	unsigned long long sleepDeadline = deadline > spinNanos ? deadline - spinNanos : 0;
+#if defined(OF_TIMER_ABSOLUTE_SLEEP)
+	timespec wakeTime;
+	wakeTime.tv_sec = sleepDeadline / NANOS_PER_SEC;
+	wakeTime.tv_nsec = sleepDeadline % NANOS_PER_SEC;
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL) == EINTR);
 #elif defined(TARGET_WIN32)
-	nextWakeTime.QuadPart += nanosPerPeriod/100;
-	SetWaitableTimer(hTimer, &nextWakeTime, 0, NULL, NULL, 0);
+	long long waitNanos = sleepDeadline - getMonotonicNanos();
+	if(waitNanos > 0){
+		HANDLE timer = CreateWaitableTimer(NULL, TRUE, NULL);
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -waitNanos / 100;
+		SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, 0);
+		WaitForSingleObject(timer, INFINITE);
+		CloseHandle(timer);
+	}
 #else
-	nextWakeTimeNanos += nanosPerPeriod;
-	if(nextWakeTimeNanos>NANOS_PER_SEC){
-		uint64_t secs = nextWakeTimeNanos / NANOS_PER_SEC;
-		nextWakeTimeNanos-=NANOS_PER_SEC*secs;
-		nextWakeTimeSecs+=secs;
+	long long waitNanos = sleepDeadline - getMonotonicNanos();
+	if(waitNanos > 0){
+		timespec waittime;
+		timespec remainder;
+		waittime.tv_sec = waitNanos / NANOS_PER_SEC;
+		waittime.tv_nsec = waitNanos % NANOS_PER_SEC;
+		while(nanosleep(&waittime,&remainder) == -1 && errno == EINTR){
+			waittime = remainder;
+		}
 	}
 #endif
+	while(getMonotonicNanos() < deadline);
 }
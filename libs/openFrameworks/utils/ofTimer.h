@@ -1,23 +1,98 @@
 #pragma once
 #include "ofConstants.h"
 
+/// \brief Statistics about how precisely an ofTimer is waking up.
+///
+/// Latency is the time between the deadline of a period and the moment
+/// the timer actually returned from waiting for it.
+typedef struct{
+	/// number of periods waited for
+	unsigned long long numPeriods;
+	/// times waitNext() was called after the deadline had already passed
+	unsigned long long numOverruns;
+	/// whole periods skipped because of overruns
+	unsigned long long numMissedPeriods;
+	/// latency of the last period in nanoseconds
+	long long lastLatencyNanos;
+	/// maximum latency in nanoseconds
+	long long maxLatencyNanos;
+	/// average latency in nanoseconds
+	double averageLatencyNanos;
+} ofTimerStats;
+
+/// \class ofTimer
+/// \brief A precise periodic waitable timer.
+///
+/// Deadlines are absolute: each period starts exactly one period after
+/// the previous deadline no matter how long the caller took to call
+/// waitNext(), so the timer doesn't drift. If the caller takes longer
+/// than a period the timer doesn't try to catch up, the missed periods
+/// are skipped and counted in the stats.
+///
+/// On linux it waits using clock_nanosleep on the absolute deadline.
+/// Waking up from a sleep can take from a few to hundreds of microseconds
+/// depending on the system load, setSpinTime() allows to sleep until a bit
+/// before the deadline and busy wait the rest which is much more precise
+/// at the cost of some cpu.
 class ofTimer {
 public:
 	ofTimer();
+	~ofTimer();
+
+	/// \brief Starts counting the current period from now.
 	void reset();
+
+	/// \brief Sets the period and starts counting from now.
 	void setPeriodicEvent(unsigned long long nanoseconds);
+
+	/// \returns the period in nanoseconds.
+	unsigned long long getPeriod() const;
+
+	/// \brief Waits until the end of the current period.
 	void waitNext();
+
+	/// \brief Sets for how long to busy wait before each deadline.
+	///
+	/// A few hundred microseconds is usually enough to avoid most
+	/// of the jitter of waking up from sleep. 0, the default, sleeps
+	/// for the whole time.
+	void setSpinTime(unsigned long long nanoseconds);
+
+	/// \returns the time busy waiting before each deadline in nanoseconds.
+	unsigned long long getSpinTime() const;
+
+	/// \returns the latency and overrun statistics since the last reset.
+	const ofTimerStats & getStats() const;
+
+	/// \brief Sets all the statistics to 0.
+	void resetStats();
+
+	/// \returns the current time of the clock used for the deadlines in nanoseconds.
+	static unsigned long long getMonotonicNanos();
+
+	/// \brief Waits until the monotonic clock reaches deadline.
+	///
+	/// \param deadline absolute time as returned by getMonotonicNanos().
+	/// \param spinNanos time to busy wait before the deadline.
+	static void waitUntil(unsigned long long deadline, unsigned long long spinNanos = 0);
+
+	/// \brief Sleeps until the monotonic clock reaches deadline, without busy waiting.
+	///
+	/// Can return a bit later than deadline. On windows it reuses the waitable
+	/// timer of this object while waitUntil() has to create one on every call.
+	///
+	/// \param deadline absolute time as returned by getMonotonicNanos().
+	void sleepUntil(unsigned long long deadline);
+
 private:
-	void calculateNextPeriod();
-#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
-	timespec nextWakeTime;
-#elif defined(TARGET_WIN32)
-	LARGE_INTEGER nextWakeTime;
+	ofTimer(const ofTimer &);
+	ofTimer & operator=(const ofTimer &);
+
+	unsigned long long nextWakeTime;
+	unsigned long long nanosPerPeriod;
+	unsigned long long spinNanos;
+	ofTimerStats stats;
+#ifdef TARGET_WIN32
 	HANDLE hTimer;
-#else
-	unsigned long long   nextWakeTimeSecs;
-	unsigned long long   nextWakeTimeNanos;
 #endif
-	unsigned long long nanosPerPeriod;
 };
-